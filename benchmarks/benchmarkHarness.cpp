@@ -0,0 +1,509 @@
+/*
+Copyright 2005 - 2017 by Paolo Brandoli/Binarno s.p.
+
+Imebra is available for free under the GNU General Public License.
+
+The full text of the license is available in the file license.rst
+ in the project root folder.
+
+If you do not want to be bound by the GPL terms (such as the requirement
+ that your application must also be GPL), you may purchase a commercial
+ license for Imebra from the Imebra’s website (http://imebra.com).
+*/
+
+/*! \file benchmarkHarness.cpp
+    \brief Implementation of the benchmark harness and of the
+            main() function of imebra_benchmarks.
+
+*/
+
+#include "benchmarkHarness.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <regex>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+namespace imebra
+{
+
+namespace benchmarks
+{
+
+namespace
+{
+
+struct registeredBenchmark
+{
+    std::string m_name;
+    benchmarkFunction_t m_function;
+};
+
+std::vector<registeredBenchmark>& getBenchmarks()
+{
+    static std::vector<registeredBenchmark> benchmarks;
+    return benchmarks;
+}
+
+std::map<std::string, std::string>& getOptions()
+{
+    static std::map<std::string, std::string> options;
+    return options;
+}
+
+// Receives the values passed to doNotOptimize()
+///////////////////////////////////////////////////////////
+const void* volatile valueSink(nullptr);
+
+struct benchmarkResult
+{
+    std::string m_name;
+    std::uint64_t m_iterations;
+    double m_realTime;
+    double m_cpuTime;
+    double m_itemsPerSecond;
+    double m_bytesPerSecond;
+    std::string m_skipReason;
+};
+
+
+///////////////////////////////////////////////////////////
+//
+// Escape a string for the JSON output
+//
+///////////////////////////////////////////////////////////
+std::string jsonString(const std::string& value)
+{
+    std::ostringstream result;
+    result << '"';
+    for(char character: value)
+    {
+        switch(character)
+        {
+        case '"':
+            result << "\\\"";
+            break;
+        case '\\':
+            result << "\\\\";
+            break;
+        case '\n':
+            result << "\\n";
+            break;
+        default:
+            if(static_cast<unsigned char>(character) < 0x20)
+            {
+                result << "\\u" << std::hex << std::setw(4) << std::setfill('0') << static_cast<int>(character) << std::dec;
+            }
+            else
+            {
+                result << character;
+            }
+        }
+    }
+    result << '"';
+    return result.str();
+}
+
+
+///////////////////////////////////////////////////////////
+//
+// Run a benchmark, increasing the number of iterations
+//  until it runs for at least minTime seconds
+//
+///////////////////////////////////////////////////////////
+benchmarkResult runBenchmark(const registeredBenchmark& benchmark, double minTime)
+{
+    std::uint64_t iterations(1);
+    for(;;)
+    {
+        benchmarkState state(iterations);
+        benchmark.m_function(state);
+
+        benchmarkResult result;
+        result.m_name = benchmark.m_name;
+        result.m_skipReason = state.getSkipReason();
+        if(!result.m_skipReason.empty())
+        {
+            result.m_iterations = 0;
+            result.m_realTime = result.m_cpuTime = result.m_itemsPerSecond = result.m_bytesPerSecond = 0;
+            return result;
+        }
+
+        const double realTime(state.getRealTime());
+        if(realTime < minTime && iterations < 1000000000)
+        {
+            // Estimate the iterations needed to reach minTime,
+            //  growing at most 10 times per attempt
+            ///////////////////////////////////////////////////////////
+            const double multiplier(realTime > minTime / 10.0 ? minTime * 1.4 / realTime : 10.0);
+            iterations = std::max(iterations + 1, static_cast<std::uint64_t>(static_cast<double>(iterations) * multiplier));
+            continue;
+        }
+
+        result.m_iterations = state.getIterations();
+        const double iterationsDouble(static_cast<double>(result.m_iterations));
+        result.m_realTime = realTime * 1.0e9 / iterationsDouble;
+        result.m_cpuTime = state.getCpuTime() * 1.0e9 / iterationsDouble;
+        result.m_itemsPerSecond = realTime > 0 ? static_cast<double>(state.getItemsPerIteration()) * iterationsDouble / realTime : 0;
+        result.m_bytesPerSecond = realTime > 0 ? static_cast<double>(state.getBytesPerIteration()) * iterationsDouble / realTime : 0;
+        return result;
+    }
+}
+
+
+///////////////////////////////////////////////////////////
+//
+// Write the results in the google-benchmark JSON format
+//
+///////////////////////////////////////////////////////////
+void writeJson(std::ostream& stream, const std::string& executable, const std::vector<benchmarkResult>& results)
+{
+    const std::time_t now(std::time(nullptr));
+    char date[64];
+    std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S%z", std::localtime(&now));
+
+    stream << "{\n";
+    stream << "  \"context\": {\n";
+    stream << "    \"date\": " << jsonString(date) << ",\n";
+    stream << "    \"executable\": " << jsonString(executable) << ",\n";
+    stream << "    \"num_cpus\": " << std::thread::hardware_concurrency() << ",\n";
+#if defined(NDEBUG)
+    stream << "    \"library_build_type\": \"release\"\n";
+#else
+    stream << "    \"library_build_type\": \"debug\"\n";
+#endif
+    stream << "  },\n";
+    stream << "  \"benchmarks\": [";
+
+    bool bFirst(true);
+    for(const benchmarkResult& result: results)
+    {
+        stream << (bFirst ? "\n" : ",\n");
+        bFirst = false;
+        stream << "    {\n";
+        stream << "      \"name\": " << jsonString(result.m_name) << ",\n";
+        stream << "      \"run_name\": " << jsonString(result.m_name) << ",\n";
+        stream << "      \"run_type\": \"iteration\",\n";
+        if(!result.m_skipReason.empty())
+        {
+            stream << "      \"error_occurred\": true,\n";
+            stream << "      \"error_message\": " << jsonString(result.m_skipReason) << "\n";
+            stream << "    }";
+            continue;
+        }
+        stream << "      \"iterations\": " << result.m_iterations << ",\n";
+        stream << std::setprecision(10);
+        stream << "      \"real_time\": " << result.m_realTime << ",\n";
+        stream << "      \"cpu_time\": " << result.m_cpuTime << ",\n";
+        if(result.m_itemsPerSecond > 0)
+        {
+            stream << "      \"items_per_second\": " << result.m_itemsPerSecond << ",\n";
+        }
+        if(result.m_bytesPerSecond > 0)
+        {
+            stream << "      \"bytes_per_second\": " << result.m_bytesPerSecond << ",\n";
+        }
+        stream << "      \"time_unit\": \"ns\"\n";
+        stream << "    }";
+    }
+    stream << "\n  ]\n";
+    stream << "}\n";
+}
+
+
+///////////////////////////////////////////////////////////
+//
+// Write a result in the console format
+//
+///////////////////////////////////////////////////////////
+void writeConsole(std::ostream& stream, const benchmarkResult& result)
+{
+    stream << std::left << std::setw(48) << result.m_name << std::right;
+    if(!result.m_skipReason.empty())
+    {
+        stream << " SKIPPED: " << result.m_skipReason << std::endl;
+        return;
+    }
+    stream << std::fixed << std::setprecision(0)
+           << std::setw(14) << result.m_realTime << " ns"
+           << std::setw(14) << result.m_cpuTime << " ns"
+           << std::setw(12) << result.m_iterations;
+    if(result.m_itemsPerSecond > 0)
+    {
+        stream << std::setprecision(2) << std::setw(12) << result.m_itemsPerSecond / 1.0e6 << "M items/s";
+    }
+    if(result.m_bytesPerSecond > 0)
+    {
+        stream << std::setprecision(2) << std::setw(12) << result.m_bytesPerSecond / (1024.0 * 1024.0) << " MiB/s";
+    }
+    stream << std::defaultfloat << std::endl;
+}
+
+} // anonymous namespace
+
+
+benchmarkState::benchmarkState(std::uint64_t iterations):
+    m_iterations(iterations),
+    m_executedIterations(0),
+    m_bStarted(false),
+    m_bRunning(false),
+    m_cpuStart(0),
+    m_realTime(0),
+    m_cpuTime(0),
+    m_itemsPerIteration(0),
+    m_bytesPerIteration(0)
+{
+}
+
+bool benchmarkState::keepRunning()
+{
+    if(!m_skipReason.empty())
+    {
+        return false;
+    }
+
+    if(!m_bStarted)
+    {
+        m_bStarted = true;
+        resumeTiming();
+        return true;
+    }
+
+    if(++m_executedIterations < m_iterations)
+    {
+        return true;
+    }
+
+    pauseTiming();
+    return false;
+}
+
+void benchmarkState::pauseTiming()
+{
+    if(m_bRunning)
+    {
+        m_realTime += std::chrono::duration<double>(std::chrono::steady_clock::now() - m_realStart).count();
+        m_cpuTime += static_cast<double>(std::clock() - m_cpuStart) / CLOCKS_PER_SEC;
+        m_bRunning = false;
+    }
+}
+
+void benchmarkState::resumeTiming()
+{
+    if(!m_bRunning)
+    {
+        m_bRunning = true;
+        m_cpuStart = std::clock();
+        m_realStart = std::chrono::steady_clock::now();
+    }
+}
+
+void benchmarkState::setItemsPerIteration(std::uint64_t items)
+{
+    m_itemsPerIteration = items;
+}
+
+void benchmarkState::setBytesPerIteration(std::uint64_t bytes)
+{
+    m_bytesPerIteration = bytes;
+}
+
+void benchmarkState::skip(const std::string& reason)
+{
+    m_skipReason = reason;
+}
+
+std::uint64_t benchmarkState::getIterations() const
+{
+    return m_executedIterations;
+}
+
+double benchmarkState::getRealTime() const
+{
+    return m_realTime;
+}
+
+double benchmarkState::getCpuTime() const
+{
+    return m_cpuTime;
+}
+
+std::uint64_t benchmarkState::getItemsPerIteration() const
+{
+    return m_itemsPerIteration;
+}
+
+std::uint64_t benchmarkState::getBytesPerIteration() const
+{
+    return m_bytesPerIteration;
+}
+
+const std::string& benchmarkState::getSkipReason() const
+{
+    return m_skipReason;
+}
+
+
+bool registerBenchmark(const std::string& name, const benchmarkFunction_t& function)
+{
+    registeredBenchmark benchmark;
+    benchmark.m_name = name;
+    benchmark.m_function = function;
+    getBenchmarks().push_back(benchmark);
+    return true;
+}
+
+
+std::string getOption(const std::string& name)
+{
+    std::map<std::string, std::string>::const_iterator findOption(getOptions().find(name));
+    return findOption == getOptions().end() ? std::string() : findOption->second;
+}
+
+
+void doNotOptimize(const void* pValue)
+{
+    valueSink = pValue;
+}
+
+} // namespace benchmarks
+
+} // namespace imebra
+
+
+int main(int argc, char** argv)
+{
+    using namespace imebra::benchmarks;
+
+    std::string filter(".");
+    std::string format("console");
+    std::string outputFile;
+    std::string outputFormat("json");
+    double minTime(0.5);
+    bool bList(false);
+
+    for(int scanArguments(1); scanArguments != argc; ++scanArguments)
+    {
+        const std::string argument(argv[scanArguments]);
+        if(argument.compare(0, 2, "--") != 0)
+        {
+            std::cerr << "Unknown argument: " << argument << std::endl;
+            return 1;
+        }
+        const size_t equalPosition(argument.find('='));
+        const std::string name(argument.substr(2, equalPosition == std::string::npos ? std::string::npos : equalPosition - 2));
+        const std::string value(equalPosition == std::string::npos ? std::string("true") : argument.substr(equalPosition + 1));
+
+        if(name == "benchmark_filter")
+        {
+            filter = value;
+        }
+        else if(name == "benchmark_format")
+        {
+            format = value;
+        }
+        else if(name == "benchmark_out")
+        {
+            outputFile = value;
+        }
+        else if(name == "benchmark_out_format")
+        {
+            outputFormat = value;
+        }
+        else if(name == "benchmark_min_time")
+        {
+            minTime = std::atof(value.c_str());
+        }
+        else if(name == "benchmark_list_tests")
+        {
+            bList = (value == "true");
+        }
+        else if(name == "help")
+        {
+            std::cout << "Usage: " << argv[0] << " [options]\n"
+                      << "  --benchmark_filter=<regex>        run only the matching benchmarks\n"
+                      << "  --benchmark_format=<console|json> format of the standard output\n"
+                      << "  --benchmark_out=<file>            write the results to a file\n"
+                      << "  --benchmark_out_format=<json>     format of the output file\n"
+                      << "  --benchmark_min_time=<seconds>    minimum running time of each benchmark\n"
+                      << "  --benchmark_list_tests            list the benchmarks\n"
+                      << "  --progressive_jpeg=<file>         progressive JPEG used by the progressive decoding benchmark\n";
+            return 0;
+        }
+        else
+        {
+            getOptions()[name] = value;
+        }
+    }
+
+    if(format != "console" && format != "json")
+    {
+        std::cerr << "Unsupported format: " << format << std::endl;
+        return 1;
+    }
+    if(outputFormat != "json")
+    {
+        std::cerr << "Unsupported output format: " << outputFormat << std::endl;
+        return 1;
+    }
+
+    std::regex filterRegex;
+    try
+    {
+        filterRegex = std::regex(filter == "all" ? std::string(".") : filter);
+    }
+    catch(const std::regex_error&)
+    {
+        std::cerr << "Invalid filter: " << filter << std::endl;
+        return 1;
+    }
+
+    std::vector<benchmarkResult> results;
+    for(const registeredBenchmark& benchmark: getBenchmarks())
+    {
+        if(!std::regex_search(benchmark.m_name, filterRegex))
+        {
+            continue;
+        }
+        if(bList)
+        {
+            std::cout << benchmark.m_name << std::endl;
+            continue;
+        }
+
+        results.push_back(runBenchmark(benchmark, minTime));
+        if(format == "console")
+        {
+            writeConsole(std::cout, results.back());
+        }
+    }
+
+    if(bList)
+    {
+        return 0;
+    }
+
+    if(format == "json")
+    {
+        writeJson(std::cout, argv[0], results);
+    }
+
+    if(!outputFile.empty())
+    {
+        std::ofstream outputStream(outputFile);
+        if(!outputStream)
+        {
+            std::cerr << "Cannot write " << outputFile << std::endl;
+            return 1;
+        }
+        writeJson(outputStream, argv[0], results);
+    }
+
+    return 0;
+}
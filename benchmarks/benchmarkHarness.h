@@ -0,0 +1,162 @@
+/*
+Copyright 2005 - 2017 by Paolo Brandoli/Binarno s.p.
+
+Imebra is available for free under the GNU General Public License.
+
+The full text of the license is available in the file license.rst
+ in the project root folder.
+
+If you do not want to be bound by the GPL terms (such as the requirement
+ that your application must also be GPL), you may purchase a commercial
+ license for Imebra from the Imebra’s website (http://imebra.com).
+*/
+
+/*! \file benchmarkHarness.h
+    \brief Minimal benchmark harness used by imebra_benchmarks.
+
+    The command line options and the JSON output follow the ones of
+     google-benchmark, so the results can be compared with its tools
+     (e.g. compare.py).
+
+*/
+
+#if !defined(imebraBenchmarkHarness_4B0E8E61_2D3A_4C47_9E0C_8F3D6A1B7E52__INCLUDED_)
+#define imebraBenchmarkHarness_4B0E8E61_2D3A_4C47_9E0C_8F3D6A1B7E52__INCLUDED_
+
+#include <chrono>
+#include <cstdint>
+#include <ctime>
+#include <functional>
+#include <string>
+
+namespace imebra
+{
+
+namespace benchmarks
+{
+
+///////////////////////////////////////////////////////////
+/// \brief Controls the timed loop of a benchmark.
+///
+/// The benchmark function prepares its data, then
+///  executes the measured code in a loop:
+///
+/// \code
+/// while(state.keepRunning())
+/// {
+///     // measured code
+/// }
+/// \endcode
+///
+/// The timer starts at the first call to keepRunning().
+///
+///////////////////////////////////////////////////////////
+class benchmarkState
+{
+public:
+    explicit benchmarkState(std::uint64_t iterations);
+
+    /// \brief Returns true until the requested number of
+    ///        iterations has been executed.
+    ///
+    ///////////////////////////////////////////////////////////
+    bool keepRunning();
+
+    /// \brief Stop the timer (e.g. while preparing the data
+    ///        for the next iteration).
+    ///
+    ///////////////////////////////////////////////////////////
+    void pauseTiming();
+
+    /// \brief Restart the timer stopped by pauseTiming().
+    ///
+    ///////////////////////////////////////////////////////////
+    void resumeTiming();
+
+    /// \brief Set the number of items (e.g. pixels)
+    ///        processed by each iteration.
+    ///
+    ///////////////////////////////////////////////////////////
+    void setItemsPerIteration(std::uint64_t items);
+
+    /// \brief Set the number of bytes processed by each
+    ///        iteration.
+    ///
+    ///////////////////////////////////////////////////////////
+    void setBytesPerIteration(std::uint64_t bytes);
+
+    /// \brief Skip the benchmark, reporting the reason.
+    ///
+    ///////////////////////////////////////////////////////////
+    void skip(const std::string& reason);
+
+    std::uint64_t getIterations() const;
+    double getRealTime() const;
+    double getCpuTime() const;
+    std::uint64_t getItemsPerIteration() const;
+    std::uint64_t getBytesPerIteration() const;
+    const std::string& getSkipReason() const;
+
+private:
+    const std::uint64_t m_iterations;
+    std::uint64_t m_executedIterations;
+    bool m_bStarted;
+    bool m_bRunning;
+
+    std::chrono::steady_clock::time_point m_realStart;
+    std::clock_t m_cpuStart;
+    double m_realTime;
+    double m_cpuTime;
+
+    std::uint64_t m_itemsPerIteration;
+    std::uint64_t m_bytesPerIteration;
+
+    std::string m_skipReason;
+};
+
+typedef std::function<void(benchmarkState&)> benchmarkFunction_t;
+
+///////////////////////////////////////////////////////////
+/// \brief Register a benchmark.
+///
+/// \param name     the benchmark's name
+/// \param function the function that executes the
+///                 benchmark
+/// \return true
+///
+///////////////////////////////////////////////////////////
+bool registerBenchmark(const std::string& name, const benchmarkFunction_t& function);
+
+///////////////////////////////////////////////////////////
+/// \brief Return the value of a command line option
+///        not used by the harness (--name=value).
+///
+/// \param name the option's name, without the leading
+///             dashes
+/// \return the option's value, or an empty string if the
+///         option is not present
+///
+///////////////////////////////////////////////////////////
+std::string getOption(const std::string& name);
+
+///////////////////////////////////////////////////////////
+/// \brief Prevent the compiler from removing a value that
+///        is not used by the benchmark.
+///
+///////////////////////////////////////////////////////////
+void doNotOptimize(const void* pValue);
+
+} // namespace benchmarks
+
+} // namespace imebra
+
+///////////////////////////////////////////////////////////
+/// \brief Define and register a benchmark function.
+///
+///////////////////////////////////////////////////////////
+#define IMEBRA_BENCHMARK(benchmarkName) \
+    static void benchmarkName(::imebra::benchmarks::benchmarkState& state); \
+    static const bool benchmarkName##Registered(::imebra::benchmarks::registerBenchmark(#benchmarkName, benchmarkName)); \
+    static void benchmarkName(::imebra::benchmarks::benchmarkState& state)
+
+#endif // !defined(imebraBenchmarkHarness_4B0E8E61_2D3A_4C47_9E0C_8F3D6A1B7E52__INCLUDED_)
@@ -0,0 +1,245 @@
+/*
+Copyright 2005 - 2017 by Paolo Brandoli/Binarno s.p.
+
+Imebra is available for free under the GNU General Public License.
+
+The full text of the license is available in the file license.rst
+ in the project root folder.
+
+If you do not want to be bound by the GPL terms (such as the requirement
+ that your application must also be GPL), you may purchase a commercial
+ license for Imebra from the Imebra’s website (http://imebra.com).
+*/
+
+/*! \file codecsBenchmarks.cpp
+    \brief Benchmarks of the image codecs.
+
+*/
+
+#include <imebra/imebra.h>
+#include <fstream>
+#include <iterator>
+#include <vector>
+#include "benchmarkHarness.h"
+#include "../tests/buildImageForTest.h"
+
+namespace imebra
+{
+
+namespace benchmarks
+{
+
+namespace
+{
+
+const std::uint32_t benchmarkImageWidth(1024);
+const std::uint32_t benchmarkImageHeight(1024);
+
+
+///////////////////////////////////////////////////////////
+//
+// Build the images used by the codecs benchmarks
+//
+///////////////////////////////////////////////////////////
+Image buildYbrImage()
+{
+    Image rgbImage(tests::buildImageForTest(benchmarkImageWidth, benchmarkImageHeight, bitDepth_t::depthU8, 7, "RGB", 50));
+
+    Transform transformToYBR(ColorTransformsFactory::getTransform("RGB", "YBR_FULL"));
+    MutableImage ybrImage(transformToYBR.allocateOutputImage(rgbImage, benchmarkImageWidth, benchmarkImageHeight));
+    transformToYBR.runTransform(rgbImage, 0, 0, benchmarkImageWidth, benchmarkImageHeight, ybrImage, 0, 0);
+    return ybrImage;
+}
+
+Image buildMonochromeImage()
+{
+    return tests::buildImageForTest(benchmarkImageWidth, benchmarkImageHeight, bitDepth_t::depthU16, 15, "MONOCHROME2", 50);
+}
+
+
+///////////////////////////////////////////////////////////
+//
+// Encode an image to a JPEG stream
+//
+///////////////////////////////////////////////////////////
+MutableMemory saveJpeg(const Image& image, const std::string& transferSyntax)
+{
+    MutableMemory memory;
+    MemoryStreamOutput streamOutput(memory);
+    StreamWriter writer(streamOutput);
+    CodecFactory::saveImage(writer, image, transferSyntax, imageQuality_t::veryHigh, image.getHighBit() < 8 ? 8 : 16, false, false, true, false);
+    return memory;
+}
+
+
+///////////////////////////////////////////////////////////
+//
+// Load a stream and decode its first image
+//
+///////////////////////////////////////////////////////////
+void loadImage(const Memory& memory)
+{
+    MemoryStreamInput streamInput(memory);
+    StreamReader reader(streamInput);
+    DataSet dataSet(CodecFactory::load(reader));
+    Image image(dataSet.getImage(0));
+    doNotOptimize(&image);
+}
+
+
+///////////////////////////////////////////////////////////
+//
+// Encode an image to a DICOM stream
+//
+///////////////////////////////////////////////////////////
+MutableMemory saveDicom(const Image& image, const std::string& transferSyntax)
+{
+    MutableDataSet dataSet(transferSyntax);
+    dataSet.setImage(0, image, imageQuality_t::veryHigh);
+
+    MutableMemory memory;
+    MemoryStreamOutput streamOutput(memory);
+    StreamWriter writer(streamOutput);
+    CodecFactory::save(dataSet, writer, codecType_t::dicom);
+    return memory;
+}
+
+
+std::uint64_t imagePixels(const Image& image)
+{
+    return static_cast<std::uint64_t>(image.getWidth()) * image.getHeight();
+}
+
+} // anonymous namespace
+
+
+IMEBRA_BENCHMARK(jpegBaselineEncode)
+{
+    Image image(buildYbrImage());
+    state.setItemsPerIteration(imagePixels(image));
+    while(state.keepRunning())
+    {
+        MutableMemory memory(saveJpeg(image, "1.2.840.10008.1.2.4.50"));
+        doNotOptimize(&memory);
+    }
+}
+
+IMEBRA_BENCHMARK(jpegBaselineDecode)
+{
+    Image image(buildYbrImage());
+    MutableMemory memory(saveJpeg(image, "1.2.840.10008.1.2.4.50"));
+    state.setItemsPerIteration(imagePixels(image));
+    state.setBytesPerIteration(memory.size());
+    while(state.keepRunning())
+    {
+        loadImage(memory);
+    }
+}
+
+IMEBRA_BENCHMARK(jpegLosslessEncode)
+{
+    Image image(buildMonochromeImage());
+    state.setItemsPerIteration(imagePixels(image));
+    while(state.keepRunning())
+    {
+        MutableMemory memory(saveJpeg(image, "1.2.840.10008.1.2.4.70"));
+        doNotOptimize(&memory);
+    }
+}
+
+IMEBRA_BENCHMARK(jpegLosslessDecode)
+{
+    Image image(buildMonochromeImage());
+    MutableMemory memory(saveJpeg(image, "1.2.840.10008.1.2.4.70"));
+    state.setItemsPerIteration(imagePixels(image));
+    state.setBytesPerIteration(memory.size());
+    while(state.keepRunning())
+    {
+        loadImage(memory);
+    }
+}
+
+///////////////////////////////////////////////////////////
+//
+// Imebra cannot write progressive JPEG files: the file
+//  must be supplied with --progressive_jpeg=<file>
+//
+///////////////////////////////////////////////////////////
+IMEBRA_BENCHMARK(jpegProgressiveDecode)
+{
+    const std::string fileName(getOption("progressive_jpeg"));
+    if(fileName.empty())
+    {
+        state.skip("use --progressive_jpeg=<file> to specify a progressive JPEG file");
+        return;
+    }
+
+    std::ifstream file(fileName, std::ios::binary);
+    const std::vector<char> content((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    if(content.empty())
+    {
+        state.skip("cannot read " + fileName);
+        return;
+    }
+    Memory memory(content.data(), content.size());
+
+    MemoryStreamInput streamInput(memory);
+    StreamReader reader(streamInput);
+    Image image(CodecFactory::load(reader).getImage(0));
+    state.setItemsPerIteration(imagePixels(image));
+    state.setBytesPerIteration(memory.size());
+    while(state.keepRunning())
+    {
+        loadImage(memory);
+    }
+}
+
+IMEBRA_BENCHMARK(rleEncode)
+{
+    Image image(buildMonochromeImage());
+    state.setItemsPerIteration(imagePixels(image));
+    while(state.keepRunning())
+    {
+        MutableMemory memory(saveDicom(image, "1.2.840.10008.1.2.5"));
+        doNotOptimize(&memory);
+    }
+}
+
+IMEBRA_BENCHMARK(rleDecode)
+{
+    Image image(buildMonochromeImage());
+    MutableMemory memory(saveDicom(image, "1.2.840.10008.1.2.5"));
+    state.setItemsPerIteration(imagePixels(image));
+    state.setBytesPerIteration(memory.size());
+    while(state.keepRunning())
+    {
+        loadImage(memory);
+    }
+}
+
+IMEBRA_BENCHMARK(nativeEncode)
+{
+    Image image(buildMonochromeImage());
+    state.setItemsPerIteration(imagePixels(image));
+    while(state.keepRunning())
+    {
+        MutableMemory memory(saveDicom(image, "1.2.840.10008.1.2.1"));
+        doNotOptimize(&memory);
+    }
+}
+
+IMEBRA_BENCHMARK(nativeDecode)
+{
+    Image image(buildMonochromeImage());
+    MutableMemory memory(saveDicom(image, "1.2.840.10008.1.2.1"));
+    state.setItemsPerIteration(imagePixels(image));
+    state.setBytesPerIteration(memory.size());
+    while(state.keepRunning())
+    {
+        loadImage(memory);
+    }
+}
+
+} // namespace benchmarks
+
+} // namespace imebra
@@ -0,0 +1,222 @@
+/*
+Copyright 2005 - 2017 by Paolo Brandoli/Binarno s.p.
+
+Imebra is available for free under the GNU General Public License.
+
+The full text of the license is available in the file license.rst
+ in the project root folder.
+
+If you do not want to be bound by the GPL terms (such as the requirement
+ that your application must also be GPL), you may purchase a commercial
+ license for Imebra from the Imebra’s website (http://imebra.com).
+*/
+
+/*! \file dataSetBenchmarks.cpp
+    \brief Benchmarks of the DataSet parsing and serialization.
+
+*/
+
+#include <imebra/imebra.h>
+#include "benchmarkHarness.h"
+#include "../tests/buildImageForTest.h"
+#include <thread>
+#include <vector>
+#include <limits>
+
+namespace imebra
+{
+
+namespace benchmarks
+{
+
+namespace
+{
+
+///////////////////////////////////////////////////////////
+//
+// Build a dataset with a 512x512 image, some patient and
+//  study tags and a sequence
+//
+///////////////////////////////////////////////////////////
+MutableDataSet buildDataSet(const std::string& transferSyntax)
+{
+    MutableDataSet dataSet(transferSyntax);
+    dataSet.setString(TagId(tagId_t::SOPClassUID_0008_0016), "1.2.840.10008.5.1.4.1.1.7");
+    dataSet.setString(TagId(tagId_t::SOPInstanceUID_0008_0018), "1.2.3.4.5.6.7.8.9");
+    dataSet.setString(TagId(tagId_t::StudyInstanceUID_0020_000D), "1.2.3.4.5.6.7");
+    dataSet.setString(TagId(tagId_t::SeriesInstanceUID_0020_000E), "1.2.3.4.5.6.7.8");
+    dataSet.setString(TagId(tagId_t::PatientName_0010_0010), "Test^Patient");
+    dataSet.setString(TagId(tagId_t::PatientID_0010_0020), "100");
+    dataSet.setString(TagId(tagId_t::Modality_0008_0060), "OT");
+    dataSet.setString(TagId(tagId_t::StudyDescription_0008_1030), "Benchmark study");
+
+    for(std::uint32_t item(0); item != 16; ++item)
+    {
+        MutableDataSet sequenceItem(dataSet.appendSequenceItem(TagId(tagId_t::ReferencedImageSequence_0008_1140)));
+        sequenceItem.setString(TagId(tagId_t::ReferencedSOPClassUID_0008_1150), "1.2.840.10008.5.1.4.1.1.7");
+        sequenceItem.setString(TagId(tagId_t::ReferencedSOPInstanceUID_0008_1155), "1.2.3.4.5.6.7.8.9." + std::to_string(item));
+    }
+
+    dataSet.setImage(0, tests::buildImageForTest(512, 512, bitDepth_t::depthU16, 11, "MONOCHROME2", 50), imageQuality_t::veryHigh);
+
+    return dataSet;
+}
+
+
+MutableMemory saveDataSet(const DataSet& dataSet)
+{
+    MutableMemory memory;
+    MemoryStreamOutput streamOutput(memory);
+    StreamWriter writer(streamOutput);
+    CodecFactory::save(dataSet, writer, codecType_t::dicom);
+    return memory;
+}
+
+
+void serializeDataSet(benchmarkState& state, const std::string& transferSyntax)
+{
+    MutableDataSet dataSet(buildDataSet(transferSyntax));
+    state.setBytesPerIteration(saveDataSet(dataSet).size());
+    while(state.keepRunning())
+    {
+        MutableMemory memory(saveDataSet(dataSet));
+        doNotOptimize(&memory);
+    }
+}
+
+
+///////////////////////////////////////////////////////////
+//
+// Build a small dataset, similar to a C-FIND response
+//
+///////////////////////////////////////////////////////////
+MutableDataSet buildSmallDataSet()
+{
+    MutableDataSet dataSet("1.2.840.10008.1.2.1");
+    dataSet.setString(TagId(tagId_t::QueryRetrieveLevel_0008_0052), "STUDY");
+    dataSet.setString(TagId(tagId_t::StudyDate_0008_0020), "20170101");
+    dataSet.setString(TagId(tagId_t::AccessionNumber_0008_0050), "A1234");
+    dataSet.setString(TagId(tagId_t::ModalitiesInStudy_0008_0061), "CT");
+    dataSet.setString(TagId(tagId_t::PatientName_0010_0010), "Test^Patient");
+    dataSet.setString(TagId(tagId_t::PatientID_0010_0020), "100");
+    dataSet.setString(TagId(tagId_t::PatientBirthDate_0010_0030), "19700101");
+    dataSet.setString(TagId(tagId_t::StudyInstanceUID_0020_000D), "1.2.3.4.5.6.7");
+    dataSet.setString(TagId(tagId_t::StudyID_0020_0010), "1");
+    dataSet.setUint32(TagId(tagId_t::NumberOfStudyRelatedInstances_0020_1208), 100);
+    return dataSet;
+}
+
+
+void parseSmallDataSet(benchmarkState& state, dataSetAllocation_t allocation)
+{
+    MutableMemory memory(saveDataSet(buildSmallDataSet()));
+    state.setBytesPerIteration(memory.size());
+    state.setItemsPerIteration(1);
+    while(state.keepRunning())
+    {
+        MemoryStreamInput streamInput(memory);
+        StreamReader reader(streamInput);
+        DataSet dataSet(CodecFactory::load(reader, std::numeric_limits<size_t>::max(), allocation));
+        doNotOptimize(&dataSet);
+    }
+}
+
+
+void parseDataSet(benchmarkState& state, const std::string& transferSyntax)
+{
+    MutableMemory memory(saveDataSet(buildDataSet(transferSyntax)));
+    state.setBytesPerIteration(memory.size());
+    while(state.keepRunning())
+    {
+        MemoryStreamInput streamInput(memory);
+        StreamReader reader(streamInput);
+        DataSet dataSet(CodecFactory::load(reader));
+        doNotOptimize(&dataSet);
+    }
+}
+
+
+///////////////////////////////////////////////////////////
+//
+// Read the tags of a shared dataset from several threads
+//
+///////////////////////////////////////////////////////////
+void readDataSetConcurrently(benchmarkState& state, bool bFreeze)
+{
+    const size_t threadsCount(4);
+    const size_t readsPerThread(10000);
+
+    DataSet dataSet(buildSmallDataSet());
+    if(bFreeze)
+    {
+        dataSet.freeze();
+    }
+
+    state.setItemsPerIteration(threadsCount * readsPerThread);
+    while(state.keepRunning())
+    {
+        std::vector<std::thread> threads;
+        for(size_t thread(0); thread != threadsCount; ++thread)
+        {
+            threads.emplace_back([&dataSet]()
+            {
+                for(size_t read(0); read != readsPerThread; ++read)
+                {
+                    std::uint32_t instances(dataSet.getUint32(TagId(tagId_t::NumberOfStudyRelatedInstances_0020_1208), 0));
+                    doNotOptimize(&instances);
+                }
+            });
+        }
+        for(std::thread& thread: threads)
+        {
+            thread.join();
+        }
+    }
+}
+
+} // anonymous namespace
+
+
+IMEBRA_BENCHMARK(dataSetSerializeExplicitVR)
+{
+    serializeDataSet(state, "1.2.840.10008.1.2.1");
+}
+
+IMEBRA_BENCHMARK(dataSetSerializeImplicitVR)
+{
+    serializeDataSet(state, "1.2.840.10008.1.2");
+}
+
+IMEBRA_BENCHMARK(dataSetParseExplicitVR)
+{
+    parseDataSet(state, "1.2.840.10008.1.2.1");
+}
+
+IMEBRA_BENCHMARK(dataSetParseImplicitVR)
+{
+    parseDataSet(state, "1.2.840.10008.1.2");
+}
+
+IMEBRA_BENCHMARK(dataSetParseSmall)
+{
+    parseSmallDataSet(state, dataSetAllocation_t::heap);
+}
+
+IMEBRA_BENCHMARK(dataSetParseSmallArena)
+{
+    parseSmallDataSet(state, dataSetAllocation_t::arena);
+}
+
+IMEBRA_BENCHMARK(dataSetConcurrentReads)
+{
+    readDataSetConcurrently(state, false);
+}
+
+IMEBRA_BENCHMARK(dataSetConcurrentReadsFrozen)
+{
+    readDataSetConcurrently(state, true);
+}
+
+} // namespace benchmarks
+
+} // namespace imebra
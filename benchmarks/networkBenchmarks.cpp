@@ -0,0 +1,181 @@
+/*
+Copyright 2005 - 2017 by Paolo Brandoli/Binarno s.p.
+
+Imebra is available for free under the GNU General Public License.
+
+The full text of the license is available in the file license.rst
+ in the project root folder.
+
+If you do not want to be bound by the GPL terms (such as the requirement
+ that your application must also be GPL), you may purchase a commercial
+ license for Imebra from the Imebra’s website (http://imebra.com).
+*/
+
+/*! \file networkBenchmarks.cpp
+    \brief Benchmarks of the ACSE and DIMSE services.
+
+    The SCU and the SCP communicate through PipeStream objects, so the
+     benchmarks measure the protocol handling and not the network.
+
+*/
+
+#include <imebra/imebra.h>
+#include "benchmarkHarness.h"
+#include "../tests/buildImageForTest.h"
+#include <thread>
+
+namespace imebra
+{
+
+namespace benchmarks
+{
+
+namespace
+{
+
+const std::string abstractSyntax("1.2.840.10008.1.1");
+
+
+///////////////////////////////////////////////////////////
+//
+// A SCP that responds to C-ECHO and C-STORE commands
+//  until the association is released
+//
+///////////////////////////////////////////////////////////
+void scpThread(
+        const PresentationContexts& presentationContexts,
+        StreamReader& readSCP,
+        StreamWriter& writeSCP)
+{
+    try
+    {
+        AssociationSCP scp("SCP", 1, 1, presentationContexts, readSCP, writeSCP, 0, 10);
+
+        DimseService dimseService(scp);
+
+        for(;;)
+        {
+            DimseCommand command(dimseService.getCommand());
+            if(command.getCommandType() == dimseCommandType_t::cStore)
+            {
+                dimseService.sendCommandOrResponse(CStoreResponse(command.getAsCStoreCommand(), dimseStatusCode_t::success));
+            }
+            else
+            {
+                dimseService.sendCommandOrResponse(CEchoResponse(command.getAsCEchoCommand(), dimseStatusCode_t::success));
+            }
+        }
+    }
+    catch(const StreamClosedError&)
+    {
+
+    }
+}
+
+
+///////////////////////////////////////////////////////////
+//
+// Two pipes connecting a SCU to a SCP running in a
+//  secondary thread
+//
+///////////////////////////////////////////////////////////
+class pipeConnection
+{
+public:
+    pipeConnection():
+        m_toSCU(65536), m_toSCP(65536),
+        m_readSCU(m_toSCU.getStreamInput()), m_writeSCU(m_toSCP.getStreamOutput()),
+        m_readSCP(m_toSCP.getStreamInput()), m_writeSCP(m_toSCU.getStreamOutput())
+    {
+        PresentationContext context(abstractSyntax);
+        context.addTransferSyntax("1.2.840.10008.1.2.1"); // explicit VR little endian
+        m_presentationContexts.addPresentationContext(context);
+
+        m_scpThread = std::thread(scpThread, std::ref(m_presentationContexts), std::ref(m_readSCP), std::ref(m_writeSCP));
+    }
+
+    ~pipeConnection()
+    {
+        m_readSCU.terminate();
+        m_readSCP.terminate();
+        m_scpThread.join();
+    }
+
+    PipeStream m_toSCU;
+    PipeStream m_toSCP;
+
+    StreamReader m_readSCU;
+    StreamWriter m_writeSCU;
+
+    StreamReader m_readSCP;
+    StreamWriter m_writeSCP;
+
+    PresentationContexts m_presentationContexts;
+
+    std::thread m_scpThread;
+};
+
+} // anonymous namespace
+
+
+IMEBRA_BENCHMARK(dimseEchoRoundTrip)
+{
+    pipeConnection connection;
+    AssociationSCU scu("SCU", "SCP", 1, 1, connection.m_presentationContexts, connection.m_readSCU, connection.m_writeSCU, 0);
+    DimseService dimse(scu);
+
+    while(state.keepRunning())
+    {
+        CEchoCommand echoCommand(abstractSyntax, dimse.getNextCommandID(), dimseCommandPriority_t::medium, "1.1.1.1.1");
+        dimse.sendCommandOrResponse(echoCommand);
+        CEchoResponse response(dimse.getCEchoResponse(echoCommand));
+        doNotOptimize(&response);
+    }
+
+    scu.release();
+}
+
+IMEBRA_BENCHMARK(dimseStoreRoundTrip)
+{
+    pipeConnection connection;
+    AssociationSCU scu("SCU", "SCP", 1, 1, connection.m_presentationContexts, connection.m_readSCU, connection.m_writeSCU, 0);
+    DimseService dimse(scu);
+
+    MutableDataSet payload("1.2.840.10008.1.2.1");
+    payload.setString(TagId(tagId_t::SOPClassUID_0008_0016), "1.2.840.10008.5.1.4.1.1.7");
+    payload.setString(TagId(tagId_t::SOPInstanceUID_0008_0018), "1.2.3.4.5.6.7.8.9");
+    payload.setString(TagId(tagId_t::PatientName_0010_0010), "Test^Patient");
+    payload.setImage(0, tests::buildImageForTest(256, 256, bitDepth_t::depthU16, 11, "MONOCHROME2", 50), imageQuality_t::veryHigh);
+
+    while(state.keepRunning())
+    {
+        CStoreCommand storeCommand(
+                    abstractSyntax,
+                    dimse.getNextCommandID(),
+                    dimseCommandPriority_t::medium,
+                    "1.2.840.10008.5.1.4.1.1.7",
+                    "1.2.3.4.5.6.7.8.9",
+                    "",
+                    0,
+                    payload);
+        dimse.sendCommandOrResponse(storeCommand);
+        CStoreResponse response(dimse.getCStoreResponse(storeCommand));
+        doNotOptimize(&response);
+    }
+
+    scu.release();
+}
+
+IMEBRA_BENCHMARK(acseAssociationRoundTrip)
+{
+    while(state.keepRunning())
+    {
+        pipeConnection connection;
+        AssociationSCU scu("SCU", "SCP", 1, 1, connection.m_presentationContexts, connection.m_readSCU, connection.m_writeSCU, 0);
+        scu.release();
+    }
+}
+
+} // namespace benchmarks
+
+} // namespace imebra
@@ -0,0 +1,181 @@
+/*
+Copyright 2005 - 2017 by Paolo Brandoli/Binarno s.p.
+
+Imebra is available for free under the GNU General Public License.
+
+The full text of the license is available in the file license.rst
+ in the project root folder.
+
+If you do not want to be bound by the GPL terms (such as the requirement
+ that your application must also be GPL), you may purchase a commercial
+ license for Imebra from the Imebra’s website (http://imebra.com).
+*/
+
+/*! \file transformsBenchmarks.cpp
+    \brief Benchmarks of the transforms and of DrawBitmap.
+
+*/
+
+#include <imebra/imebra.h>
+#include "benchmarkHarness.h"
+#include "../tests/buildImageForTest.h"
+#include <vector>
+
+namespace imebra
+{
+
+namespace benchmarks
+{
+
+namespace
+{
+
+const std::uint32_t benchmarkImageWidth(1024);
+const std::uint32_t benchmarkImageHeight(1024);
+const std::uint64_t benchmarkImagePixels(static_cast<std::uint64_t>(benchmarkImageWidth) * benchmarkImageHeight);
+
+
+///////////////////////////////////////////////////////////
+//
+// Apply a transform to a whole image
+//
+///////////////////////////////////////////////////////////
+void runTransform(benchmarkState& state, const Transform& transform, const Image& inputImage)
+{
+    MutableImage outputImage(transform.allocateOutputImage(inputImage, benchmarkImageWidth, benchmarkImageHeight));
+    state.setItemsPerIteration(benchmarkImagePixels);
+    while(state.keepRunning())
+    {
+        transform.runTransform(inputImage, 0, 0, benchmarkImageWidth, benchmarkImageHeight, outputImage, 0, 0);
+    }
+}
+
+
+///////////////////////////////////////////////////////////
+//
+// Apply a color transform to an 8 bit image
+//
+///////////////////////////////////////////////////////////
+void runColorTransform(benchmarkState& state, const std::string& inputColorSpace, const std::string& outputColorSpace)
+{
+    Image inputImage(tests::buildImageForTest(benchmarkImageWidth, benchmarkImageHeight, bitDepth_t::depthU8, 7, inputColorSpace, 50));
+    runTransform(state, ColorTransformsFactory::getTransform(inputColorSpace, outputColorSpace), inputImage);
+}
+
+
+///////////////////////////////////////////////////////////
+//
+// 12 bit image used by the VOI/LUT benchmarks
+//
+///////////////////////////////////////////////////////////
+Image buildMonochromeImage()
+{
+    return tests::buildImageForTest(benchmarkImageWidth, benchmarkImageHeight, bitDepth_t::depthU16, 11, "MONOCHROME2", 50);
+}
+
+} // anonymous namespace
+
+
+IMEBRA_BENCHMARK(rgbToYbrFull)
+{
+    runColorTransform(state, "RGB", "YBR_FULL");
+}
+
+IMEBRA_BENCHMARK(ybrFullToRgb)
+{
+    runColorTransform(state, "YBR_FULL", "RGB");
+}
+
+IMEBRA_BENCHMARK(rgbToYbrPartial)
+{
+    runColorTransform(state, "RGB", "YBR_PARTIAL");
+}
+
+IMEBRA_BENCHMARK(ybrPartialToRgb)
+{
+    runColorTransform(state, "YBR_PARTIAL", "RGB");
+}
+
+IMEBRA_BENCHMARK(rgbToYbrRct)
+{
+    runColorTransform(state, "RGB", "YBR_RCT");
+}
+
+IMEBRA_BENCHMARK(ybrRctToRgb)
+{
+    runColorTransform(state, "YBR_RCT", "RGB");
+}
+
+IMEBRA_BENCHMARK(rgbToYbrIct)
+{
+    runColorTransform(state, "RGB", "YBR_ICT");
+}
+
+IMEBRA_BENCHMARK(ybrIctToRgb)
+{
+    runColorTransform(state, "YBR_ICT", "RGB");
+}
+
+IMEBRA_BENCHMARK(rgbToMonochrome2)
+{
+    runColorTransform(state, "RGB", "MONOCHROME2");
+}
+
+IMEBRA_BENCHMARK(monochrome2ToRgb)
+{
+    runColorTransform(state, "MONOCHROME2", "RGB");
+}
+
+IMEBRA_BENCHMARK(monochrome1ToMonochrome2)
+{
+    runColorTransform(state, "MONOCHROME1", "MONOCHROME2");
+}
+
+IMEBRA_BENCHMARK(voilut)
+{
+    VOILUT voilut(VOIDescription(2048.0, 4096.0, dicomVOIFunction_t::linear, ""));
+    runTransform(state, voilut, buildMonochromeImage());
+}
+
+IMEBRA_BENCHMARK(modalityVOILUT)
+{
+    MutableDataSet dataSet("1.2.840.10008.1.2.1");
+    dataSet.setDouble(TagId(tagId_t::RescaleSlope_0028_1053), 2.0);
+    dataSet.setDouble(TagId(tagId_t::RescaleIntercept_0028_1052), -1024.0);
+    ModalityVOILUT modalityVOILUT(dataSet);
+    runTransform(state, modalityVOILUT, buildMonochromeImage());
+}
+
+IMEBRA_BENCHMARK(optimalVOI)
+{
+    Image image(buildMonochromeImage());
+    state.setItemsPerIteration(benchmarkImagePixels);
+    while(state.keepRunning())
+    {
+        // Different percentiles on each iteration, so the
+        //  cached results are not reused
+        ///////////////////////////////////////////////////////////
+        const double lowPercentile(static_cast<double>(state.getIterations() % 1000) / 1000.0);
+        VOIDescription voi(VOILUT::getOptimalVOI(image, 0, 0, benchmarkImageWidth, benchmarkImageHeight, lowPercentile, 100.0));
+        doNotOptimize(&voi);
+    }
+}
+
+IMEBRA_BENCHMARK(drawBitmapRGBA)
+{
+    Image image(buildMonochromeImage());
+    TransformsChain chain;
+    chain.addTransform(VOILUT(VOILUT::getOptimalVOI(image, 0, 0, benchmarkImageWidth, benchmarkImageHeight)));
+    DrawBitmap drawBitmap(chain);
+
+    std::vector<char> bitmap(benchmarkImagePixels * 4);
+    state.setItemsPerIteration(benchmarkImagePixels);
+    while(state.keepRunning())
+    {
+        drawBitmap.getBitmap(image, drawBitmapType_t::drawBitmapRGBA, 4, bitmap.data(), bitmap.size());
+    }
+}
+
+} // namespace benchmarks
+
+} // namespace imebra
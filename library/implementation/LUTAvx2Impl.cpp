@@ -0,0 +1,100 @@
+/*
+Copyright 2005 - 2017 by Paolo Brandoli/Binarno s.p.
+
+Imebra is available for free under the GNU General Public License.
+
+The full text of the license is available in the file license.rst
+ in the project root folder.
+
+If you do not want to be bound by the GPL terms (such as the requirement
+ that your application must also be GPL), you may purchase a commercial
+ license for Imebra from the Imebra’s website (http://imebra.com).
+*/
+
+/*! \file LUTAvx2Impl.cpp
+    \brief AVX2 version of the lut lookup.
+
+    This file is compiled with the AVX2 instruction set enabled: its
+     functions are called only when the CPU supports AVX2.
+     Don't include headers that define non-template inline functions
+     shared with other translation units.
+
+*/
+
+#include "LUTSimdImpl.h"
+#include "simdAvx2Impl.h"
+
+#if defined(IMEBRA_SIMD_X86)
+
+namespace imebra
+{
+
+namespace implementation
+{
+
+#if defined(__AVX2__)
+
+///////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////
+//
+//
+// Clamp the values, gather the mapped values and store
+//  them
+//
+//
+///////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////
+template <class inputType, class outputType>
+size_t lutMapValuesAvx2(const inputType* pInput, outputType* pOutput, size_t count, const std::uint32_t* pTable, std::int32_t firstMapped, std::int32_t lastIndex, std::int32_t outputOffset)
+{
+    const __m256i first(_mm256_set1_epi32(firstMapped));
+    const __m256i last(_mm256_set1_epi32(lastIndex));
+    const __m256i zero(_mm256_setzero_si256());
+    const __m256i offset(_mm256_set1_epi32(outputOffset));
+    const int* pIntTable(reinterpret_cast<const int*>(pTable));
+
+    const size_t mappedCount(count & ~(size_t)7);
+    for(size_t scanValues(0); scanValues != mappedCount; scanValues += 8)
+    {
+        __m256i indexes(_mm256_sub_epi32(simd::load8(pInput + scanValues), first));
+        indexes = _mm256_min_epi32(_mm256_max_epi32(indexes, zero), last);
+        simd::store8(_mm256_add_epi32(_mm256_i32gather_epi32(pIntTable, indexes, 4), offset), pOutput + scanValues);
+    }
+
+    return mappedCount;
+}
+
+#else
+
+///////////////////////////////////////////////////////////
+//
+// Built without the AVX2 flags: let the caller map all
+//  the values
+//
+///////////////////////////////////////////////////////////
+template <class inputType, class outputType>
+size_t lutMapValuesAvx2(const inputType* /* pInput */, outputType* /* pOutput */, size_t /* count */, const std::uint32_t* /* pTable */, std::int32_t /* firstMapped */, std::int32_t /* lastIndex */, std::int32_t /* outputOffset */)
+{
+    return 0;
+}
+
+#endif
+
+#define IMEBRA_INSTANTIATE_LUT_AVX2(inputType) \
+    template size_t lutMapValuesAvx2<inputType, std::uint8_t>(const inputType*, std::uint8_t*, size_t, const std::uint32_t*, std::int32_t, std::int32_t, std::int32_t); \
+    template size_t lutMapValuesAvx2<inputType, std::int8_t>(const inputType*, std::int8_t*, size_t, const std::uint32_t*, std::int32_t, std::int32_t, std::int32_t); \
+    template size_t lutMapValuesAvx2<inputType, std::uint16_t>(const inputType*, std::uint16_t*, size_t, const std::uint32_t*, std::int32_t, std::int32_t, std::int32_t); \
+    template size_t lutMapValuesAvx2<inputType, std::int16_t>(const inputType*, std::int16_t*, size_t, const std::uint32_t*, std::int32_t, std::int32_t, std::int32_t); \
+    template size_t lutMapValuesAvx2<inputType, std::uint32_t>(const inputType*, std::uint32_t*, size_t, const std::uint32_t*, std::int32_t, std::int32_t, std::int32_t); \
+    template size_t lutMapValuesAvx2<inputType, std::int32_t>(const inputType*, std::int32_t*, size_t, const std::uint32_t*, std::int32_t, std::int32_t, std::int32_t);
+
+IMEBRA_INSTANTIATE_LUT_AVX2(std::uint8_t)
+IMEBRA_INSTANTIATE_LUT_AVX2(std::int8_t)
+IMEBRA_INSTANTIATE_LUT_AVX2(std::uint16_t)
+IMEBRA_INSTANTIATE_LUT_AVX2(std::int16_t)
+
+} // namespace implementation
+
+} // namespace imebra
+
+#endif
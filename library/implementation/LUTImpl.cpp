@@ -104,6 +104,12 @@ lut::lut(std::shared_ptr<handlers::readingDataHandlerNumericBase> pDescriptor, s
 
     m_pDataHandler = pData;
 
+    m_mappedValues.resize(m_size);
+    if(m_size != 0)
+    {
+        pData->copyTo(m_mappedValues.data(), m_size);
+    }
+
     m_description = description;
 
     IMEBRA_FUNCTION_END();
@@ -196,12 +202,17 @@ std::uint32_t lut::getMappedValue(std::int32_t index) const
         index = m_firstMapped;
     }
 
+    if(m_size == 0)
+    {
+        IMEBRA_THROW(MissingItemError, "The LUT is empty");
+    }
+
     std::uint32_t correctedIndex = (std::uint32_t)(index - m_firstMapped);
     if(correctedIndex >= m_size)
     {
         correctedIndex = m_size - 1;
     }
-    return m_pDataHandler->getUint32(correctedIndex);
+    return m_mappedValues[correctedIndex];
 
     IMEBRA_FUNCTION_END();
 }
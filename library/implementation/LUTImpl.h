@@ -21,7 +21,10 @@ If you do not want to be bound by the GPL terms (such as the requirement
 
 #include <map>
 #include <memory>
+#include <vector>
+#include <type_traits>
 #include "dataHandlerNumericImpl.h"
+#include "LUTSimdImpl.h"
 
 namespace imebra
 {
@@ -50,6 +53,10 @@ namespace handlers
 /// 3 lookups tables can be joined together to form a
 ///  color palette.
 ///
+/// The constructor copies the mapped values into a
+///  contiguous table, so the lookups don't need to go
+///  through the data handler.
+///
 ///////////////////////////////////////////////////////////
 class lut
 {
@@ -102,7 +109,84 @@ public:
 
     std::uint32_t getMappedValue(std::int32_t index) const;
 
+    /// \brief Map a sequence of values through the lut.
+    ///
+    /// The values are clamped to the range covered by the
+    ///  lut, exactly like getMappedValue() does, then
+    ///  outputOffset is added to the mapped values before
+    ///  they are stored into the output.
+    ///
+    /// Uses the AVX2 gather instructions for 8 and 16 bit
+    ///  input values when the CPU supports them.
+    ///
+    /// @param pInput       the values to map
+    /// @param pOutput      the buffer that receives the
+    ///                      mapped values
+    /// @param count        the number of values to map
+    /// @param outputOffset the value added to the mapped
+    ///                      values
+    ///
+    ///////////////////////////////////////////////////////////
+    template <class inputType, class outputType>
+    void mapValues(const inputType* pInput, outputType* pOutput, size_t count, std::int64_t outputOffset) const
+    {
+        if(m_size == 0)
+        {
+            return;
+        }
+
+        const size_t simdCount(mapValuesSimd(pInput, pOutput, count, outputOffset, std::integral_constant<bool, sizeof(inputType) <= 2>()));
+        pInput += simdCount;
+        pOutput += simdCount;
+
+        const std::uint32_t* pTable(m_mappedValues.data());
+        const std::int64_t firstMapped(m_firstMapped);
+        const std::int64_t lastIndex((std::int64_t)m_size - 1);
+        for(size_t scanValues(count - simdCount); scanValues != 0; --scanValues)
+        {
+            std::int64_t index((std::int64_t)*(pInput++) - firstMapped);
+            if(index < 0)
+            {
+                index = 0;
+            }
+            else if(index > lastIndex)
+            {
+                index = lastIndex;
+            }
+            *(pOutput++) = (outputType)(outputOffset + pTable[index]);
+        }
+    }
+
 protected:
+    // Vectorized version of mapValues(): returns the number
+    //  of values that have been mapped.
+    ///////////////////////////////////////////////////////////
+    template <class inputType, class outputType>
+    size_t mapValuesSimd(const inputType* /* pInput */, outputType* /* pOutput */, size_t /* count */, std::int64_t /* outputOffset */, std::false_type) const
+    {
+        return 0;
+    }
+
+    template <class inputType, class outputType>
+    size_t mapValuesSimd(const inputType* pInput, outputType* pOutput, size_t count, std::int64_t outputOffset, std::true_type) const
+    {
+#if defined(IMEBRA_SIMD_X86)
+        // The 32 bit lanes must be able to hold the corrected
+        //  indexes
+        ///////////////////////////////////////////////////////////
+        if(getSimdInstructions() == simdInstructions_t::avx2 && m_firstMapped >= -65536 && m_firstMapped <= 65536)
+        {
+            return lutMapValuesAvx2(pInput, pOutput, count, m_mappedValues.data(), m_firstMapped, (std::int32_t)(m_size - 1), (std::int32_t)outputOffset);
+        }
+#else
+        (void)pInput;
+        (void)pOutput;
+        (void)count;
+        (void)outputOffset;
+#endif
+        return 0;
+    }
+
     // Convert a signed value in the LUT descriptor to an
     //  unsigned value.
     ///////////////////////////////////////////////////////////
@@ -115,6 +199,10 @@ protected:
     std::wstring m_description;
 
     std::shared_ptr<handlers::readingDataHandlerNumericBase> m_pDataHandler;
+
+    // The mapped values, copied from m_pDataHandler
+    ///////////////////////////////////////////////////////////
+    std::vector<std::uint32_t> m_mappedValues;
 };
 
 
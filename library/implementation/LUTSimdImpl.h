@@ -0,0 +1,70 @@
+/*
+Copyright 2005 - 2017 by Paolo Brandoli/Binarno s.p.
+
+Imebra is available for free under the GNU General Public License.
+
+The full text of the license is available in the file license.rst
+ in the project root folder.
+
+If you do not want to be bound by the GPL terms (such as the requirement
+ that your application must also be GPL), you may purchase a commercial
+ license for Imebra from the Imebra’s website (http://imebra.com).
+*/
+
+/*! \file LUTSimdImpl.h
+    \brief Declaration of the vectorized lut lookup.
+
+*/
+
+#if !defined(imebraLUTSimd_9C41E7A2_0B5D_4F3E_8A62_D17E4B09C3F5__INCLUDED_)
+#define imebraLUTSimd_9C41E7A2_0B5D_4F3E_8A62_D17E4B09C3F5__INCLUDED_
+
+#include "simdImpl.h"
+#include <cstdint>
+#include <cstddef>
+
+namespace imebra
+{
+
+namespace implementation
+{
+
+#if defined(IMEBRA_SIMD_X86)
+
+///////////////////////////////////////////////////////////
+/// \brief Maps 8 and 16 bit values through a lut table
+///        by using the AVX2 gather instructions.
+///
+/// Each value is clamped to the range
+///  [firstMapped, firstMapped + lastIndex], looked up in
+///  pTable and added to outputOffset; the result is
+///  truncated to outputType.
+///
+/// Instantiated for std::uint8_t, std::int8_t,
+///  std::uint16_t and std::int16_t input values and all
+///  the integer output types used by the images.
+///
+/// \param pInput       the values to map
+/// \param pOutput      the buffer that receives the mapped
+///                     values
+/// \param count        the number of values to map
+/// \param pTable       the lut table
+/// \param firstMapped  the value mapped by the first item
+///                     in the table
+/// \param lastIndex    the index of the last item in the
+///                     table
+/// \param outputOffset the value added to the mapped values
+/// \return the number of values mapped: the caller must
+///         map the remaining ones
+///
+///////////////////////////////////////////////////////////
+template <class inputType, class outputType>
+size_t lutMapValuesAvx2(const inputType* pInput, outputType* pOutput, size_t count, const std::uint32_t* pTable, std::int32_t firstMapped, std::int32_t lastIndex, std::int32_t outputOffset);
+
+#endif
+
+} // namespace implementation
+
+} // namespace imebra
+
+#endif // !defined(imebraLUTSimd_9C41E7A2_0B5D_4F3E_8A62_D17E4B09C3F5__INCLUDED_)
@@ -89,7 +89,11 @@ public:
         std::int64_t sourceR, sourceG, sourceB, cb, cr;
         for(; inputHeight != 0; --inputHeight)
         {
-            for(std::uint32_t scanPixels(inputWidth); scanPixels != 0; --scanPixels)
+            const std::uint32_t simdPixels(transformPixelsSimd(colorTransformKernel_t::rgbToYbrRct, pInputMemory, pOutputMemory, inputWidth, inputHighBit, outputHighBit));
+            pInputMemory += simdPixels * 3;
+            pOutputMemory += simdPixels * 3;
+
+            for(std::uint32_t scanPixels(inputWidth - simdPixels); scanPixels != 0; --scanPixels)
             {
                 sourceR = (std::int64_t)*pInputMemory++ - inputHandlerMinValue;
                 sourceG = (std::int64_t)*pInputMemory++ - inputHandlerMinValue;
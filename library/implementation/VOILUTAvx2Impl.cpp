@@ -0,0 +1,138 @@
+/*
+Copyright 2005 - 2017 by Paolo Brandoli/Binarno s.p.
+
+Imebra is available for free under the GNU General Public License.
+
+The full text of the license is available in the file license.rst
+ in the project root folder.
+
+If you do not want to be bound by the GPL terms (such as the requirement
+ that your application must also be GPL), you may purchase a commercial
+ license for Imebra from the Imebra’s website (http://imebra.com).
+*/
+
+/*! \file VOILUTAvx2Impl.cpp
+    \brief AVX2 version of the minimum/maximum search used by the
+            optimal VOI.
+
+    This file is compiled with the AVX2 instruction set enabled: its
+     functions are called only when the CPU supports AVX2.
+     Don't include headers that define non-template inline functions
+     shared with other translation units.
+
+*/
+
+#include "VOILUTSimdImpl.h"
+#include "simdAvx2Impl.h"
+
+#if defined(IMEBRA_SIMD_X86)
+
+namespace imebra
+{
+
+namespace implementation
+{
+
+#if defined(__AVX2__)
+
+namespace
+{
+
+///////////////////////////////////////////////////////////
+//
+// Lane-wise minimum and maximum for each value type
+//
+///////////////////////////////////////////////////////////
+inline __m256i minimum(__m256i a, __m256i b, std::uint8_t)  { return _mm256_min_epu8(a, b); }
+inline __m256i maximum(__m256i a, __m256i b, std::uint8_t)  { return _mm256_max_epu8(a, b); }
+inline __m256i minimum(__m256i a, __m256i b, std::int8_t)   { return _mm256_min_epi8(a, b); }
+inline __m256i maximum(__m256i a, __m256i b, std::int8_t)   { return _mm256_max_epi8(a, b); }
+inline __m256i minimum(__m256i a, __m256i b, std::uint16_t) { return _mm256_min_epu16(a, b); }
+inline __m256i maximum(__m256i a, __m256i b, std::uint16_t) { return _mm256_max_epu16(a, b); }
+inline __m256i minimum(__m256i a, __m256i b, std::int16_t)  { return _mm256_min_epi16(a, b); }
+inline __m256i maximum(__m256i a, __m256i b, std::int16_t)  { return _mm256_max_epi16(a, b); }
+inline __m256i minimum(__m256i a, __m256i b, std::uint32_t) { return _mm256_min_epu32(a, b); }
+inline __m256i maximum(__m256i a, __m256i b, std::uint32_t) { return _mm256_max_epu32(a, b); }
+inline __m256i minimum(__m256i a, __m256i b, std::int32_t)  { return _mm256_min_epi32(a, b); }
+inline __m256i maximum(__m256i a, __m256i b, std::int32_t)  { return _mm256_max_epi32(a, b); }
+
+} // anonymous namespace
+
+
+///////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////
+//
+//
+// Minimum and maximum values
+//
+//
+///////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////
+template <class valueType>
+size_t findMinMaxAvx2(const valueType* pValues, size_t count, valueType* pMinValue, valueType* pMaxValue)
+{
+    const size_t valuesPerRegister(sizeof(__m256i) / sizeof(valueType));
+    const size_t scannedCount(count - count % valuesPerRegister);
+    if(scannedCount == 0)
+    {
+        return 0;
+    }
+
+    __m256i minValues(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(pValues)));
+    __m256i maxValues(minValues);
+    for(size_t scanValues(valuesPerRegister); scanValues != scannedCount; scanValues += valuesPerRegister)
+    {
+        const __m256i values(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(pValues + scanValues)));
+        minValues = minimum(minValues, values, valueType());
+        maxValues = maximum(maxValues, values, valueType());
+    }
+
+    // Reduce the lanes
+    ///////////////////////////////////////////////////////////
+    valueType minLanes[valuesPerRegister];
+    valueType maxLanes[valuesPerRegister];
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(minLanes), minValues);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(maxLanes), maxValues);
+    for(size_t scanLanes(0); scanLanes != valuesPerRegister; ++scanLanes)
+    {
+        if(minLanes[scanLanes] < *pMinValue)
+        {
+            *pMinValue = minLanes[scanLanes];
+        }
+        if(maxLanes[scanLanes] > *pMaxValue)
+        {
+            *pMaxValue = maxLanes[scanLanes];
+        }
+    }
+
+    return scannedCount;
+}
+
+#else
+
+///////////////////////////////////////////////////////////
+//
+// Built without the AVX2 flags: let the caller scan
+//  all the values
+//
+///////////////////////////////////////////////////////////
+template <class valueType>
+size_t findMinMaxAvx2(const valueType* /* pValues */, size_t /* count */, valueType* /* pMinValue */, valueType* /* pMaxValue */)
+{
+    return 0;
+}
+
+#endif
+
+template size_t findMinMaxAvx2<std::uint8_t>(const std::uint8_t*, size_t, std::uint8_t*, std::uint8_t*);
+template size_t findMinMaxAvx2<std::int8_t>(const std::int8_t*, size_t, std::int8_t*, std::int8_t*);
+template size_t findMinMaxAvx2<std::uint16_t>(const std::uint16_t*, size_t, std::uint16_t*, std::uint16_t*);
+template size_t findMinMaxAvx2<std::int16_t>(const std::int16_t*, size_t, std::int16_t*, std::int16_t*);
+template size_t findMinMaxAvx2<std::uint32_t>(const std::uint32_t*, size_t, std::uint32_t*, std::uint32_t*);
+template size_t findMinMaxAvx2<std::int32_t>(const std::int32_t*, size_t, std::int32_t*, std::int32_t*);
+
+} // namespace implementation
+
+} // namespace imebra
+
+#endif
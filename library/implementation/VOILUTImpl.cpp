@@ -20,7 +20,10 @@ If you do not want to be bound by the GPL terms (such as the requirement
 #include "VOILUTImpl.h"
 #include "dataSetImpl.h"
 #include "VOIDescriptionImpl.h"
+#include "threadPoolImpl.h"
 #include "../include/imebra/exceptions.h"
+#include <algorithm>
+#include <list>
 
 namespace imebra
 {
@@ -116,6 +119,249 @@ std::shared_ptr<image> VOILUT::allocateOutputImage(
 }
 
 
+///////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////
+//
+//
+// Apply the center/width/function to a single value
+//
+//
+///////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////
+std::int64_t VOILUT::getWindowValue(double inputValue, std::int64_t outputMin, std::int64_t outputMax) const
+{
+    const double outputMaxMinusOutputMin = (double)(outputMax - outputMin);
+    std::int64_t outputValue;
+
+    switch(m_function)
+    {
+    case dicomVOIFunction_t::linearExact:
+        outputValue = (std::int64_t)(((inputValue - m_windowCenter) / m_windowWidth) * outputMaxMinusOutputMin + (double)outputMin);
+        break;
+    case dicomVOIFunction_t::sigmoid:
+        outputValue = (std::int64_t)(outputMaxMinusOutputMin/(1.0 + std::exp(-4.0 * (inputValue - m_windowCenter)/ m_windowWidth)));
+        break;
+    case dicomVOIFunction_t::linear:
+    default:
+        if(m_windowWidth <= 1)
+        {
+            return inputValue <= m_windowCenter - 0.5 ? outputMin : outputMax;
+        }
+        outputValue = (std::int64_t)(((inputValue - (m_windowCenter - 0.5)) / (m_windowWidth - 1.0) + 0.5) * outputMaxMinusOutputMin + (double)outputMin);
+        break;
+    }
+
+    return std::min(std::max(outputValue, outputMin), outputMax);
+}
+
+
+///////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////
+//
+//
+// Build the table that maps all the values in the range
+//  [firstValue, lastValue]
+//
+//
+///////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////
+std::shared_ptr<const VOILUT::windowTable> VOILUT::getWindowTable(std::int32_t firstValue, std::int32_t lastValue, std::int64_t outputMin, std::int64_t outputMax) const
+{
+    IMEBRA_FUNCTION_START();
+
+    {
+        std::lock_guard<std::mutex> lock(m_windowTableMutex);
+        if(m_pWindowTable != nullptr &&
+                m_pWindowTable->m_firstValue == firstValue &&
+                m_pWindowTable->m_lastValue == lastValue &&
+                m_pWindowTable->m_outputMin == outputMin &&
+                m_pWindowTable->m_outputMax == outputMax)
+        {
+            return m_pWindowTable;
+        }
+    }
+
+    std::shared_ptr<windowTable> pTable(std::make_shared<windowTable>());
+    pTable->m_firstValue = firstValue;
+    pTable->m_lastValue = lastValue;
+    pTable->m_outputMin = outputMin;
+    pTable->m_outputMax = outputMax;
+
+    // All the functions are monotonic: only the values
+    //  between the first change after the lowest input and
+    //  the last change before the highest input need to be
+    //  calculated, the others are filled with the
+    //  saturated values.
+    ///////////////////////////////////////////////////////////
+    const std::int64_t firstOutput(getWindowValue((double)firstValue, outputMin, outputMax));
+    const std::int64_t lastOutput(getWindowValue((double)lastValue, outputMin, outputMax));
+
+    std::int32_t lowestChange(firstValue), highestChange(lastValue + 1);
+    if(firstOutput == lastOutput)
+    {
+        lowestChange = highestChange;
+    }
+    else
+    {
+        // First value with an output different from
+        //  firstOutput
+        ///////////////////////////////////////////////////////////
+        std::int32_t searchLow(firstValue + 1), searchHigh(lastValue);
+        while(searchLow < searchHigh)
+        {
+            const std::int32_t middle(searchLow + (searchHigh - searchLow) / 2);
+            if(getWindowValue((double)middle, outputMin, outputMax) != firstOutput)
+            {
+                searchHigh = middle;
+            }
+            else
+            {
+                searchLow = middle + 1;
+            }
+        }
+        lowestChange = searchLow;
+
+        // First value with the output equal to lastOutput
+        ///////////////////////////////////////////////////////////
+        searchHigh = lastValue;
+        while(searchLow < searchHigh)
+        {
+            const std::int32_t middle(searchLow + (searchHigh - searchLow) / 2);
+            if(getWindowValue((double)middle, outputMin, outputMax) == lastOutput)
+            {
+                searchHigh = middle;
+            }
+            else
+            {
+                searchLow = middle + 1;
+            }
+        }
+        highestChange = searchLow;
+    }
+
+    std::vector<std::uint32_t>& values(pTable->m_values);
+    values.resize((size_t)((std::int64_t)lastValue - (std::int64_t)firstValue + 1));
+    std::fill(values.begin(), values.begin() + (lowestChange - firstValue), (std::uint32_t)(firstOutput - outputMin));
+    for(std::int32_t scanValues(lowestChange); scanValues < highestChange; ++scanValues)
+    {
+        values[(size_t)(scanValues - firstValue)] = (std::uint32_t)(getWindowValue((double)scanValues, outputMin, outputMax) - outputMin);
+    }
+    std::fill(values.begin() + (highestChange - firstValue), values.end(), (std::uint32_t)(lastOutput - outputMin));
+
+    std::lock_guard<std::mutex> lock(m_windowTableMutex);
+    m_pWindowTable = pTable;
+    return pTable;
+
+    IMEBRA_FUNCTION_END();
+}
+
+
+namespace
+{
+
+///////////////////////////////////////////////////////////
+//
+// Optimal VOI already calculated for an image area.
+//
+// The entry refers to the image's memory: the image
+//  replaces its memory when a writing handler commits
+//  new content, so an entry is never reused for
+//  different pixels.
+//
+///////////////////////////////////////////////////////////
+struct optimalVOIEntry
+{
+    std::weak_ptr<const memory> m_pMemory;
+    std::uint32_t m_topLeftX;
+    std::uint32_t m_topLeftY;
+    std::uint32_t m_width;
+    std::uint32_t m_height;
+    double m_lowPercentile;
+    double m_highPercentile;
+    std::shared_ptr<VOIDescription> m_pVOIDescription;
+};
+
+bool samePercentile(double percentile0, double percentile1)
+{
+    return std::fabs(percentile0 - percentile1) < std::numeric_limits<double>::denorm_min();
+}
+
+///////////////////////////////////////////////////////////
+//
+// Keeps the most recently calculated optimal VOIs
+//
+///////////////////////////////////////////////////////////
+class optimalVOICache
+{
+public:
+    std::shared_ptr<VOIDescription> find(const std::shared_ptr<const memory>& pMemory, std::uint32_t topLeftX, std::uint32_t topLeftY, std::uint32_t width, std::uint32_t height, double lowPercentile, double highPercentile)
+    {
+        std::lock_guard<std::mutex> lock(m_lock);
+
+        for(std::list<optimalVOIEntry>::iterator scanEntries(m_entries.begin()); scanEntries != m_entries.end(); )
+        {
+            std::shared_ptr<const memory> pEntryMemory(scanEntries->m_pMemory.lock());
+            if(pEntryMemory == nullptr)
+            {
+                // The image has been modified or released
+                ///////////////////////////////////////////////////////////
+                scanEntries = m_entries.erase(scanEntries);
+                continue;
+            }
+            if(pEntryMemory == pMemory &&
+                    scanEntries->m_topLeftX == topLeftX &&
+                    scanEntries->m_topLeftY == topLeftY &&
+                    scanEntries->m_width == width &&
+                    scanEntries->m_height == height &&
+                    samePercentile(scanEntries->m_lowPercentile, lowPercentile) &&
+                    samePercentile(scanEntries->m_highPercentile, highPercentile))
+            {
+                m_entries.splice(m_entries.begin(), m_entries, scanEntries);
+                return m_entries.front().m_pVOIDescription;
+            }
+            ++scanEntries;
+        }
+
+        return nullptr;
+    }
+
+    void add(const std::shared_ptr<const memory>& pMemory, std::uint32_t topLeftX, std::uint32_t topLeftY, std::uint32_t width, std::uint32_t height, double lowPercentile, double highPercentile, const std::shared_ptr<VOIDescription>& pVOIDescription)
+    {
+        std::lock_guard<std::mutex> lock(m_lock);
+
+        optimalVOIEntry entry;
+        entry.m_pMemory = pMemory;
+        entry.m_topLeftX = topLeftX;
+        entry.m_topLeftY = topLeftY;
+        entry.m_width = width;
+        entry.m_height = height;
+        entry.m_lowPercentile = lowPercentile;
+        entry.m_highPercentile = highPercentile;
+        entry.m_pVOIDescription = pVOIDescription;
+        m_entries.push_front(entry);
+
+        if(m_entries.size() > m_maxEntries)
+        {
+            m_entries.pop_back();
+        }
+    }
+
+private:
+    static const size_t m_maxEntries = 32;
+
+    std::mutex m_lock;
+    std::list<optimalVOIEntry> m_entries;
+};
+
+optimalVOICache& getOptimalVOICache()
+{
+    static optimalVOICache cache;
+    return cache;
+}
+
+} // anonymous namespace
+
+
 ///////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////
 //
@@ -129,17 +375,137 @@ std::shared_ptr<VOIDescription> VOILUT::getOptimalVOI(const std::shared_ptr<imeb
 {
     IMEBRA_FUNCTION_START();
 
+    return getOptimalVOI(inputImage, inputTopLeftX, inputTopLeftY, inputWidth, inputHeight, 0.0, 100.0);
+
+    IMEBRA_FUNCTION_END();
+}
+
+
+///////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////
+//
+//
+// Finds the optimal VOI between two percentiles.
+//
+//
+///////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////
+std::shared_ptr<VOIDescription> VOILUT::getOptimalVOI(const std::shared_ptr<imebra::implementation::image>& inputImage, std::uint32_t inputTopLeftX, std::uint32_t inputTopLeftY, std::uint32_t inputWidth, std::uint32_t inputHeight, double lowPercentile, double highPercentile)
+{
+    IMEBRA_FUNCTION_START();
+
     std::uint32_t width, height;
     inputImage->getSize(&width, &height);
 
-    if(inputTopLeftX + inputWidth > width || inputTopLeftY + inputHeight > height)
+    if(inputWidth == 0 || inputHeight == 0 || inputTopLeftX + inputWidth > width || inputTopLeftY + inputHeight > height)
     {
         IMEBRA_THROW(TransformInvalidAreaError, "The input and/or output areas are invalid");
     }
 
+    if(!(lowPercentile >= 0.0 && lowPercentile <= highPercentile && highPercentile <= 100.0))
+    {
+        IMEBRA_THROW(TransformError, "The percentiles must be in the range 0..100 and the low percentile cannot be greater than the high percentile");
+    }
+
     std::shared_ptr<handlers::readingDataHandlerNumericBase> handler(inputImage->getReadingDataHandler());
-    std::shared_ptr<VOIDescription> voiDescription;
-    HANDLER_CALL_TEMPLATE_FUNCTION_WITH_PARAMS(templateFindOptimalVOI, handler, width, inputTopLeftX, inputTopLeftY, inputWidth, inputHeight, voiDescription);
+    const std::shared_ptr<const memory> pMemory(handler->getMemory());
+
+    optimalVOICache& cache(getOptimalVOICache());
+    std::shared_ptr<VOIDescription> voiDescription(cache.find(pMemory, inputTopLeftX, inputTopLeftY, inputWidth, inputHeight, lowPercentile, highPercentile));
+    if(voiDescription != nullptr)
+    {
+        return voiDescription;
+    }
+
+    // Split the area in bands of rows, one for each thread
+    //  that can run in parallel. Small areas are scanned
+    //  by the calling thread only.
+    ///////////////////////////////////////////////////////////
+    std::shared_ptr<threadPool> pThreadPool(threadPool::getThreadPool());
+    const size_t minimumBandPixels(65536);
+    const size_t areaPixels((size_t)inputWidth * (size_t)inputHeight);
+    const std::uint32_t bandsNumber((std::uint32_t)std::max((size_t)1, std::min(std::min(pThreadPool->getMaximumParallelism(), areaPixels / minimumBandPixels), (size_t)inputHeight)));
+    const std::uint32_t bandHeight((inputHeight + bandsNumber - 1) / bandsNumber);
+
+    // Find the minimum and maximum values
+    ///////////////////////////////////////////////////////////
+    std::vector<std::int64_t> bandsMinValue(bandsNumber);
+    std::vector<std::int64_t> bandsMaxValue(bandsNumber);
+    pThreadPool->parallelFor(bandsNumber, bandsNumber, [&](size_t band)
+    {
+        const std::uint32_t firstRow((std::uint32_t)band * bandHeight);
+        const std::uint32_t rows(std::min(bandHeight, inputHeight - firstRow));
+        HANDLER_CALL_TEMPLATE_FUNCTION_WITH_PARAMS(templateFindMinMax, handler, width, inputTopLeftX, inputTopLeftY + firstRow, inputWidth, rows, bandsMinValue[band], bandsMaxValue[band]);
+    });
+
+    std::int64_t minValue(*std::min_element(bandsMinValue.begin(), bandsMinValue.end()));
+    std::int64_t maxValue(*std::max_element(bandsMaxValue.begin(), bandsMaxValue.end()));
+
+    // Move the limits to the requested percentiles
+    ///////////////////////////////////////////////////////////
+    if(minValue != maxValue && (lowPercentile > 0.0 || highPercentile < 100.0))
+    {
+        // Up to 65536 bins: each bin covers a single value
+        //  for images with up to 16 bits per sample
+        ///////////////////////////////////////////////////////////
+        std::uint32_t binShift(0);
+        while(((maxValue - minValue) >> binShift) >= 65536)
+        {
+            ++binShift;
+        }
+        const size_t binsNumber((size_t)((maxValue - minValue) >> binShift) + 1);
+
+        std::vector<std::vector<std::uint32_t> > bandsHistogram(bandsNumber);
+        pThreadPool->parallelFor(bandsNumber, bandsNumber, [&](size_t band)
+        {
+            const std::uint32_t firstRow((std::uint32_t)band * bandHeight);
+            const std::uint32_t rows(std::min(bandHeight, inputHeight - firstRow));
+            bandsHistogram[band].resize(binsNumber, 0);
+            HANDLER_CALL_TEMPLATE_FUNCTION_WITH_PARAMS(templateBuildHistogram, handler, width, inputTopLeftX, inputTopLeftY + firstRow, inputWidth, rows, minValue, binShift, bandsHistogram[band]);
+        });
+
+        // Positions of the limits in the sorted pixels
+        ///////////////////////////////////////////////////////////
+        const double totalPixels((double)areaPixels);
+        const size_t lowIndex(std::min(areaPixels - 1, (size_t)std::floor(totalPixels * lowPercentile / 100.0)));
+        size_t highIndex((size_t)std::max(1.0, std::ceil(totalPixels * highPercentile / 100.0)) - 1);
+        highIndex = std::max(lowIndex, std::min(areaPixels - 1, highIndex));
+
+        size_t lowBin(0), highBin(0);
+        size_t pixelsCount(0);
+        for(size_t scanBins(0); scanBins != binsNumber; ++scanBins)
+        {
+            const size_t previousCount(pixelsCount);
+            for(const std::vector<std::uint32_t>& bandHistogram: bandsHistogram)
+            {
+                pixelsCount += bandHistogram[scanBins];
+            }
+            if(previousCount <= lowIndex && pixelsCount > lowIndex)
+            {
+                lowBin = scanBins;
+            }
+            if(pixelsCount > highIndex)
+            {
+                highBin = scanBins;
+                break;
+            }
+        }
+
+        const std::int64_t highLimit(minValue + ((std::int64_t)(highBin + 1) << binShift) - 1);
+        minValue += (std::int64_t)lowBin << binShift;
+        maxValue = std::min(maxValue, highLimit);
+    }
+
+    const double center((double)(maxValue + minValue + 1) / 2);
+    const double windowWidth(2.0 * (center - (double)minValue));
+    voiDescription = std::make_shared<VOIDescription>(
+                center,
+                windowWidth,
+                dicomVOIFunction_t::linear,
+                "");
+
+    cache.add(pMemory, inputTopLeftX, inputTopLeftY, inputWidth, inputHeight, lowPercentile, highPercentile, voiDescription);
+
     return voiDescription;
 
     IMEBRA_FUNCTION_END();
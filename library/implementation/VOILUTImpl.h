@@ -22,8 +22,13 @@ If you do not want to be bound by the GPL terms (such as the requirement
 #include "imageImpl.h"
 #include "LUTImpl.h"
 #include "transformImpl.h"
+#include "VOILUTSimdImpl.h"
 #include <string>
 #include <cmath>
+#include <limits>
+#include <mutex>
+#include <type_traits>
+#include <vector>
 
 
 namespace imebra
@@ -94,6 +99,40 @@ public:
     ///////////////////////////////////////////////////////////
     static std::shared_ptr<VOIDescription> getOptimalVOI(const std::shared_ptr<imebra::implementation::image>& inputImage, std::uint32_t inputTopLeftX, std::uint32_t inputTopLeftY, std::uint32_t inputWidth, std::uint32_t inputHeight);
 
+    /// \brief Finds the optimal VOI values, ignoring the
+    ///        darkest and the brightest pixels.
+    ///
+    /// The window covers the values between the
+    ///  lowPercentile and the highPercentile of the
+    ///  pixels in the area. 0 and 100 select the
+    ///  minimum and maximum values, as getOptimalVOI()
+    ///  without the percentiles.
+    ///
+    /// The histogram is exact for images with up to 16 bits
+    ///  per sample: with wider ranges each histogram bin
+    ///  covers more values and the limits are rounded
+    ///  outward to the bin boundaries.
+    ///
+    /// The result is cached and reused until the image
+    ///  content changes.
+    ///
+    /// @param inputImage     the image for which the optimal
+    ///                        VOI must be found
+    /// @param inputTopLeftX  the horizontal coordinate of the
+    ///                        top-left corner of the area
+    /// @param inputTopLeftY  the vertical coordinate of the
+    ///                        top-left corner of the area
+    /// @param inputWidth     the width of the area
+    /// @param inputHeight    the height of the area
+    /// @param lowPercentile  the percentage of pixels (0..100)
+    ///                        that are left below the window
+    /// @param highPercentile the percentage of pixels (0..100)
+    ///                        that are inside or below the
+    ///                        window
+    ///
+    ///////////////////////////////////////////////////////////
+    static std::shared_ptr<VOIDescription> getOptimalVOI(const std::shared_ptr<imebra::implementation::image>& inputImage, std::uint32_t inputTopLeftX, std::uint32_t inputTopLeftY, std::uint32_t inputWidth, std::uint32_t inputHeight, double lowPercentile, double highPercentile);
+
     DEFINE_RUN_TEMPLATE_TRANSFORM;
 
     // The actual transformation is done here
@@ -131,12 +170,9 @@ public:
         {
             for(; inputHeight != 0; --inputHeight)
             {
-                for(std::uint32_t scanPixels(inputWidth); scanPixels != 0; --scanPixels)
-                {
-                    *(pOutputMemory++) = (outputType)( outputHandlerMinValue + m_pLUT->getMappedValue((std::int32_t)*pInputMemory++ ));
-                }
-                pInputMemory += (inputHandlerWidth - inputWidth);
-                pOutputMemory += (outputHandlerWidth - inputWidth);
+                m_pLUT->mapValues(pInputMemory, pOutputMemory, inputWidth, outputHandlerMinValue);
+                pInputMemory += inputHandlerWidth;
+                pOutputMemory += outputHandlerWidth;
             }
             return;
         }
@@ -149,6 +185,15 @@ public:
         std::int64_t outputHandlerNumValues = (std::int64_t)1 << (outputHighBit + 1);
         std::int64_t outputMin(outputHandlerMinValue);
         std::int64_t outputMax(outputHandlerMinValue + outputHandlerNumValues - 1);
+
+        // 8 and 16 bit values are mapped through a table
+        ///////////////////////////////////////////////////////////
+        if(mapValuesThroughTable(pInputMemory, pOutputMemory, inputHandlerWidth, outputHandlerWidth, inputWidth, inputHeight, outputMin, outputMax,
+                                 std::integral_constant<bool, sizeof(inputType) <= 2>()))
+        {
+            return;
+        }
+
         double outputMaxMinusOutputMin = (double)(outputMax - outputMin);
         double inputValue;
         std::int64_t outputValue;
@@ -275,54 +320,167 @@ public:
 
 protected:
 
-    // Find the optimal VOI
+    // Table that maps all the values of an 8 or 16 bit type
+    //  through the center/width/function.
+    // The values are stored as offsets from the minimum
+    //  output value.
+    ///////////////////////////////////////////////////////////
+    struct windowTable
+    {
+        std::int32_t m_firstValue;
+        std::int32_t m_lastValue;
+        std::int64_t m_outputMin;
+        std::int64_t m_outputMax;
+        std::vector<std::uint32_t> m_values;
+    };
+
+    // Return the table for the specified input range and
+    //  output range: the last built table is cached.
+    ///////////////////////////////////////////////////////////
+    std::shared_ptr<const windowTable> getWindowTable(std::int32_t firstValue, std::int32_t lastValue, std::int64_t outputMin, std::int64_t outputMax) const;
+
+    // Apply the center/width/function to one value.
+    // Returns the same values as templateTransform().
+    ///////////////////////////////////////////////////////////
+    std::int64_t getWindowValue(double inputValue, std::int64_t outputMin, std::int64_t outputMax) const;
+
+    // Map the values through the window table: returns false
+    //  if the input type is too large for a table.
+    ///////////////////////////////////////////////////////////
+    template <class inputType, class outputType>
+    bool mapValuesThroughTable(
+            const inputType* /* pInputMemory */, outputType* /* pOutputMemory */,
+            std::uint32_t /* inputHandlerWidth */, std::uint32_t /* outputHandlerWidth */,
+            std::uint32_t /* inputWidth */, std::uint32_t /* inputHeight */,
+            std::int64_t /* outputMin */, std::int64_t /* outputMax */,
+            std::false_type) const
+    {
+        return false;
+    }
+
+    template <class inputType, class outputType>
+    bool mapValuesThroughTable(
+            const inputType* pInputMemory, outputType* pOutputMemory,
+            std::uint32_t inputHandlerWidth, std::uint32_t outputHandlerWidth,
+            std::uint32_t inputWidth, std::uint32_t inputHeight,
+            std::int64_t outputMin, std::int64_t outputMax,
+            std::true_type) const
+    {
+        const std::int32_t firstValue((std::int32_t)std::numeric_limits<inputType>::min());
+        const std::int32_t lastValue((std::int32_t)std::numeric_limits<inputType>::max());
+
+        std::shared_ptr<const windowTable> pTable(getWindowTable(firstValue, lastValue, outputMin, outputMax));
+        const std::uint32_t* pValues(pTable->m_values.data());
+
+#if defined(IMEBRA_SIMD_X86)
+        const bool bAvx2(getSimdInstructions() == simdInstructions_t::avx2);
+#endif
+
+        for(; inputHeight != 0; --inputHeight)
+        {
+            size_t mappedValues(0);
+#if defined(IMEBRA_SIMD_X86)
+            if(bAvx2)
+            {
+                mappedValues = lutMapValuesAvx2(pInputMemory, pOutputMemory, inputWidth, pValues, firstValue, lastValue - firstValue, (std::int32_t)outputMin);
+            }
+#endif
+            const inputType* pInput(pInputMemory + mappedValues);
+            outputType* pOutput(pOutputMemory + mappedValues);
+            for(size_t scanPixels(inputWidth - mappedValues); scanPixels != 0; --scanPixels)
+            {
+                *(pOutput++) = (outputType)(outputMin + (std::int64_t)pValues[(std::int32_t)*(pInput++) - firstValue]);
+            }
+
+            pInputMemory += inputHandlerWidth;
+            pOutputMemory += outputHandlerWidth;
+        }
+
+        return true;
+    }
+
+    // Find the minimum and maximum values in a band of rows
     //
     ///////////////////////////////////////////////////////////
     template <class inputType> static
-            void templateFindOptimalVOI(
+            void templateFindMinMax(
                     inputType* inputHandlerData, size_t /* inputHandlerSize */, std::uint32_t inputHandlerWidth,
                     std::uint32_t inputTopLeftX, std::uint32_t inputTopLeftY, std::uint32_t inputWidth, std::uint32_t inputHeight,
-                    std::shared_ptr<VOIDescription>& voiDescription)
+                    std::int64_t& minValue, std::int64_t& maxValue)
     {
         IMEBRA_FUNCTION_START();
 
-        inputType* pInputMemory(inputHandlerData + inputHandlerWidth * inputTopLeftY + inputTopLeftX);
-        inputType minValue(*pInputMemory);
-        inputType maxValue(minValue);
-        inputType value;
+        const inputType* pInputMemory(inputHandlerData + (size_t)inputHandlerWidth * inputTopLeftY + inputTopLeftX);
+        inputType bandMinValue(*pInputMemory);
+        inputType bandMaxValue(bandMinValue);
+
+#if defined(IMEBRA_SIMD_X86)
+        const bool bSimd(getSimdInstructions() == simdInstructions_t::avx2);
+#endif
         for(std::uint32_t scanY(inputHeight); scanY != 0; --scanY)
         {
-            for(std::uint32_t scanX(inputWidth); scanX != 0; --scanX)
+            size_t scanX(0);
+#if defined(IMEBRA_SIMD_X86)
+            if(bSimd)
             {
-                value = *(pInputMemory++);
-                if(value < minValue)
+                scanX = findMinMaxAvx2(pInputMemory, inputWidth, &bandMinValue, &bandMaxValue);
+            }
+#endif
+            for(; scanX != inputWidth; ++scanX)
+            {
+                const inputType value(pInputMemory[scanX]);
+                if(value < bandMinValue)
                 {
-                    minValue = value;
+                    bandMinValue = value;
                 }
-                else if(value > maxValue)
+                else if(value > bandMaxValue)
                 {
-                    maxValue = value;
+                    bandMaxValue = value;
                 }
             }
-            pInputMemory += inputHandlerWidth - inputWidth;
+            pInputMemory += inputHandlerWidth;
         }
 
-        double center = (double)((std::int64_t)maxValue + (std::int64_t)minValue + 1) / 2;
-        double width = 2.0 * (center - (double)minValue);
-        voiDescription = std::make_shared<VOIDescription>(
-                    center,
-                    width,
-                    dicomVOIFunction_t::linear,
-                    "");
+        minValue = (std::int64_t)bandMinValue;
+        maxValue = (std::int64_t)bandMaxValue;
 
         IMEBRA_FUNCTION_END();
+    }
+
+    // Count the values in a band of rows. The histogram has
+    //  one bin for each group of (1 << binShift) values,
+    //  starting from minValue
+    //
+    ///////////////////////////////////////////////////////////
+    template <class inputType> static
+            void templateBuildHistogram(
+                    inputType* inputHandlerData, size_t /* inputHandlerSize */, std::uint32_t inputHandlerWidth,
+                    std::uint32_t inputTopLeftX, std::uint32_t inputTopLeftY, std::uint32_t inputWidth, std::uint32_t inputHeight,
+                    std::int64_t minValue, std::uint32_t binShift, std::vector<std::uint32_t>& histogram)
+    {
+        IMEBRA_FUNCTION_START();
 
+        const inputType* pInputMemory(inputHandlerData + (size_t)inputHandlerWidth * inputTopLeftY + inputTopLeftX);
+        std::uint32_t* pHistogram(histogram.data());
+        for(std::uint32_t scanY(inputHeight); scanY != 0; --scanY)
+        {
+            for(std::uint32_t scanX(0); scanX != inputWidth; ++scanX)
+            {
+                ++pHistogram[(size_t)(((std::int64_t)pInputMemory[scanX] - minValue) >> binShift)];
+            }
+            pInputMemory += inputHandlerWidth;
+        }
+
+        IMEBRA_FUNCTION_END();
     }
 
     std::shared_ptr<const lut> m_pLUT;
     double m_windowCenter;
     double m_windowWidth;
     dicomVOIFunction_t m_function;
+
+    mutable std::mutex m_windowTableMutex;
+    mutable std::shared_ptr<const windowTable> m_pWindowTable;
 };
 
 /// @}
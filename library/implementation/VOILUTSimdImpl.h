@@ -0,0 +1,61 @@
+/*
+Copyright 2005 - 2017 by Paolo Brandoli/Binarno s.p.
+
+Imebra is available for free under the GNU General Public License.
+
+The full text of the license is available in the file license.rst
+ in the project root folder.
+
+If you do not want to be bound by the GPL terms (such as the requirement
+ that your application must also be GPL), you may purchase a commercial
+ license for Imebra from the Imebra’s website (http://imebra.com).
+*/
+
+/*! \file VOILUTSimdImpl.h
+    \brief Declaration of the vectorized functions used by the
+            optimal VOI search.
+
+*/
+
+#if !defined(imebraVOILUTSimd_0C9E4F1B_6A52_4D3E_9B07_2F8E5D1A7C34__INCLUDED_)
+#define imebraVOILUTSimd_0C9E4F1B_6A52_4D3E_9B07_2F8E5D1A7C34__INCLUDED_
+
+#include "simdImpl.h"
+#include <cstdint>
+#include <cstddef>
+
+namespace imebra
+{
+
+namespace implementation
+{
+
+#if defined(IMEBRA_SIMD_X86)
+
+///////////////////////////////////////////////////////////
+/// \brief Finds the minimum and the maximum values in a
+///        row with the AVX2 instructions.
+///
+/// Instantiated for all the integer types used by the
+///  images.
+///
+/// \param pValues   the values to scan
+/// \param count     the number of values to scan
+/// \param pMinValue contains the minimum value found so
+///                  far and receives the updated minimum
+/// \param pMaxValue contains the maximum value found so
+///                  far and receives the updated maximum
+/// \return the number of values scanned: the caller
+///         must scan the remaining ones
+///
+///////////////////////////////////////////////////////////
+template <class valueType>
+size_t findMinMaxAvx2(const valueType* pValues, size_t count, valueType* pMinValue, valueType* pMaxValue);
+
+#endif
+
+} // namespace implementation
+
+} // namespace imebra
+
+#endif // !defined(imebraVOILUTSimd_0C9E4F1B_6A52_4D3E_9B07_2F8E5D1A7C34__INCLUDED_)
@@ -90,7 +90,11 @@ public:
 
         for(; inputHeight != 0; --inputHeight)
         {
-            for(std::uint32_t scanPixels(inputWidth); scanPixels != 0; --scanPixels)
+            const std::uint32_t simdPixels(transformPixelsSimd(colorTransformKernel_t::ybrFullToRgb, pInputMemory, pOutputMemory, inputWidth, inputHighBit, outputHighBit));
+            pInputMemory += simdPixels * 3;
+            pOutputMemory += simdPixels * 3;
+
+            for(std::uint32_t scanPixels(inputWidth - simdPixels); scanPixels != 0; --scanPixels)
             {
                 sourceY = (std::int64_t)*(pInputMemory++);
                 sourceB = (std::int64_t)*(pInputMemory++) - inputMiddleValue;
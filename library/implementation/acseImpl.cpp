@@ -19,6 +19,7 @@ If you do not want to be bound by the GPL terms (such as the requirement
 #include "memoryImpl.h"
 #include "configurationImpl.h"
 #include "dicomStreamCodecImpl.h"
+#include "codecFactoryImpl.h"
 #include "dataHandlerStringUIImpl.h"
 #include <memory.h>
 #include <cassert>
@@ -1746,7 +1747,8 @@ associationBase::associationBase(
     m_pReader(pReader),
     m_pWriter(pWriter),
     m_bTerminated(false),
-    m_dimseTimeout(dimseTimeout)
+    m_dimseTimeout(dimseTimeout),
+    m_dataSetAllocation(dataSetAllocation_t::heap)
 {
 }
 
@@ -2087,7 +2089,8 @@ std::shared_ptr<associationBase::receivedDataset> associationBase::decodePDU(boo
 
             std::shared_ptr<memoryStreamInput> dataSetStream(std::make_shared<memoryStreamInput>(datasetMemory));
             std::shared_ptr<streamReader> dataSetStreamReader(std::make_shared<streamReader>(dataSetStream));
-            std::shared_ptr<dataSet> pDataset(std::make_shared<dataSet>(transferSyntax, charsetsList_t()));
+            std::shared_ptr<memoryArena> pArena(codecs::codecFactory::createDataSetArena(m_dataSetAllocation));
+            std::shared_ptr<dataSet> pDataset(allocateShared<dataSet>(pArena, transferSyntax, charsetsList_t(), pArena));
             codecs::dicomStreamCodec::parseStream(dataSetStreamReader, pDataset, bExplicitDataType, endianType);
 
             // Return the dataset
@@ -2205,6 +2208,11 @@ std::string associationBase::getOtherAET() const
     IMEBRA_FUNCTION_END();
 }
 
+void associationBase::setDataSetAllocation(dataSetAllocation_t allocation)
+{
+    m_dataSetAllocation = allocation;
+}
+
 std::string associationBase::getPresentationContextTransferSyntax(const std::string& abstractSyntax) const
 {
     IMEBRA_FUNCTION_START();
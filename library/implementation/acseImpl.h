@@ -1236,6 +1236,17 @@ public:
     //////////////////////////////////////////////////////////////////
     std::string getOtherAET() const;
 
+    ///
+    /// \brief Set how the memory for the datasets received
+    ///        from now on is allocated.
+    ///
+    /// \param allocation dataSetAllocation_t::arena to
+    ///                   allocate each received dataSet from
+    ///                   its own memory arena
+    ///
+    //////////////////////////////////////////////////////////////////
+    void setDataSetAllocation(dataSetAllocation_t allocation);
+
     std::string getPresentationContextTransferSyntax(const std::string& abstractSyntax) const;
 
     std::vector<std::string> getPresentationContextTransferSyntaxes(const std::string& abstractSyntax) const;
@@ -1334,6 +1345,10 @@ private:
     // DIMSE Timeout, in seconds (0 = infinite)
     ///////////////////////////////////////////////////////////
     std::uint32_t m_dimseTimeout;
+
+    // How the memory for the received datasets is allocated
+    ///////////////////////////////////////////////////////////
+    std::atomic<dataSetAllocation_t> m_dataSetAllocation;
 };
 
 
@@ -34,6 +34,11 @@ bool baseStreamInput::seekable() const
     return false;
 }
 
+std::shared_ptr<const memory> baseStreamInput::getMemory(size_t /* startPosition */, size_t /* length */) const
+{
+    return nullptr;
+}
+
 baseStreamOutput::~baseStreamOutput()
 {
 }
@@ -36,6 +36,8 @@ namespace imebra
 namespace implementation
 {
 
+class memory;
+
 ///////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////
 /// \brief This class represents an input stream.
@@ -111,6 +113,25 @@ public:
     ///////////////////////////////////////////////////////////
     virtual bool seekable() const;
 
+    ///
+    /// \brief Return a memory object that refers to a region
+    ///        of the stream's content without copying it.
+    ///
+    /// Used by the buffers loaded lazily from the stream to
+    ///  avoid copying their content.
+    ///
+    /// The default implementation returns a null pointer,
+    ///  meaning that the region must be read with read().
+    ///
+    /// @param startPosition the position of the first byte
+    ///                      of the region
+    /// @param length        the region's size, in bytes
+    /// @return a memory object referring to the region, or
+    ///         a null pointer if the stream's content is
+    ///         not available in memory
+    ///
+    ///////////////////////////////////////////////////////////
+    virtual std::shared_ptr<const memory> getMemory(size_t startPosition, size_t length) const;
 
 };
 
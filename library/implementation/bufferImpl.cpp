@@ -82,7 +82,9 @@ buffer::buffer(const std::shared_ptr<const charsetsList_t>& pCharsets, streamCon
     m_originalBufferPosition(0),
     m_originalBufferLength(0),
     m_originalWordLength(1),
-    m_pCharsetsList(pCharsets)
+    m_pCharsetsList(pCharsets),
+    m_writingHandlers(0),
+    m_bFrozen(false)
 {
 }
 
@@ -108,7 +110,9 @@ buffer::buffer(
         m_originalBufferPosition(bufferPosition),
         m_originalBufferLength(bufferLength),
         m_originalWordLength(wordLength),
-        m_pCharsetsList(pCharsets)
+        m_pCharsetsList(pCharsets),
+        m_writingHandlers(0),
+        m_bFrozen(false)
 {
 }
 
@@ -136,18 +140,36 @@ std::shared_ptr<const memory> buffer::getLocalMemory() const
     ///////////////////////////////////////////////////////////
     if(m_originalStream != nullptr)
     {
+        const bool bAdjustEndian(m_originalWordLength > 1u && m_byteOrdering != streamReader::getPlatformEndian());
+
+        // If the stream's content is already in memory then
+        //  refer to it directly when it doesn't need to be
+        //  adjusted and it is aligned to the word's length
+        ///////////////////////////////////////////////////////////
+        std::shared_ptr<const memory> sourceMemory(m_originalStream->getMemory(m_originalBufferPosition, m_originalBufferLength));
+        if(sourceMemory != nullptr &&
+                !bAdjustEndian &&
+                (m_originalWordLength <= 1u || reinterpret_cast<std::uintptr_t>(sourceMemory->data()) % m_originalWordLength == 0))
+        {
+            return sourceMemory;
+        }
+
         std::shared_ptr<memory> localMemory(std::make_shared<memory>(m_originalBufferLength));
         if(m_originalBufferLength != 0)
         {
-            std::shared_ptr<streamReader> reader(std::make_shared<streamReader>(m_originalStream, m_originalBufferPosition, m_originalBufferLength));
-            std::vector<std::uint8_t> localBuffer;
-            localBuffer.resize(m_originalBufferLength);
-            reader->read(&localBuffer[0], m_originalBufferLength);
-            if(m_originalWordLength != 0)
+            if(sourceMemory != nullptr)
+            {
+                ::memcpy(localMemory->data(), sourceMemory->data(), m_originalBufferLength);
+            }
+            else
+            {
+                std::shared_ptr<streamReader> reader(std::make_shared<streamReader>(m_originalStream, m_originalBufferPosition, m_originalBufferLength));
+                reader->read(localMemory->data(), m_originalBufferLength);
+            }
+            if(bAdjustEndian)
             {
-                reader->adjustEndian(&localBuffer[0], m_originalWordLength, m_byteOrdering, m_originalBufferLength/m_originalWordLength);
+                streamReader::adjustEndian(localMemory->data(), m_originalWordLength, m_byteOrdering, m_originalBufferLength / m_originalWordLength);
             }
-            localMemory->assign(&localBuffer[0], m_originalBufferLength);
         }
         return localMemory;
     }
@@ -208,7 +230,7 @@ std::shared_ptr<handlers::readingDataHandler> buffer::getReadingDataHandler(tagV
 {
     IMEBRA_FUNCTION_START();
 
-    std::lock_guard<std::mutex> lock(m_mutex);
+    std::unique_lock<std::mutex> lock(lockForReading());
 
     std::shared_ptr<const memory> localMemory(getLocalMemory());
 
@@ -330,7 +352,31 @@ std::shared_ptr<handlers::writingDataHandler> buffer::getWritingDataHandler(tagV
 {
     IMEBRA_FUNCTION_START();
 
-    std::lock_guard<std::mutex> lock(m_mutex);
+    std::unique_lock<std::mutex> lock(lockForWriting());
+
+    std::shared_ptr<handlers::writingDataHandler> handler(createWritingDataHandler(tagVR, size));
+
+    // The handler calls commit() when it is released
+    ///////////////////////////////////////////////////////////
+    ++m_writingHandlers;
+
+    return handler;
+
+    IMEBRA_FUNCTION_END();
+}
+
+
+///////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////
+//
+// Allocate a writing handler for the buffer's VR. The
+//  caller must hold the buffer's lock
+//
+///////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////
+std::shared_ptr<handlers::writingDataHandler> buffer::createWritingDataHandler(tagVR_t tagVR, std::uint32_t size)
+{
+    IMEBRA_FUNCTION_START();
 
     // Reset the pointer to the data handler
     ///////////////////////////////////////////////////////////
@@ -462,7 +508,7 @@ std::shared_ptr<handlers::writingDataHandler> buffer::getWritingDataHandler(tagV
 ///////////////////////////////////////////////////////////
 bool buffer::hasExternalStream() const
 {
-    std::lock_guard<std::mutex> lock(m_mutex);
+    std::unique_lock<std::mutex> lock(lockForReading());
 
     return m_originalStream != nullptr;
 }
@@ -481,7 +527,7 @@ std::shared_ptr<streamReader> buffer::getStreamReader()
 {
     IMEBRA_FUNCTION_START();
 
-    std::lock_guard<std::mutex> lock(m_mutex);
+    std::unique_lock<std::mutex> lock(lockForReading());
 
     // If the object must be loaded from the original stream,
     //  then return the original stream
@@ -538,7 +584,7 @@ std::shared_ptr<handlers::readingDataHandlerRaw> buffer::getReadingDataHandlerRa
 {
     IMEBRA_FUNCTION_START();
 
-    std::lock_guard<std::mutex> lock(m_mutex);
+    std::unique_lock<std::mutex> lock(lockForReading());
 
     return std::make_shared<handlers::readingDataHandlerRaw>(getLocalMemory(), tagVR);
 
@@ -550,9 +596,15 @@ std::shared_ptr<handlers::writingDataHandlerRaw> buffer::getWritingDataHandlerRa
 {
     IMEBRA_FUNCTION_START();
 
-    std::lock_guard<std::mutex> lock(m_mutex);
+    std::unique_lock<std::mutex> lock(lockForWriting());
+
+    std::shared_ptr<handlers::writingDataHandlerRaw> handler(std::make_shared<handlers::writingDataHandlerRaw>(shared_from_this(), size, tagVR));
+
+    // The handler calls commit() when it is released
+    ///////////////////////////////////////////////////////////
+    ++m_writingHandlers;
 
-    return std::make_shared<handlers::writingDataHandlerRaw>(shared_from_this(), size, tagVR);
+    return handler;
 
     IMEBRA_FUNCTION_END();
 }
@@ -603,7 +655,7 @@ void buffer::appendMemory(std::shared_ptr<const memory> pMemory)
 {
     IMEBRA_FUNCTION_START();
 
-    std::lock_guard<std::mutex> lock(m_mutex);
+    std::unique_lock<std::mutex> lock(lockForWriting());
 
     m_memory.push_back(pMemory);
 
@@ -622,7 +674,7 @@ size_t buffer::getBufferSizeBytes() const
 {
     IMEBRA_FUNCTION_START();
 
-    std::lock_guard<std::mutex> lock(m_mutex);
+    std::unique_lock<std::mutex> lock(lockForReading());
 
     // The buffer has not been loaded yet
     ///////////////////////////////////////////////////////////
@@ -662,6 +714,32 @@ void buffer::commit(std::shared_ptr<memory> newMemory)
 
     std::lock_guard<std::mutex> lock(m_mutex);
 
+    // freeze() refuses to run while a writing handler is
+    //  alive, so the buffer cannot be frozen here
+    ///////////////////////////////////////////////////////////
+    --m_writingHandlers;
+
+    m_memory.clear();
+    m_memory.push_back(newMemory);
+    m_originalStream.reset();
+
+    IMEBRA_FUNCTION_END();
+}
+
+
+///////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////
+//
+// Replace the buffer's content without a writing handler
+//
+///////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////
+void buffer::assignMemory(std::shared_ptr<const memory> newMemory)
+{
+    IMEBRA_FUNCTION_START();
+
+    std::unique_lock<std::mutex> lock(lockForWriting());
+
     m_memory.clear();
     m_memory.push_back(newMemory);
     m_originalStream.reset();
@@ -670,6 +748,84 @@ void buffer::commit(std::shared_ptr<memory> newMemory)
 }
 
 
+///////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////
+//
+// Return true if a writing handler is still alive
+//
+///////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////
+bool buffer::hasWritingDataHandlers() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    return m_writingHandlers != 0;
+}
+
+
+///////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////
+//
+// Make the buffer read only
+//
+///////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////
+void buffer::freeze()
+{
+    IMEBRA_FUNCTION_START();
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    if(m_writingHandlers != 0)
+    {
+        IMEBRA_THROW(DataSetFrozenError, "Cannot freeze a buffer while a writing data handler is alive");
+    }
+
+    m_bFrozen.store(true, std::memory_order_release);
+
+    IMEBRA_FUNCTION_END();
+}
+
+
+///////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////
+//
+// Lock the buffer, unless it is frozen
+//
+///////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////
+std::unique_lock<std::mutex> buffer::lockForReading() const
+{
+    if(m_bFrozen.load(std::memory_order_acquire))
+    {
+        return std::unique_lock<std::mutex>();
+    }
+    return std::unique_lock<std::mutex>(m_mutex);
+}
+
+
+///////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////
+//
+// Lock the buffer, or throw if it is frozen
+//
+///////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////
+std::unique_lock<std::mutex> buffer::lockForWriting() const
+{
+    IMEBRA_FUNCTION_START();
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    if(m_bFrozen.load(std::memory_order_relaxed))
+    {
+        IMEBRA_THROW(DataSetFrozenError, "The buffer belongs to a frozen dataset");
+    }
+    return lock;
+
+    IMEBRA_FUNCTION_END();
+}
+
+
 } // namespace implementation
 
 } // namespace imebra
@@ -25,6 +25,7 @@ If you do not want to be bound by the GPL terms (such as the requirement
 #include "../include/imebra/definitions.h"
 
 #include <mutex>
+#include <atomic>
 
 namespace imebra
 {
@@ -186,6 +187,16 @@ public:
     ///////////////////////////////////////////////////////////
     void appendMemory(std::shared_ptr<const memory> pMemory);
 
+    /// \brief Replace the buffer's content with a block of
+    ///         memory, without creating a writing handler.
+    ///
+    /// Throws DataSetFrozenError if the buffer is frozen.
+    ///
+    /// @param newMemory the new buffer's content
+    ///
+    ///////////////////////////////////////////////////////////
+    void assignMemory(std::shared_ptr<const memory> newMemory);
+
 
     ///////////////////////////////////////////////////////////
     /// \name Stream
@@ -245,10 +256,60 @@ public:
 
     //@}
 
+    /// \brief Called by the writing handlers when they are
+    ///         released: replace the buffer's content with
+    ///         the handler's memory.
+    ///
+    /// Must be called exactly once by each handler returned
+    ///  by getWritingDataHandler() or
+    ///  getWritingDataHandlerRaw().
+    ///
+    /// @param newMemory the handler's memory
+    ///
+    ///////////////////////////////////////////////////////////
     void commit(std::shared_ptr<memory> newMemory);
 
+    /// \brief Return true if a writing handler obtained from
+    ///         the buffer has not been released yet.
+    ///
+    ///////////////////////////////////////////////////////////
+    bool hasWritingDataHandlers() const;
+
+    /// \brief Make the buffer read only.
+    ///
+    /// Once frozen, the reading methods don't lock the
+    ///  buffer anymore and the writing methods throw
+    ///  DataSetFrozenError.
+    ///
+    /// Throws DataSetFrozenError if a writing handler
+    ///  obtained from the buffer is still alive.
+    ///
+    ///////////////////////////////////////////////////////////
+    void freeze();
+
 protected:
 
+    /// \brief Lock the buffer before reading its content.
+    ///
+    /// The returned lock doesn't own the mutex when the
+    ///  buffer is frozen.
+    ///
+    ///////////////////////////////////////////////////////////
+    std::unique_lock<std::mutex> lockForReading() const;
+
+    /// \brief Lock the buffer before modifying its content.
+    ///
+    /// Throws DataSetFrozenError if the buffer is frozen.
+    ///
+    ///////////////////////////////////////////////////////////
+    std::unique_lock<std::mutex> lockForWriting() const;
+
+    /// \brief Allocate a writing handler for the specified
+    ///         VR. The caller must hold the buffer's lock.
+    ///
+    ///////////////////////////////////////////////////////////
+    std::shared_ptr<handlers::writingDataHandler> createWritingDataHandler(tagVR_t tagVR, std::uint32_t size);
+
     /// \brief Returns a memory block containing the buffer
     ///        data.
     ///
@@ -297,6 +358,14 @@ private:
     ///////////////////////////////////////////////////////////
     std::shared_ptr<const charsetsList_t> m_pCharsetsList;
 
+    // Writing handlers not released yet, guarded by m_mutex
+    ///////////////////////////////////////////////////////////
+    size_t m_writingHandlers;
+
+    // Set by freeze()
+    ///////////////////////////////////////////////////////////
+    std::atomic<bool> m_bFrozen;
+
 };
 
 
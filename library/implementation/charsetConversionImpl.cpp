@@ -22,6 +22,198 @@ namespace imebra
 namespace implementation
 {
 
+///////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////
+//
+//
+// cachedCharsetConversion
+//
+//
+///////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////
+cachedCharsetConversion::cachedCharsetConversion():
+    m_pInfo(nullptr), m_bAsciiCompatible(false)
+{
+}
+
+cachedCharsetConversion::cachedCharsetConversion(const charsetInformation& info, std::unique_ptr<defaultCharsetConversion> pConversion, bool bAsciiCompatible):
+    m_pInfo(&info), m_pConversion(std::move(pConversion)), m_bAsciiCompatible(bAsciiCompatible)
+{
+}
+
+cachedCharsetConversion::cachedCharsetConversion(cachedCharsetConversion&& source):
+    m_pInfo(source.m_pInfo), m_pConversion(std::move(source.m_pConversion)), m_bAsciiCompatible(source.m_bAsciiCompatible)
+{
+    source.m_pInfo = nullptr;
+}
+
+cachedCharsetConversion::~cachedCharsetConversion()
+{
+    reset();
+}
+
+cachedCharsetConversion& cachedCharsetConversion::operator=(cachedCharsetConversion&& source)
+{
+    if(this != &source)
+    {
+        reset();
+        m_pInfo = source.m_pInfo;
+        m_pConversion = std::move(source.m_pConversion);
+        m_bAsciiCompatible = source.m_bAsciiCompatible;
+        source.m_pInfo = nullptr;
+    }
+    return *this;
+}
+
+const defaultCharsetConversion* cachedCharsetConversion::operator->() const
+{
+    return m_pConversion.get();
+}
+
+bool cachedCharsetConversion::isAsciiCompatible() const
+{
+    return m_bAsciiCompatible;
+}
+
+void cachedCharsetConversion::reset()
+{
+    if(m_pConversion != nullptr)
+    {
+        charsetConversionCache::getCharsetConversionCache().reuseConversion(m_pInfo, std::move(m_pConversion));
+    }
+    m_pInfo = nullptr;
+}
+
+
+///////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////
+//
+//
+// charsetConversionCache
+//
+//
+///////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////
+charsetConversionCache::cachedConversions::cachedConversions():
+    m_bAsciiTested(false), m_bAsciiCompatible(false)
+{
+}
+
+charsetConversionCache& charsetConversionCache::getCharsetConversionCache()
+{
+    static charsetConversionCache cache;
+    return cache;
+}
+
+cachedCharsetConversion charsetConversionCache::getConversion(const charsetInformation& info)
+{
+    IMEBRA_FUNCTION_START();
+
+    bool bAsciiTested(false);
+    bool bAsciiCompatible(false);
+    {
+        std::lock_guard<std::mutex> lock(m_lock);
+        cachedConversions& conversions(m_cachedConversions[&info]);
+        if(!conversions.m_conversions.empty())
+        {
+            std::unique_ptr<defaultCharsetConversion> pConversion(std::move(conversions.m_conversions.back()));
+            conversions.m_conversions.pop_back();
+            return cachedCharsetConversion(info, std::move(pConversion), conversions.m_bAsciiCompatible);
+        }
+        bAsciiTested = conversions.m_bAsciiTested;
+        bAsciiCompatible = conversions.m_bAsciiCompatible;
+    }
+
+    // Create the conversion object outside the lock
+    ///////////////////////////////////////////////////////////
+    std::unique_ptr<defaultCharsetConversion> pConversion(new defaultCharsetConversion(info));
+    if(!bAsciiTested)
+    {
+        bAsciiCompatible = testAsciiCompatible(*pConversion);
+
+        std::lock_guard<std::mutex> lock(m_lock);
+        cachedConversions& conversions(m_cachedConversions[&info]);
+        conversions.m_bAsciiTested = true;
+        conversions.m_bAsciiCompatible = bAsciiCompatible;
+    }
+
+    return cachedCharsetConversion(info, std::move(pConversion), bAsciiCompatible);
+
+    IMEBRA_FUNCTION_END();
+}
+
+void charsetConversionCache::reuseConversion(const charsetInformation* pInfo, std::unique_ptr<defaultCharsetConversion> pConversion)
+{
+    std::lock_guard<std::mutex> lock(m_lock);
+
+    // Keep enough conversion objects for a few threads
+    ///////////////////////////////////////////////////////////
+    std::vector<std::unique_ptr<defaultCharsetConversion> >& conversions(m_cachedConversions[pInfo].m_conversions);
+    if(conversions.size() < IMEBRA_CHARSET_CONVERSION_CACHE_SIZE)
+    {
+        conversions.push_back(std::move(pConversion));
+    }
+}
+
+bool charsetConversionCache::testAsciiCompatible(const defaultCharsetConversion& conversion)
+{
+    std::string asciiChars;
+    std::wstring unicodeChars;
+    for(char asciiChar(1); asciiChar != 0x7f; ++asciiChar)
+    {
+        if(asciiChar != 0x1b)
+        {
+            asciiChars.push_back(asciiChar);
+            unicodeChars.push_back((wchar_t)asciiChar);
+        }
+    }
+    asciiChars.push_back(0x7f);
+    unicodeChars.push_back((wchar_t)0x7f);
+
+    try
+    {
+        return conversion.toUnicode(asciiChars) == unicodeChars && conversion.fromUnicode(unicodeChars) == asciiChars;
+    }
+    catch(const std::exception&)
+    {
+        return false;
+    }
+}
+
+
+///////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////
+//
+//
+// dicomConversion
+//
+//
+///////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////
+bool dicomConversion::isAscii(const std::string& value)
+{
+    for(const char scanChars: value)
+    {
+        if((scanChars & 0x80) != 0 || scanChars == 0x1b || scanChars == 0)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool dicomConversion::isAscii(const std::wstring& value)
+{
+    for(const wchar_t scanChars: value)
+    {
+        if(scanChars >= 0x80 || scanChars == 0x1b || scanChars == 0)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
 std::string dicomConversion::convertFromUnicode(const std::wstring& unicodeString, const charsetsList_t& charsets)
 {
     IMEBRA_FUNCTION_START();
@@ -31,13 +223,19 @@ std::string dicomConversion::convertFromUnicode(const std::wstring& unicodeStrin
         return "";
     }
 
+    charsetConversionCache& conversionCache(charsetConversionCache::getCharsetConversionCache());
+
     // Check for the dicom charset's name
     ///////////////////////////////////////////////////////////
     if(charsets.empty())
     {
-        const charsetInformation info = defaultCharsetConversion::getDictionary().getCharsetInformation("ISO_IR 6", 0);
-        defaultCharsetConversion localCharsetConversion(info);
-        std::string returnString =  localCharsetConversion.fromUnicode(unicodeString);
+        const charsetInformation& info = defaultCharsetConversion::getDictionary().getCharsetInformation("ISO_IR 6", 0);
+        cachedCharsetConversion localCharsetConversion(conversionCache.getConversion(info));
+        if(localCharsetConversion.isAsciiCompatible() && isAscii(unicodeString))
+        {
+            return std::string(unicodeString.begin(), unicodeString.end());
+        }
+        std::string returnString =  localCharsetConversion->fromUnicode(unicodeString);
         if(returnString.empty())
         {
             IMEBRA_THROW(CharsetConversionCannotConvert, "Cannot convert from unicode using only the charset 'ISO_IR 6'");
@@ -47,8 +245,16 @@ std::string dicomConversion::convertFromUnicode(const std::wstring& unicodeStrin
 
     // Setup the conversion objects
     ///////////////////////////////////////////////////////////
-    const charsetInformation startingInfo = defaultCharsetConversion::getDictionary().getCharsetInformation(charsets.front(), 0);
-    std::unique_ptr<defaultCharsetConversion> localCharsetConversion(new defaultCharsetConversion(startingInfo));
+    const charsetInformation& startingInfo = defaultCharsetConversion::getDictionary().getCharsetInformation(charsets.front(), 0);
+    cachedCharsetConversion localCharsetConversion(conversionCache.getConversion(startingInfo));
+
+    // 7 bit strings don't need to be converted when the
+    //  initial charset maps them to themselves
+    ///////////////////////////////////////////////////////////
+    if(localCharsetConversion.isAsciiCompatible() && isAscii(unicodeString))
+    {
+        return std::string(unicodeString.begin(), unicodeString.end());
+    }
 
     // Returned string
     ///////////////////////////////////////////////////////////
@@ -102,14 +308,14 @@ std::string dicomConversion::convertFromUnicode(const std::wstring& unicodeStrin
             {
                 try
                 {
-                    const charsetInformation info = defaultCharsetConversion::getDictionary().getCharsetInformation(dicomCharset, variant);
-                    std::unique_ptr<defaultCharsetConversion> testEscapeSequence(new defaultCharsetConversion(info));
+                    const charsetInformation& info = defaultCharsetConversion::getDictionary().getCharsetInformation(dicomCharset, variant);
+                    cachedCharsetConversion testEscapeSequence(conversionCache.getConversion(info));
                     std::string convertedChar(testEscapeSequence->fromUnicode(code));
                     if(!convertedChar.empty())
                     {
                         convertedSequence = info.m_escapeSequence;
                         convertedSequence += convertedChar;
-                        localCharsetConversion.reset(testEscapeSequence.release());
+                        localCharsetConversion = std::move(testEscapeSequence);
                         break;
                     }
                 }
@@ -146,20 +352,35 @@ std::wstring dicomConversion::convertToUnicode(const std::string& value, const c
         return L"";
     }
 
+    charsetConversionCache& conversionCache(charsetConversionCache::getCharsetConversionCache());
+
     // Should we take care of the escape sequences...?
     ///////////////////////////////////////////////////////////
     if(charsets.empty())
     {
-        const charsetInformation info = defaultCharsetConversion::getDictionary().getCharsetInformation("ISO_IR 6", 0);
-        defaultCharsetConversion localCharsetConversion(info);
-        return localCharsetConversion.toUnicode(value);
+        const charsetInformation& info = defaultCharsetConversion::getDictionary().getCharsetInformation("ISO_IR 6", 0);
+        cachedCharsetConversion localCharsetConversion(conversionCache.getConversion(info));
+        if(localCharsetConversion.isAsciiCompatible() && isAscii(value))
+        {
+            return std::wstring(value.begin(), value.end());
+        }
+        return localCharsetConversion->toUnicode(value);
     }
 
     // Initialize the conversion engine with the default
     //  charset
     ///////////////////////////////////////////////////////////
-    const charsetInformation startingInfo = defaultCharsetConversion::getDictionary().getCharsetInformation(charsets.front(), 0);
-    std::unique_ptr<defaultCharsetConversion> localCharsetConversion(new defaultCharsetConversion(startingInfo));
+    const charsetInformation& startingInfo = defaultCharsetConversion::getDictionary().getCharsetInformation(charsets.front(), 0);
+    cachedCharsetConversion localCharsetConversion(conversionCache.getConversion(startingInfo));
+
+    // 7 bit strings without escape sequences don't need to
+    //  be converted when the initial charset maps them to
+    //  themselves
+    ///////////////////////////////////////////////////////////
+    if(localCharsetConversion.isAsciiCompatible() && isAscii(value))
+    {
+        return std::wstring(value.begin(), value.end());
+    }
 
     // Only one charset is present: we don't need to check
     //  the escape sequences
@@ -245,7 +466,7 @@ std::wstring dicomConversion::convertToUnicode(const std::string& value, const c
 
         if(pNextCharsetInformation != nullptr)
         {
-            localCharsetConversion.reset(new defaultCharsetConversion(*pNextCharsetInformation));
+            localCharsetConversion = conversionCache.getConversion(*pNextCharsetInformation);
         }
     }
 
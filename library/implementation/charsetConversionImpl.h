@@ -21,6 +21,10 @@ If you do not want to be bound by the GPL terms (such as the requirement
 #include "charsetConversionJavaImpl.h"
 #include "../include/imebra/definitions.h"
 #include <string>
+#include <map>
+#include <vector>
+#include <memory>
+#include <mutex>
 
 namespace imebra
 {
@@ -28,11 +32,111 @@ namespace imebra
 namespace implementation
 {
 
+class charsetConversionCache;
+
+///////////////////////////////////////////////////////////
+/// \brief A conversion object borrowed from the
+///        charsetConversionCache.
+///
+/// The conversion object is returned to the cache when
+///  this object is destroyed or reset.
+///
+///////////////////////////////////////////////////////////
+class cachedCharsetConversion
+{
+public:
+    cachedCharsetConversion();
+    cachedCharsetConversion(const charsetInformation& info, std::unique_ptr<defaultCharsetConversion> pConversion, bool bAsciiCompatible);
+    cachedCharsetConversion(cachedCharsetConversion&& source);
+    ~cachedCharsetConversion();
+
+    cachedCharsetConversion& operator=(cachedCharsetConversion&& source);
+
+    cachedCharsetConversion(const cachedCharsetConversion&) = delete;
+    cachedCharsetConversion& operator=(const cachedCharsetConversion&) = delete;
+
+    const defaultCharsetConversion* operator->() const;
+
+    /// \brief Return true if the charset converts the 7 bit
+    ///        chars (except ESC) to the same unicode code
+    ///        points and vice-versa.
+    ///
+    ///////////////////////////////////////////////////////////
+    bool isAsciiCompatible() const;
+
+    /// \brief Return the conversion object to the cache.
+    ///
+    ///////////////////////////////////////////////////////////
+    void reset();
+
+private:
+    const charsetInformation* m_pInfo;
+    std::unique_ptr<defaultCharsetConversion> m_pConversion;
+    bool m_bAsciiCompatible;
+};
+
+
+///////////////////////////////////////////////////////////
+/// \brief Keeps the conversion objects ready for reuse, so
+///        the underlying converters (e.g. the iconv
+///        handles) are not opened for each converted
+///        string.
+///
+/// Each conversion object is used by one thread at a
+///  time: getConversion() hands it out and the
+///  cachedCharsetConversion returns it to the cache.
+///
+///////////////////////////////////////////////////////////
+class charsetConversionCache
+{
+    friend class cachedCharsetConversion;
+
+public:
+    static charsetConversionCache& getCharsetConversionCache();
+
+    /// \brief Return a conversion object for the specified
+    ///        charset.
+    ///
+    /// \param info a charset returned by the charset
+    ///             dictionary
+    /// \return a conversion object for the charset
+    ///
+    ///////////////////////////////////////////////////////////
+    cachedCharsetConversion getConversion(const charsetInformation& info);
+
+private:
+    void reuseConversion(const charsetInformation* pInfo, std::unique_ptr<defaultCharsetConversion> pConversion);
+
+    // Test if the 7 bit chars are mapped to themselves
+    ///////////////////////////////////////////////////////////
+    static bool testAsciiCompatible(const defaultCharsetConversion& conversion);
+
+    struct cachedConversions
+    {
+        cachedConversions();
+
+        std::vector<std::unique_ptr<defaultCharsetConversion> > m_conversions;
+        bool m_bAsciiTested;
+        bool m_bAsciiCompatible;
+    };
+
+    std::mutex m_lock;
+    std::map<const charsetInformation*, cachedConversions> m_cachedConversions;
+};
+
+
 class dicomConversion
 {
 public:
     static std::string convertFromUnicode(const std::wstring& unicodeString, const charsetsList_t& charsets);
     static std::wstring convertToUnicode(const std::string& value, const charsetsList_t& charsets);
+
+private:
+    // Return true if the string contains only 7 bit chars
+    //  and no ESC (so no ISO 2022 escape sequences)
+    ///////////////////////////////////////////////////////////
+    static bool isAscii(const std::string& value);
+    static bool isAscii(const std::wstring& value);
 };
 
 }
@@ -66,7 +66,7 @@ static codecFactory::forceCodecFactoryCreation forceCreation;
 //
 ///////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////
-codecFactory::codecFactory(): m_maximumImageWidth(MAXIMUM_IMAGE_WIDTH), m_maximumImageHeight(MAXIMUM_IMAGE_HEIGHT)
+codecFactory::codecFactory(): m_maximumImageWidth(MAXIMUM_IMAGE_WIDTH), m_maximumImageHeight(MAXIMUM_IMAGE_HEIGHT), m_maximumDecodingThreads(1), m_jpegRestartInterval(0)
 {
     IMEBRA_FUNCTION_START();
 
@@ -192,7 +192,7 @@ std::shared_ptr<codecFactory> codecFactory::getCodecFactory()
 //
 ///////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////
-std::shared_ptr<dataSet> codecFactory::load(std::shared_ptr<streamReader> pStream, std::uint32_t maxSizeBufferLoad /* = 0xffffffff */)
+std::shared_ptr<dataSet> codecFactory::load(std::shared_ptr<streamReader> pStream, std::uint32_t maxSizeBufferLoad /* = 0xffffffff */, std::uint32_t stopAtTag /* = 0xffffffff */, const tagFilter_t& tagFilter /* = tagFilter_t() */, dataSetAllocation_t allocation /* = dataSetAllocation_t::heap */)
 {
     IMEBRA_FUNCTION_START();
 
@@ -235,7 +235,7 @@ std::shared_ptr<dataSet> codecFactory::load(std::shared_ptr<streamReader> pStrea
 
         try
         {
-            std::shared_ptr<dataSet> pDataSet(scanCodecs->second->read(pTempReader, maxSizeBufferLoad));
+            std::shared_ptr<dataSet> pDataSet(scanCodecs->second->read(pTempReader, maxSizeBufferLoad, stopAtTag, tagFilter, allocation));
             return pDataSet;
         }
         catch(CodecWrongFormatError&)
@@ -268,6 +268,35 @@ std::uint32_t codecFactory::getMaximumImageHeight()
     return m_maximumImageHeight;
 }
 
+void codecFactory::setMaximumDecodingThreads(const std::uint32_t maximumThreads)
+{
+    m_maximumDecodingThreads = maximumThreads;
+}
+
+std::uint32_t codecFactory::getMaximumDecodingThreads()
+{
+    return m_maximumDecodingThreads;
+}
+
+void codecFactory::setJpegRestartInterval(const std::uint16_t mcuPerRestartInterval)
+{
+    m_jpegRestartInterval = mcuPerRestartInterval;
+}
+
+std::uint16_t codecFactory::getJpegRestartInterval()
+{
+    return m_jpegRestartInterval;
+}
+
+std::shared_ptr<memoryArena> codecFactory::createDataSetArena(dataSetAllocation_t allocation)
+{
+    if(allocation != dataSetAllocation_t::arena)
+    {
+        return std::shared_ptr<memoryArena>();
+    }
+    return std::make_shared<memoryArena>();
+}
+
 } // namespace codecs
 
 } // namespace implementation
@@ -24,8 +24,10 @@ If you do not want to be bound by the GPL terms (such as the requirement
 #include <map>
 #include <list>
 #include <functional>
+#include <atomic>
 #include "../include/imebra/codecFactory.h"
 #include "dataSetImpl.h"
+#include "streamCodecImpl.h"
 
 
 namespace imebra
@@ -147,11 +149,22 @@ public:
 	///                 ignore this parameter.
 	///                Set to 0xffffffff to load all the 
 	///                 buffers immediatly
+	/// @param stopAtTag the parsing stops at the first tag
+	///                 of the root dataset with an id (group
+	///                 in the high word, tag in the low word)
+	///                 equal or greater than stopAtTag.
+	///                Set to 0xffffffff to parse the whole
+	///                 stream
+	/// @param tagFilter if set, then only the tags accepted
+	///                 by the filter are loaded
+	/// @param allocation dataSetAllocation_t::arena to
+	///                 allocate the tags of the dataSet from
+	///                 an arena owned by the dataSet
 	/// @return a pointer to the dataSet containing the parsed
 	///          data
 	///
 	///////////////////////////////////////////////////////////
-	std::shared_ptr<dataSet> load(std::shared_ptr<streamReader> pStream, std::uint32_t maxSizeBufferLoad = 0xffffffff);
+	std::shared_ptr<dataSet> load(std::shared_ptr<streamReader> pStream, std::uint32_t maxSizeBufferLoad = 0xffffffff, std::uint32_t stopAtTag = 0xffffffff, const tagFilter_t& tagFilter = tagFilter_t(), dataSetAllocation_t allocation = dataSetAllocation_t::heap);
 
     /// \brief Set the maximum size of the images created by
     ///         the codec::getImage() function.
@@ -184,6 +197,55 @@ public:
     ///////////////////////////////////////////////////////////
     std::uint32_t getMaximumImageHeight();
 
+    /// \brief Set the maximum number of threads that a codec
+    ///         can use to decode one image.
+    ///
+    /// @param maximumThreads the maximum number of threads.
+    ///                        1 means that the images are
+    ///                        decoded by the calling thread
+    ///                        only, 0 means that all the
+    ///                        hardware threads can be used
+    ///
+    ///////////////////////////////////////////////////////////
+    void setMaximumDecodingThreads(const std::uint32_t maximumThreads);
+
+    /// \brief Get the maximum number of threads that a codec
+    ///         can use to decode one image.
+    ///
+    /// @return the value set by setMaximumDecodingThreads()
+    ///
+    ///////////////////////////////////////////////////////////
+    std::uint32_t getMaximumDecodingThreads();
+
+    /// \brief Set the number of MCUs in each restart interval
+    ///         written by the jpeg encoder.
+    ///
+    /// @param mcuPerRestartInterval the number of MCUs in each
+    ///                        restart interval. 0 disables the
+    ///                        restart markers
+    ///
+    ///////////////////////////////////////////////////////////
+    void setJpegRestartInterval(const std::uint16_t mcuPerRestartInterval);
+
+    /// \brief Get the number of MCUs in each restart interval
+    ///         written by the jpeg encoder.
+    ///
+    /// @return the value set by setJpegRestartInterval()
+    ///
+    ///////////////////////////////////////////////////////////
+    std::uint16_t getJpegRestartInterval();
+
+    /// \brief Return the arena to use for a dataSet being
+    ///         loaded.
+    ///
+    /// @param allocation the allocation strategy requested
+    ///                    for the dataSet
+    /// @return a new memoryArena, or null if allocation is
+    ///          not dataSetAllocation_t::arena
+    ///
+    ///////////////////////////////////////////////////////////
+    static std::shared_ptr<memoryArena> createDataSetArena(dataSetAllocation_t allocation);
+
 protected:
 	// The list of the registered codecs
 	///////////////////////////////////////////////////////////
@@ -196,6 +258,14 @@ protected:
     std::uint32_t m_maximumImageWidth;
     std::uint32_t m_maximumImageHeight;
 
+    // Maximum number of threads used to decode one image
+    ///////////////////////////////////////////////////////////
+    std::atomic<std::uint32_t> m_maximumDecodingThreads;
+
+    // MCUs per restart interval written by the jpeg encoder
+    ///////////////////////////////////////////////////////////
+    std::atomic<std::uint16_t> m_jpegRestartInterval;
+
 
 public:
 	// Force the creation of the codec factory before main()
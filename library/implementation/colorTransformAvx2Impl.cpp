@@ -0,0 +1,491 @@
+/*
+Copyright 2005 - 2017 by Paolo Brandoli/Binarno s.p.
+
+Imebra is available for free under the GNU General Public License.
+
+The full text of the license is available in the file license.rst
+ in the project root folder.
+
+If you do not want to be bound by the GPL terms (such as the requirement
+ that your application must also be GPL), you may purchase a commercial
+ license for Imebra from the Imebra’s website (http://imebra.com).
+*/
+
+/*! \file colorTransformAvx2Impl.cpp
+    \brief AVX2 version of the YBR <-> RGB conversions.
+
+    This file is compiled with the AVX2 instruction set enabled: its
+     functions are called only when the CPU supports AVX2.
+     Don't include headers that define non-template inline functions
+     shared with other translation units.
+
+*/
+
+#include "colorTransformSimdImpl.h"
+#include "simdAvx2Impl.h"
+
+#if defined(IMEBRA_SIMD_X86)
+
+namespace imebra
+{
+
+namespace implementation
+{
+
+#if defined(__AVX2__)
+
+namespace
+{
+
+///////////////////////////////////////////////////////////
+//
+// Byte shuffle masks that move the samples of 8 pixels
+//  between the interleaved and the planar layouts.
+// A negative index clears the destination byte.
+//
+///////////////////////////////////////////////////////////
+struct shuffleMasks
+{
+    shuffleMasks()
+    {
+        for(int channel(0); channel != 3; ++channel)
+        {
+            // 8 bit samples: the 24 interleaved bytes are
+            //  loaded in two registers (16 + 8 bytes)
+            ///////////////////////////////////////////////////////////
+            for(int byte(0); byte != 16; ++byte)
+            {
+                const int source(byte * 3 + channel);
+                m_load8[channel][0][byte] = (std::int8_t)((byte < 8 && source < 16) ? source : -1);
+                m_load8[channel][1][byte] = (std::int8_t)((byte < 8 && source >= 16) ? source - 16 : -1);
+            }
+
+            // 16 bit samples: the 24 interleaved words are
+            //  loaded in three registers
+            ///////////////////////////////////////////////////////////
+            for(int reg(0); reg != 3; ++reg)
+            {
+                for(int word(0); word != 8; ++word)
+                {
+                    const int source(word * 3 + channel);
+                    const bool bInRegister(source / 8 == reg);
+                    m_load16[channel][reg][word * 2] = (std::int8_t)(bInRegister ? (source % 8) * 2 : -1);
+                    m_load16[channel][reg][word * 2 + 1] = (std::int8_t)(bInRegister ? (source % 8) * 2 + 1 : -1);
+                }
+            }
+        }
+
+        // 8 bit samples: the source registers contain the
+        //  channels 0 and 1 (8 bytes each) and the channel 2
+        ///////////////////////////////////////////////////////////
+        for(int reg(0); reg != 2; ++reg)
+        {
+            for(int byte(0); byte != 16; ++byte)
+            {
+                const int destination(reg * 16 + byte);
+                const int channel(destination % 3);
+                const int pixel(destination / 3);
+                const bool bValid(destination < 24);
+                m_store8[reg][0][byte] = (std::int8_t)((bValid && channel != 2) ? channel * 8 + pixel : -1);
+                m_store8[reg][1][byte] = (std::int8_t)((bValid && channel == 2) ? pixel : -1);
+            }
+        }
+
+        // 16 bit samples: one source register per channel
+        ///////////////////////////////////////////////////////////
+        for(int reg(0); reg != 3; ++reg)
+        {
+            for(int word(0); word != 8; ++word)
+            {
+                const int destination(reg * 8 + word);
+                for(int channel(0); channel != 3; ++channel)
+                {
+                    const bool bFromChannel(destination % 3 == channel);
+                    m_store16[reg][channel][word * 2] = (std::int8_t)(bFromChannel ? (destination / 3) * 2 : -1);
+                    m_store16[reg][channel][word * 2 + 1] = (std::int8_t)(bFromChannel ? (destination / 3) * 2 + 1 : -1);
+                }
+            }
+        }
+    }
+
+    std::int8_t m_load8[3][2][16];
+    std::int8_t m_load16[3][3][16];
+    std::int8_t m_store8[2][2][16];
+    std::int8_t m_store16[3][3][16];
+};
+
+const shuffleMasks& getShuffleMasks()
+{
+    static const shuffleMasks masks;
+    return masks;
+}
+
+inline __m128i loadMask(const std::int8_t* pMask)
+{
+    return _mm_loadu_si128(reinterpret_cast<const __m128i*>(pMask));
+}
+
+
+///////////////////////////////////////////////////////////
+//
+// Load 8 interleaved pixels into 3 registers (one per
+//  channel, 32 bit per sample) and store them back
+//
+///////////////////////////////////////////////////////////
+template <class sampleType>
+class interleavedPixels;
+
+template <>
+class interleavedPixels<std::uint8_t>
+{
+public:
+    interleavedPixels()
+    {
+        const shuffleMasks& masks(getShuffleMasks());
+        for(int channel(0); channel != 3; ++channel)
+        {
+            m_load[channel][0] = loadMask(masks.m_load8[channel][0]);
+            m_load[channel][1] = loadMask(masks.m_load8[channel][1]);
+        }
+        for(int reg(0); reg != 2; ++reg)
+        {
+            m_store[reg][0] = loadMask(masks.m_store8[reg][0]);
+            m_store[reg][1] = loadMask(masks.m_store8[reg][1]);
+        }
+    }
+
+    void load(const std::uint8_t* pInput, __m256i* pChannels) const
+    {
+        const __m128i low(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pInput)));
+        const __m128i high(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(pInput + 16)));
+        for(int channel(0); channel != 3; ++channel)
+        {
+            pChannels[channel] = _mm256_cvtepu8_epi32(_mm_or_si128(_mm_shuffle_epi8(low, m_load[channel][0]), _mm_shuffle_epi8(high, m_load[channel][1])));
+        }
+    }
+
+    void store(const __m256i* pChannels, std::uint8_t* pOutput) const
+    {
+        const __m128i channels01(_mm_unpacklo_epi64(simd::truncateToBytes(pChannels[0]), simd::truncateToBytes(pChannels[1])));
+        const __m128i channel2(simd::truncateToBytes(pChannels[2]));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(pOutput), _mm_or_si128(_mm_shuffle_epi8(channels01, m_store[0][0]), _mm_shuffle_epi8(channel2, m_store[0][1])));
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(pOutput + 16), _mm_or_si128(_mm_shuffle_epi8(channels01, m_store[1][0]), _mm_shuffle_epi8(channel2, m_store[1][1])));
+    }
+
+private:
+    __m128i m_load[3][2];
+    __m128i m_store[2][2];
+};
+
+template <>
+class interleavedPixels<std::uint16_t>
+{
+public:
+    interleavedPixels()
+    {
+        const shuffleMasks& masks(getShuffleMasks());
+        for(int first(0); first != 3; ++first)
+        {
+            for(int second(0); second != 3; ++second)
+            {
+                m_load[first][second] = loadMask(masks.m_load16[first][second]);
+                m_store[first][second] = loadMask(masks.m_store16[first][second]);
+            }
+        }
+    }
+
+    void load(const std::uint16_t* pInput, __m256i* pChannels) const
+    {
+        const __m128i source[3] = {
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(pInput)),
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(pInput + 8)),
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(pInput + 16))};
+        for(int channel(0); channel != 3; ++channel)
+        {
+            const __m128i words(_mm_or_si128(
+                                    _mm_or_si128(_mm_shuffle_epi8(source[0], m_load[channel][0]), _mm_shuffle_epi8(source[1], m_load[channel][1])),
+                                    _mm_shuffle_epi8(source[2], m_load[channel][2])));
+            pChannels[channel] = _mm256_cvtepu16_epi32(words);
+        }
+    }
+
+    void store(const __m256i* pChannels, std::uint16_t* pOutput) const
+    {
+        const __m128i channels[3] = {simd::truncateToWords(pChannels[0]), simd::truncateToWords(pChannels[1]), simd::truncateToWords(pChannels[2])};
+        for(int reg(0); reg != 3; ++reg)
+        {
+            const __m128i words(_mm_or_si128(
+                                    _mm_or_si128(_mm_shuffle_epi8(channels[0], m_store[reg][0]), _mm_shuffle_epi8(channels[1], m_store[reg][1])),
+                                    _mm_shuffle_epi8(channels[2], m_store[reg][2])));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(pOutput + reg * 8), words);
+        }
+    }
+
+private:
+    __m128i m_load[3][3];
+    __m128i m_store[3][3];
+};
+
+
+///////////////////////////////////////////////////////////
+//
+// Arithmetic helpers
+//
+///////////////////////////////////////////////////////////
+
+// Divide by 2^shift rounding toward zero, like the
+//  integer division in the portable transforms
+///////////////////////////////////////////////////////////
+template <int shift>
+inline __m256i divideTruncate(__m256i value)
+{
+    const __m256i bias(_mm256_srli_epi32(_mm256_srai_epi32(value, 31), 32 - shift));
+    return _mm256_srai_epi32(_mm256_add_epi32(value, bias), shift);
+}
+
+inline __m256i multiply(std::int32_t factor, __m256i value)
+{
+    return _mm256_mullo_epi32(_mm256_set1_epi32(factor), value);
+}
+
+inline __m256i clamp(__m256i value, __m256i maxValue)
+{
+    return _mm256_min_epi32(_mm256_max_epi32(value, _mm256_setzero_si256()), maxValue);
+}
+
+
+///////////////////////////////////////////////////////////
+//
+// The conversions. They use the same formulas as the
+//  portable transforms.
+//
+///////////////////////////////////////////////////////////
+class ybrFullToRgb
+{
+public:
+    ybrFullToRgb(std::uint32_t highBit):
+        m_middle(_mm256_set1_epi32((std::int32_t)1 << highBit)),
+        m_maxValue(_mm256_set1_epi32(((std::int32_t)1 << (highBit + 1)) - 1))
+    {}
+
+    void operator()(__m256i* pChannels) const
+    {
+        const __m256i y(pChannels[0]);
+        const __m256i b(_mm256_sub_epi32(pChannels[1], m_middle));
+        const __m256i r(_mm256_sub_epi32(pChannels[2], m_middle));
+
+        pChannels[0] = clamp(_mm256_add_epi32(y, divideTruncate<14>(multiply(22970, r))), m_maxValue);
+        pChannels[1] = clamp(_mm256_sub_epi32(y, divideTruncate<14>(_mm256_add_epi32(multiply(5638, b), multiply(11700, r)))), m_maxValue);
+        pChannels[2] = clamp(_mm256_add_epi32(y, divideTruncate<14>(multiply(29032, b))), m_maxValue);
+    }
+
+private:
+    __m256i m_middle;
+    __m256i m_maxValue;
+};
+
+class ybrPartialToRgb
+{
+public:
+    ybrPartialToRgb(std::uint32_t highBit):
+        m_minY(_mm256_set1_epi32((std::int32_t)1 << (highBit - 3))),
+        m_middle(_mm256_set1_epi32((std::int32_t)1 << highBit)),
+        m_maxValue(_mm256_set1_epi32(((std::int32_t)1 << (highBit + 1)) - 1)),
+        m_rounding(_mm256_set1_epi32(8191))
+    {}
+
+    void operator()(__m256i* pChannels) const
+    {
+        const __m256i y(_mm256_add_epi32(multiply(19071, _mm256_sub_epi32(pChannels[0], m_minY)), m_rounding));
+        const __m256i b(_mm256_sub_epi32(pChannels[1], m_middle));
+        const __m256i r(_mm256_sub_epi32(pChannels[2], m_middle));
+
+        pChannels[0] = clamp(divideTruncate<14>(_mm256_add_epi32(y, multiply(26148, r))), m_maxValue);
+        pChannels[1] = clamp(divideTruncate<14>(_mm256_sub_epi32(_mm256_sub_epi32(y, multiply(13320, r)), multiply(6406, b))), m_maxValue);
+        pChannels[2] = clamp(divideTruncate<14>(_mm256_add_epi32(y, multiply(33063, b))), m_maxValue);
+    }
+
+private:
+    __m256i m_minY;
+    __m256i m_middle;
+    __m256i m_maxValue;
+    __m256i m_rounding;
+};
+
+class ybrRctToRgb
+{
+public:
+    ybrRctToRgb(std::uint32_t highBit):
+        m_middle(_mm256_set1_epi32((std::int32_t)1 << highBit)),
+        m_maxValue(_mm256_set1_epi32(((std::int32_t)1 << (highBit + 1)) - 1))
+    {}
+
+    void operator()(__m256i* pChannels) const
+    {
+        const __m256i b(_mm256_sub_epi32(pChannels[1], m_middle));
+        const __m256i r(_mm256_sub_epi32(pChannels[2], m_middle));
+        const __m256i g(_mm256_sub_epi32(pChannels[0], divideTruncate<2>(_mm256_add_epi32(r, b))));
+
+        pChannels[0] = clamp(_mm256_add_epi32(r, g), m_maxValue);
+        pChannels[1] = clamp(g, m_maxValue);
+        pChannels[2] = clamp(_mm256_add_epi32(b, g), m_maxValue);
+    }
+
+private:
+    __m256i m_middle;
+    __m256i m_maxValue;
+};
+
+class rgbToYbrFull
+{
+public:
+    rgbToYbrFull(std::uint32_t highBit):
+        m_middle(_mm256_set1_epi32((std::int32_t)1 << highBit))
+    {}
+
+    void operator()(__m256i* pChannels) const
+    {
+        const __m256i r(pChannels[0]);
+        const __m256i g(pChannels[1]);
+        const __m256i b(pChannels[2]);
+
+        pChannels[0] = divideTruncate<14>(_mm256_add_epi32(_mm256_add_epi32(multiply(4899, r), multiply(9617, g)), multiply(1868, b)));
+        pChannels[1] = _mm256_add_epi32(m_middle, divideTruncate<14>(_mm256_sub_epi32(_mm256_sub_epi32(multiply(8192, b), multiply(2765, r)), multiply(5427, g))));
+        pChannels[2] = _mm256_add_epi32(m_middle, divideTruncate<14>(_mm256_sub_epi32(_mm256_sub_epi32(multiply(8192, r), multiply(6860, g)), multiply(1332, b))));
+    }
+
+private:
+    __m256i m_middle;
+};
+
+class rgbToYbrPartial
+{
+public:
+    rgbToYbrPartial(std::uint32_t highBit):
+        m_minY(_mm256_set1_epi32((std::int32_t)1 << (highBit - 3))),
+        m_middle(_mm256_set1_epi32((std::int32_t)1 << highBit)),
+        m_rounding(_mm256_set1_epi32(8191))
+    {}
+
+    void operator()(__m256i* pChannels) const
+    {
+        const __m256i r(pChannels[0]);
+        const __m256i g(pChannels[1]);
+        const __m256i b(pChannels[2]);
+
+        pChannels[0] = _mm256_add_epi32(m_minY, divideTruncate<14>(_mm256_add_epi32(_mm256_add_epi32(_mm256_add_epi32(multiply(4207, r), multiply(8259, g)), multiply(1604, b)), m_rounding)));
+        pChannels[1] = _mm256_add_epi32(m_middle, divideTruncate<14>(_mm256_add_epi32(_mm256_sub_epi32(_mm256_sub_epi32(multiply(7196, b), multiply(2428, r)), multiply(4768, g)), m_rounding)));
+        pChannels[2] = _mm256_add_epi32(m_middle, divideTruncate<14>(_mm256_add_epi32(_mm256_sub_epi32(_mm256_sub_epi32(multiply(7196, r), multiply(6026, g)), multiply(1170, b)), m_rounding)));
+    }
+
+private:
+    __m256i m_minY;
+    __m256i m_middle;
+    __m256i m_rounding;
+};
+
+class rgbToYbrRct
+{
+public:
+    rgbToYbrRct(std::uint32_t highBit):
+        m_middle(_mm256_set1_epi32((std::int32_t)1 << highBit)),
+        m_maxValue(_mm256_set1_epi32(((std::int32_t)1 << (highBit + 1)) - 1))
+    {}
+
+    void operator()(__m256i* pChannels) const
+    {
+        const __m256i r(pChannels[0]);
+        const __m256i g(pChannels[1]);
+        const __m256i b(pChannels[2]);
+
+        pChannels[0] = divideTruncate<2>(_mm256_add_epi32(_mm256_add_epi32(r, _mm256_add_epi32(g, g)), b));
+        pChannels[1] = clamp(_mm256_add_epi32(_mm256_sub_epi32(b, g), m_middle), m_maxValue);
+        pChannels[2] = clamp(_mm256_add_epi32(_mm256_sub_epi32(r, g), m_middle), m_maxValue);
+    }
+
+private:
+    __m256i m_middle;
+    __m256i m_maxValue;
+};
+
+
+///////////////////////////////////////////////////////////
+//
+// Convert blocks of 8 pixels
+//
+///////////////////////////////////////////////////////////
+template <class sampleType, class kernel>
+size_t convertPixels(const kernel& conversion, const sampleType* pInput, sampleType* pOutput, size_t pixels)
+{
+    const interleavedPixels<sampleType> interleaved;
+    const size_t convertedPixels(pixels & ~(size_t)7);
+
+    __m256i channels[3];
+    for(size_t scanPixels(0); scanPixels != convertedPixels; scanPixels += 8)
+    {
+        interleaved.load(pInput + scanPixels * 3, channels);
+        conversion(channels);
+        interleaved.store(channels, pOutput + scanPixels * 3);
+    }
+
+    return convertedPixels;
+}
+
+} // anonymous namespace
+
+
+///////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////
+//
+//
+// Select the conversion
+//
+//
+///////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////
+template <class sampleType>
+size_t colorTransformAvx2(colorTransformKernel_t kernel, const sampleType* pInput, sampleType* pOutput, size_t pixels, std::uint32_t highBit)
+{
+    switch(kernel)
+    {
+    case colorTransformKernel_t::ybrFullToRgb:
+        return convertPixels(ybrFullToRgb(highBit), pInput, pOutput, pixels);
+    case colorTransformKernel_t::ybrPartialToRgb:
+        return convertPixels(ybrPartialToRgb(highBit), pInput, pOutput, pixels);
+    case colorTransformKernel_t::ybrRctToRgb:
+        return convertPixels(ybrRctToRgb(highBit), pInput, pOutput, pixels);
+    case colorTransformKernel_t::rgbToYbrFull:
+        return convertPixels(rgbToYbrFull(highBit), pInput, pOutput, pixels);
+    case colorTransformKernel_t::rgbToYbrPartial:
+        return convertPixels(rgbToYbrPartial(highBit), pInput, pOutput, pixels);
+    case colorTransformKernel_t::rgbToYbrRct:
+        return convertPixels(rgbToYbrRct(highBit), pInput, pOutput, pixels);
+    }
+
+    return 0;
+}
+
+#else
+
+///////////////////////////////////////////////////////////
+//
+// Built without the AVX2 flags: let the caller convert
+//  all the pixels
+//
+///////////////////////////////////////////////////////////
+template <class sampleType>
+size_t colorTransformAvx2(colorTransformKernel_t /* kernel */, const sampleType* /* pInput */, sampleType* /* pOutput */, size_t /* pixels */, std::uint32_t /* highBit */)
+{
+    return 0;
+}
+
+#endif
+
+template size_t colorTransformAvx2<std::uint8_t>(colorTransformKernel_t, const std::uint8_t*, std::uint8_t*, size_t, std::uint32_t);
+template size_t colorTransformAvx2<std::uint16_t>(colorTransformKernel_t, const std::uint16_t*, std::uint16_t*, size_t, std::uint32_t);
+
+} // namespace implementation
+
+} // namespace imebra
+
+#endif
@@ -88,6 +88,68 @@ void colorTransform::checkHighBit(std::uint32_t inputHighBit, std::uint32_t outp
 }
 
 
+///////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////
+//
+//
+// Vectorized conversion of 8 bit samples
+//
+//
+///////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////
+std::uint32_t colorTransform::transformPixelsSimd(colorTransformKernel_t kernel, const std::uint8_t* pInput, std::uint8_t* pOutput, std::uint32_t pixels, std::uint32_t inputHighBit, std::uint32_t outputHighBit)
+{
+#if defined(IMEBRA_SIMD_X86)
+    // The YBR_PARTIAL luminance offset needs at least 3 bits
+    ///////////////////////////////////////////////////////////
+    if(getSimdInstructions() == simdInstructions_t::avx2 && inputHighBit == outputHighBit && inputHighBit >= 3)
+    {
+        return (std::uint32_t)colorTransformAvx2(kernel, pInput, pOutput, pixels, inputHighBit);
+    }
+#else
+    (void)kernel;
+    (void)pInput;
+    (void)pOutput;
+    (void)pixels;
+    (void)inputHighBit;
+    (void)outputHighBit;
+#endif
+    return 0;
+}
+
+
+///////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////
+//
+//
+// Vectorized conversion of 16 bit samples
+//
+//
+///////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////
+std::uint32_t colorTransform::transformPixelsSimd(colorTransformKernel_t kernel, const std::uint16_t* pInput, std::uint16_t* pOutput, std::uint32_t pixels, std::uint32_t inputHighBit, std::uint32_t outputHighBit)
+{
+#if defined(IMEBRA_SIMD_X86)
+    // The YBR_PARTIAL to RGB formula may overflow the 32 bit
+    //  lanes with 16 bit samples
+    ///////////////////////////////////////////////////////////
+    if(getSimdInstructions() == simdInstructions_t::avx2 && inputHighBit == outputHighBit && inputHighBit >= 3 &&
+            kernel != colorTransformKernel_t::ybrPartialToRgb)
+    {
+        return (std::uint32_t)colorTransformAvx2(kernel, pInput, pOutput, pixels, inputHighBit);
+    }
+#else
+    (void)kernel;
+    (void)pInput;
+    (void)pOutput;
+    (void)pixels;
+    (void)inputHighBit;
+    (void)outputHighBit;
+#endif
+    return 0;
+}
+
+
 std::shared_ptr<image> colorTransform::allocateOutputImage(
         bitDepth_t inputDepth,
         const std::string& /* inputColorSpace */,
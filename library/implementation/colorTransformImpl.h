@@ -21,6 +21,7 @@ If you do not want to be bound by the GPL terms (such as the requirement
 #define imebraColorTransform_E27C63E7_A907_4899_9BD3_8026AD7D110C__INCLUDED_
 
 #include "transformImpl.h"
+#include "colorTransformSimdImpl.h"
 
 
 namespace imebra
@@ -97,6 +98,22 @@ protected:
 
     virtual void checkHighBit(std::uint32_t inputHighBit, std::uint32_t outputHighBit) const;
 
+    // Vectorized conversion of a row of pixels, available
+    //  for 8 and 16 bit unsigned samples: returns the
+    //  number of pixels that have been converted.
+    // The transforms convert the remaining pixels with
+    //  their portable code.
+    ///////////////////////////////////////////////////////////
+    template <class inputType, class outputType>
+    static std::uint32_t transformPixelsSimd(colorTransformKernel_t /* kernel */, const inputType* /* pInput */, outputType* /* pOutput */, std::uint32_t /* pixels */, std::uint32_t /* inputHighBit */, std::uint32_t /* outputHighBit */)
+    {
+        return 0;
+    }
+
+    static std::uint32_t transformPixelsSimd(colorTransformKernel_t kernel, const std::uint8_t* pInput, std::uint8_t* pOutput, std::uint32_t pixels, std::uint32_t inputHighBit, std::uint32_t outputHighBit);
+
+    static std::uint32_t transformPixelsSimd(colorTransformKernel_t kernel, const std::uint16_t* pInput, std::uint16_t* pOutput, std::uint32_t pixels, std::uint32_t inputHighBit, std::uint32_t outputHighBit);
+
 };
 
 /// @}
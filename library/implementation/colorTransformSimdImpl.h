@@ -0,0 +1,79 @@
+/*
+Copyright 2005 - 2017 by Paolo Brandoli/Binarno s.p.
+
+Imebra is available for free under the GNU General Public License.
+
+The full text of the license is available in the file license.rst
+ in the project root folder.
+
+If you do not want to be bound by the GPL terms (such as the requirement
+ that your application must also be GPL), you may purchase a commercial
+ license for Imebra from the Imebra’s website (http://imebra.com).
+*/
+
+/*! \file colorTransformSimdImpl.h
+    \brief Declaration of the vectorized YBR <-> RGB conversions.
+
+*/
+
+#if !defined(imebraColorTransformSimd_1731E91A_312D_4497_87FE_BDC71B3405D0__INCLUDED_)
+#define imebraColorTransformSimd_1731E91A_312D_4497_87FE_BDC71B3405D0__INCLUDED_
+
+#include "simdImpl.h"
+#include <cstdint>
+#include <cstddef>
+
+namespace imebra
+{
+
+namespace implementation
+{
+
+///////////////////////////////////////////////////////////
+/// \brief Color conversions that have a vectorized
+///        version.
+///
+///////////////////////////////////////////////////////////
+enum class colorTransformKernel_t
+{
+    ybrFullToRgb,    ///< YBR_FULL or YBR_ICT to RGB
+    ybrPartialToRgb, ///< YBR_PARTIAL to RGB
+    ybrRctToRgb,     ///< YBR_RCT to RGB
+    rgbToYbrFull,    ///< RGB to YBR_FULL or YBR_ICT
+    rgbToYbrPartial, ///< RGB to YBR_PARTIAL
+    rgbToYbrRct      ///< RGB to YBR_RCT
+};
+
+#if defined(IMEBRA_SIMD_X86)
+
+///////////////////////////////////////////////////////////
+/// \brief Converts interleaved pixels with the AVX2
+///        instructions.
+///
+/// The results are identical to the ones produced by the
+///  portable color transforms for unsigned samples that
+///  have the same high bit in the input and in the output.
+///
+/// Instantiated for std::uint8_t and std::uint16_t.
+///
+/// \param kernel  the conversion to apply
+/// \param pInput  the input pixels (3 samples per pixel)
+/// \param pOutput the buffer that receives the converted
+///                pixels
+/// \param pixels  the number of pixels to convert
+/// \param highBit the high bit of the input and output
+///                samples
+/// \return the number of pixels converted: the caller
+///         must convert the remaining ones
+///
+///////////////////////////////////////////////////////////
+template <class sampleType>
+size_t colorTransformAvx2(colorTransformKernel_t kernel, const sampleType* pInput, sampleType* pOutput, size_t pixels, std::uint32_t highBit);
+
+#endif
+
+} // namespace implementation
+
+} // namespace imebra
+
+#endif // !defined(imebraColorTransformSimd_1731E91A_312D_4497_87FE_BDC71B3405D0__INCLUDED_)
@@ -116,6 +116,62 @@ void colorTransformsFactory::registerTransform(std::shared_ptr<colorTransform> n
 
     m_transformsList.push_back(newColorTransform);
 
+    buildTransformsMap();
+
+    IMEBRA_FUNCTION_END();
+}
+
+
+///////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////
+//
+//
+// Prepare the transforms for all the pairs of color
+//  spaces
+//
+//
+///////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////
+void colorTransformsFactory::buildTransformsMap()
+{
+    IMEBRA_FUNCTION_START();
+
+    m_transformsMap.clear();
+
+    // The first registered transform wins: single
+    //  transforms have the precedence over the chains
+    ///////////////////////////////////////////////////////////
+    for(tTransformsList::const_iterator scanSingleTransform = m_transformsList.begin(); scanSingleTransform != m_transformsList.end(); ++scanSingleTransform)
+    {
+        m_transformsMap.insert(
+                    tTransformsMap::value_type(
+                        std::make_pair((*scanSingleTransform)->getInitialColorSpace(), (*scanSingleTransform)->getFinalColorSpace()),
+                        *scanSingleTransform));
+    }
+
+    for(tTransformsList::const_iterator scanMultipleTransforms = m_transformsList.begin(); scanMultipleTransforms != m_transformsList.end(); ++scanMultipleTransforms)
+    {
+        const std::string initialColorSpace((*scanMultipleTransforms)->getInitialColorSpace());
+
+        for(tTransformsList::const_iterator secondTransform = m_transformsList.begin(); secondTransform != m_transformsList.end(); ++secondTransform)
+        {
+            const std::string finalColorSpace((*secondTransform)->getFinalColorSpace());
+
+            if(finalColorSpace == initialColorSpace ||
+                (*secondTransform)->getInitialColorSpace() != (*scanMultipleTransforms)->getFinalColorSpace() ||
+                m_transformsMap.find(std::make_pair(initialColorSpace, finalColorSpace)) != m_transformsMap.end())
+            {
+                continue;
+            }
+
+            std::shared_ptr<transformsChain> chain = std::make_shared<transformsChain>();
+            chain->addTransform(*scanMultipleTransforms);
+            chain->addTransform(*secondTransform);
+
+            m_transformsMap[std::make_pair(initialColorSpace, finalColorSpace)] = chain;
+        }
+    }
+
     IMEBRA_FUNCTION_END();
 }
 
@@ -347,6 +403,15 @@ std::shared_ptr<transform> colorTransformsFactory::getTransform(const std::strin
 {
     IMEBRA_FUNCTION_START();
 
+    // The color spaces are usually already normalized:
+    //  try them before normalizing them
+    ///////////////////////////////////////////////////////////
+    tTransformsMap::const_iterator findTransform(m_transformsMap.find(std::make_pair(startColorSpace, endColorSpace)));
+    if(findTransform != m_transformsMap.end())
+    {
+        return findTransform->second;
+    }
+
     std::string normalizedStartColorSpace = normalizeColorSpace(startColorSpace);
     std::string normalizedEndColorSpace = normalizeColorSpace(endColorSpace);
 
@@ -355,40 +420,10 @@ std::shared_ptr<transform> colorTransformsFactory::getTransform(const std::strin
         return std::shared_ptr<colorTransform>(0);
     }
 
-    for(tTransformsList::iterator scanSingleTransform = m_transformsList.begin(); scanSingleTransform != m_transformsList.end(); ++scanSingleTransform)
+    findTransform = m_transformsMap.find(std::make_pair(normalizedStartColorSpace, normalizedEndColorSpace));
+    if(findTransform != m_transformsMap.end())
     {
-        if( (*scanSingleTransform)->getInitialColorSpace() == normalizedStartColorSpace &&
-            (*scanSingleTransform)->getFinalColorSpace() == normalizedEndColorSpace)
-        {
-            std::shared_ptr<colorTransform> newTransform = *scanSingleTransform;
-            return newTransform;
-        }
-    }
-
-    for(tTransformsList::iterator scanMultipleTransforms = m_transformsList.begin(); scanMultipleTransforms != m_transformsList.end(); ++scanMultipleTransforms)
-    {
-        if( (*scanMultipleTransforms)->getInitialColorSpace() != normalizedStartColorSpace)
-        {
-            continue;
-        }
-
-        for(tTransformsList::iterator secondTransform = m_transformsList.begin(); secondTransform != m_transformsList.end(); ++secondTransform)
-        {
-            if( (*secondTransform)->getFinalColorSpace() != normalizedEndColorSpace ||
-                (*secondTransform)->getInitialColorSpace() != (*scanMultipleTransforms)->getFinalColorSpace())
-            {
-                continue;
-            }
-
-            std::shared_ptr<colorTransform> newTransform0 = *scanMultipleTransforms;
-            std::shared_ptr<colorTransform> newTransform1 = *secondTransform;
-
-            std::shared_ptr<transformsChain> chain = std::make_shared<transformsChain>();
-            chain->addTransform(newTransform0);
-            chain->addTransform(newTransform1);
-
-            return chain;
-        }
+        return findTransform->second;
     }
 
     IMEBRA_THROW(ColorTransformsFactoryNoTransformError, "There isn't any transform that can convert between the color space " << startColorSpace << " and " << endColorSpace);
@@ -21,6 +21,8 @@ If you do not want to be bound by the GPL terms (such as the requirement
 #define imebraColorTransformsFactory_82307D4A_6490_4202_BF86_93399D32721E__INCLUDED_
 
 #include <list>
+#include <map>
+#include <string>
 
 #include "colorTransformImpl.h"
 
@@ -253,6 +255,10 @@ public:
 	///  then a colorTransformsFactoryExceptionNoTransform
 	///  is thrown.
 	///
+	/// The transforms are prepared when they are
+	///  registered: the returned transforms are shared
+	///  and must not be modified.
+	///
 	/// @param startColorSpace the color space from which the
 	///                         conversion has to take
 	///                         place
@@ -269,9 +275,22 @@ public:
 	//@}
 
 protected:
+	/// \brief Prepare the transforms for all the pairs of
+	///         color spaces that can be converted by one or
+	///         two registered transforms.
+	///
+	///////////////////////////////////////////////////////////
+	void buildTransformsMap();
+
 	typedef std::list<std::shared_ptr<colorTransform> > tTransformsList;
 	tTransformsList m_transformsList;
 
+	// Transforms (single or chains of two) indexed by the
+	//  normalized initial and final color spaces
+	///////////////////////////////////////////////////////////
+	typedef std::map<std::pair<std::string, std::string>, std::shared_ptr<transform> > tTransformsMap;
+	tTransformsMap m_transformsMap;
+
 public:
 	// Force the construction of the factory before main()
 	//  starts
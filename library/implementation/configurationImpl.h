@@ -28,6 +28,9 @@ If you do not want to be bound by the GPL terms (such as the requirement
 #ifndef MAXIMUM_PDU_SIZE
     #define MAXIMUM_PDU_SIZE 32768
 #endif
+#ifndef IMEBRA_CHARSET_CONVERSION_CACHE_SIZE
+    #define IMEBRA_CHARSET_CONVERSION_CACHE_SIZE 16
+#endif
 
 #if !defined(IMEBRA_WINDOWS) && !defined(IMEBRA_POSIX)
 
@@ -59,8 +59,8 @@ namespace implementation
 //
 ///////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////
-data::data(tagVR_t tagVR, const std::shared_ptr<charsetsList_t> pCharsets):
-    m_pCharsetsList(pCharsets), m_tagVR(tagVR)
+data::data(tagVR_t tagVR, const std::shared_ptr<charsetsList_t> pCharsets, const std::shared_ptr<memoryArena>& pArena /* = std::shared_ptr<memoryArena>() */):
+    m_pCharsetsList(pCharsets), m_tagVR(tagVR), m_pArena(pArena), m_bFrozen(false)
 {
 }
 
@@ -92,7 +92,7 @@ void data::setBuffer(size_t bufferId, const std::shared_ptr<buffer>& newBuffer)
 {
     IMEBRA_FUNCTION_START();
 
-    std::lock_guard<std::mutex> lock(m_mutex);
+    std::unique_lock<std::mutex> lock(lockForWriting());
 
     // Assign the new buffer
     ///////////////////////////////////////////////////////////
@@ -135,7 +135,7 @@ size_t data::getBuffersCount() const
 {
     IMEBRA_FUNCTION_START();
 
-    std::lock_guard<std::mutex> lock(m_mutex);
+    std::unique_lock<std::mutex> lock(lockForReading());
 
     // Returns the number of buffers
     ///////////////////////////////////////////////////////////
@@ -156,7 +156,7 @@ size_t data::getBuffersCount() const
 ///////////////////////////////////////////////////////////
 bool data::bufferExists(size_t bufferId) const
 {
-    std::lock_guard<std::mutex> lock(m_mutex);
+    std::unique_lock<std::mutex> lock(lockForReading());
 
     return bufferId < m_buffers.size() && m_buffers.at(bufferId) != nullptr;
 }
@@ -185,7 +185,7 @@ std::shared_ptr<buffer> data::getBuffer(size_t bufferId) const
 {
     IMEBRA_FUNCTION_START();
 
-    std::lock_guard<std::mutex> lock(m_mutex);
+    std::unique_lock<std::mutex> lock(lockForReading());
 
     // Retrieve the buffer
     ///////////////////////////////////////////////////////////
@@ -204,7 +204,7 @@ std::shared_ptr<buffer> data::getBufferCreate(size_t bufferId)
 {
     IMEBRA_FUNCTION_START();
 
-    std::lock_guard<std::mutex> lock(m_mutex);
+    std::unique_lock<std::mutex> lock(lockForWriting());
 
     // Retrieve the buffer
     ///////////////////////////////////////////////////////////
@@ -213,7 +213,7 @@ std::shared_ptr<buffer> data::getBufferCreate(size_t bufferId)
         return m_buffers.at(bufferId);
     }
 
-    std::shared_ptr<buffer> pNewBuffer(std::make_shared<buffer>(m_pCharsetsList));
+    std::shared_ptr<buffer> pNewBuffer(allocateShared<buffer>(m_pArena, m_pCharsetsList));
     if(bufferId >= m_buffers.size())
     {
         m_buffers.resize(bufferId + 1);
@@ -230,7 +230,7 @@ std::shared_ptr<buffer> data::getBufferCreate(size_t bufferId, streamController:
 {
     IMEBRA_FUNCTION_START();
 
-    std::lock_guard<std::mutex> lock(m_mutex);
+    std::unique_lock<std::mutex> lock(lockForWriting());
 
     // Retrieve the buffer
     ///////////////////////////////////////////////////////////
@@ -239,7 +239,7 @@ std::shared_ptr<buffer> data::getBufferCreate(size_t bufferId, streamController:
         return m_buffers.at(bufferId);
     }
 
-    std::shared_ptr<buffer> pNewBuffer(std::make_shared<buffer>(m_pCharsetsList, endianType));
+    std::shared_ptr<buffer> pNewBuffer(allocateShared<buffer>(m_pArena, m_pCharsetsList, endianType));
     if(bufferId >= m_buffers.size())
     {
         m_buffers.resize(bufferId + 1);
@@ -261,14 +261,15 @@ std::shared_ptr<buffer> data::getBufferCreate(size_t bufferId,
 {
     IMEBRA_FUNCTION_START();
 
-    std::lock_guard<std::mutex> lock(m_mutex);
+    std::unique_lock<std::mutex> lock(lockForWriting());
 
-    std::shared_ptr<buffer> pNewBuffer(std::make_shared<buffer>(originalStream,
-                                                                bufferPosition,
-                                                                bufferLength,
-                                                                wordLength,
-                                                                endianType,
-                                                                m_pCharsetsList));
+    std::shared_ptr<buffer> pNewBuffer(allocateShared<buffer>(m_pArena,
+                                                              originalStream,
+                                                              bufferPosition,
+                                                              bufferLength,
+                                                              wordLength,
+                                                              endianType,
+                                                              m_pCharsetsList));
     if(bufferId >= m_buffers.size())
     {
         m_buffers.resize(bufferId + 1);
@@ -567,7 +568,7 @@ std::shared_ptr<dataSet> data::getSequenceItem(size_t dataSetId) const
 {
     IMEBRA_FUNCTION_START();
 
-    std::lock_guard<std::mutex> lock(m_mutex);
+    std::unique_lock<std::mutex> lock(lockForReading());
 
     if(m_embeddedDataSets.size() <= dataSetId)
     {
@@ -583,7 +584,7 @@ bool data::dataSetExists(size_t dataSetId) const
 {
     IMEBRA_FUNCTION_START();
 
-    std::lock_guard<std::mutex> lock(m_mutex);
+    std::unique_lock<std::mutex> lock(lockForReading());
 
     return m_embeddedDataSets.size() > dataSetId;
 
@@ -604,9 +605,9 @@ std::shared_ptr<dataSet> data::appendSequenceItem()
 {
     IMEBRA_FUNCTION_START();
 
-    std::lock_guard<std::mutex> lock(m_mutex);
+    std::unique_lock<std::mutex> lock(lockForWriting());
 
-    std::shared_ptr<dataSet> pDataSet(std::make_shared<dataSet>(m_pCharsetsList));
+    std::shared_ptr<dataSet> pDataSet(allocateShared<dataSet>(m_pArena, m_pCharsetsList, m_pArena));
     m_embeddedDataSets.push_back(pDataSet);
 
     return pDataSet;
@@ -615,6 +616,139 @@ std::shared_ptr<dataSet> data::appendSequenceItem()
 }
 
 
+///////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////
+//
+//
+// Make the tag, its buffers and its sequence items read
+//  only
+//
+//
+///////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////
+void data::freeze()
+{
+    IMEBRA_FUNCTION_START();
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    // Check all the buffers before freezing them, so the tag
+    //  is not left partially frozen
+    ///////////////////////////////////////////////////////////
+    if(hasWritingDataHandlersNoLock())
+    {
+        IMEBRA_THROW(DataSetFrozenError, "Cannot freeze the tag while a writing data handler is alive");
+    }
+
+    for(const std::shared_ptr<buffer>& pBuffer: m_buffers)
+    {
+        if(pBuffer != nullptr)
+        {
+            pBuffer->freeze();
+        }
+    }
+
+    for(const std::shared_ptr<dataSet>& pDataSet: m_embeddedDataSets)
+    {
+        pDataSet->freeze();
+    }
+
+    m_bFrozen.store(true, std::memory_order_release);
+
+    IMEBRA_FUNCTION_END();
+}
+
+
+///////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////
+//
+//
+// Return true if a writing handler is still alive
+//
+//
+///////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////
+bool data::hasWritingDataHandlers() const
+{
+    IMEBRA_FUNCTION_START();
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    return hasWritingDataHandlersNoLock();
+
+    IMEBRA_FUNCTION_END();
+}
+
+
+bool data::hasWritingDataHandlersNoLock() const
+{
+    IMEBRA_FUNCTION_START();
+
+    for(const std::shared_ptr<buffer>& pBuffer: m_buffers)
+    {
+        if(pBuffer != nullptr && pBuffer->hasWritingDataHandlers())
+        {
+            return true;
+        }
+    }
+
+    for(const std::shared_ptr<dataSet>& pDataSet: m_embeddedDataSets)
+    {
+        if(pDataSet->hasWritingDataHandlers())
+        {
+            return true;
+        }
+    }
+
+    return false;
+
+    IMEBRA_FUNCTION_END();
+}
+
+
+///////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////
+//
+//
+// Lock the tag, unless it is frozen
+//
+//
+///////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////
+std::unique_lock<std::mutex> data::lockForReading() const
+{
+    if(m_bFrozen.load(std::memory_order_acquire))
+    {
+        return std::unique_lock<std::mutex>();
+    }
+    return std::unique_lock<std::mutex>(m_mutex);
+}
+
+
+///////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////
+//
+//
+// Lock the tag, or throw if it is frozen
+//
+//
+///////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////
+std::unique_lock<std::mutex> data::lockForWriting() const
+{
+    IMEBRA_FUNCTION_START();
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    if(m_bFrozen.load(std::memory_order_relaxed))
+    {
+        IMEBRA_THROW(DataSetFrozenError, "The tag belongs to a frozen dataset");
+    }
+    return lock;
+
+    IMEBRA_FUNCTION_END();
+}
+
+
 } // namespace implementation
 
 } // namespace imebra
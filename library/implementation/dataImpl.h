@@ -23,11 +23,13 @@ If you do not want to be bound by the GPL terms (such as the requirement
 
 #include "dataHandlerNumericImpl.h"
 #include "streamControllerImpl.h"
+#include "memoryArenaImpl.h"
 #include "../include/imebra/definitions.h"
 
 #include <map>
 #include <vector>
 #include <mutex>
+#include <atomic>
 
 namespace imebra
 {
@@ -70,7 +72,16 @@ class data
 {
 public:
 
-    data(tagVR_t tagVR, const std::shared_ptr<charsetsList_t> pCharsets);
+    /// \brief Constructor.
+    ///
+    /// @param tagVR     the tag's data type
+    /// @param pCharsets the charsets used by the tag's strings
+    /// @param pArena    if not null, the buffers and the
+    ///                   sequence items are allocated from
+    ///                   this arena
+    ///
+    ///////////////////////////////////////////////////////////
+    data(tagVR_t tagVR, const std::shared_ptr<charsetsList_t> pCharsets, const std::shared_ptr<memoryArena>& pArena = std::shared_ptr<memoryArena>());
 
     virtual ~data();
 
@@ -340,12 +351,58 @@ public:
     ///////////////////////////////////////////////////////////
     void setBuffer(size_t bufferId, const std::shared_ptr<buffer>& newBuffer);
 
+    /// \brief Make the tag, its buffers and its sequence
+    ///         items read only.
+    ///
+    /// Once frozen, the reading methods don't lock the tag
+    ///  anymore and the writing methods throw
+    ///  DataSetFrozenError.
+    ///
+    /// Throws DataSetFrozenError without freezing anything
+    ///  if a writing handler obtained from the tag or from
+    ///  its sequence items is still alive.
+    ///
+    ///////////////////////////////////////////////////////////
+    void freeze();
+
+    /// \brief Return true if a writing handler obtained from
+    ///         the tag or from its sequence items has not
+    ///         been released yet.
+    ///
+    ///////////////////////////////////////////////////////////
+    bool hasWritingDataHandlers() const;
+
 protected:
 
+    /// \brief Lock the tag before reading its buffers or
+    ///         sequence items.
+    ///
+    /// The returned lock doesn't own the mutex when the
+    ///  tag is frozen.
+    ///
+    ///////////////////////////////////////////////////////////
+    std::unique_lock<std::mutex> lockForReading() const;
+
+    /// \brief Lock the tag before modifying its buffers or
+    ///         sequence items.
+    ///
+    /// Throws DataSetFrozenError if the tag is frozen.
+    ///
+    ///////////////////////////////////////////////////////////
+    std::unique_lock<std::mutex> lockForWriting() const;
+
+    /// \brief Same as hasWritingDataHandlers(), but the
+    ///         caller must hold the tag's lock.
+    ///
+    ///////////////////////////////////////////////////////////
+    bool hasWritingDataHandlersNoLock() const;
+
     const std::shared_ptr<charsetsList_t> m_pCharsetsList;
 
     const tagVR_t m_tagVR;
 
+    const std::shared_ptr<memoryArena> m_pArena;
+
     // Pointers to the internal buffers
     ///////////////////////////////////////////////////////////
     typedef std::vector<std::shared_ptr<buffer>> tBuffersVector;
@@ -358,6 +415,10 @@ protected:
     tEmbeddedDatasetsVector m_embeddedDataSets;
 
     mutable std::mutex m_mutex;
+
+    // Set by freeze()
+    ///////////////////////////////////////////////////////////
+    std::atomic<bool> m_bFrozen;
 };
 
 /// @}
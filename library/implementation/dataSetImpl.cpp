@@ -42,6 +42,7 @@ If you do not want to be bound by the GPL terms (such as the requirement
 #include <iostream>
 #include <string.h>
 #include <limits>
+#include <algorithm>
 
 
 namespace imebra
@@ -64,18 +65,19 @@ namespace implementation
 ///////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////
 
-dataSet::dataSet(const std::shared_ptr<charsetsList_t>& pCharsetsList): m_itemOffset(0), m_pCharsetsList(pCharsetsList)
+dataSet::dataSet(const std::shared_ptr<charsetsList_t>& pCharsetsList, const std::shared_ptr<memoryArena>& pArena /* = std::shared_ptr<memoryArena>() */):
+    m_itemOffset(0), m_pCharsetsList(pCharsetsList), m_pArena(pArena), m_bFrozen(false)
 {
 }
 
 dataSet::dataSet(const std::string& transferSyntax, const std::shared_ptr<charsetsList_t>& pCharsetsList):
-    m_itemOffset(0), m_pCharsetsList(pCharsetsList)
+    m_itemOffset(0), m_pCharsetsList(pCharsetsList), m_bFrozen(false)
 {
     setString(0x0002, 0x0, 0x0010, 0, transferSyntax);
 }
 
-dataSet::dataSet(const std::string& transferSyntax, const charsetsList_t& charsetsList):
-    m_itemOffset(0), m_pCharsetsList(std::make_shared<charsetsList_t>(charsetsList))
+dataSet::dataSet(const std::string& transferSyntax, const charsetsList_t& charsetsList, const std::shared_ptr<memoryArena>& pArena /* = std::shared_ptr<memoryArena>() */):
+    m_itemOffset(0), m_pCharsetsList(std::make_shared<charsetsList_t>(charsetsList)), m_pArena(pArena), m_bFrozen(false)
 {
     setString(0x0002, 0x0, 0x0010, 0, transferSyntax);
 
@@ -104,26 +106,21 @@ std::shared_ptr<data> dataSet::getTag(std::uint16_t groupId, std::uint32_t order
 {
     IMEBRA_FUNCTION_START();
 
-    std::lock_guard<std::recursive_mutex> lock(m_mutex);
+    std::unique_lock<std::recursive_mutex> lock(lockForReading());
 
-    tGroups::const_iterator findGroup(m_groups.find(groupId));
-    if(findGroup == m_groups.end())
+    const std::uint64_t key(getTagKey(groupId, order, tagId));
+    tTagsEntries::const_iterator findTag(lowerBound(key));
+    if(findTag != m_tags.end() && findTag->m_key == key)
     {
-        IMEBRA_THROW(MissingGroupError, "The requested group is missing");
+        return findTag->m_pData;
     }
 
-    if(findGroup->second.size() <= order)
+    if(getGroupsNumber(groupId) <= order)
     {
         IMEBRA_THROW(MissingGroupError, "The requested group is missing");
     }
 
-    const tTags& tagsMap = findGroup->second.at(order);
-    tTags::const_iterator findTag(tagsMap.find(tagId));
-    if(findTag == tagsMap.end())
-    {
-        IMEBRA_THROW(MissingTagError, "The requested tag is missing");
-    }
-    return findTag->second;
+    IMEBRA_THROW(MissingTagError, "The requested tag is missing");
 
     IMEBRA_FUNCTION_END();
 }
@@ -133,19 +130,26 @@ std::shared_ptr<data> dataSet::getTagCreate(std::uint16_t groupId, std::uint32_t
 {
     IMEBRA_FUNCTION_START();
 
-    std::lock_guard<std::recursive_mutex> lock(m_mutex);
+    std::unique_lock<std::recursive_mutex> lock(lockForWriting());
+
+    const std::uint64_t key(getTagKey(groupId, order, tagId));
 
-    if(m_groups[groupId].size() <= order)
+    // The codecs create the tags in ascending order: append
+    //  them without searching
+    ///////////////////////////////////////////////////////////
+    if(m_tags.empty() || m_tags.back().m_key < key)
     {
-        m_groups[groupId].resize(order + 1);
+        m_tags.push_back(tagEntry{key, allocateShared<data>(m_pArena, tagVR, m_pCharsetsList, m_pArena)});
+        return m_tags.back().m_pData;
     }
 
-    if(m_groups[groupId][order][tagId] == nullptr)
+    tTagsEntries::iterator findTag(m_tags.begin() + (lowerBound(key) - m_tags.cbegin()));
+    if(findTag->m_key == key)
     {
-        m_groups[groupId][order][tagId] = std::make_shared<data>(tagVR, m_pCharsetsList);
+        return findTag->m_pData;
     }
 
-    return m_groups[groupId][order][tagId];
+    return m_tags.insert(findTag, tagEntry{key, allocateShared<data>(m_pArena, tagVR, m_pCharsetsList, m_pArena)})->m_pData;
 
     IMEBRA_FUNCTION_END();
 }
@@ -189,7 +193,79 @@ std::shared_ptr<image> dataSet::getImage(std::uint32_t frameNumber) const
 {
     IMEBRA_FUNCTION_START();
 
-    std::lock_guard<std::recursive_mutex> lock(m_mutex);
+    // The dataset is locked only while the frame is located
+    ///////////////////////////////////////////////////////////
+    return getImageDecoder(frameNumber, imageScale_t::full)();
+
+    IMEBRA_FUNCTION_END();
+}
+
+
+///////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////
+//
+//
+// Retrieve the image at a reduced resolution
+//
+//
+///////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////
+std::shared_ptr<image> dataSet::getScaledImage(std::uint32_t frameNumber, imageScale_t scale) const
+{
+    IMEBRA_FUNCTION_START();
+
+    return getImageDecoder(frameNumber, scale)();
+
+    IMEBRA_FUNCTION_END();
+}
+
+
+///////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////
+//
+//
+// Retrieve several images, decoded in parallel
+//
+//
+///////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////
+std::shared_ptr<framesDecoder> dataSet::getImages(std::uint32_t firstFrame, std::uint32_t framesCount, size_t maxThreads) const
+{
+    IMEBRA_FUNCTION_START();
+
+    std::vector<framesDecoder::tFrameDecoder> frameDecoders;
+    frameDecoders.reserve(framesCount);
+
+    {
+        std::unique_lock<std::recursive_mutex> lock(lockForReading());
+
+        for(std::uint32_t scanFrames(0); scanFrames != framesCount; ++scanFrames)
+        {
+            frameDecoders.push_back(getImageDecoder(firstFrame + scanFrames, imageScale_t::full));
+        }
+    }
+
+    return std::make_shared<framesDecoder>(firstFrame, frameDecoders, maxThreads);
+
+    IMEBRA_FUNCTION_END();
+}
+
+
+///////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////
+//
+//
+// Locate an image and return the function that decodes
+//  it
+//
+//
+///////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////
+framesDecoder::tFrameDecoder dataSet::getImageDecoder(std::uint32_t frameNumber, imageScale_t scale) const
+{
+    IMEBRA_FUNCTION_START();
+
+    std::unique_lock<std::recursive_mutex> lock(lockForReading());
 
     // Retrieve the transfer syntax
     ///////////////////////////////////////////////////////////
@@ -349,31 +425,69 @@ std::shared_ptr<image> dataSet::getImage(std::uint32_t frameNumber) const
             imageStream = getStreamReader(0x7fe0, static_cast<std::uint16_t>(frameNumber), 0x0010, 0x0);
         }
 
-        std::shared_ptr<image> pImage;
-        pImage = pCodec->getImage(transferSyntax,
-                                  colorSpace,
-                                  channelsNumber,
-                                  imageWidth,
-                                  imageHeight,
-                                  bSubSampledX,
-                                  bSubSampledY,
-                                  bInterleaved,
-                                  b2Complement,
-                                  allocatedBits,
-                                  storedBits,
-                                  highBit,
-                                  imageStream);
-
-        if(pImage->getColorSpace() == "PALETTE COLOR")
+        // Read the palette now: the decoder doesn't access
+        //  the dataset
+        ///////////////////////////////////////////////////////////
+        std::shared_ptr<palette> imagePalette;
+        if(colorSpace == "PALETTE COLOR")
         {
-            std::shared_ptr<lut> red(std::make_shared<lut>(getReadingDataHandlerNumeric(0x0028, 0x0, 0x1101, 0), getReadingDataHandlerNumeric(0x0028, 0x0, 0x1201, 0), L"", pImage->isSigned()));
-            std::shared_ptr<lut> green(std::make_shared<lut>(getReadingDataHandlerNumeric(0x0028, 0x0, 0x1102, 0), getReadingDataHandlerNumeric(0x0028, 0x0, 0x1202, 0), L"", pImage->isSigned()));
-            std::shared_ptr<lut> blue(std::make_shared<lut>(getReadingDataHandlerNumeric(0x0028, 0x0, 0x1103, 0), getReadingDataHandlerNumeric(0x0028, 0x0, 0x1203, 0), L"", pImage->isSigned()));
-            std::shared_ptr<palette> imagePalette(std::make_shared<palette>(red, green, blue));
-            pImage->setPalette(imagePalette);
+            std::shared_ptr<lut> red(std::make_shared<lut>(getReadingDataHandlerNumeric(0x0028, 0x0, 0x1101, 0), getReadingDataHandlerNumeric(0x0028, 0x0, 0x1201, 0), L"", b2Complement));
+            std::shared_ptr<lut> green(std::make_shared<lut>(getReadingDataHandlerNumeric(0x0028, 0x0, 0x1102, 0), getReadingDataHandlerNumeric(0x0028, 0x0, 0x1202, 0), L"", b2Complement));
+            std::shared_ptr<lut> blue(std::make_shared<lut>(getReadingDataHandlerNumeric(0x0028, 0x0, 0x1103, 0), getReadingDataHandlerNumeric(0x0028, 0x0, 0x1203, 0), L"", b2Complement));
+            imagePalette = std::make_shared<palette>(red, green, blue);
         }
 
-        return pImage;
+        return [=]() -> std::shared_ptr<image>
+        {
+            try
+            {
+                std::shared_ptr<image> pImage;
+                if(scale == imageScale_t::full)
+                {
+                    pImage = pCodec->getImage(transferSyntax,
+                                              colorSpace,
+                                              channelsNumber,
+                                              imageWidth,
+                                              imageHeight,
+                                              bSubSampledX,
+                                              bSubSampledY,
+                                              bInterleaved,
+                                              b2Complement,
+                                              allocatedBits,
+                                              storedBits,
+                                              highBit,
+                                              imageStream);
+                }
+                else
+                {
+                    pImage = pCodec->getScaledImage(transferSyntax,
+                                                    colorSpace,
+                                                    channelsNumber,
+                                                    imageWidth,
+                                                    imageHeight,
+                                                    bSubSampledX,
+                                                    bSubSampledY,
+                                                    bInterleaved,
+                                                    b2Complement,
+                                                    allocatedBits,
+                                                    storedBits,
+                                                    highBit,
+                                                    scale,
+                                                    imageStream);
+                }
+
+                if(imagePalette != nullptr && pImage->getColorSpace() == "PALETTE COLOR")
+                {
+                    pImage->setPalette(imagePalette);
+                }
+
+                return pImage;
+            }
+            catch(const MissingDataElementError&)
+            {
+                IMEBRA_THROW(DataSetImageDoesntExistError, "The requested image doesn't exist");
+            }
+        };
     }
     catch(const MissingDataElementError&)
     {
@@ -398,7 +512,7 @@ std::shared_ptr<image> dataSet::getModalityImage(std::uint32_t frameNumber) cons
 {
     IMEBRA_FUNCTION_START();
 
-    std::lock_guard<std::recursive_mutex> lock(m_mutex);
+    std::unique_lock<std::recursive_mutex> lock(lockForReading());
 
     std::shared_ptr<image> originalImage = getImage(frameNumber);
 
@@ -479,7 +593,7 @@ void dataSet::setImage(std::uint32_t frameNumber, std::shared_ptr<image> pImage,
 {
     IMEBRA_FUNCTION_START();
 
-    std::lock_guard<std::recursive_mutex> lock(m_mutex);
+    std::unique_lock<std::recursive_mutex> lock(lockForWriting());
 
     // bDontChangeAttributes is true if some images already
     //  exist in the dataset and we must save the new image
@@ -973,7 +1087,7 @@ size_t dataSet::getFrameBufferIds(std::uint32_t frameNumber, std::uint32_t* pFir
 {
     IMEBRA_FUNCTION_START();
 
-    std::lock_guard<std::recursive_mutex> lock(m_mutex);
+    std::unique_lock<std::recursive_mutex> lock(lockForReading());
 
     try
     {
@@ -1091,7 +1205,7 @@ std::shared_ptr<lut> dataSet::getLut(std::uint16_t groupId, std::uint16_t tagId,
 {
     IMEBRA_FUNCTION_START();
 
-    std::lock_guard<std::recursive_mutex> lock(m_mutex);
+    std::unique_lock<std::recursive_mutex> lock(lockForReading());
 
     std::shared_ptr<dataSet> embeddedLUT = getSequenceItem(groupId, 0, tagId, lutId);
     std::shared_ptr<handlers::readingDataHandlerNumericBase> descriptorHandle = embeddedLUT->getReadingDataHandlerNumeric(0x0028, 0x0, 0x3002, 0x0);
@@ -1470,7 +1584,7 @@ void dataSet::setInt64(std::uint16_t groupId, std::uint32_t order, std::uint16_t
 {
     IMEBRA_FUNCTION_START();
 
-    std::lock_guard<std::recursive_mutex> lock(m_mutex);
+    std::unique_lock<std::recursive_mutex> lock(lockForWriting());
 
     std::shared_ptr<handlers::writingDataHandler> dataHandler = getWritingDataHandler(groupId, order, tagId, bufferId, tagVR);
     dataHandler->setSize(1);
@@ -1503,7 +1617,7 @@ void dataSet::setInt32(std::uint16_t groupId, std::uint32_t order, std::uint16_t
 {
     IMEBRA_FUNCTION_START();
 
-    std::lock_guard<std::recursive_mutex> lock(m_mutex);
+    std::unique_lock<std::recursive_mutex> lock(lockForWriting());
 
     std::shared_ptr<handlers::writingDataHandler> dataHandler = getWritingDataHandler(groupId, order, tagId, bufferId, tagVR);
     dataHandler->setSize(1);
@@ -1536,7 +1650,7 @@ void dataSet::setUint64(std::uint16_t groupId, std::uint32_t order, std::uint16_
 {
     IMEBRA_FUNCTION_START();
 
-    std::lock_guard<std::recursive_mutex> lock(m_mutex);
+    std::unique_lock<std::recursive_mutex> lock(lockForWriting());
 
     std::shared_ptr<handlers::writingDataHandler> dataHandler = getWritingDataHandler(groupId, order, tagId, bufferId, tagVR);
     dataHandler->setSize(1);
@@ -1569,7 +1683,7 @@ void dataSet::setUint32(std::uint16_t groupId, std::uint32_t order, std::uint16_
 {
     IMEBRA_FUNCTION_START();
 
-    std::lock_guard<std::recursive_mutex> lock(m_mutex);
+    std::unique_lock<std::recursive_mutex> lock(lockForWriting());
 
     std::shared_ptr<handlers::writingDataHandler> dataHandler = getWritingDataHandler(groupId, order, tagId, bufferId, tagVR);
     dataHandler->setSize(1);
@@ -1602,7 +1716,7 @@ void dataSet::setInt16(std::uint16_t groupId, std::uint32_t order, std::uint16_t
 {
     IMEBRA_FUNCTION_START();
 
-    std::lock_guard<std::recursive_mutex> lock(m_mutex);
+    std::unique_lock<std::recursive_mutex> lock(lockForWriting());
 
     std::shared_ptr<handlers::writingDataHandler> dataHandler = getWritingDataHandler(groupId, order, tagId, bufferId, tagVR);
     dataHandler->setSize(1);
@@ -1635,7 +1749,7 @@ void dataSet::setUint16(std::uint16_t groupId, std::uint32_t order, std::uint16_
 {
     IMEBRA_FUNCTION_START();
 
-    std::lock_guard<std::recursive_mutex> lock(m_mutex);
+    std::unique_lock<std::recursive_mutex> lock(lockForWriting());
 
     std::shared_ptr<handlers::writingDataHandler> dataHandler = getWritingDataHandler(groupId, order, tagId, bufferId, tagVR);
     dataHandler->setSize(1);
@@ -1668,7 +1782,7 @@ void dataSet::setInt8(std::uint16_t groupId, std::uint32_t order, std::uint16_t
 {
     IMEBRA_FUNCTION_START();
 
-    std::lock_guard<std::recursive_mutex> lock(m_mutex);
+    std::unique_lock<std::recursive_mutex> lock(lockForWriting());
 
     std::shared_ptr<handlers::writingDataHandler> dataHandler = getWritingDataHandler(groupId, order, tagId, bufferId, tagVR);
     dataHandler->setSize(1);
@@ -1701,7 +1815,7 @@ void dataSet::setUint8(std::uint16_t groupId, std::uint32_t order, std::uint16_t
 {
     IMEBRA_FUNCTION_START();
 
-    std::lock_guard<std::recursive_mutex> lock(m_mutex);
+    std::unique_lock<std::recursive_mutex> lock(lockForWriting());
 
     std::shared_ptr<handlers::writingDataHandler> dataHandler = getWritingDataHandler(groupId, order, tagId, bufferId, tagVR);
     dataHandler->setSize(1);
@@ -1802,7 +1916,7 @@ void dataSet::setDouble(std::uint16_t groupId, std::uint32_t order, std::uint16_
 {
     IMEBRA_FUNCTION_START();
 
-    std::lock_guard<std::recursive_mutex> lock(m_mutex);
+    std::unique_lock<std::recursive_mutex> lock(lockForWriting());
 
     std::shared_ptr<handlers::writingDataHandler> dataHandler = getWritingDataHandler(groupId, order, tagId, bufferId, tagVR);
     dataHandler->setSize(1);
@@ -1835,7 +1949,7 @@ void dataSet::setFloat(std::uint16_t groupId, std::uint32_t order, std::uint16_t
 {
     IMEBRA_FUNCTION_START();
 
-    std::lock_guard<std::recursive_mutex> lock(m_mutex);
+    std::unique_lock<std::recursive_mutex> lock(lockForWriting());
 
     std::shared_ptr<handlers::writingDataHandler> dataHandler = getWritingDataHandler(groupId, order, tagId, bufferId, tagVR);
     dataHandler->setSize(1);
@@ -1979,7 +2093,7 @@ void dataSet::setPatientName(std::uint16_t groupId, std::uint32_t order, std::ui
 {
     IMEBRA_FUNCTION_START();
 
-    std::lock_guard<std::recursive_mutex> lock(m_mutex);
+    std::unique_lock<std::recursive_mutex> lock(lockForWriting());
 
     std::shared_ptr<handlers::writingDataHandler> dataHandler = getWritingDataHandler(groupId, order, tagId, bufferId, tagVR_t::PN);
     dataHandler->setSize(1);
@@ -1992,7 +2106,7 @@ void dataSet::setUnicodePatientName(std::uint16_t groupId, std::uint32_t order,
 {
     IMEBRA_FUNCTION_START();
 
-    std::lock_guard<std::recursive_mutex> lock(m_mutex);
+    std::unique_lock<std::recursive_mutex> lock(lockForWriting());
 
     std::shared_ptr<handlers::writingDataHandler> dataHandler = getWritingDataHandler(groupId, order, tagId, bufferId, tagVR_t::PN);
     dataHandler->setSize(1);
@@ -2017,7 +2131,7 @@ void dataSet::setString(std::uint16_t groupId, std::uint32_t order, std::uint16_
 {
     IMEBRA_FUNCTION_START();
 
-    std::lock_guard<std::recursive_mutex> lock(m_mutex);
+    std::unique_lock<std::recursive_mutex> lock(lockForWriting());
 
     std::shared_ptr<handlers::writingDataHandler> dataHandler = getWritingDataHandler(groupId, order, tagId, bufferId, tagVR);
     dataHandler->setSize(1);
@@ -2050,7 +2164,7 @@ void dataSet::setUnicodeString(std::uint16_t groupId, std::uint32_t order, std::
 {
     IMEBRA_FUNCTION_START();
 
-    std::lock_guard<std::recursive_mutex> lock(m_mutex);
+    std::unique_lock<std::recursive_mutex> lock(lockForWriting());
 
     std::shared_ptr<handlers::writingDataHandler> dataHandler = getWritingDataHandler(groupId, order, tagId, bufferId, tagVR);
     dataHandler->setSize(1);
@@ -2074,7 +2188,7 @@ void dataSet::setAge(std::uint16_t groupId, std::uint32_t order, std::uint16_t t
 {
     IMEBRA_FUNCTION_START();
 
-    std::lock_guard<std::recursive_mutex> lock(m_mutex);
+    std::unique_lock<std::recursive_mutex> lock(lockForWriting());
 
     std::shared_ptr<handlers::writingDataHandler> dataHandler = getWritingDataHandler(groupId, order, tagId, bufferId, tagVR_t::AS);
     dataHandler->setSize(1);
@@ -2115,7 +2229,7 @@ void dataSet::setDate(std::uint16_t groupId, std::uint32_t order, std::uint16_t
 {
     IMEBRA_FUNCTION_START();
 
-    std::lock_guard<std::recursive_mutex> lock(m_mutex);
+    std::unique_lock<std::recursive_mutex> lock(lockForWriting());
 
     std::shared_ptr<handlers::writingDataHandler> dataHandler = getWritingDataHandler(groupId, order, tagId, bufferId, tagVR);
     dataHandler->setSize(1);
@@ -2347,7 +2461,7 @@ tagVR_t dataSet::getDataType(std::uint16_t groupId, std::uint32_t order, std::ui
 ///////////////////////////////////////////////////////////
 void dataSet::setItemOffset(std::uint32_t offset)
 {
-    std::lock_guard<std::recursive_mutex> lock(m_mutex);
+    std::unique_lock<std::recursive_mutex> lock(lockForWriting());
 
     m_itemOffset = offset;
 }
@@ -2364,7 +2478,7 @@ void dataSet::setItemOffset(std::uint32_t offset)
 ///////////////////////////////////////////////////////////
 std::uint32_t dataSet::getItemOffset() const
 {
-    std::lock_guard<std::recursive_mutex> lock(m_mutex);
+    std::unique_lock<std::recursive_mutex> lock(lockForReading());
 
     return m_itemOffset;
 }
@@ -2373,13 +2487,13 @@ dataSet::tGroupsIds dataSet::getGroups() const
 {
     IMEBRA_FUNCTION_START();
 
-    std::lock_guard<std::recursive_mutex> lock(m_mutex);
+    std::unique_lock<std::recursive_mutex> lock(lockForReading());
 
     dataSet::tGroupsIds groups;
 
-    for(tGroups::const_iterator scanGroups(m_groups.begin()), endGroups(m_groups.end()); scanGroups != endGroups; ++scanGroups)
+    for(tTagsEntries::const_iterator scanTags(m_tags.begin()), endTags(m_tags.end()); scanTags != endTags; ++scanTags)
     {
-        groups.insert(scanGroups->first);
+        groups.insert(groups.end(), static_cast<std::uint16_t>(scanTags->m_key >> 48));
     }
 
     return groups;
@@ -2391,50 +2505,155 @@ std::uint32_t dataSet::getGroupsNumber(uint16_t groupId) const
 {
     IMEBRA_FUNCTION_START();
 
-    std::lock_guard<std::recursive_mutex> lock(m_mutex);
+    std::unique_lock<std::recursive_mutex> lock(lockForReading());
 
-    dataSet::tGroups::const_iterator findGroup(m_groups.find(groupId));
+    // The last tag of the group has the highest order
+    ///////////////////////////////////////////////////////////
+    tTagsEntries::const_iterator nextGroup(lowerBound(getTagKey(groupId, 0xffffffff, 0xffff)));
+    if(nextGroup != m_tags.end() && nextGroup->m_key == getTagKey(groupId, 0xffffffff, 0xffff))
+    {
+        ++nextGroup;
+    }
 
-    if(findGroup == m_groups.end())
+    if(nextGroup == m_tags.begin() || static_cast<std::uint16_t>((nextGroup - 1)->m_key >> 48) != groupId)
     {
         return 0;
     }
 
-    return static_cast<std::uint32_t>(findGroup->second.size());
+    return static_cast<std::uint32_t>((nextGroup - 1)->m_key >> 16) + 1;
 
     IMEBRA_FUNCTION_END();
 }
 
-const dataSet::tTags& dataSet::getGroupTags(std::uint16_t groupId, size_t groupOrder) const
+dataSet::tTags dataSet::getGroupTags(std::uint16_t groupId, size_t groupOrder) const
 {
     IMEBRA_FUNCTION_START();
 
-    static const dataSet::tTags emptyTags;
+    dataSet::tTags tags;
 
-    std::lock_guard<std::recursive_mutex> lock(m_mutex);
+    std::unique_lock<std::recursive_mutex> lock(lockForReading());
 
-    tGroups::const_iterator findGroup(m_groups.find(groupId));
-    if(findGroup == m_groups.end() || findGroup->second.size() <= groupOrder)
+    const std::uint64_t groupKey(getTagKey(groupId, static_cast<std::uint32_t>(groupOrder), 0));
+    for(tTagsEntries::const_iterator scanTags(lowerBound(groupKey)), endTags(m_tags.end());
+        scanTags != endTags && (scanTags->m_key & ~std::uint64_t(0xffff)) == groupKey;
+        ++scanTags)
     {
-        return emptyTags;
+        tags.emplace_back(static_cast<std::uint16_t>(scanTags->m_key), scanTags->m_pData);
     }
 
-    return findGroup->second.at(groupOrder);
+    return tags;
 
     IMEBRA_FUNCTION_END();
 }
 
+std::uint64_t dataSet::getTagKey(std::uint16_t groupId, std::uint32_t order, std::uint16_t tagId)
+{
+    return (static_cast<std::uint64_t>(groupId) << 48) | (static_cast<std::uint64_t>(order) << 16) | tagId;
+}
+
+dataSet::tTagsEntries::const_iterator dataSet::lowerBound(std::uint64_t key) const
+{
+    return std::lower_bound(m_tags.begin(), m_tags.end(), key, [](const tagEntry& entry, std::uint64_t searchKey)
+    {
+        return entry.m_key < searchKey;
+    });
+}
+
+const std::shared_ptr<memoryArena>& dataSet::getArena() const
+{
+    return m_pArena;
+}
+
 void dataSet::setCharsetsList(const charsetsList_t& charsets)
 {
     IMEBRA_FUNCTION_START();
 
-    std::lock_guard<std::recursive_mutex> lock(m_mutex);
+    std::unique_lock<std::recursive_mutex> lock(lockForWriting());
 
     *m_pCharsetsList = charsets;
 
     IMEBRA_FUNCTION_END();
 }
 
+void dataSet::freeze()
+{
+    IMEBRA_FUNCTION_START();
+
+    std::lock_guard<std::recursive_mutex> lock(m_mutex);
+
+    if(m_bFrozen.load(std::memory_order_relaxed))
+    {
+        return;
+    }
+
+    // Check all the tags before freezing them, so the dataSet
+    //  is not left partially frozen
+    ///////////////////////////////////////////////////////////
+    if(hasWritingDataHandlers())
+    {
+        IMEBRA_THROW(DataSetFrozenError, "Cannot freeze the dataSet while a writing data handler is alive");
+    }
+
+    // Freeze the tags first, so the tags are already read
+    //  only when the readers stop locking the dataSet
+    ///////////////////////////////////////////////////////////
+    for(const tagEntry& entry: m_tags)
+    {
+        entry.m_pData->freeze();
+    }
+
+    m_bFrozen.store(true, std::memory_order_release);
+
+    IMEBRA_FUNCTION_END();
+}
+
+bool dataSet::hasWritingDataHandlers() const
+{
+    IMEBRA_FUNCTION_START();
+
+    std::unique_lock<std::recursive_mutex> lock(lockForReading());
+
+    for(const tagEntry& entry: m_tags)
+    {
+        if(entry.m_pData->hasWritingDataHandlers())
+        {
+            return true;
+        }
+    }
+
+    return false;
+
+    IMEBRA_FUNCTION_END();
+}
+
+bool dataSet::isFrozen() const
+{
+    return m_bFrozen.load(std::memory_order_acquire);
+}
+
+std::unique_lock<std::recursive_mutex> dataSet::lockForReading() const
+{
+    if(m_bFrozen.load(std::memory_order_acquire))
+    {
+        return std::unique_lock<std::recursive_mutex>();
+    }
+    return std::unique_lock<std::recursive_mutex>(m_mutex);
+}
+
+std::unique_lock<std::recursive_mutex> dataSet::lockForWriting() const
+{
+    IMEBRA_FUNCTION_START();
+
+    std::unique_lock<std::recursive_mutex> lock(m_mutex);
+    if(m_bFrozen.load(std::memory_order_relaxed))
+    {
+        IMEBRA_THROW(DataSetFrozenError, "The dataset is frozen and cannot be modified");
+    }
+    return lock;
+
+    IMEBRA_FUNCTION_END();
+}
+
 } // namespace implementation
 
 } // namespace imebra
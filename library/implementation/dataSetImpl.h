@@ -22,11 +22,13 @@ If you do not want to be bound by the GPL terms (such as the requirement
 #include "exceptionImpl.h"
 #include "streamCodecImpl.h"
 #include "dataImpl.h"
+#include "framesDecoderImpl.h"
 #include <vector>
 #include <memory>
 #include <set>
-#include <map>
+#include <utility>
 #include <mutex>
+#include <atomic>
 
 
 namespace imebra
@@ -77,6 +79,10 @@ class overlay;
 ///  component will lock the entire dataSet and all
 ///  its components.
 ///
+/// A dataSet that will not be modified anymore can be
+///  frozen with freeze(): the frozen dataSet is read
+///  without locking it.
+///
 /// For an introduction to the dataSet, read
 ///  \ref quick_tour_dataSet.
 ///
@@ -85,9 +91,10 @@ class overlay;
 class dataSet : public std::enable_shared_from_this<dataSet>
 {
 public:
-    // Costructor
+    // Costructor. If pArena is not null then the tags are
+    //  allocated from the arena
     ///////////////////////////////////////////////////////////
-    dataSet(const std::shared_ptr<charsetsList_t>& pCharsetsList);
+    dataSet(const std::shared_ptr<charsetsList_t>& pCharsetsList, const std::shared_ptr<memoryArena>& pArena = std::shared_ptr<memoryArena>());
 
     // Create a sequence item dataset
     ///////////////////////////////////////////////////////////
@@ -95,7 +102,13 @@ public:
 
     // Create a root dataset (not a sequence item)
     ///////////////////////////////////////////////////////////
-    dataSet(const std::string& transferSyntax, const charsetsList_t& charsetsList);
+    dataSet(const std::string& transferSyntax, const charsetsList_t& charsetsList, const std::shared_ptr<memoryArena>& pArena = std::shared_ptr<memoryArena>());
+
+    /// \brief Return the arena used to allocate the tags, or
+    ///         null if the tags are allocated on the heap.
+    ///
+    ///////////////////////////////////////////////////////////
+    const std::shared_ptr<memoryArena>& getArena() const;
 
     ///////////////////////////////////////////////////////////
     /// \name Get/set groups/tags
@@ -192,6 +205,43 @@ public:
     ///////////////////////////////////////////////////////////
     std::shared_ptr<image> getImage(std::uint32_t frameNumber) const;
 
+    /// \brief Retrieve an image at a reduced resolution.
+    ///
+    /// The lossy jpeg images are decoded directly at the
+    ///  requested resolution; the other images are decoded
+    ///  at full resolution and then shrunk.
+    ///
+    /// @param frameNumber The frame number to retrieve.
+    ///                    The first frame's id is 0
+    /// @param scale       the scale at which the image is
+    ///                     decoded
+    /// @return            A pointer to the retrieved
+    ///                     image
+    ///
+    ///////////////////////////////////////////////////////////
+    std::shared_ptr<image> getScaledImage(std::uint32_t frameNumber, imageScale_t scale) const;
+
+    /// \brief Retrieve several consecutive images, decoded
+    ///         in parallel.
+    ///
+    /// The frames are located while the dataset is locked,
+    ///  then they are decoded in the background in
+    ///  ascending order by the library's thread pool.
+    ///
+    /// Throws DataSetImageDoesntExistError if one of the
+    ///  requested frames doesn't exist.
+    ///
+    /// @param firstFrame  the first frame to retrieve
+    /// @param framesCount the number of frames to retrieve
+    /// @param maxThreads  the maximum number of threads used
+    ///                     to decode the frames. 0 means all
+    ///                     the pool threads
+    /// @return            an object that returns the decoded
+    ///                     frames
+    ///
+    ///////////////////////////////////////////////////////////
+    std::shared_ptr<framesDecoder> getImages(std::uint32_t firstFrame, std::uint32_t framesCount, size_t maxThreads) const;
+
     /// \brief Retrieve an image from the dataset and apply the
     ///        modality transform if it is specified in the
     ///        dataset.
@@ -690,9 +740,10 @@ public:
 
     //@}
 
-    typedef std::map<std::uint16_t, std::shared_ptr<data> > tTags;
-    typedef std::vector<tTags> tGroupsList;
-    typedef std::map<std::uint16_t, tGroupsList> tGroups;
+    /// \brief The tags of a group, sorted by tag id.
+    ///
+    ///////////////////////////////////////////////////////////
+    typedef std::vector<std::pair<std::uint16_t, std::shared_ptr<data> > > tTags;
 
     typedef std::set<std::uint16_t> tGroupsIds;
 
@@ -700,11 +751,68 @@ public:
 
     std::uint32_t getGroupsNumber(std::uint16_t groupId) const;
 
-    const tTags& getGroupTags(std::uint16_t groupId, size_t groupOrder) const;
+    tTags getGroupTags(std::uint16_t groupId, size_t groupOrder) const;
 
     void setCharsetsList(const charsetsList_t& charsets);
 
+    /// \brief Make the dataSet, its tags and its sequence
+    ///         items read only.
+    ///
+    /// Once frozen, the reading methods don't lock the
+    ///  dataSet anymore and can be called concurrently
+    ///  without contention, while the writing methods throw
+    ///  DataSetFrozenError.
+    ///
+    /// Throws DataSetFrozenError without freezing anything
+    ///  if a writing data handler obtained from the dataSet
+    ///  is still alive.
+    ///
+    ///////////////////////////////////////////////////////////
+    void freeze();
+
+    /// \brief Return true if a writing data handler obtained
+    ///         from the dataSet or from its sequence items
+    ///         has not been released yet.
+    ///
+    ///////////////////////////////////////////////////////////
+    bool hasWritingDataHandlers() const;
+
+    /// \brief Return true if freeze() has been called.
+    ///
+    ///////////////////////////////////////////////////////////
+    bool isFrozen() const;
+
 private:
+    /// \brief Lock the dataSet before reading its tags.
+    ///
+    /// The returned lock doesn't own the mutex when the
+    ///  dataSet is frozen.
+    ///
+    ///////////////////////////////////////////////////////////
+    std::unique_lock<std::recursive_mutex> lockForReading() const;
+
+    /// \brief Lock the dataSet before modifying its tags.
+    ///
+    /// Throws DataSetFrozenError if the dataSet is frozen.
+    ///
+    ///////////////////////////////////////////////////////////
+    std::unique_lock<std::recursive_mutex> lockForWriting() const;
+
+    /// \brief Locate a frame and return a function that
+    ///         decodes it.
+    ///
+    /// The returned function doesn't access the dataset and
+    ///  can be called from any thread, once.
+    ///
+    /// @param frameNumber the frame to locate
+    /// @param scale       the scale at which the frame is
+    ///                     decoded
+    /// @return            the function that decodes the
+    ///                     frame
+    ///
+    ///////////////////////////////////////////////////////////
+    framesDecoder::tFrameDecoder getImageDecoder(std::uint32_t frameNumber, imageScale_t scale) const;
+
     /// \brief Get a frame's offset from the offset table.
     ///
     /// @param frameNumber the number of the frame for which
@@ -739,11 +847,47 @@ private:
     ///////////////////////////////////////////////////////////
     std::uint32_t getFrameBufferId(std::uint32_t offset) const;
 
-    tGroups m_groups;
+    /// \brief Build the key used to sort the tags.
+    ///
+    /// The key contains the group id in the most significant
+    ///  word, followed by the group order and by the tag id,
+    ///  so the tags of a group are stored next to each other.
+    ///
+    ///////////////////////////////////////////////////////////
+    static std::uint64_t getTagKey(std::uint16_t groupId, std::uint32_t order, std::uint16_t tagId);
+
+    /// \brief A tag stored in the dataSet.
+    ///
+    ///////////////////////////////////////////////////////////
+    struct tagEntry
+    {
+        std::uint64_t m_key;           ///< see getTagKey()
+        std::shared_ptr<data> m_pData; ///< the tag's content
+    };
+
+    /// \brief All the tags, sorted by key.
+    ///
+    /// The tags are looked up with a binary search.
+    ///
+    ///////////////////////////////////////////////////////////
+    typedef std::vector<tagEntry> tTagsEntries;
+    tTagsEntries m_tags;
+
+    /// \brief Return the first tag with a key equal or
+    ///         greater than the specified one.
+    ///
+    ///////////////////////////////////////////////////////////
+    tTagsEntries::const_iterator lowerBound(std::uint64_t key) const;
 
     std::shared_ptr<charsetsList_t> m_pCharsetsList;
 
+    const std::shared_ptr<memoryArena> m_pArena;
+
     mutable std::recursive_mutex m_mutex;
+
+    // Set by freeze()
+    ///////////////////////////////////////////////////////////
+    std::atomic<bool> m_bFrozen;
 };
 
 
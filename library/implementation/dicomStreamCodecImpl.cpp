@@ -18,6 +18,7 @@ If you do not want to be bound by the GPL terms (such as the requirement
 
 #include <list>
 #include <vector>
+#include <map>
 #include <string.h>
 #include "exceptionImpl.h"
 #include "streamReaderImpl.h"
@@ -28,6 +29,7 @@ If you do not want to be bound by the GPL terms (such as the requirement
 #include "dicomDictImpl.h"
 #include "bufferImpl.h"
 #include "nullStreamImpl.h"
+#include "memoryStreamImpl.h"
 #include "../include/imebra/exceptions.h"
 #include "../include/imebra/definitions.h"
 
@@ -40,6 +42,357 @@ namespace implementation
 namespace codecs
 {
 
+///////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////
+//
+//
+//
+// dicomStreamHandler
+//
+//
+//
+///////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////
+dicomStreamHandler::~dicomStreamHandler()
+{
+}
+
+
+///////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////
+//
+//
+//
+// dicomStreamCodec::elementsHandler
+//
+//
+//
+///////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////
+//
+// Receives the elements found by parseDataSetElements().
+// The values are delivered on pStream, positioned at their
+//  first byte: the handler may read up to the value's
+//  length and the parser skips the bytes left unread
+//
+///////////////////////////////////////////////////////////
+class dicomStreamCodec::elementsHandler
+{
+public:
+    virtual ~elementsHandler()
+    {
+    }
+
+    virtual void onTag(std::uint16_t groupId, std::uint16_t tagId, tagVR_t tagVR, std::uint32_t tagLength, size_t wordSize, streamController::tByteOrdering endianType, const std::shared_ptr<streamReader>& pStream) = 0;
+
+    virtual void onSequenceStart(std::uint16_t groupId, std::uint16_t tagId, tagVR_t tagVR, std::uint32_t tagLength) = 0;
+
+    virtual void onSequenceEnd(std::uint16_t groupId, std::uint16_t tagId) = 0;
+
+    // itemOffset is the position of the item's header in
+    //  the controlled stream (used by DICOMDIR structures)
+    ///////////////////////////////////////////////////////////
+    virtual void onItemStart(std::uint32_t itemLength, std::uint32_t itemOffset) = 0;
+
+    virtual void onItemEnd() = 0;
+
+    virtual void onPixelFragment(std::uint16_t groupId, std::uint16_t tagId, tagVR_t tagVR, std::uint32_t fragmentId, std::uint32_t fragmentLength, size_t wordSize, streamController::tByteOrdering endianType, const std::shared_ptr<streamReader>& pStream) = 0;
+};
+
+
+///////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////
+//
+//
+//
+// dicomStreamCodec::dataSetBuilder
+//
+//
+//
+///////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////
+//
+// Fills a dataSet with the elements found by
+//  parseDataSetElements(). Used by parseStream()
+//
+///////////////////////////////////////////////////////////
+class dicomStreamCodec::dataSetBuilder: public dicomStreamCodec::elementsHandler
+{
+public:
+    dataSetBuilder(const std::shared_ptr<dataSet>& pDataSet, std::uint32_t maxSizeBufferLoad, const tagFilter_t& tagFilter):
+        m_maxSizeBufferLoad(maxSizeBufferLoad),
+        m_tagFilter(tagFilter)
+    {
+        m_levels.push_back(level(pDataSet));
+    }
+
+    virtual void onTag(std::uint16_t groupId, std::uint16_t tagId, tagVR_t tagVR, std::uint32_t tagLength, size_t wordSize, streamController::tByteOrdering endianType, const std::shared_ptr<streamReader>& pStream) override
+    {
+        level& currentLevel(m_levels.back());
+        const std::uint16_t order(currentLevel.getOrder(groupId, tagId));
+
+        // The parser skips the value if we don't read it
+        ///////////////////////////////////////////////////////////
+        if(isSkipped(currentLevel, groupId, tagId))
+        {
+            return;
+        }
+
+        readTag(pStream, currentLevel.m_pDataSet, tagLength, groupId, order, tagId, tagVR, endianType, wordSize, 0, m_maxSizeBufferLoad);
+
+        // We found the charsets list
+        ///////////////////////////////////////////////////////////
+        if(groupId == 0x0008 && tagId == 0x0005)
+        {
+            std::shared_ptr<handlers::readingDataHandler> charsetsHandler(currentLevel.m_pDataSet->getReadingDataHandler(0x0008, 0, 0x0005, 0));
+            charsetsList_t charsets;
+            for(size_t componentId(0); componentId != charsetsHandler->getSize(); ++componentId)
+            {
+                const std::string charset(charsetsHandler->getString(componentId));
+                if(!charset.empty())
+                {
+                    charsets.push_back(charset);
+                }
+            }
+            currentLevel.m_pDataSet->setCharsetsList(charsets);
+        }
+    }
+
+    virtual void onSequenceStart(std::uint16_t groupId, std::uint16_t tagId, tagVR_t tagVR, std::uint32_t tagLength) override
+    {
+        level& currentLevel(m_levels.back());
+        currentLevel.m_sequenceOrder = currentLevel.getOrder(groupId, tagId);
+        currentLevel.m_bSkipSequence = isSkipped(currentLevel, groupId, tagId);
+
+        // The sequences with a zero length are not added to
+        //  the dataset
+        ///////////////////////////////////////////////////////////
+        if(!currentLevel.m_bSkipSequence && tagLength != 0)
+        {
+            currentLevel.m_pSequenceTag = currentLevel.m_pDataSet->getTagCreate(groupId, 0x0, tagId, tagVR);
+        }
+    }
+
+    virtual void onSequenceEnd(std::uint16_t /* groupId */, std::uint16_t /* tagId */) override
+    {
+        m_levels.back().m_pSequenceTag.reset();
+    }
+
+    virtual void onItemStart(std::uint32_t /* itemLength */, std::uint32_t itemOffset) override
+    {
+        // The items of a skipped sequence are parsed into a null
+        //  dataset, so all their tags are skipped too
+        ///////////////////////////////////////////////////////////
+        std::shared_ptr<dataSet> pItem;
+        const std::shared_ptr<data>& pSequenceTag(m_levels.back().m_pSequenceTag);
+        if(pSequenceTag != nullptr)
+        {
+            pItem = pSequenceTag->appendSequenceItem();
+            pItem->setItemOffset(itemOffset);
+        }
+        m_levels.push_back(level(pItem));
+    }
+
+    virtual void onItemEnd() override
+    {
+        m_levels.pop_back();
+    }
+
+    virtual void onPixelFragment(std::uint16_t groupId, std::uint16_t tagId, tagVR_t tagVR, std::uint32_t fragmentId, std::uint32_t fragmentLength, size_t wordSize, streamController::tByteOrdering endianType, const std::shared_ptr<streamReader>& pStream) override
+    {
+        const level& currentLevel(m_levels.back());
+        if(currentLevel.m_bSkipSequence)
+        {
+            return;
+        }
+
+        readTag(pStream, currentLevel.m_pDataSet, fragmentLength, groupId, currentLevel.m_sequenceOrder, tagId, tagVR, endianType, wordSize, fragmentId, m_maxSizeBufferLoad);
+    }
+
+private:
+    // The dataset being filled and the state of its parsing.
+    //  One level is pushed for each sequence item
+    ///////////////////////////////////////////////////////////
+    struct level
+    {
+        explicit level(const std::shared_ptr<dataSet>& pDataSet):
+            m_pDataSet(pDataSet),
+            m_order(0),
+            m_lastGroupId(0),
+            m_lastTagId(0),
+            m_sequenceOrder(0),
+            m_bSkipSequence(true)
+        {
+        }
+
+        // Adjust the order when multiple groups with the same
+        //  id are present
+        ///////////////////////////////////////////////////////////
+        std::uint16_t getOrder(std::uint16_t groupId, std::uint16_t tagId)
+        {
+            if(groupId != 0 && groupId <= m_lastGroupId && tagId <= m_lastTagId)
+            {
+                ++m_order;
+            }
+            else if(groupId > m_lastGroupId)
+            {
+                m_order = 0;
+            }
+            m_lastGroupId = groupId;
+            m_lastTagId = tagId;
+
+            return m_order;
+        }
+
+        std::shared_ptr<dataSet> m_pDataSet;
+
+        std::uint16_t m_order;
+        std::uint16_t m_lastGroupId;
+        std::uint16_t m_lastTagId;
+
+        // The sequence or the encapsulated buffer being parsed
+        ///////////////////////////////////////////////////////////
+        std::shared_ptr<data> m_pSequenceTag;
+        std::uint16_t m_sequenceOrder;
+        bool m_bSkipSequence;
+    };
+
+    // Skip the tags rejected by the filter and all the tags
+    //  of a skipped sequence (null dataset).
+    // The group 0x0002 and the charsets are always loaded
+    //  because they are needed to parse the rest of the
+    //  stream
+    ///////////////////////////////////////////////////////////
+    bool isSkipped(const level& currentLevel, std::uint16_t groupId, std::uint16_t tagId) const
+    {
+        return currentLevel.m_pDataSet == nullptr ||
+                (m_tagFilter &&
+                 groupId != 0x0002 &&
+                 !(groupId == 0x0008 && tagId == 0x0005) &&
+                 !m_tagFilter(groupId, tagId));
+    }
+
+    const std::uint32_t m_maxSizeBufferLoad;
+    const tagFilter_t& m_tagFilter;
+
+    std::vector<level> m_levels;
+};
+
+
+///////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////
+//
+//
+//
+// dicomStreamCodec::eventsForwarder
+//
+//
+//
+///////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////
+//
+// Forwards the elements found by parseDataSetElements()
+//  to a dicomStreamHandler. Used by parseStreamEvents().
+// The handler receives a reader limited to the value, so
+//  it cannot consume the bytes of the next element
+//
+///////////////////////////////////////////////////////////
+class dicomStreamCodec::eventsForwarder: public dicomStreamCodec::elementsHandler
+{
+public:
+    explicit eventsForwarder(dicomStreamHandler& handler):
+        m_handler(handler)
+    {
+    }
+
+    virtual void onTag(std::uint16_t groupId, std::uint16_t tagId, tagVR_t tagVR, std::uint32_t tagLength, size_t /* wordSize */, streamController::tByteOrdering /* endianType */, const std::shared_ptr<streamReader>& pStream) override
+    {
+        std::shared_ptr<streamReader> pValueReader(getValueReader(pStream, tagLength));
+        m_handler.onTag(groupId, tagId, tagVR, tagLength, pValueReader);
+        skipValue(pValueReader, tagLength);
+    }
+
+    virtual void onSequenceStart(std::uint16_t groupId, std::uint16_t tagId, tagVR_t tagVR, std::uint32_t tagLength) override
+    {
+        m_handler.onSequenceStart(groupId, tagId, tagVR, tagLength);
+    }
+
+    virtual void onSequenceEnd(std::uint16_t groupId, std::uint16_t tagId) override
+    {
+        m_handler.onSequenceEnd(groupId, tagId);
+    }
+
+    virtual void onItemStart(std::uint32_t itemLength, std::uint32_t /* itemOffset */) override
+    {
+        m_handler.onItemStart(itemLength);
+    }
+
+    virtual void onItemEnd() override
+    {
+        m_handler.onItemEnd();
+    }
+
+    virtual void onPixelFragment(std::uint16_t groupId, std::uint16_t tagId, tagVR_t /* tagVR */, std::uint32_t fragmentId, std::uint32_t fragmentLength, size_t /* wordSize */, streamController::tByteOrdering /* endianType */, const std::shared_ptr<streamReader>& pStream) override
+    {
+        std::shared_ptr<streamReader> pValueReader(getValueReader(pStream, fragmentLength));
+        m_handler.onPixelFragment(groupId, tagId, fragmentId, fragmentLength, pValueReader);
+        skipValue(pValueReader, fragmentLength);
+    }
+
+private:
+    // Return a reader that sees only the value at the current
+    //  position of pStream. pStream moves past the value
+    ///////////////////////////////////////////////////////////
+    static std::shared_ptr<streamReader> getValueReader(const std::shared_ptr<streamReader>& pStream, std::uint32_t valueLength)
+    {
+        IMEBRA_FUNCTION_START();
+
+        // A virtual stream cannot have a zero length
+        ///////////////////////////////////////////////////////////
+        if(valueLength == 0)
+        {
+            return std::make_shared<streamReader>(std::make_shared<memoryStreamInput>(std::make_shared<memory>()));
+        }
+
+        return pStream->getReader(valueLength);
+
+        IMEBRA_FUNCTION_END();
+    }
+
+    // Skip the part of the value that the handler didn't read
+    ///////////////////////////////////////////////////////////
+    static void skipValue(const std::shared_ptr<streamReader>& pValueReader, std::uint32_t valueLength)
+    {
+        IMEBRA_FUNCTION_START();
+
+        const size_t readBytes(pValueReader->position());
+        if(readBytes > valueLength)
+        {
+            IMEBRA_THROW(StreamReadError, "The stream handler moved the read position past the end of the value");
+        }
+        pValueReader->seekForward((std::uint32_t)(valueLength - readBytes));
+
+        IMEBRA_FUNCTION_END();
+    }
+
+    dicomStreamHandler& m_handler;
+};
+
+
 ///////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////
@@ -117,7 +470,7 @@ void dicomStreamCodec::buildStream(std::shared_ptr<streamWriter> pStream, std::s
         size_t numGroups = pDataSet->getGroupsNumber(*scanGroups);
         for(size_t scanGroupsNumber(0); scanGroupsNumber != numGroups; ++scanGroupsNumber)
         {
-            const dataSet::tTags& tags(pDataSet->getGroupTags(*scanGroups, scanGroupsNumber));
+            const dataSet::tTags tags(pDataSet->getGroupTags(*scanGroups, scanGroupsNumber));
 
             if(*scanGroups == 0x0002)
             {
@@ -125,7 +478,7 @@ void dicomStreamCodec::buildStream(std::shared_ptr<streamWriter> pStream, std::s
                 ////////////////////////////////////////////////////////////////////////
                 if(streamType == streamType_t::mediaStorage)
                 {
-                    dataSet::tTags temporaryTags(tags);
+                    std::map<std::uint16_t, std::shared_ptr<data> > temporaryTags(tags.begin(), tags.end());
                     const std::shared_ptr<charsetsList_t> charsets(std::make_shared<charsetsList_t>());
                     std::shared_ptr<data> metaInformationTag(std::make_shared<data>(tagVR_t::OB, charsets));
                     {
@@ -151,7 +504,7 @@ void dicomStreamCodec::buildStream(std::shared_ptr<streamWriter> pStream, std::s
                     }
                     temporaryTags[0x13] = implementationNameTag;
 
-                    writeGroup(pStream, temporaryTags, *scanGroups, bExplicitDataType, endianType);
+                    writeGroup(pStream, dataSet::tTags(temporaryTags.begin(), temporaryTags.end()), *scanGroups, bExplicitDataType, endianType);
                 }
             }
             else
@@ -590,13 +943,12 @@ std::uint32_t dicomStreamCodec::getDataSetLength(std::shared_ptr<dataSet> pDataS
 ///////////////////////////////////////////////////////////
 //
 //
-// Read a DICOM stream and fill the dataset with the
-//  DICOM's content
+// Read the preamble and the DICM signature
 //
 //
 ///////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////
-void dicomStreamCodec::readStream(std::shared_ptr<streamReader> pStream, std::shared_ptr<dataSet> pDataSet, std::uint32_t maxSizeBufferLoad /* = 0xffffffff */) const
+bool dicomStreamCodec::readPreamble(std::shared_ptr<streamReader> pStream)
 {
     IMEBRA_FUNCTION_START();
 
@@ -635,7 +987,6 @@ void dicomStreamCodec::readStream(std::shared_ptr<streamReader> pStream, std::sh
     }
 
     bool bExplicitDataType = true;
-    streamController::tByteOrdering endianType=streamController::tByteOrdering::lowByteEndian;
     if(bFailed)
     {
         // Tags 0x8 and 0x2 are accepted in the begin of the file
@@ -657,9 +1008,34 @@ void dicomStreamCodec::readStream(std::shared_ptr<streamReader> pStream, std::sh
         bExplicitDataType = dicomDictionary::getDicomDictionary()->isDataTypeValid(firstDataType);
     }
 
+    return bExplicitDataType;
+
+    IMEBRA_FUNCTION_END();
+}
+
+
+///////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////
+//
+//
+// Read a DICOM stream and fill the dataset with the
+//  DICOM's content
+//
+//
+///////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////
+void dicomStreamCodec::readStream(std::shared_ptr<streamReader> pStream, std::shared_ptr<dataSet> pDataSet, std::uint32_t maxSizeBufferLoad /* = 0xffffffff */, std::uint32_t stopAtTag /* = 0xffffffff */, const tagFilter_t& tagFilter /* = tagFilter_t() */) const
+{
+    IMEBRA_FUNCTION_START();
+
+    // Read the preamble and the DICM signature
+    ///////////////////////////////////////////////////////////
+    bool bExplicitDataType(readPreamble(pStream));
+    streamController::tByteOrdering endianType=streamController::tByteOrdering::lowByteEndian;
+
     // Signature OK. Now scan all the tags.
     ///////////////////////////////////////////////////////////
-    parseStream(pStream, pDataSet, bExplicitDataType, endianType, maxSizeBufferLoad);
+    parseStream(pStream, pDataSet, bExplicitDataType, endianType, maxSizeBufferLoad, 0xffffffff, 0, 0, stopAtTag, tagFilter);
 
     IMEBRA_FUNCTION_END();
 }
@@ -680,7 +1056,66 @@ void dicomStreamCodec::parseStream(std::shared_ptr<streamReader> pStream,
                              std::uint32_t maxSizeBufferLoad /* = 0xffffffff */,
                              std::uint32_t subItemLength /* = 0xffffffff */,
                              std::uint32_t* pReadSubItemLength /* = 0 */,
-                             std::uint32_t depth)
+                             std::uint32_t depth /* = 0 */,
+                             std::uint32_t stopAtTag /* = 0xffffffff */,
+                             const tagFilter_t& tagFilter /* = tagFilter_t() */)
+{
+    IMEBRA_FUNCTION_START();
+
+    std::uint32_t tempReadSubItemLength = 0; // used when the last parameter is not defined
+    if(pReadSubItemLength == 0)
+    {
+        pReadSubItemLength = &tempReadSubItemLength;
+    }
+
+    dataSetBuilder builder(pDataSet, maxSizeBufferLoad, tagFilter);
+    parseDataSetElements(pStream, builder, bExplicitDataType, endianType, subItemLength, pReadSubItemLength, depth, stopAtTag);
+
+    IMEBRA_FUNCTION_END();
+}
+
+
+///////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////
+//
+//
+// Parse a DICOM stream and send its content to a handler
+//
+//
+///////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////
+void dicomStreamCodec::parseStreamEvents(std::shared_ptr<streamReader> pStream, dicomStreamHandler& handler)
+{
+    IMEBRA_FUNCTION_START();
+
+    bool bExplicitDataType(readPreamble(pStream));
+
+    eventsForwarder forwarder(handler);
+    std::uint32_t readLength(0);
+    parseDataSetElements(pStream, forwarder, bExplicitDataType, streamController::tByteOrdering::lowByteEndian, 0xffffffff, &readLength, 0, 0xffffffff);
+
+    IMEBRA_FUNCTION_END();
+}
+
+
+///////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////
+//
+//
+// Parse a dataset and send its elements to a handler
+//
+//
+///////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////
+void dicomStreamCodec::parseDataSetElements(
+        std::shared_ptr<streamReader> pStream,
+        elementsHandler& handler,
+        bool bExplicitDataType,
+        streamController::tByteOrdering endianType,
+        std::uint32_t subItemLength,
+        std::uint32_t* pReadSubItemLength,
+        std::uint32_t depth,
+        std::uint32_t stopAtTag)
 {
     IMEBRA_FUNCTION_START();
 
@@ -691,24 +1126,12 @@ void dicomStreamCodec::parseStream(std::shared_ptr<streamReader> pStream,
 
     std::uint16_t tagId;
     std::uint16_t tagSubId;
-    std::uint16_t tagLengthWord;
     std::uint32_t tagLengthDWord;
 
-    // Used to calculate the group order
-    ///////////////////////////////////////////////////////////
-    std::uint16_t order = 0;
-    std::uint16_t lastGroupId = 0;
-    std::uint16_t lastTagId = 0;
-
-    std::uint32_t tempReadSubItemLength = 0; // used when the last parameter is not defined
-    bool       bFirstTag = (pReadSubItemLength == 0);
-    bool       bCheckTransferSyntax = bFirstTag;
-    size_t     wordSize;
+    bool bFirstTag(depth == 0);
+    bool bCheckTransferSyntax(bFirstTag);
+    std::string transferSyntax;
 
-    if(pReadSubItemLength == 0)
-    {
-        pReadSubItemLength = &tempReadSubItemLength;
-    }
     *pReadSubItemLength = 0;
 
     ///////////////////////////////////////////////////////////
@@ -745,22 +1168,18 @@ void dicomStreamCodec::parseStream(std::shared_ptr<streamReader> pStream,
             pStream->adjustEndian((std::uint8_t*)&tagId, sizeof(tagId), endianType);
         }
 
-        // If this tag's id is not 0x0002, then load the
-        //  transfer syntax and set the byte endian.
+        // If this tag's id is not 0x0002, then apply the
+        //  transfer syntax read from the group 0x0002
         ///////////////////////////////////////////////////////////
         if(tagId != 0x0002 && bCheckTransferSyntax)
         {
             // Reverse the last adjust
             pStream->adjustEndian((std::uint8_t*)&tagId, sizeof(tagId), endianType);
 
-            std::string transferSyntax = pDataSet->getString(
-                        0x0002,
-                        0x0,
-                        0x0010,
-                        0,
-                        0,
-                        endianType == streamController::tByteOrdering::lowByteEndian ? "1.2.840.10008.1.2.1" : "1.2.840.10008.1.2.2");
-
+            if(transferSyntax.empty())
+            {
+                transferSyntax = endianType == streamController::tByteOrdering::lowByteEndian ? "1.2.840.10008.1.2.1" : "1.2.840.10008.1.2.2";
+            }
             if(transferSyntax == "1.2.840.10008.1.2.2")
                 endianType = streamController::tByteOrdering::highByteEndian;
             if(transferSyntax == "1.2.840.10008.1.2")
@@ -776,10 +1195,6 @@ void dicomStreamCodec::parseStream(std::shared_ptr<streamReader> pStream,
         ///////////////////////////////////////////////////////////
         bFirstTag = false;
 
-        // Set the word's length to the default value
-        ///////////////////////////////////////////////////////////
-        wordSize = 1;
-
         // Get the tag's sub ID
         ///////////////////////////////////////////////////////////
         pStream->read((std::uint8_t*)&tagSubId, sizeof(tagSubId));
@@ -797,96 +1212,18 @@ void dicomStreamCodec::parseStream(std::shared_ptr<streamReader> pStream,
             break;
         }
 
-        //
-        // Explicit data type
-        //
+        // Stop before the requested tag of the root dataset
         ///////////////////////////////////////////////////////////
-        tagVR_t tagType(tagVR_t::UN);
-
-        if(bExplicitDataType && tagId!=0xfffe)
+        if(depth == 0 && ((static_cast<std::uint32_t>(tagId) << 16) | tagSubId) >= stopAtTag)
         {
-            // Get the tag's type
-            ///////////////////////////////////////////////////////////
-            std::string tagTypeString((size_t)2, ' ');
-
-            pStream->read((std::uint8_t*)&(tagTypeString[0]), 2);
-            (*pReadSubItemLength) += 2;
-
-            // Get the tag's length
-            ///////////////////////////////////////////////////////////
-            pStream->read((std::uint8_t*)&tagLengthWord, sizeof(tagLengthWord));
-            pStream->adjustEndian((std::uint8_t*)&tagLengthWord, sizeof(tagLengthWord), endianType);
-            (*pReadSubItemLength) += (std::uint32_t)sizeof(tagLengthWord);
-
-            // The data type is valid
-            ///////////////////////////////////////////////////////////
-            try
-            {
-                tagType = dicomDictionary::getDicomDictionary()->stringDataTypeToEnum(tagTypeString);
-                tagLengthDWord=(std::uint32_t)tagLengthWord;
-                wordSize = dicomDictionary::getDicomDictionary()->getWordSize(tagType);
-                if(dicomDictionary::getDicomDictionary()->getLongLength(tagType))
-                {
-                    pStream->read((std::uint8_t*)&tagLengthDWord, sizeof(tagLengthDWord));
-                    pStream->adjustEndian((std::uint8_t*)&tagLengthDWord, sizeof(tagLengthDWord), endianType);
-                    (*pReadSubItemLength) += (std::uint32_t)sizeof(tagLengthDWord);
-                }
-            }
-            catch(const DictionaryUnknownDataTypeError&)
-            {
-                // The data type is not valid. Switch to implicit data type
-                ///////////////////////////////////////////////////////////
-                bExplicitDataType = false;
-                if(endianType == streamController::tByteOrdering::lowByteEndian)
-                    tagLengthDWord=(((std::uint32_t)tagLengthWord)<<16) | ((std::uint32_t)tagTypeString[0]) | (((std::uint32_t)tagTypeString[1])<<8);
-                else
-                    tagLengthDWord=(std::uint32_t)tagLengthWord | (((std::uint32_t)tagTypeString[0])<<24) | (((std::uint32_t)tagTypeString[1])<<16);
-            }
-
-
-        } // End of the explicit data type read block
-
-
-        ///////////////////////////////////////////////////////////
-        //
-        // Implicit data type
-        //
-        ///////////////////////////////////////////////////////////
-        else
-        {
-            // Get the tag's length
-            ///////////////////////////////////////////////////////////
-            pStream->read((std::uint8_t*)&tagLengthDWord, sizeof(tagLengthDWord));
-            pStream->adjustEndian((std::uint8_t*)&tagLengthDWord, sizeof(tagLengthDWord), endianType);
-            (*pReadSubItemLength) += (std::uint32_t)sizeof(tagLengthDWord);
+            break;
         }
 
+        // Read the tag's data type and length
         ///////////////////////////////////////////////////////////
-        //
-        // Find the default data type and the tag's word's size
-        //
-        ///////////////////////////////////////////////////////////
-        if((!bExplicitDataType || tagId==0xfffe))
-        {
-            // Group length. Data type is always UL
-            ///////////////////////////////////////////////////////////
-            if(tagSubId == 0)
-            {
-                tagType = tagVR_t::UL;
-            }
-            else
-            {
-                try
-                {
-                    tagType = dicomDictionary::getDicomDictionary()->getTagType(tagId, tagSubId);
-                }
-                catch(const DictionaryUnknownTagError&)
-                {
-                    tagType = tagVR_t::UN;
-                }
-                wordSize = dicomDictionary::getDicomDictionary()->getWordSize(tagType);
-            }
-        }
+        tagVR_t tagType(tagVR_t::UN);
+        size_t wordSize(1);
+        readTagTypeAndLength(pStream, tagId, tagSubId, bExplicitDataType, endianType, &tagType, &tagLengthDWord, &wordSize, pReadSubItemLength);
 
         // Check for the end of a sequence
         ///////////////////////////////////////////////////////////
@@ -895,98 +1232,74 @@ void dicomStreamCodec::parseStream(std::shared_ptr<streamReader> pStream,
             break;
         }
 
-        ///////////////////////////////////////////////////////////
-        ///////////////////////////////////////////////////////////
-        //
-        //
-        // Read the tag's buffer
-        //
-        //
-        ///////////////////////////////////////////////////////////
-        ///////////////////////////////////////////////////////////
-
         ///////////////////////////////////////////////////////////
         //
-        // Adjust the order when multiple groups with the same
-        //  id are present.
+        // Tag with a defined length
         //
         ///////////////////////////////////////////////////////////
-        if(tagId != 0 && tagId<=lastGroupId && tagSubId<=lastTagId)
-        {
-            ++order;
-        }
-        else
-        {
-            if(tagId>lastGroupId)
-            {
-                order = 0;
-            }
-        }
-        lastGroupId=tagId;
-        lastTagId=tagSubId;
-
         if(tagLengthDWord != 0xffffffff && tagType != tagVR_t::SQ)
         {
-            (*pReadSubItemLength) += readTag(pStream, pDataSet, tagLengthDWord, tagId, order, tagSubId, tagType, endianType, wordSize, 0, maxSizeBufferLoad);
-
-            // We found the charsets list
-            if(tagId == 0x0008 && tagSubId == 0x0005)
+            if(bCheckTransferSyntax && tagId == 0x0002 && tagSubId == 0x0010)
             {
-                std::shared_ptr<handlers::readingDataHandler> charsetsHandler(pDataSet->getReadingDataHandler(0x0008, 0, 0x0005, 0));
-                charsetsList_t charsets;
-                for(size_t componentId(0); componentId != charsetsHandler->getSize(); ++componentId)
+                // The transfer syntax is needed to parse the rest of
+                //  the stream: read it and give a copy to the handler
+                ///////////////////////////////////////////////////////////
+                if(tagLengthDWord > 1024)
                 {
-                    const std::string charset(charsetsHandler->getString(componentId));
-                    if(!charset.empty())
-                    {
-                        charsets.push_back(charset);
-                    }
+                    IMEBRA_THROW(CodecCorruptedFileError, "The transfer syntax is too long");
+                }
+                std::shared_ptr<memory> pTransferSyntaxMemory(std::make_shared<memory>(tagLengthDWord));
+                if(tagLengthDWord != 0)
+                {
+                    pStream->read(pTransferSyntaxMemory->data(), tagLengthDWord);
                 }
-                pDataSet->setCharsetsList(charsets);
+                transferSyntax.assign((const char*)pTransferSyntaxMemory->data(), tagLengthDWord);
+                while(!transferSyntax.empty() && (transferSyntax.back() == 0 || transferSyntax.back() == ' '))
+                {
+                    transferSyntax.pop_back();
+                }
+
+                std::shared_ptr<streamReader> pValueReader(std::make_shared<streamReader>(std::make_shared<memoryStreamInput>(pTransferSyntaxMemory)));
+                handler.onTag(tagId, tagSubId, tagType, tagLengthDWord, wordSize, endianType, pValueReader);
             }
+            else
+            {
+                const size_t valueStart(pStream->position());
+                handler.onTag(tagId, tagSubId, tagType, tagLengthDWord, wordSize, endianType, pStream);
+                skipUnreadBytes(pStream, valueStart, tagLengthDWord);
+            }
+
+            (*pReadSubItemLength) += tagLengthDWord;
             continue;
         }
 
         ///////////////////////////////////////////////////////////
         //
-        // We are within an undefined-length tag or a sequence
+        // Sequence or undefined-length tag
         //
         ///////////////////////////////////////////////////////////
+        handler.onSequenceStart(tagId, tagSubId, tagType, tagLengthDWord);
 
-        // Parse all the sequence's items
-        ///////////////////////////////////////////////////////////
         std::uint16_t subItemGroupId;
         std::uint16_t subItemTagId;
         std::uint32_t sequenceItemLength;
-        std::uint32_t bufferId = 0;
+        std::uint32_t fragmentId(0);
         while(tagLengthDWord && !pStream->endReached())
         {
-            // Add the tag to the dataset
-            ///////////////////////////////////////////////////////////
-            std::shared_ptr<data> sequenceTag = pDataSet->getTagCreate(tagId, 0x0, tagSubId, tagType);
-
             // Remember the item's position (used by DICOMDIR
             //  structures)
             ///////////////////////////////////////////////////////////
             std::uint32_t itemOffset((std::uint32_t)pStream->getControlledStreamPosition());
 
-            // Read the sequence item's group
+            // Read the item's group, id and length
             ///////////////////////////////////////////////////////////
             pStream->read((std::uint8_t*)&subItemGroupId, sizeof(subItemGroupId));
             pStream->adjustEndian((std::uint8_t*)&subItemGroupId, sizeof(subItemGroupId), endianType);
-            (*pReadSubItemLength) += (std::uint32_t)sizeof(subItemGroupId);
-
-            // Read the sequence item's id
-            ///////////////////////////////////////////////////////////
             pStream->read((std::uint8_t*)&subItemTagId, sizeof(subItemTagId));
             pStream->adjustEndian((std::uint8_t*)&subItemTagId, sizeof(subItemTagId), endianType);
-            (*pReadSubItemLength) += (std::uint32_t)sizeof(subItemTagId);
-
-            // Read the sequence item's length
-            ///////////////////////////////////////////////////////////
             pStream->read((std::uint8_t*)&sequenceItemLength, sizeof(sequenceItemLength));
             pStream->adjustEndian((std::uint8_t*)&sequenceItemLength, sizeof(sequenceItemLength), endianType);
-            (*pReadSubItemLength) += (std::uint32_t)sizeof(sequenceItemLength);
+            (*pReadSubItemLength) += 8;
 
             if(tagLengthDWord!=0xffffffff)
             {
@@ -1000,26 +1313,29 @@ void dicomStreamCodec::parseStream(std::shared_ptr<streamReader> pStream,
                 break;
             }
 
-            ///////////////////////////////////////////////////////////
-            // Parse a sub element
+            // Sequence item
             ///////////////////////////////////////////////////////////
             if((sequenceItemLength == 0xffffffff) || tagType == tagVR_t::SQ)
             {
-                std::shared_ptr<dataSet> sequenceDataSet(sequenceTag->appendSequenceItem());
-                sequenceDataSet->setItemOffset(itemOffset);
+                handler.onItemStart(sequenceItemLength, itemOffset);
                 std::uint32_t effectiveLength(0);
-                parseStream(pStream, sequenceDataSet, bExplicitDataType, endianType, maxSizeBufferLoad, sequenceItemLength, &effectiveLength, depth + 1);
+                parseDataSetElements(pStream, handler, bExplicitDataType, endianType, sequenceItemLength, &effectiveLength, depth + 1, stopAtTag);
+                handler.onItemEnd();
+
                 (*pReadSubItemLength) += effectiveLength;
                 if(tagLengthDWord!=0xffffffff)
+                {
                     tagLengthDWord-=effectiveLength;
-
+                }
                 continue;
             }
 
+            // Fragment of an encapsulated buffer
             ///////////////////////////////////////////////////////////
-            // Read a buffer's element
-            ///////////////////////////////////////////////////////////
-            sequenceItemLength = readTag(pStream, pDataSet, sequenceItemLength, tagId, order, tagSubId, tagType, endianType, wordSize, bufferId++, maxSizeBufferLoad);
+            const size_t valueStart(pStream->position());
+            handler.onPixelFragment(tagId, tagSubId, tagType, fragmentId++, sequenceItemLength, wordSize, endianType, pStream);
+            skipUnreadBytes(pStream, valueStart, sequenceItemLength);
+
             (*pReadSubItemLength) += sequenceItemLength;
             if(tagLengthDWord!=0xffffffff)
             {
@@ -1027,10 +1343,152 @@ void dicomStreamCodec::parseStream(std::shared_ptr<streamReader> pStream,
             }
         }
 
+        handler.onSequenceEnd(tagId, tagSubId);
+
     } // End of the tags-read block
 
     IMEBRA_FUNCTION_END();
+}
+
+
+///////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////
+//
+//
+// Skip the part of a tag that the handler didn't read
+//
+//
+///////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////
+void dicomStreamCodec::skipUnreadBytes(std::shared_ptr<streamReader> pStream, size_t valueStart, std::uint32_t valueLength)
+{
+    IMEBRA_FUNCTION_START();
+
+    const size_t position(pStream->position());
+    if(position < valueStart || position - valueStart > valueLength)
+    {
+        IMEBRA_THROW(StreamReadError, "The element handler moved the read position outside the tag's value");
+    }
+    pStream->seekForward((std::uint32_t)(valueLength - (position - valueStart)));
+
+    IMEBRA_FUNCTION_END();
+}
+
+
+///////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////
+//
+//
+// Read the data type and the length of a tag
+//
+//
+///////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////
+void dicomStreamCodec::readTagTypeAndLength(
+        std::shared_ptr<streamReader> pStream,
+        std::uint16_t tagId,
+        std::uint16_t tagSubId,
+        bool& bExplicitDataType,
+        streamController::tByteOrdering endianType,
+        tagVR_t* pTagType,
+        std::uint32_t* pTagLength,
+        size_t* pWordSize,
+        std::uint32_t* pReadLength)
+{
+    IMEBRA_FUNCTION_START();
+
+    std::uint16_t tagLengthWord;
+
+    //
+    // Explicit data type
+    //
+    ///////////////////////////////////////////////////////////
+    if(bExplicitDataType && tagId!=0xfffe)
+    {
+        // Get the tag's type
+        ///////////////////////////////////////////////////////////
+        std::string tagTypeString((size_t)2, ' ');
+
+        pStream->read((std::uint8_t*)&(tagTypeString[0]), 2);
+        (*pReadLength) += 2;
+
+        // Get the tag's length
+        ///////////////////////////////////////////////////////////
+        pStream->read((std::uint8_t*)&tagLengthWord, sizeof(tagLengthWord));
+        pStream->adjustEndian((std::uint8_t*)&tagLengthWord, sizeof(tagLengthWord), endianType);
+        (*pReadLength) += (std::uint32_t)sizeof(tagLengthWord);
 
+        // The data type is valid
+        ///////////////////////////////////////////////////////////
+        try
+        {
+            (*pTagType) = dicomDictionary::getDicomDictionary()->stringDataTypeToEnum(tagTypeString);
+            (*pTagLength)=(std::uint32_t)tagLengthWord;
+            (*pWordSize) = dicomDictionary::getDicomDictionary()->getWordSize(*pTagType);
+            if(dicomDictionary::getDicomDictionary()->getLongLength(*pTagType))
+            {
+                pStream->read((std::uint8_t*)pTagLength, sizeof(*pTagLength));
+                pStream->adjustEndian((std::uint8_t*)pTagLength, sizeof(*pTagLength), endianType);
+                (*pReadLength) += (std::uint32_t)sizeof(*pTagLength);
+            }
+        }
+        catch(const DictionaryUnknownDataTypeError&)
+        {
+            // The data type is not valid. Switch to implicit data type
+            ///////////////////////////////////////////////////////////
+            bExplicitDataType = false;
+            if(endianType == streamController::tByteOrdering::lowByteEndian)
+                (*pTagLength)=(((std::uint32_t)tagLengthWord)<<16) | ((std::uint32_t)tagTypeString[0]) | (((std::uint32_t)tagTypeString[1])<<8);
+            else
+                (*pTagLength)=(std::uint32_t)tagLengthWord | (((std::uint32_t)tagTypeString[0])<<24) | (((std::uint32_t)tagTypeString[1])<<16);
+        }
+
+
+    } // End of the explicit data type read block
+
+
+    ///////////////////////////////////////////////////////////
+    //
+    // Implicit data type
+    //
+    ///////////////////////////////////////////////////////////
+    else
+    {
+        // Get the tag's length
+        ///////////////////////////////////////////////////////////
+        pStream->read((std::uint8_t*)pTagLength, sizeof(*pTagLength));
+        pStream->adjustEndian((std::uint8_t*)pTagLength, sizeof(*pTagLength), endianType);
+        (*pReadLength) += (std::uint32_t)sizeof(*pTagLength);
+    }
+
+    ///////////////////////////////////////////////////////////
+    //
+    // Find the default data type and the tag's word's size
+    //
+    ///////////////////////////////////////////////////////////
+    if((!bExplicitDataType || tagId==0xfffe))
+    {
+        // Group length. Data type is always UL
+        ///////////////////////////////////////////////////////////
+        if(tagSubId == 0)
+        {
+            (*pTagType) = tagVR_t::UL;
+        }
+        else
+        {
+            try
+            {
+                (*pTagType) = dicomDictionary::getDicomDictionary()->getTagType(tagId, tagSubId);
+            }
+            catch(const DictionaryUnknownTagError&)
+            {
+                (*pTagType) = tagVR_t::UN;
+            }
+            (*pWordSize) = dicomDictionary::getDicomDictionary()->getWordSize(*pTagType);
+        }
+    }
+
+    IMEBRA_FUNCTION_END();
 }
 
 
@@ -1085,6 +1543,31 @@ std::uint32_t dicomStreamCodec::readTag(
         return (std::uint32_t)bufferLength;
     }
 
+    // When the dataset uses an arena then read the small
+    //  values directly into it.
+    // Like the heap buffers, the values are followed by a
+    //  zero byte
+    ///////////////////////////////////////////////////////////
+    const std::shared_ptr<memoryArena>& pArena(pDataSet->getArena());
+    if(pArena != nullptr &&
+            tagLengthDWord != 0 &&
+            tagLengthDWord <= IMEBRA_MEMORY_ARENA_MAX_VALUE_SIZE &&
+            !(tagId == 0xfffc && tagSubId == 0xfffc))
+    {
+        std::uint8_t* pValue(static_cast<std::uint8_t*>(pArena->allocate(tagLengthDWord + 1, sizeof(std::uint64_t))));
+        pStream->read(pValue, tagLengthDWord);
+        pValue[tagLengthDWord] = 0;
+        if(wordSize != 0)
+        {
+            pStream->adjustEndian(pValue, wordSize, endianType, tagLengthDWord / wordSize);
+        }
+
+        std::shared_ptr<memory> pValueMemory(allocateShared<memory>(pArena, pArena, pValue, tagLengthDWord));
+        pDataSet->getTagCreate(tagId, order, tagSubId, tagType)->getBufferCreate(bufferId)->assignMemory(pValueMemory);
+
+        return tagLengthDWord;
+    }
+
     // Allocate the tag's buffer
     ///////////////////////////////////////////////////////////
     std::shared_ptr<handlers::writingDataHandlerRaw> handler(pDataSet->getWritingDataHandlerRaw(tagId, order, tagSubId, bufferId, tagType));
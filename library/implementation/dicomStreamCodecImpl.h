@@ -49,6 +49,92 @@ namespace codecs
 ///
 /// @{
 
+///////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////
+/// \brief Receives the content of a DICOM stream parsed
+///        by dicomStreamCodec::parseStreamEvents().
+///
+/// The callbacks are called in the same order in which
+///  the tags appear in the stream.
+///
+///////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////
+class dicomStreamHandler
+{
+public:
+    virtual ~dicomStreamHandler();
+
+    /// \brief Called for each tag that has a defined
+    ///        length and is not a sequence.
+    ///
+    /// pReader sees only the tag's value: reading past its
+    ///  end throws StreamEOFError. The bytes that are not
+    ///  read are skipped.
+    ///
+    /// @param groupId   the tag's group
+    /// @param tagId     the tag's id
+    /// @param tagVR     the tag's data type
+    /// @param tagLength the length of the tag's value
+    /// @param pReader   a reader limited to the tag's value
+    ///
+    ///////////////////////////////////////////////////////////
+    virtual void onTag(std::uint16_t groupId, std::uint16_t tagId, tagVR_t tagVR, std::uint32_t tagLength, const std::shared_ptr<streamReader>& pReader) = 0;
+
+    /// \brief Called when a sequence or a tag with
+    ///        undefined length (e.g. encapsulated pixel
+    ///        data) starts.
+    ///
+    /// @param groupId   the tag's group
+    /// @param tagId     the tag's id
+    /// @param tagVR     the tag's data type
+    /// @param tagLength the tag's length (0xffffffff when
+    ///                   undefined)
+    ///
+    ///////////////////////////////////////////////////////////
+    virtual void onSequenceStart(std::uint16_t groupId, std::uint16_t tagId, tagVR_t tagVR, std::uint32_t tagLength) = 0;
+
+    /// \brief Called when the sequence notified by
+    ///        onSequenceStart() ends.
+    ///
+    ///////////////////////////////////////////////////////////
+    virtual void onSequenceEnd(std::uint16_t groupId, std::uint16_t tagId) = 0;
+
+    /// \brief Called when an item (embedded dataset) of
+    ///        a sequence starts.
+    ///
+    /// @param itemLength the item's length (0xffffffff when
+    ///                   undefined)
+    ///
+    ///////////////////////////////////////////////////////////
+    virtual void onItemStart(std::uint32_t itemLength) = 0;
+
+    /// \brief Called when the item notified by onItemStart()
+    ///        ends.
+    ///
+    ///////////////////////////////////////////////////////////
+    virtual void onItemEnd() = 0;
+
+    /// \brief Called for each fragment of an encapsulated
+    ///        buffer.
+    ///
+    /// pReader sees only the fragment: reading past its end
+    ///  throws StreamEOFError. The bytes that are not read
+    ///  are skipped.
+    ///
+    /// @param groupId        the group of the tag that
+    ///                        contains the fragment
+    /// @param tagId          the id of the tag that contains
+    ///                        the fragment
+    /// @param fragmentId     the fragment's index (0 for the
+    ///                        offset table)
+    /// @param fragmentLength the fragment's length
+    /// @param pReader        a reader limited to the
+    ///                        fragment
+    ///
+    ///////////////////////////////////////////////////////////
+    virtual void onPixelFragment(std::uint16_t groupId, std::uint16_t tagId, std::uint32_t fragmentId, std::uint32_t fragmentLength, const std::shared_ptr<streamReader>& pReader) = 0;
+};
+
 ///////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////
 /// \brief The Dicom codec.
@@ -104,6 +190,17 @@ public:
     ///                    - >=1 = dataset embedded into
     ///                      another dataset. This value is
     ///                      used to prevent a stack overflow
+    /// @param stopAtTag  the parsing stops at the first tag
+    ///                    of the root dataset with an id
+    ///                    (group in the high word, tag in
+    ///                    the low word) equal or greater than
+    ///                    stopAtTag. Set to 0xffffffff to
+    ///                    parse the whole stream
+    /// @param tagFilter  if set, then the tags rejected by
+    ///                    the filter are skipped without
+    ///                    being added to the dataset
+    ///
+    /// If pDataSet is null then all the tags are skipped.
     ///
     ///////////////////////////////////////////////////////////
     static void parseStream(
@@ -114,7 +211,9 @@ public:
         std::uint32_t maxSizeBufferLoad = 0xffffffff,
         std::uint32_t subItemLength = 0xffffffff,
         std::uint32_t* pReadSubItemLength = 0,
-        std::uint32_t depth = 0);
+        std::uint32_t depth = 0,
+        std::uint32_t stopAtTag = 0xffffffff,
+        const tagFilter_t& tagFilter = tagFilter_t());
 
     /// \brief Indicates the type of DICOM stream to build
     ///
@@ -140,6 +239,19 @@ public:
     ///////////////////////////////////////////////////////////
     static void buildStream(std::shared_ptr<streamWriter> pStream, std::shared_ptr<const dataSet> pDataSet, bool bExplicitDataType, streamController::tByteOrdering endianType, streamType_t streamType);
 
+    /// \brief Parse a DICOM stream without building a
+    ///        dataSet and send its content to a handler.
+    ///
+    /// The stream may start with the 128 bytes preamble and
+    ///  the DICM signature.
+    ///
+    /// @param pStream the stream to parse
+    /// @param handler the handler that receives the tags,
+    ///                 the sequences and the fragments
+    ///
+    ///////////////////////////////////////////////////////////
+    static void parseStreamEvents(std::shared_ptr<streamReader> pStream, dicomStreamHandler& handler);
+
 protected:
     // Write a dicom stream
     ///////////////////////////////////////////////////////////
@@ -147,11 +259,46 @@ protected:
 
     // Load a dicom stream
     ///////////////////////////////////////////////////////////
-    virtual void readStream(std::shared_ptr<streamReader> pStream, std::shared_ptr<dataSet> pDataSet, std::uint32_t maxSizeBufferLoad = 0xffffffff) const;
+    virtual void readStream(std::shared_ptr<streamReader> pStream, std::shared_ptr<dataSet> pDataSet, std::uint32_t maxSizeBufferLoad = 0xffffffff, std::uint32_t stopAtTag = 0xffffffff, const tagFilter_t& tagFilter = tagFilter_t()) const;
 
 
 
 protected:
+    // Read the preamble and the signature, if present.
+    //  Returns true if the stream uses explicit data types
+    ///////////////////////////////////////////////////////////
+    static bool readPreamble(std::shared_ptr<streamReader> pStream);
+
+    // Read the data type and the length of a tag
+    ///////////////////////////////////////////////////////////
+    static void readTagTypeAndLength(std::shared_ptr<streamReader> pStream, std::uint16_t tagId, std::uint16_t tagSubId, bool& bExplicitDataType, streamController::tByteOrdering endianType, tagVR_t* pTagType, std::uint32_t* pTagLength, size_t* pWordSize, std::uint32_t* pReadLength);
+
+    // Receives the elements found by parseDataSetElements()
+    ///////////////////////////////////////////////////////////
+    class elementsHandler;
+
+    // Fills a dataSet with the parsed elements
+    //  (used by parseStream())
+    ///////////////////////////////////////////////////////////
+    class dataSetBuilder;
+
+    // Forwards the parsed elements to a dicomStreamHandler
+    //  (used by parseStreamEvents())
+    ///////////////////////////////////////////////////////////
+    class eventsForwarder;
+
+    // Parse a dataset and send its elements to a handler.
+    //  This is the only loop that walks the DICOM datasets:
+    //  parseStream() and parseStreamEvents() both use it
+    ///////////////////////////////////////////////////////////
+    static void parseDataSetElements(std::shared_ptr<streamReader> pStream, elementsHandler& handler, bool bExplicitDataType, streamController::tByteOrdering endianType, std::uint32_t subItemLength, std::uint32_t* pReadSubItemLength, std::uint32_t depth, std::uint32_t stopAtTag);
+
+    // Skip the part of a value not read by an
+    //  elementsHandler. Throws StreamReadError if the
+    //  handler moved the read position outside the value
+    ///////////////////////////////////////////////////////////
+    static void skipUnreadBytes(std::shared_ptr<streamReader> pStream, size_t valueStart, std::uint32_t valueLength);
+
     // Read a single tag
     ///////////////////////////////////////////////////////////
     static std::uint32_t readTag(std::shared_ptr<streamReader> pStream, std::shared_ptr<dataSet> pDataSet, std::uint32_t tagLengthDWord, std::uint16_t tagId, std::uint16_t order, std::uint16_t tagSubId, tagVR_t tagType, streamController::tByteOrdering endianType, size_t wordSize, std::uint32_t bufferId, std::uint32_t maxSizeBufferLoad = 0xffffffff);
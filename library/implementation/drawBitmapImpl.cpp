@@ -21,6 +21,10 @@ If you do not want to be bound by the GPL terms (such as the requirement
 #include "colorTransformsFactoryImpl.h"
 #include "transformHighBitImpl.h"
 #include "transformsChainImpl.h"
+#include "LUTSimdImpl.h"
+
+#include <cstring>
+#include <vector>
 
 namespace imebra
 {
@@ -28,6 +32,253 @@ namespace imebra
 namespace implementation
 {
 
+namespace
+{
+
+///////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////
+//
+//
+// Fill an image row with all the values representable by
+//  the image's data type
+//
+//
+///////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////
+template <class dataType>
+void fillRamp(dataType* pRamp, std::int32_t firstValue, std::uint32_t rampSize)
+{
+    for(std::uint32_t scanRamp(0); scanRamp != rampSize; ++scanRamp)
+    {
+        *(pRamp++) = (dataType)(firstValue + (std::int32_t)scanRamp);
+    }
+}
+
+
+///////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////
+//
+//
+// Map the pixels through a table of packed output pixels
+//  and write them directly into the bitmap
+//
+//
+///////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////
+template <class inputType>
+void drawFromTable(
+        const inputType* pInput,
+        std::uint32_t width, std::uint32_t height,
+        const std::uint32_t* pTable, std::int32_t firstValue, std::uint32_t tableSize,
+        std::uint32_t destPixelSize, std::uint8_t* pBuffer, std::uint32_t rowSizeBytes)
+{
+#if defined(IMEBRA_SIMD_X86)
+    const bool bAvx2(getSimdInstructions() == simdInstructions_t::avx2);
+#else
+    (void)tableSize;
+#endif
+
+    for(std::uint32_t scanY(height); scanY != 0; --scanY)
+    {
+        size_t scanX(0);
+
+#if defined(IMEBRA_SIMD_X86)
+        // The table covers all the representable values: the
+        //  gather kernel never has to clamp them
+        ///////////////////////////////////////////////////////////
+        if(bAvx2 && destPixelSize == 4 && reinterpret_cast<std::uintptr_t>(pBuffer) % sizeof(std::uint32_t) == 0)
+        {
+            scanX = lutMapValuesAvx2(pInput, reinterpret_cast<std::uint32_t*>(pBuffer), width, pTable, firstValue, (std::int32_t)tableSize - 1, 0);
+        }
+#endif
+
+        for(std::uint8_t* pOutput(pBuffer + scanX * destPixelSize); scanX != width; ++scanX, pOutput += destPixelSize)
+        {
+            ::memcpy(pOutput, &(pTable[(std::int32_t)pInput[scanX] - firstValue]), destPixelSize);
+        }
+
+        pInput += width;
+        pBuffer += rowSizeBytes;
+    }
+}
+
+
+///////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////
+//
+//
+// Map the rows of an area through a table of RGB pixels
+//
+//
+///////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////
+template <class inputType>
+void mapRowsThroughTable(
+        const inputType* pInput, std::uint32_t inputWidth,
+        std::uint32_t width, std::uint32_t height,
+        const std::uint32_t* pTable, std::int32_t firstValue,
+        std::uint8_t* pOutput)
+{
+    for(std::uint32_t scanY(height); scanY != 0; --scanY)
+    {
+        for(std::uint32_t scanX(0); scanX != width; ++scanX, pOutput += 3)
+        {
+            ::memcpy(pOutput, &(pTable[(std::int32_t)pInput[scanX] - firstValue]), 3);
+        }
+        pInput += inputWidth;
+    }
+}
+
+
+///////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////
+//
+//
+// Provides the rows of an image's area, already
+//  converted to 8 bit RGB.
+//
+// The rows are calculated in blocks: the pointers
+//  returned by getRows() are valid until the next call.
+//
+//
+///////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////
+class renderedRows
+{
+public:
+    renderedRows(
+            const transforms::transformsChain& chain,
+            const std::shared_ptr<const image>& sourceImage,
+            std::uint32_t topLeftX, std::uint32_t topLeftY, std::uint32_t width, std::uint32_t height,
+            std::uint32_t rowsPerBlock,
+            const std::vector<std::uint32_t>& table, std::int32_t firstValue):
+        m_chain(chain),
+        m_sourceImage(sourceImage),
+        m_topLeftX(topLeftX), m_topLeftY(topLeftY), m_width(width), m_height(height),
+        m_rowsPerBlock(std::min(std::max(rowsPerBlock, (std::uint32_t)2), height)),
+        m_table(table), m_firstValue(firstValue),
+        m_blockStart(0), m_blockRows(0)
+    {
+        if(m_table.empty())
+        {
+            m_blockImage = std::make_shared<image>(m_width, m_rowsPerBlock, bitDepth_t::depthU8, "RGB", 7);
+        }
+        else
+        {
+            m_sourceHandler = m_sourceImage->getReadingDataHandler();
+            m_tableBlock.resize((size_t)m_width * m_rowsPerBlock * 3);
+        }
+    }
+
+    // Return the first of the rows [row, row + numRows),
+    //  which follow each other in memory
+    ///////////////////////////////////////////////////////////
+    const std::uint8_t* getRows(std::uint32_t row, std::uint32_t numRows)
+    {
+        if(row < m_blockStart || row + numRows > m_blockStart + m_blockRows)
+        {
+            calculateBlock(row);
+        }
+        return m_pBlock + (size_t)(row - m_blockStart) * m_width * 3;
+    }
+
+private:
+    void calculateBlock(std::uint32_t firstRow)
+    {
+        m_blockStart = firstRow;
+        m_blockRows = std::min(m_rowsPerBlock, m_height - firstRow);
+
+        if(!m_table.empty())
+        {
+            std::uint32_t sourceWidth, sourceHeight;
+            m_sourceImage->getSize(&sourceWidth, &sourceHeight);
+            const size_t firstPixel((size_t)(m_topLeftY + firstRow) * sourceWidth + m_topLeftX);
+            const std::uint8_t* pSource(m_sourceHandler->getMemoryBuffer());
+            switch(m_sourceImage->getDepth())
+            {
+            case bitDepth_t::depthU8:
+                mapRowsThroughTable((const std::uint8_t*)pSource + firstPixel, sourceWidth, m_width, m_blockRows, m_table.data(), m_firstValue, m_tableBlock.data());
+                break;
+            case bitDepth_t::depthS8:
+                mapRowsThroughTable((const std::int8_t*)pSource + firstPixel, sourceWidth, m_width, m_blockRows, m_table.data(), m_firstValue, m_tableBlock.data());
+                break;
+            case bitDepth_t::depthU16:
+                mapRowsThroughTable((const std::uint16_t*)pSource + firstPixel, sourceWidth, m_width, m_blockRows, m_table.data(), m_firstValue, m_tableBlock.data());
+                break;
+            default:
+                mapRowsThroughTable((const std::int16_t*)pSource + firstPixel, sourceWidth, m_width, m_blockRows, m_table.data(), m_firstValue, m_tableBlock.data());
+                break;
+            }
+            m_pBlock = m_tableBlock.data();
+            return;
+        }
+
+        m_blockHandler.reset();
+        m_chain.runTransform(m_sourceImage, m_topLeftX, m_topLeftY + firstRow, m_width, m_blockRows, m_blockImage, 0, 0);
+        m_blockHandler = m_blockImage->getReadingDataHandler();
+        m_pBlock = m_blockHandler->getMemoryBuffer();
+    }
+
+    const transforms::transformsChain& m_chain;
+    const std::shared_ptr<const image> m_sourceImage;
+    const std::uint32_t m_topLeftX, m_topLeftY, m_width, m_height;
+    const std::uint32_t m_rowsPerBlock;
+
+    const std::vector<std::uint32_t>& m_table;
+    const std::int32_t m_firstValue;
+    std::shared_ptr<handlers::readingDataHandlerNumericBase> m_sourceHandler;
+    std::vector<std::uint8_t> m_tableBlock;
+
+    std::shared_ptr<image> m_blockImage;
+    std::shared_ptr<handlers::readingDataHandlerNumericBase> m_blockHandler;
+
+    std::uint32_t m_blockStart;
+    std::uint32_t m_blockRows;
+    const std::uint8_t* m_pBlock;
+};
+
+
+///////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////
+//
+//
+// Store an RGB pixel in the bitmap
+//
+//
+///////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////
+inline std::uint8_t* storePixel(std::uint8_t* pOutput, std::uint32_t red, std::uint32_t green, std::uint32_t blue, drawBitmapType_t drawBitmapType)
+{
+    switch(drawBitmapType)
+    {
+    case drawBitmapType_t::drawBitmapRGB:
+        *pOutput++ = (std::uint8_t)red;
+        *pOutput++ = (std::uint8_t)green;
+        *pOutput++ = (std::uint8_t)blue;
+        break;
+    case drawBitmapType_t::drawBitmapBGR:
+        *pOutput++ = (std::uint8_t)blue;
+        *pOutput++ = (std::uint8_t)green;
+        *pOutput++ = (std::uint8_t)red;
+        break;
+    case drawBitmapType_t::drawBitmapRGBA:
+        *pOutput++ = (std::uint8_t)red;
+        *pOutput++ = (std::uint8_t)green;
+        *pOutput++ = (std::uint8_t)blue;
+        *pOutput++ = 0xff;
+        break;
+    default:
+        *pOutput++ = (std::uint8_t)blue;
+        *pOutput++ = (std::uint8_t)green;
+        *pOutput++ = (std::uint8_t)red;
+        *pOutput++ = 0xff;
+        break;
+    }
+    return pOutput;
+}
+
+} // anonymous namespace
+
 
 drawBitmap::drawBitmap(std::shared_ptr<transforms::transform> transformsChain):
     m_userTransforms(transformsChain)
@@ -80,37 +331,35 @@ size_t drawBitmap::getBitmap(const std::shared_ptr<const image>& sourceImage, dr
     //  transforms and high bit shift
     ///////////////////////////////////////////////////////////////////////////////
     transforms::transformsChain chain;
-    chain.addTransform(m_userTransforms);
+    buildRenderingChain(sourceImage, chain);
 
-    // Allocate the transforms that obtain an RGB image
-    ///////////////////////////////////////////////////////////////////////////////
-    std::shared_ptr<const image> chainEndImage(sourceImage);
-    if(!chain.isEmpty())
-    {
-        chainEndImage = chain.allocateOutputImage(sourceImage->getDepth(),
-                                                  sourceImage->getColorSpace(),
-                                                  sourceImage->getHighBit(),
-                                                  sourceImage->getPalette(),
-                                                  1, 1);
-    }
-
-    std::shared_ptr<transforms::colorTransforms::colorTransformsFactory> pColorTransformsFactory(transforms::colorTransforms::colorTransformsFactory::getColorTransformsFactory());
-    std::shared_ptr<transforms::transform> rgbColorTransform(pColorTransformsFactory->getTransform(chainEndImage->getColorSpace(), "RGB"));
-
-    if(rgbColorTransform != 0 && !rgbColorTransform->isEmpty())
-    {
-        chain.addTransform(rgbColorTransform);
-        chainEndImage = chain.allocateOutputImage(sourceImage->getDepth(),
-                                                  sourceImage->getColorSpace(),
-                                                  sourceImage->getHighBit(),
-                                                  sourceImage->getPalette(),
-                                                  1, 1);
-    }
-
-    if(chainEndImage->getHighBit() != 7 || chainEndImage->getDepth() != bitDepth_t::depthU8)
+    // Images with one channel and up to 16 bits per pixel are
+    //  rendered through a table that maps each value to
+    //  the final pixel
+    ///////////////////////////////////////////////////////////
+    std::vector<std::uint32_t> table;
+    std::int32_t firstValue(0);
+    if(buildPixelTable(chain, sourceImage, drawBitmapType, (std::uint64_t)width * height, table, firstValue))
     {
-        std::shared_ptr<transforms::transformHighBit> highBitTransform(std::make_shared<transforms::transformHighBit>());
-        chain.addTransform(highBitTransform);
+        const std::uint32_t tableSize((std::uint32_t)table.size());
+        std::shared_ptr<handlers::readingDataHandlerNumericBase> imageHandler(sourceImage->getReadingDataHandler());
+        const std::uint8_t* pImageMemory(imageHandler->getMemoryBuffer());
+        switch(sourceImage->getDepth())
+        {
+        case bitDepth_t::depthU8:
+            drawFromTable((const std::uint8_t*)pImageMemory, width, height, table.data(), firstValue, tableSize, destPixelSize, pBuffer, rowSizeBytes);
+            break;
+        case bitDepth_t::depthS8:
+            drawFromTable((const std::int8_t*)pImageMemory, width, height, table.data(), firstValue, tableSize, destPixelSize, pBuffer, rowSizeBytes);
+            break;
+        case bitDepth_t::depthU16:
+            drawFromTable((const std::uint16_t*)pImageMemory, width, height, table.data(), firstValue, tableSize, destPixelSize, pBuffer, rowSizeBytes);
+            break;
+        default:
+            drawFromTable((const std::int16_t*)pImageMemory, width, height, table.data(), firstValue, tableSize, destPixelSize, pBuffer, rowSizeBytes);
+            break;
+        }
+        return memorySize;
     }
 
     // If a transform chain is active then allocate a temporary
@@ -209,6 +458,379 @@ size_t drawBitmap::getBitmap(const std::shared_ptr<const image>& sourceImage, dr
 }
 
 
+std::shared_ptr<memory> drawBitmap::getBitmap(
+        const std::shared_ptr<const image>& sourceImage,
+        std::uint32_t sourceTopLeftX, std::uint32_t sourceTopLeftY, std::uint32_t sourceWidth, std::uint32_t sourceHeight,
+        std::uint32_t bitmapWidth, std::uint32_t bitmapHeight,
+        drawBitmapFilter_t filter,
+        drawBitmapType_t drawBitmapType, std::uint32_t rowAlignBytes)
+{
+    IMEBRA_FUNCTION_START();
+
+    size_t memorySize(getBitmap(sourceImage, sourceTopLeftX, sourceTopLeftY, sourceWidth, sourceHeight, bitmapWidth, bitmapHeight, filter, drawBitmapType, rowAlignBytes, 0, 0));
+
+    std::shared_ptr<memory> bitmapMemory = std::make_shared<memory>(memorySize);
+
+    getBitmap(sourceImage, sourceTopLeftX, sourceTopLeftY, sourceWidth, sourceHeight, bitmapWidth, bitmapHeight, filter, drawBitmapType, rowAlignBytes, bitmapMemory->data(), memorySize);
+
+    return bitmapMemory;
+
+    IMEBRA_FUNCTION_END();
+}
+
+
+///////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////
+//
+//
+// Render an area of the image into a bitmap of the
+//  specified size
+//
+//
+///////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////
+size_t drawBitmap::getBitmap(
+        const std::shared_ptr<const image>& sourceImage,
+        std::uint32_t sourceTopLeftX, std::uint32_t sourceTopLeftY, std::uint32_t sourceWidth, std::uint32_t sourceHeight,
+        std::uint32_t bitmapWidth, std::uint32_t bitmapHeight,
+        drawBitmapFilter_t filter,
+        drawBitmapType_t drawBitmapType, std::uint32_t rowAlignBytes,
+        std::uint8_t* pBuffer, size_t bufferSize)
+{
+    IMEBRA_FUNCTION_START();
+
+    std::uint32_t width, height;
+    sourceImage->getSize(&width, &height);
+    if(sourceWidth == 0 || sourceHeight == 0 ||
+            (std::uint64_t)sourceTopLeftX + sourceWidth > width ||
+            (std::uint64_t)sourceTopLeftY + sourceHeight > height)
+    {
+        IMEBRA_THROW(TransformInvalidAreaError, "The area to render exceeds the image's size");
+    }
+
+    // The whole image at its original size
+    ///////////////////////////////////////////////////////////
+    if(sourceTopLeftX == 0 && sourceTopLeftY == 0 && sourceWidth == width && sourceHeight == height &&
+            bitmapWidth == width && bitmapHeight == height)
+    {
+        return getBitmap(sourceImage, drawBitmapType, rowAlignBytes, pBuffer, bufferSize);
+    }
+
+    std::uint32_t destPixelSize((drawBitmapType == drawBitmapType_t::drawBitmapRGBA || drawBitmapType == drawBitmapType_t::drawBitmapBGRA) ? 4 : 3);
+
+    // Calculate the row' size, in bytes
+    ///////////////////////////////////////////////////////////
+    std::uint32_t rowSizeBytes = (bitmapWidth * destPixelSize + rowAlignBytes - 1) / rowAlignBytes;
+    rowSizeBytes *= rowAlignBytes;
+
+    std::uint32_t memorySize(rowSizeBytes * bitmapHeight);
+    if(memorySize == 0 || memorySize > bufferSize)
+    {
+        return memorySize;
+    }
+
+    transforms::transformsChain chain;
+    buildRenderingChain(sourceImage, chain);
+
+    // The bilinear filter reads only 2 rows for each bitmap
+    //  row
+    ///////////////////////////////////////////////////////////
+    const bool bSparseRows(filter == drawBitmapFilter_t::bilinear && bitmapHeight < sourceHeight / 2);
+    const std::uint64_t readRows(bSparseRows ? (std::uint64_t)bitmapHeight * 2 : sourceHeight);
+
+    std::vector<std::uint32_t> table;
+    std::int32_t firstValue(0);
+    buildPixelTable(chain, sourceImage, drawBitmapType_t::drawBitmapRGB, readRows * sourceWidth, table, firstValue);
+
+    const std::uint32_t rowsPerBlock(bSparseRows ? 2 : std::max((std::uint32_t)1, (std::uint32_t)(65536 / ((std::uint64_t)sourceWidth * 3))));
+    renderedRows rows(chain, sourceImage, sourceTopLeftX, sourceTopLeftY, sourceWidth, sourceHeight, rowsPerBlock, table, firstValue);
+
+    if(filter == drawBitmapFilter_t::box)
+    {
+        // Each bitmap pixel is the average of the pixels in the
+        //  area it covers: when enlarging the area contains
+        //  at least one pixel
+        ///////////////////////////////////////////////////////////
+        std::vector<std::uint32_t> columnsStart(bitmapWidth), columnsEnd(bitmapWidth);
+        for(std::uint32_t scanX(0); scanX != bitmapWidth; ++scanX)
+        {
+            columnsStart[scanX] = (std::uint32_t)((std::uint64_t)scanX * sourceWidth / bitmapWidth);
+            columnsEnd[scanX] = std::max(columnsStart[scanX] + 1, (std::uint32_t)((std::uint64_t)(scanX + 1) * sourceWidth / bitmapWidth));
+        }
+
+        std::vector<std::uint64_t> sums((size_t)bitmapWidth * 3);
+        for(std::uint32_t scanY(0); scanY != bitmapHeight; ++scanY)
+        {
+            const std::uint32_t rowsStart((std::uint32_t)((std::uint64_t)scanY * sourceHeight / bitmapHeight));
+            const std::uint32_t rowsEnd(std::max(rowsStart + 1, (std::uint32_t)((std::uint64_t)(scanY + 1) * sourceHeight / bitmapHeight)));
+
+            std::fill(sums.begin(), sums.end(), 0);
+            for(std::uint32_t sourceRow(rowsStart); sourceRow != rowsEnd; ++sourceRow)
+            {
+                const std::uint8_t* pRow(rows.getRows(sourceRow, 1));
+                std::uint64_t* pSums(sums.data());
+                for(std::uint32_t scanX(0); scanX != bitmapWidth; ++scanX, pSums += 3)
+                {
+                    std::uint32_t red(0), green(0), blue(0);
+                    const std::uint8_t* pPixel(pRow + (size_t)columnsStart[scanX] * 3);
+                    for(std::uint32_t sourceColumn(columnsStart[scanX]); sourceColumn != columnsEnd[scanX]; ++sourceColumn)
+                    {
+                        red += *pPixel++;
+                        green += *pPixel++;
+                        blue += *pPixel++;
+                    }
+                    pSums[0] += red;
+                    pSums[1] += green;
+                    pSums[2] += blue;
+                }
+            }
+
+            std::uint8_t* pOutput(pBuffer + (size_t)scanY * rowSizeBytes);
+            const std::uint64_t* pSums(sums.data());
+            for(std::uint32_t scanX(0); scanX != bitmapWidth; ++scanX, pSums += 3)
+            {
+                const std::uint64_t area((std::uint64_t)(rowsEnd - rowsStart) * (columnsEnd[scanX] - columnsStart[scanX]));
+                pOutput = storePixel(pOutput,
+                                     (std::uint32_t)((pSums[0] + area / 2) / area),
+                                     (std::uint32_t)((pSums[1] + area / 2) / area),
+                                     (std::uint32_t)((pSums[2] + area / 2) / area),
+                                     drawBitmapType);
+            }
+        }
+
+        return memorySize;
+    }
+
+    // Bilinear filter: the pixels' centers are aligned, the
+    //  weights have 8 bits of precision
+    ///////////////////////////////////////////////////////////
+    std::vector<std::uint32_t> columns0(bitmapWidth), columns1(bitmapWidth), columnsWeight(bitmapWidth);
+    for(std::uint32_t scanX(0); scanX != bitmapWidth; ++scanX)
+    {
+        calculateBilinearPosition(scanX, bitmapWidth, sourceWidth, &(columns0[scanX]), &(columns1[scanX]), &(columnsWeight[scanX]));
+    }
+
+    for(std::uint32_t scanY(0); scanY != bitmapHeight; ++scanY)
+    {
+        std::uint32_t row0, row1, rowWeight;
+        calculateBilinearPosition(scanY, bitmapHeight, sourceHeight, &row0, &row1, &rowWeight);
+
+        const std::uint8_t* pRow0(rows.getRows(row0, row1 - row0 + 1));
+        const std::uint8_t* pRow1(pRow0 + (size_t)(row1 - row0) * sourceWidth * 3);
+
+        std::uint8_t* pOutput(pBuffer + (size_t)scanY * rowSizeBytes);
+        for(std::uint32_t scanX(0); scanX != bitmapWidth; ++scanX)
+        {
+            const std::uint8_t* pPixel00(pRow0 + (size_t)columns0[scanX] * 3);
+            const std::uint8_t* pPixel01(pRow0 + (size_t)columns1[scanX] * 3);
+            const std::uint8_t* pPixel10(pRow1 + (size_t)columns0[scanX] * 3);
+            const std::uint8_t* pPixel11(pRow1 + (size_t)columns1[scanX] * 3);
+            const std::uint32_t columnWeight(columnsWeight[scanX]);
+
+            std::uint32_t channels[3];
+            for(size_t channel(0); channel != 3; ++channel)
+            {
+                const std::uint32_t top((std::uint32_t)pPixel00[channel] * (256 - columnWeight) + (std::uint32_t)pPixel01[channel] * columnWeight);
+                const std::uint32_t bottom((std::uint32_t)pPixel10[channel] * (256 - columnWeight) + (std::uint32_t)pPixel11[channel] * columnWeight);
+                channels[channel] = (top * (256 - rowWeight) + bottom * rowWeight + 32768) >> 16;
+            }
+            pOutput = storePixel(pOutput, channels[0], channels[1], channels[2], drawBitmapType);
+        }
+    }
+
+    return memorySize;
+
+    IMEBRA_FUNCTION_END();
+}
+
+
+///////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////
+//
+//
+// Calculate the 2 source pixels and the weight of the
+//  second one for a bitmap pixel
+//
+//
+///////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////
+void drawBitmap::calculateBilinearPosition(std::uint32_t bitmapPosition, std::uint32_t bitmapSize, std::uint32_t sourceSize, std::uint32_t* pSource0, std::uint32_t* pSource1, std::uint32_t* pWeight1)
+{
+    // position = (bitmapPosition + 0.5) * sourceSize / bitmapSize - 0.5,
+    //  with 8 rounded fractional bits
+    ///////////////////////////////////////////////////////////
+    const std::int64_t numerator((((std::int64_t)bitmapPosition * 2 + 1) * sourceSize - bitmapSize) * 256);
+    if(numerator <= 0)
+    {
+        *pSource0 = *pSource1 = 0;
+        *pWeight1 = 0;
+        return;
+    }
+    const std::int64_t position((numerator + bitmapSize) / ((std::int64_t)bitmapSize * 2));
+
+    *pSource0 = (std::uint32_t)(position >> 8);
+    *pWeight1 = (std::uint32_t)(position & 0xff);
+    if(*pSource0 >= sourceSize - 1)
+    {
+        *pSource0 = *pSource1 = sourceSize - 1;
+        *pWeight1 = 0;
+        return;
+    }
+    *pSource1 = *pSource0 + 1;
+}
+
+
+///////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////
+//
+//
+// Build the chain that converts the image into an 8 bit
+//  RGB image
+//
+//
+///////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////
+void drawBitmap::buildRenderingChain(const std::shared_ptr<const image>& sourceImage, transforms::transformsChain& chain) const
+{
+    IMEBRA_FUNCTION_START();
+
+    chain.addTransform(m_userTransforms);
+
+    // Allocate the transforms that obtain an RGB image
+    ///////////////////////////////////////////////////////////////////////////////
+    std::shared_ptr<const image> chainEndImage(sourceImage);
+    if(!chain.isEmpty())
+    {
+        chainEndImage = chain.allocateOutputImage(sourceImage->getDepth(),
+                                                  sourceImage->getColorSpace(),
+                                                  sourceImage->getHighBit(),
+                                                  sourceImage->getPalette(),
+                                                  1, 1);
+    }
+
+    std::shared_ptr<transforms::colorTransforms::colorTransformsFactory> pColorTransformsFactory(transforms::colorTransforms::colorTransformsFactory::getColorTransformsFactory());
+    std::shared_ptr<transforms::transform> rgbColorTransform(pColorTransformsFactory->getTransform(chainEndImage->getColorSpace(), "RGB"));
+
+    if(rgbColorTransform != 0 && !rgbColorTransform->isEmpty())
+    {
+        chain.addTransform(rgbColorTransform);
+        chainEndImage = chain.allocateOutputImage(sourceImage->getDepth(),
+                                                  sourceImage->getColorSpace(),
+                                                  sourceImage->getHighBit(),
+                                                  sourceImage->getPalette(),
+                                                  1, 1);
+    }
+
+    if(chainEndImage->getHighBit() != 7 || chainEndImage->getDepth() != bitDepth_t::depthU8)
+    {
+        std::shared_ptr<transforms::transformHighBit> highBitTransform(std::make_shared<transforms::transformHighBit>());
+        chain.addTransform(highBitTransform);
+    }
+
+    IMEBRA_FUNCTION_END();
+}
+
+
+///////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////
+//
+//
+// Build the table that maps each value of a single
+//  channel image to its final pixel
+//
+//
+///////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////
+bool drawBitmap::buildPixelTable(const transforms::transformsChain& chain, const std::shared_ptr<const image>& sourceImage, drawBitmapType_t drawBitmapType, std::uint64_t readPixels, std::vector<std::uint32_t>& table, std::int32_t& firstValue) const
+{
+    IMEBRA_FUNCTION_START();
+
+    if(chain.isEmpty() ||
+            transforms::colorTransforms::colorTransformsFactory::getNumberOfChannels(sourceImage->getColorSpace()) != 1)
+    {
+        return false;
+    }
+
+    const bitDepth_t depth(sourceImage->getDepth());
+    std::uint32_t tableSize(0);
+    switch(depth)
+    {
+    case bitDepth_t::depthU8:
+        firstValue = 0;
+        tableSize = 256;
+        break;
+    case bitDepth_t::depthS8:
+        firstValue = -128;
+        tableSize = 256;
+        break;
+    case bitDepth_t::depthU16:
+        firstValue = 0;
+        tableSize = 65536;
+        break;
+    case bitDepth_t::depthS16:
+        firstValue = -32768;
+        tableSize = 65536;
+        break;
+    default:
+        return false;
+    }
+
+    // Building the table is worth only when more pixels
+    //  than the table's size are going to be read
+    ///////////////////////////////////////////////////////////
+    if(readPixels < (std::uint64_t)tableSize)
+    {
+        return false;
+    }
+
+    // Run the transforms on an image that contains all the
+    //  representable values
+    ///////////////////////////////////////////////////////////
+    std::shared_ptr<image> rampImage(std::make_shared<image>(tableSize, 1, depth, sourceImage->getColorSpace(), sourceImage->getHighBit()));
+    rampImage->setPalette(sourceImage->getPalette());
+    {
+        std::shared_ptr<handlers::writingDataHandlerNumericBase> rampHandler(rampImage->getWritingDataHandler());
+        switch(depth)
+        {
+        case bitDepth_t::depthU8:
+            fillRamp((std::uint8_t*)rampHandler->getMemoryBuffer(), firstValue, tableSize);
+            break;
+        case bitDepth_t::depthS8:
+            fillRamp((std::int8_t*)rampHandler->getMemoryBuffer(), firstValue, tableSize);
+            break;
+        case bitDepth_t::depthU16:
+            fillRamp((std::uint16_t*)rampHandler->getMemoryBuffer(), firstValue, tableSize);
+            break;
+        default:
+            fillRamp((std::int16_t*)rampHandler->getMemoryBuffer(), firstValue, tableSize);
+            break;
+        }
+    }
+
+    std::shared_ptr<image> rgbRampImage(std::make_shared<image>(tableSize, 1, bitDepth_t::depthU8, "RGB", 7));
+    chain.runTransform(rampImage, 0, 0, tableSize, 1, rgbRampImage, 0, 0);
+
+    // Pack the output pixels into the table
+    ///////////////////////////////////////////////////////////
+    table.resize(tableSize);
+    std::shared_ptr<handlers::readingDataHandlerNumericBase> rgbRampHandler(rgbRampImage->getReadingDataHandler());
+    const std::uint8_t* pRgb(rgbRampHandler->getMemoryBuffer());
+    const bool bBGR(drawBitmapType == drawBitmapType_t::drawBitmapBGR || drawBitmapType == drawBitmapType_t::drawBitmapBGRA);
+    for(std::uint32_t scanTable(0); scanTable != tableSize; ++scanTable, pRgb += 3)
+    {
+        const std::uint8_t pixel[4] = {
+            bBGR ? pRgb[2] : pRgb[0],
+            pRgb[1],
+            bBGR ? pRgb[0] : pRgb[2],
+            0xff};
+        ::memcpy(&(table[scanTable]), pixel, sizeof(pixel));
+    }
+
+    return true;
+
+    IMEBRA_FUNCTION_END();
+}
+
 
 } // namespace implementation
 
@@ -28,6 +28,7 @@ This file is not included automatically by implementation.h
 
 
 #include <memory>
+#include <vector>
 #include <string.h>
 
 namespace imebra
@@ -36,6 +37,11 @@ namespace imebra
 	namespace implementation
 	{
 
+        namespace transforms
+        {
+            class transformsChain;
+        }
+
 		/// \addtogroup group_helpers Helpers
 		///
 		/// @{
@@ -102,7 +108,68 @@ namespace imebra
 
             size_t getBitmap(const std::shared_ptr<const image>& sourceImage, drawBitmapType_t drawBitmapType, std::uint32_t rowAlignBytes, std::uint8_t* pBuffer, size_t bufferSize);
 
+            /// \brief Renders an area of the image into an RGB or
+            ///         BGR buffer of the specified size.
+            ///
+            /// The area is resized while the transforms are
+            ///  applied: only the rows needed by the filter are
+            ///  transformed and no intermediate image of the whole
+            ///  area is allocated.
+            ///
+            /// @param sourceImage    the image to render
+            /// @param sourceTopLeftX the horizontal coordinate of
+            ///                        the area's top-left corner
+            /// @param sourceTopLeftY the vertical coordinate of
+            ///                        the area's top-left corner
+            /// @param sourceWidth    the area's width
+            /// @param sourceHeight   the area's height
+            /// @param bitmapWidth    the bitmap's width
+            /// @param bitmapHeight   the bitmap's height
+            /// @param filter         the filter used to resize
+            ///                        the area
+            /// @param drawBitmapType The RGB order
+            /// @param rowAlignBytes  the boundary alignment of each
+            ///                         row
+            /// @return the memory object in which the output buffer
+            ///          is stored.
+            ///
+            ///////////////////////////////////////////////////////////
+            std::shared_ptr<memory> getBitmap(
+                    const std::shared_ptr<const image>& sourceImage,
+                    std::uint32_t sourceTopLeftX, std::uint32_t sourceTopLeftY, std::uint32_t sourceWidth, std::uint32_t sourceHeight,
+                    std::uint32_t bitmapWidth, std::uint32_t bitmapHeight,
+                    drawBitmapFilter_t filter,
+                    drawBitmapType_t drawBitmapType, std::uint32_t rowAlignBytes);
+
+            size_t getBitmap(
+                    const std::shared_ptr<const image>& sourceImage,
+                    std::uint32_t sourceTopLeftX, std::uint32_t sourceTopLeftY, std::uint32_t sourceWidth, std::uint32_t sourceHeight,
+                    std::uint32_t bitmapWidth, std::uint32_t bitmapHeight,
+                    drawBitmapFilter_t filter,
+                    drawBitmapType_t drawBitmapType, std::uint32_t rowAlignBytes,
+                    std::uint8_t* pBuffer, size_t bufferSize);
+
 		protected:
+            // Fill the chain with the user transforms and the
+            //  transforms that convert the image to 8 bit RGB
+            ///////////////////////////////////////////////////////////
+            void buildRenderingChain(const std::shared_ptr<const image>& sourceImage, transforms::transformsChain& chain) const;
+
+            // Images with one channel and up to 16 bits per pixel
+            //  can be rendered through a table: the transforms are
+            //  applied to all the representable values once, then
+            //  the pixels are mapped through the table.
+            // Returns false if the image cannot be rendered this
+            //  way or if reading readPixels pixels costs less than
+            //  building the table.
+            ///////////////////////////////////////////////////////////
+            bool buildPixelTable(const transforms::transformsChain& chain, const std::shared_ptr<const image>& sourceImage, drawBitmapType_t drawBitmapType, std::uint64_t readPixels, std::vector<std::uint32_t>& table, std::int32_t& firstValue) const;
+
+            // Calculate the position of a bitmap pixel in the
+            //  source area for the bilinear filter
+            ///////////////////////////////////////////////////////////
+            static void calculateBilinearPosition(std::uint32_t bitmapPosition, std::uint32_t bitmapSize, std::uint32_t sourceSize, std::uint32_t* pSource0, std::uint32_t* pSource1, std::uint32_t* pWeight1);
+
             // Transform that calculates an 8 bit per channel RGB image
             std::shared_ptr<transforms::transform> m_userTransforms;
 		};
@@ -24,6 +24,13 @@ If you do not want to be bound by the GPL terms (such as the requirement
 #include <errno.h>
 #include <locale>
 #include <codecvt>
+#include <limits>
+
+#if defined(IMEBRA_POSIX)
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#endif
 
 
 namespace imebra
@@ -164,6 +171,25 @@ fileStream::~fileStream()
 }
 
 
+///////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////
+//
+//
+// Move the file position (64 bit offsets)
+//
+//
+///////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////
+void fileStream::seek(size_t position) const
+{
+#if defined(IMEBRA_WINDOWS)
+    ::_fseeki64(m_openFile, (__int64)position, SEEK_SET);
+#else
+    ::fseeko(m_openFile, (off_t)position, SEEK_SET);
+#endif
+}
+
+
 ///////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////
 //
@@ -205,7 +231,7 @@ void fileStreamOutput::write(size_t startPosition, const std::uint8_t* pBuffer,
 
     std::lock_guard<std::mutex> lock(m_mutex);
 
-    ::fseek(m_openFile, (long)startPosition, SEEK_SET);
+    seek(startPosition);
     if(ferror(m_openFile) != 0)
     {
         IMEBRA_THROW(StreamWriteError, "stream::seek failure");
@@ -233,9 +259,42 @@ size_t fileStreamInput::read(size_t startPosition, std::uint8_t* pBuffer, size_t
 {
     IMEBRA_FUNCTION_START();
 
+#if defined(IMEBRA_POSIX)
+
+    // pread doesn't move the file position, so concurrent
+    //  reads don't need to be serialized
+    ///////////////////////////////////////////////////////////
+    if((std::uint64_t)startPosition > (std::uint64_t)std::numeric_limits<off_t>::max())
+    {
+        return 0;
+    }
+
+    const int fileDescriptor(::fileno(m_openFile));
+    size_t readBytes(0);
+    while(readBytes != bufferLength)
+    {
+        ssize_t partialRead(::pread(fileDescriptor, pBuffer + readBytes, bufferLength - readBytes, (off_t)(startPosition + readBytes)));
+        if(partialRead == 0)
+        {
+            break;
+        }
+        if(partialRead < 0)
+        {
+            if(errno == EINTR)
+            {
+                continue;
+            }
+            IMEBRA_THROW(StreamReadError, "stream::pread failure - error code: " << errno);
+        }
+        readBytes += (size_t)partialRead;
+    }
+    return readBytes;
+
+#else
+
     std::lock_guard<std::mutex> lock(m_mutex);
 
-    ::fseek(m_openFile, (long)startPosition, SEEK_SET);
+    seek(startPosition);
     if(ferror(m_openFile) != 0)
     {
         IMEBRA_THROW(StreamReadError, "stream::fseek failure");
@@ -248,6 +307,8 @@ size_t fileStreamInput::read(size_t startPosition, std::uint8_t* pBuffer, size_t
     }
     return readBytes;
 
+#endif
+
     IMEBRA_FUNCTION_END();
 }
 
@@ -265,15 +326,27 @@ size_t fileStreamInput::getSize() const
 {
     IMEBRA_FUNCTION_START();
 
+#if defined(IMEBRA_POSIX)
+
+    struct stat fileStatus;
+    if(::fstat(::fileno(m_openFile), &fileStatus) != 0)
+    {
+        IMEBRA_THROW(StreamReadError, "stream::fstat failure - error code: " << errno);
+    }
+
+    return (size_t)fileStatus.st_size;
+
+#else
+
     std::lock_guard<std::mutex> lock(m_mutex);
 
-    ::fseek(m_openFile, 0, SEEK_END);
+    ::_fseeki64(m_openFile, 0, SEEK_END);
     if(ferror(m_openFile) != 0)
     {
         IMEBRA_THROW(StreamReadError, "stream::fseek failure");
     }
 
-    long int position = ::ftell(m_openFile);
+    __int64 position = ::_ftelli64(m_openFile);
     if(position < 0)
     {
         IMEBRA_THROW(StreamReadError, "stream::ftell failure");
@@ -281,6 +354,8 @@ size_t fileStreamInput::getSize() const
 
     return (size_t)position;
 
+#endif
+
     IMEBRA_FUNCTION_END();
 
 }
@@ -47,6 +47,10 @@ public:
     virtual ~fileStream();
 
 protected:
+    // Move the file position. m_mutex must be locked
+    ///////////////////////////////////////////////////////////
+    void seek(size_t position) const;
+
     FILE* m_openFile;
     mutable std::mutex m_mutex;
 };
@@ -59,6 +63,11 @@ protected:
 /// This class can be used to read/write on physical files
 ///  in the mass storage.
 ///
+/// On POSIX systems the data is read with pread(), which
+///  doesn't move the file position: several threads can
+///  read from the same stream without serializing on
+///  m_mutex.
+///
 ///////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////
 class fileStreamInput : public baseStreamInput, public fileStream
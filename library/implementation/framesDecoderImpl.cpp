@@ -0,0 +1,242 @@
+/*
+Copyright 2005 - 2017 by Paolo Brandoli/Binarno s.p.
+
+Imebra is available for free under the GNU General Public License.
+
+The full text of the license is available in the file license.rst
+ in the project root folder.
+
+If you do not want to be bound by the GPL terms (such as the requirement
+ that your application must also be GPL), you may purchase a commercial
+ license for Imebra from the Imebra’s website (http://imebra.com).
+*/
+
+/*! \file framesDecoderImpl.cpp
+    \brief Implementation of the class that decodes several frames of a
+            dataset in parallel.
+
+*/
+
+#include "framesDecoderImpl.h"
+#include "threadPoolImpl.h"
+#include "exceptionImpl.h"
+#include "../include/imebra/exceptions.h"
+
+namespace imebra
+{
+
+namespace implementation
+{
+
+///////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////
+//
+//
+// Constructor
+//
+//
+///////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////
+framesDecoder::framesDecoder(std::uint32_t firstFrame, const std::vector<tFrameDecoder>& frameDecoders, size_t maxThreads):
+    m_firstFrame(firstFrame), m_pState(std::make_shared<decodingState>())
+{
+    IMEBRA_FUNCTION_START();
+
+    m_pState->m_nextFrame = 0;
+    m_pState->m_bCancel = false;
+    m_pState->m_frames.resize(frameDecoders.size());
+    for(size_t scanFrames(0); scanFrames != frameDecoders.size(); ++scanFrames)
+    {
+        m_pState->m_frames[scanFrames].m_decoder = frameDecoders[scanFrames];
+        m_pState->m_frames[scanFrames].m_status = frameStatus_t::pending;
+    }
+
+    // Queue one job per thread: each job decodes the frames
+    //  in order until none is left
+    ///////////////////////////////////////////////////////////
+    std::shared_ptr<threadPool> pThreadPool(threadPool::getThreadPool());
+    size_t jobs(pThreadPool->getMaximumParallelism() - 1);
+    if(maxThreads != 0 && maxThreads < jobs)
+    {
+        jobs = maxThreads;
+    }
+    if(frameDecoders.size() < jobs)
+    {
+        jobs = frameDecoders.size();
+    }
+
+    std::shared_ptr<decodingState> pState(m_pState);
+    for(size_t queueJobs(0); queueJobs != jobs; ++queueJobs)
+    {
+        pThreadPool->execute([pState](){ decodePendingFrames(pState); });
+    }
+
+    IMEBRA_FUNCTION_END();
+}
+
+
+///////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////
+//
+//
+// Destructor
+//
+//
+///////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////
+framesDecoder::~framesDecoder()
+{
+    std::lock_guard<std::mutex> lock(m_pState->m_lock);
+    m_pState->m_bCancel = true;
+}
+
+
+///////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////
+//
+//
+// Return the first frame
+//
+//
+///////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////
+std::uint32_t framesDecoder::getFirstFrame() const
+{
+    return m_firstFrame;
+}
+
+
+///////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////
+//
+//
+// Return the number of frames
+//
+//
+///////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////
+std::uint32_t framesDecoder::getFramesCount() const
+{
+    return static_cast<std::uint32_t>(m_pState->m_frames.size());
+}
+
+
+///////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////
+//
+//
+// Return a decoded frame
+//
+//
+///////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////
+std::shared_ptr<image> framesDecoder::getImage(std::uint32_t frameNumber)
+{
+    IMEBRA_FUNCTION_START();
+
+    if(frameNumber < m_firstFrame || frameNumber - m_firstFrame >= m_pState->m_frames.size())
+    {
+        IMEBRA_THROW(DataSetImageDoesntExistError, "The requested image doesn't exist");
+    }
+    const size_t frameIndex(frameNumber - m_firstFrame);
+
+    decodingState& state(*m_pState);
+    std::unique_lock<std::mutex> lock(state.m_lock);
+
+    // Decode the frame in this thread if the pool hasn't
+    //  picked it up yet
+    ///////////////////////////////////////////////////////////
+    if(state.m_frames[frameIndex].m_status == frameStatus_t::pending)
+    {
+        state.m_frames[frameIndex].m_status = frameStatus_t::decoding;
+        lock.unlock();
+        decodeFrame(state, frameIndex);
+        lock.lock();
+    }
+
+    state.m_frameDecoded.wait(lock, [&state, frameIndex](){ return state.m_frames[frameIndex].m_status == frameStatus_t::decoded; });
+
+    if(state.m_frames[frameIndex].m_pException)
+    {
+        std::rethrow_exception(state.m_frames[frameIndex].m_pException);
+    }
+
+    return state.m_frames[frameIndex].m_pImage;
+
+    IMEBRA_FUNCTION_END();
+}
+
+
+///////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////
+//
+//
+// Decode one frame
+//
+//
+///////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////
+void framesDecoder::decodeFrame(decodingState& state, size_t frameIndex)
+{
+    // Only the thread that set the status to "decoding"
+    //  accesses the decoder
+    ///////////////////////////////////////////////////////////
+    frame& decodedFrame(state.m_frames[frameIndex]);
+    std::shared_ptr<image> pImage;
+    std::exception_ptr pException;
+    try
+    {
+        pImage = decodedFrame.m_decoder();
+    }
+    catch(...)
+    {
+        pException = std::current_exception();
+    }
+    tFrameDecoder releaseDecoder;
+    releaseDecoder.swap(decodedFrame.m_decoder);
+
+    {
+        std::lock_guard<std::mutex> lock(state.m_lock);
+        decodedFrame.m_pImage = pImage;
+        decodedFrame.m_pException = pException;
+        decodedFrame.m_status = frameStatus_t::decoded;
+    }
+    state.m_frameDecoded.notify_all();
+}
+
+
+///////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////
+//
+//
+// Decode the pending frames in order
+//
+//
+///////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////
+void framesDecoder::decodePendingFrames(const std::shared_ptr<decodingState>& pState)
+{
+    decodingState& state(*pState);
+    for(;;)
+    {
+        size_t frameIndex;
+        {
+            std::lock_guard<std::mutex> lock(state.m_lock);
+            while(state.m_nextFrame != state.m_frames.size() && state.m_frames[state.m_nextFrame].m_status != frameStatus_t::pending)
+            {
+                ++state.m_nextFrame;
+            }
+            if(state.m_bCancel || state.m_nextFrame == state.m_frames.size())
+            {
+                return;
+            }
+            frameIndex = state.m_nextFrame++;
+            state.m_frames[frameIndex].m_status = frameStatus_t::decoding;
+        }
+        decodeFrame(state, frameIndex);
+    }
+}
+
+} // namespace implementation
+
+} // namespace imebra
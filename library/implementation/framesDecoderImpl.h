@@ -0,0 +1,149 @@
+/*
+Copyright 2005 - 2017 by Paolo Brandoli/Binarno s.p.
+
+Imebra is available for free under the GNU General Public License.
+
+The full text of the license is available in the file license.rst
+ in the project root folder.
+
+If you do not want to be bound by the GPL terms (such as the requirement
+ that your application must also be GPL), you may purchase a commercial
+ license for Imebra from the Imebra’s website (http://imebra.com).
+*/
+
+/*! \file framesDecoderImpl.h
+    \brief Declaration of the class that decodes several frames of a
+            dataset in parallel.
+
+*/
+
+#if !defined(imebraFramesDecoder_2B9C7E14_5A0D_4F63_9E81_C47D3A6B0F25__INCLUDED_)
+#define imebraFramesDecoder_2B9C7E14_5A0D_4F63_9E81_C47D3A6B0F25__INCLUDED_
+
+#include <memory>
+#include <functional>
+#include <vector>
+#include <mutex>
+#include <condition_variable>
+#include <exception>
+#include <cstdint>
+
+namespace imebra
+{
+
+namespace implementation
+{
+
+class image;
+
+///////////////////////////////////////////////////////////
+/// \brief Decodes a range of frames in the background
+///        and returns them in order.
+///
+/// The frames are decoded by the library's thread pool
+///  in ascending order, so the first frames become
+///  available while the next ones are still being
+///  decoded.
+///
+/// When getImage() requests a frame that hasn't been
+///  picked up by the pool yet then the frame is decoded
+///  by the calling thread.
+///
+///////////////////////////////////////////////////////////
+class framesDecoder
+{
+public:
+    /// \brief Function that decodes one frame. It must not
+    ///         access the dataset.
+    ///
+    ///////////////////////////////////////////////////////////
+    typedef std::function<std::shared_ptr<image>()> tFrameDecoder;
+
+    /// \brief Constructor. Starts decoding the frames.
+    ///
+    /// \param firstFrame    the number of the first frame
+    /// \param frameDecoders the functions that decode the
+    ///                      frames, in order
+    /// \param maxThreads    the maximum number of pool
+    ///                      threads used to decode the
+    ///                      frames. 0 means all the pool
+    ///                      threads
+    ///
+    ///////////////////////////////////////////////////////////
+    framesDecoder(std::uint32_t firstFrame, const std::vector<tFrameDecoder>& frameDecoders, size_t maxThreads);
+
+    /// \brief Destructor. The frames not yet started are
+    ///        not decoded.
+    ///
+    ///////////////////////////////////////////////////////////
+    ~framesDecoder();
+
+    /// \brief Return the number of the first frame.
+    ///
+    ///////////////////////////////////////////////////////////
+    std::uint32_t getFirstFrame() const;
+
+    /// \brief Return the number of frames.
+    ///
+    ///////////////////////////////////////////////////////////
+    std::uint32_t getFramesCount() const;
+
+    /// \brief Return a decoded frame, waiting until it is
+    ///        available.
+    ///
+    /// If the decoding of the frame failed then rethrows
+    ///  the decoder's exception.
+    ///
+    /// \param frameNumber the frame number (not relative to
+    ///                    the first frame)
+    /// \return the decoded frame
+    ///
+    ///////////////////////////////////////////////////////////
+    std::shared_ptr<image> getImage(std::uint32_t frameNumber);
+
+private:
+    enum class frameStatus_t
+    {
+        pending,
+        decoding,
+        decoded
+    };
+
+    struct frame
+    {
+        tFrameDecoder m_decoder;
+        frameStatus_t m_status;
+        std::shared_ptr<image> m_pImage;
+        std::exception_ptr m_pException;
+    };
+
+    // State shared with the jobs running in the thread pool
+    ///////////////////////////////////////////////////////////
+    struct decodingState
+    {
+        std::mutex m_lock;
+        std::condition_variable m_frameDecoded;
+        std::vector<frame> m_frames;
+        size_t m_nextFrame;
+        bool m_bCancel;
+    };
+
+    // Decode one frame, then mark it as decoded.
+    // m_lock must not be held
+    ///////////////////////////////////////////////////////////
+    static void decodeFrame(decodingState& state, size_t frameIndex);
+
+    // Decode the pending frames in order until none is left
+    ///////////////////////////////////////////////////////////
+    static void decodePendingFrames(const std::shared_ptr<decodingState>& pState);
+
+    const std::uint32_t m_firstFrame;
+
+    std::shared_ptr<decodingState> m_pState;
+};
+
+} // namespace implementation
+
+} // namespace imebra
+
+#endif // !defined(imebraFramesDecoder_2B9C7E14_5A0D_4F63_9E81_C47D3A6B0F25__INCLUDED_)
@@ -92,6 +92,8 @@ void huffmanTable::reset()
     m_valuesToHuffmanLength.resize(m_numValues);
     ::memset(&(m_valuesToHuffmanLength[0]), 0, m_numValues*sizeof(m_valuesToHuffmanLength[0]));
 
+    m_lookupTable.clear();
+
     m_valuesPerLength.fill(0);
     m_firstValidLength = 0;
     m_firstMinValue = 0xffffffff;
@@ -332,6 +334,13 @@ void huffmanTable::calcHuffmanTables()
     m_firstMinValue = 0xffffffff;
     m_firstMaxValue = 0xffffffff;
     m_firstValidLength = 0;
+
+    // Entries not filled below are resolved by the slow path
+    //  in readHuffmanCode()
+    ///////////////////////////////////////////////////////////
+    const size_t lookupBits(IMEBRA_HUFFMAN_LOOKUP_BITS);
+    m_lookupTable.assign((size_t)1 << lookupBits, lookupEntry());
+
     for(size_t codeLength = 1; codeLength != m_valuesPerLength.size(); ++codeLength)
     {
         if(m_valuesPerLength[codeLength] != 0 && m_firstValidLength == 0)
@@ -347,6 +356,39 @@ void huffmanTable::calcHuffmanTables()
             m_maxValuePerLength[codeLength]=huffmanCode;
             m_valuesToHuffman[m_orderedValues[valueIndex]]=huffmanCode;
             m_valuesToHuffmanLength[m_orderedValues[valueIndex]] = codeLength;
+
+            // Fill all the lookup entries that begin with this
+            //  code
+            ///////////////////////////////////////////////////////////
+            if(codeLength <= lookupBits && (huffmanCode >> codeLength) == 0)
+            {
+                const std::uint32_t value(m_orderedValues[valueIndex]);
+                const size_t amplitudeLength(value & 0xf);
+                const size_t suffixLength(lookupBits - codeLength);
+                const size_t firstEntry((size_t)huffmanCode << suffixLength);
+                for(size_t suffix(0); suffix != ((size_t)1 << suffixLength); ++suffix)
+                {
+                    lookupEntry& entry(m_lookupTable[firstEntry + suffix]);
+                    entry.m_value = (std::uint16_t)value;
+                    entry.m_codeLength = (std::uint8_t)codeLength;
+                    if(amplitudeLength > suffixLength)
+                    {
+                        continue;
+                    }
+                    std::int32_t amplitude(0);
+                    if(amplitudeLength != 0)
+                    {
+                        amplitude = (std::int32_t)((suffix >> (suffixLength - amplitudeLength)) & (((size_t)1 << amplitudeLength) - 1));
+                        if(amplitude < ((std::int32_t)1 << (amplitudeLength - 1)))
+                        {
+                            amplitude -= ((std::int32_t)1 << amplitudeLength) - 1;
+                        }
+                    }
+                    entry.m_amplitude = amplitude;
+                    entry.m_totalLength = (std::uint8_t)(codeLength + amplitudeLength);
+                }
+            }
+
             ++valueIndex;
             ++huffmanCode;
         }
@@ -373,6 +415,18 @@ void huffmanTable::calcHuffmanTables()
 ///////////////////////////////////////////////////////////
 std::uint32_t huffmanTable::readHuffmanCode(codecs::jpegStreamReader& stream)
 {
+    // Fast path: the code is resolved by the lookup table
+    ///////////////////////////////////////////////////////////
+    if(!m_lookupTable.empty())
+    {
+        const lookupEntry& entry(m_lookupTable[stream.peekBits(IMEBRA_HUFFMAN_LOOKUP_BITS)]);
+        if(entry.m_codeLength != 0 && entry.m_codeLength <= stream.availableBits())
+        {
+            stream.skipBits(entry.m_codeLength);
+            return entry.m_value;
+        }
+    }
+
     IMEBRA_FUNCTION_START();
 
     // Read initial number of bits
@@ -433,6 +487,54 @@ std::uint32_t huffmanTable::readHuffmanCode(codecs::jpegStreamReader& stream)
 }
 
 
+///////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////
+//
+//
+// Read an Huffman code and the following amplitude
+//
+//
+///////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////
+std::uint32_t huffmanTable::readHuffmanCodeAndAmplitude(codecs::jpegStreamReader& stream, std::int32_t* pAmplitude)
+{
+    // Fast path: code and amplitude are resolved by the
+    //  lookup table
+    ///////////////////////////////////////////////////////////
+    if(!m_lookupTable.empty())
+    {
+        const lookupEntry& entry(m_lookupTable[stream.peekBits(IMEBRA_HUFFMAN_LOOKUP_BITS)]);
+        if(entry.m_totalLength != 0 && entry.m_totalLength <= stream.availableBits())
+        {
+            stream.skipBits(entry.m_totalLength);
+            *pAmplitude = entry.m_amplitude;
+            return entry.m_value;
+        }
+    }
+
+    IMEBRA_FUNCTION_START();
+
+    const std::uint32_t value(readHuffmanCode(stream));
+
+    const std::uint32_t amplitudeLength(value & 0xf);
+    if(amplitudeLength == 0)
+    {
+        *pAmplitude = 0;
+        return value;
+    }
+
+    std::int32_t amplitude((std::int32_t)stream.readBits(amplitudeLength));
+    if(amplitude < ((std::int32_t)1 << (amplitudeLength - 1)))
+    {
+        amplitude -= ((std::int32_t)1 << amplitudeLength) - 1;
+    }
+    *pAmplitude = amplitude;
+    return value;
+
+    IMEBRA_FUNCTION_END();
+}
+
+
 ///////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////
 //
@@ -25,6 +25,11 @@ If you do not want to be bound by the GPL terms (such as the requirement
 #include <array>
 #include <limits>
 
+// Number of bits used to index the fast lookup table used
+//  by readHuffmanCode() and readHuffmanCodeAndAmplitude()
+#if(!defined IMEBRA_HUFFMAN_LOOKUP_BITS)
+    #define IMEBRA_HUFFMAN_LOOKUP_BITS 10
+#endif
 
 namespace imebra
 {
@@ -174,6 +179,10 @@ public:
     /// \brief Read and decode an huffman code from the
     ///         specified stream.
     ///
+    /// The codes not longer than IMEBRA_HUFFMAN_LOOKUP_BITS
+    ///  are resolved with a single table lookup, the longer
+    ///  ones are decoded one length at a time.
+    ///
     /// The function throws a huffmanExceptionRead exception
     ///  if the read code cannot be decoded.
     ///
@@ -183,6 +192,27 @@ public:
     ///////////////////////////////////////////////////////////
     std::uint32_t readHuffmanCode(codecs::jpegStreamReader& stream);
 
+    /// \brief Read and decode an huffman code and the
+    ///         amplitude bits that follow it.
+    ///
+    /// The 4 least significant bits of the decoded value
+    ///  specify the length of the amplitude, as in the jpeg
+    ///  lossy DC and AC coefficients.
+    ///
+    /// When the code and the amplitude bits fit in
+    ///  IMEBRA_HUFFMAN_LOOKUP_BITS then both are resolved with
+    ///  a single table lookup.
+    ///
+    /// @param stream     the stream reader used to read the
+    ///                    code
+    /// @param pAmplitude a pointer to the variable that
+    ///                    receives the amplitude (0 when
+    ///                    the amplitude length is 0)
+    /// @return the decoded value
+    ///
+    ///////////////////////////////////////////////////////////
+    std::uint32_t readHuffmanCodeAndAmplitude(codecs::jpegStreamReader& stream, std::int32_t* pAmplitude);
+
     /// \brief Write an huffman code to the specified stream.
     ///
     /// The function throws a huffmanExceptionWrite exception
@@ -263,6 +293,17 @@ private:
     std::vector<std::uint32_t> m_valuesToHuffman;
     std::vector<size_t> m_valuesToHuffmanLength;
 
+    // Lookup table indexed by the next
+    //  IMEBRA_HUFFMAN_LOOKUP_BITS bits in the stream
+    struct lookupEntry
+    {
+        std::int32_t m_amplitude;   // Decoded amplitude
+        std::uint16_t m_value;      // Decoded value
+        std::uint8_t m_codeLength;  // Code length, 0 if the code is longer than the lookup bits
+        std::uint8_t m_totalLength; // Code + amplitude length, 0 if longer than the lookup bits
+    };
+    std::vector<lookupEntry> m_lookupTable;
+
 };
 
 } // namespace implementation
@@ -22,6 +22,8 @@ If you do not want to be bound by the GPL terms (such as the requirement
 #include "dataHandlerNumericImpl.h"
 #include "exceptionImpl.h"
 #include <string.h>
+#include <algorithm>
+#include <vector>
 
 
 namespace imebra
@@ -33,6 +35,73 @@ namespace implementation
 namespace codecs
 {
 
+namespace
+{
+
+///////////////////////////////////////////////////////////
+//
+// Shrink interleaved samples by averaging (or picking
+//  the top-left sample of) each scale x scale group
+//
+///////////////////////////////////////////////////////////
+template<class samplesType_t>
+void scaleSamples(const samplesType_t* pSource, size_t /* sourceSize */, std::uint32_t width, std::uint32_t height, std::uint32_t channels, std::uint32_t scale, bool bSubsample, std::uint8_t* pDestinationMemory)
+{
+    samplesType_t* pDestination(reinterpret_cast<samplesType_t*>(pDestinationMemory));
+    const std::uint32_t scaledWidth((width + scale - 1) / scale);
+    const std::uint32_t scaledHeight((height + scale - 1) / scale);
+
+    std::vector<std::int64_t> sums((size_t)scaledWidth * channels);
+
+    for(std::uint32_t scaledY(0); scaledY != scaledHeight; ++scaledY)
+    {
+        const std::uint32_t firstRow(scaledY * scale);
+        const std::uint32_t endRow(std::min(firstRow + scale, height));
+
+        if(bSubsample)
+        {
+            const samplesType_t* pRow(pSource + (size_t)firstRow * width * channels);
+            for(std::uint32_t scaledX(0); scaledX != scaledWidth; ++scaledX)
+            {
+                const samplesType_t* pPixel(pRow + (size_t)scaledX * scale * channels);
+                for(std::uint32_t channel(0); channel != channels; ++channel)
+                {
+                    *pDestination++ = *pPixel++;
+                }
+            }
+            continue;
+        }
+
+        std::fill(sums.begin(), sums.end(), 0);
+        for(std::uint32_t row(firstRow); row != endRow; ++row)
+        {
+            const samplesType_t* pRow(pSource + (size_t)row * width * channels);
+            for(std::uint32_t column(0); column != width; ++column)
+            {
+                std::int64_t* pSums(&(sums[(size_t)(column / scale) * channels]));
+                for(std::uint32_t channel(0); channel != channels; ++channel)
+                {
+                    *pSums++ += (std::int64_t)*pRow++;
+                }
+            }
+        }
+
+        const std::int64_t* pSums(sums.data());
+        for(std::uint32_t scaledX(0); scaledX != scaledWidth; ++scaledX)
+        {
+            const std::uint32_t firstColumn(scaledX * scale);
+            const std::int64_t area((std::int64_t)(endRow - firstRow) * (std::int64_t)(std::min(firstColumn + scale, width) - firstColumn));
+            for(std::uint32_t channel(0); channel != channels; ++channel)
+            {
+                const std::int64_t sum(*pSums++);
+                *pDestination++ = (samplesType_t)((sum >= 0 ? sum + area / 2 : sum - area / 2) / area);
+            }
+        }
+    }
+}
+
+} // anonymous namespace
+
 
 std::vector<std::shared_ptr<channel>> imageCodec::allocChannels(std::uint32_t channelsNumber, std::uint32_t width, std::uint32_t height, bool bSubSampledX, bool bSubSampledY)
 {
@@ -175,6 +244,92 @@ void channel::allocate(std::uint32_t width, std::uint32_t height)
     IMEBRA_FUNCTION_END();
 }
 
+
+///////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////
+//
+//
+// Decode the image at full resolution, then shrink it
+//
+//
+///////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////
+std::shared_ptr<image> imageCodec::getScaledImage(const std::string& transferSyntax,
+                                                  const std::string& colorSpace,
+                                                  std::uint32_t channelsNumber,
+                                                  std::uint32_t imageWidth,
+                                                  std::uint32_t imageHeight,
+                                                  bool bSubsampledX,
+                                                  bool bSubsampledY,
+                                                  bool bInterleaved,
+                                                  bool b2Complement,
+                                                  std::uint8_t allocatedBits,
+                                                  std::uint8_t storedBits,
+                                                  std::uint8_t highBit,
+                                                  imageScale_t scale,
+                                                  std::shared_ptr<streamReader> pSourceStream) const
+{
+    IMEBRA_FUNCTION_START();
+
+    return scaleImage(getImage(transferSyntax,
+                               colorSpace,
+                               channelsNumber,
+                               imageWidth,
+                               imageHeight,
+                               bSubsampledX,
+                               bSubsampledY,
+                               bInterleaved,
+                               b2Complement,
+                               allocatedBits,
+                               storedBits,
+                               highBit,
+                               pSourceStream), scale);
+
+    IMEBRA_FUNCTION_END();
+}
+
+
+///////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////
+//
+//
+// Shrink an image
+//
+//
+///////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////
+std::shared_ptr<image> imageCodec::scaleImage(const std::shared_ptr<image>& pImage, imageScale_t scale)
+{
+    IMEBRA_FUNCTION_START();
+
+    if(scale == imageScale_t::full)
+    {
+        return pImage;
+    }
+
+    const std::uint32_t scaleFactor((std::uint32_t)scale);
+    std::uint32_t width, height;
+    pImage->getSize(&width, &height);
+
+    std::shared_ptr<image> pScaledImage(std::make_shared<image>(
+                                            (width + scaleFactor - 1) / scaleFactor,
+                                            (height + scaleFactor - 1) / scaleFactor,
+                                            pImage->getDepth(),
+                                            pImage->getColorSpace(),
+                                            pImage->getHighBit()));
+    pScaledImage->setPalette(pImage->getPalette());
+
+    const bool bSubsample(pImage->getColorSpace() == "PALETTE COLOR");
+
+    std::shared_ptr<handlers::readingDataHandlerNumericBase> pSourceHandler(pImage->getReadingDataHandler());
+    std::shared_ptr<handlers::writingDataHandlerNumericBase> pDestinationHandler(pScaledImage->getWritingDataHandler());
+    HANDLER_CALL_TEMPLATE_FUNCTION_WITH_PARAMS(scaleSamples, pSourceHandler, width, height, pImage->getChannelsNumber(), scaleFactor, bSubsample, pDestinationHandler->getMemoryBuffer());
+
+    return pScaledImage;
+
+    IMEBRA_FUNCTION_END();
+}
+
 } // namespace codecs
 
 } // namespace implementation
@@ -134,6 +134,41 @@ public:
                                             std::uint8_t highBit,
                                             std::shared_ptr<streamReader> pSourceStream) const = 0;
 
+    /// \brief Get a decompressed image at a reduced
+    ///        resolution.
+    ///
+    /// The returned image's size is the original size
+    ///  divided by the scale factor, rounded up; each pixel
+    ///  is the average of the pixels it covers.
+    ///
+    /// The default implementation decompresses the image
+    ///  at full resolution with getImage() and then
+    ///  shrinks it: codecs that can decode directly at a
+    ///  lower resolution override this function.
+    ///
+    /// The parameters are the same ones used by getImage(),
+    ///  with the addition of:
+    ///
+    /// @param scale the scale at which the image must be
+    ///              decoded
+    /// @return a pointer to the loaded image
+    ///
+    ///////////////////////////////////////////////////////////
+    virtual std::shared_ptr<image> getScaledImage(const std::string& transferSyntax,
+                                                  const std::string& colorSpace,
+                                                  std::uint32_t channelsNumber,
+                                                  std::uint32_t imageWidth,
+                                                  std::uint32_t imageHeight,
+                                                  bool bSubsampledX,
+                                                  bool bSubsampledY,
+                                                  bool bInterleaved,
+                                                  bool b2Complement,
+                                                  std::uint8_t allocatedBits,
+                                                  std::uint8_t storedBits,
+                                                  std::uint8_t highBit,
+                                                  imageScale_t scale,
+                                                  std::shared_ptr<streamReader> pSourceStream) const;
+
     ///
     /// \brief Return the default planar configuration.
     ///
@@ -273,6 +308,19 @@ public:
             bitDepth_t samplesDepth,
             size_t numSamples);
 
+    /// \brief Shrink an image by averaging the pixels.
+    ///
+    /// Palette images are subsampled instead, because the
+    ///  average of the palette indexes is meaningless.
+    ///
+    /// @param pImage the image to shrink
+    /// @param scale  the scale factor
+    /// @return the shrunk image, or pImage if scale is
+    ///         imageScale_t::full
+    ///
+    ///////////////////////////////////////////////////////////
+    static std::shared_ptr<image> scaleImage(const std::shared_ptr<image>& pImage, imageScale_t scale);
+
 };
 
 class channel
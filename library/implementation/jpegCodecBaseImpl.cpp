@@ -138,6 +138,8 @@ jpegChannel::jpegChannel():
         m_blockMcuXY(0),
         m_lastDCValue(0),
         m_defaultDCValue(0),
+        m_scaleShiftX(0),
+        m_scaleShiftY(0),
         m_losslessPositionX(0),
         m_losslessPositionY(0),
         m_unprocessedAmplitudesCount(0),
@@ -345,6 +347,7 @@ void jpegInformation::reset(imageQuality_t compQuality)
     m_spectralIndexEnd = 63;
 
     m_bLossless = false;
+    m_bProgressive = false;
 
     // The number of MCUs (horizontal, vertical, total)
     ///////////////////////////////////////////////////////////
@@ -363,6 +366,10 @@ void jpegInformation::reset(imageQuality_t compQuality)
     m_jpegImageWidth = 0;
     m_jpegImageHeight = 0;
 
+    m_scaleShift = 0;
+
+    m_simdInstructions = getSimdInstructions();
+
     // Reset the QT tables
     ///////////////////////////////////////////////////////////
     for(int resetQT = 0; resetQT<16; ++resetQT)
@@ -463,17 +470,35 @@ void jpegInformation::allocChannels()
         m_jpegImageHeight*=(m_maxSamplingFactorY<<3);
     }
 
-    // Allocate the channels' buffers
+    // Allocate the channels' buffers. The lossy images
+    //  decoded at a reduced resolution need smaller buffers.
+    // The subsampled channels are reduced less, so their
+    //  resolution is preserved as long as possible.
+    // The progressive images spread the coefficients of each
+    //  block across several scans, so they are decoded at
+    //  full resolution
     ///////////////////////////////////////////////////////////
+    const std::uint32_t scaleShift((m_bLossless || m_bProgressive) ? 0 : m_scaleShift);
     for(tChannelsMap::iterator channelsIterator1=m_channelsMap.begin(); channelsIterator1 != m_channelsMap.end(); ++channelsIterator1)
     {
         std::shared_ptr<jpeg::jpegChannel> pChannel=channelsIterator1->second;
         pChannel->m_defaultDCValue = m_bLossless ? ((std::int32_t)1<<(m_precision - 1)) : 0;
         pChannel->m_lastDCValue = pChannel->m_defaultDCValue;
 
+        pChannel->m_scaleShiftX = scaleShift;
+        for(std::uint32_t subsampling(m_maxSamplingFactorX / pChannel->m_samplingFactorX); subsampling > 1 && pChannel->m_scaleShiftX != 0; subsampling >>= 1)
+        {
+            --(pChannel->m_scaleShiftX);
+        }
+        pChannel->m_scaleShiftY = scaleShift;
+        for(std::uint32_t subsampling(m_maxSamplingFactorY / pChannel->m_samplingFactorY); subsampling > 1 && pChannel->m_scaleShiftY != 0; subsampling >>= 1)
+        {
+            --(pChannel->m_scaleShiftY);
+        }
+
         pChannel->allocate(
-                    m_jpegImageWidth*(std::uint32_t)pChannel->m_samplingFactorX/m_maxSamplingFactorX,
-                    m_jpegImageHeight*(std::uint32_t)pChannel->m_samplingFactorY/m_maxSamplingFactorY);
+                    (m_jpegImageWidth*(std::uint32_t)pChannel->m_samplingFactorX/m_maxSamplingFactorX) >> pChannel->m_scaleShiftX,
+                    (m_jpegImageHeight*(std::uint32_t)pChannel->m_samplingFactorY/m_maxSamplingFactorY) >> pChannel->m_scaleShiftY);
         pChannel->m_valuesMask = m_valuesMask;
     }
 
@@ -558,6 +583,7 @@ void jpegInformation::findMcuSize()
     }
     m_mcuNumberTotal = m_mcuNumberX*m_mcuNumberY;
     m_mcuProcessed = 0;
+    m_mcuLastRestart = 0;
     m_mcuProcessedX = 0;
     m_mcuProcessedY = 0;
 }
@@ -583,6 +609,7 @@ void jpegInformation::recalculateQuantizationTables(int table)
         for(std::uint8_t col = 0; col<8; ++col)
         {
             m_decompressionQuantizationTable[table][tableIndex] = (long long)((float)((m_quantizationTable[table][tableIndex])<<JPEG_DECOMPRESSION_BITS_PRECISION)*JpegDctScaleFactor[col]*JpegDctScaleFactor[row]);
+            m_decompressionQuantizationTableFloat[table][tableIndex] = (float)(m_quantizationTable[table][tableIndex])*JpegDctScaleFactor[col]*JpegDctScaleFactor[row];
             m_compressionQuantizationTable[table][tableIndex] = 1.0f/((float)((m_quantizationTable[table][tableIndex])<<3)*JpegDctScaleFactor[col]*JpegDctScaleFactor[row]);
             ++tableIndex;
         }
@@ -923,6 +950,7 @@ void tagSOF::readTag(streamReader& stream, jpegInformation* pInformation, std::u
     std::shared_ptr<streamReader> tagReader(stream.getReader(tagLength));
 
     pInformation->m_bLossless = (tagEntry==0xc3) || (tagEntry==0xc7);
+    pInformation->m_bProgressive = (tagEntry==0xc2) || (tagEntry==0xc6);
     pInformation->m_process = (std::uint8_t)(tagEntry - 0xc0);
 
     // Read the precision, in bits
@@ -1586,8 +1614,127 @@ void tagEOI::readTag(streamReader&, jpegInformation* pInformation, std::uint8_t
 jpegStreamReader::jpegStreamReader(std::shared_ptr<streamReader> pStreamReader):
     m_pStreamReader(pStreamReader),
     m_inBitsBuffer(0),
-    m_inBitsNum(0)
+    m_inBitsNum(0),
+    m_inBytesStuffed(0)
+{
+}
+
+
+///////////////////////////////////////////////////////////
+//
+// Discard the bits in the active byte and return the
+//  whole bytes that have not been consumed
+//
+///////////////////////////////////////////////////////////
+void jpegStreamReader::resetInBitsBuffer()
 {
+    IMEBRA_FUNCTION_START();
+
+    size_t unusedBytes(m_inBitsNum >> 3);
+    if(unusedBytes != 0)
+    {
+        size_t rewindBytes(unusedBytes);
+        for(size_t scanBytes(0); scanBytes != unusedBytes; ++scanBytes)
+        {
+            rewindBytes += (m_inBytesStuffed >> scanBytes) & 1;
+        }
+        rewind(rewindBytes);
+    }
+
+    m_inBitsNum = 0;
+    m_inBytesStuffed = 0;
+
+    IMEBRA_FUNCTION_END();
+}
+
+
+///////////////////////////////////////////////////////////
+//
+// Returns true if there are no more bytes to read
+//
+///////////////////////////////////////////////////////////
+bool jpegStreamReader::endReached()
+{
+    IMEBRA_FUNCTION_START();
+
+    return m_inBitsNum < 8 && m_pStreamReader->endReached();
+
+    IMEBRA_FUNCTION_END();
+}
+
+
+///////////////////////////////////////////////////////////
+//
+// Load as many bytes as possible into the bits buffer,
+//  stopping before any jpeg tag
+//
+///////////////////////////////////////////////////////////
+void jpegStreamReader::fillBitsBuffer()
+{
+    IMEBRA_FUNCTION_START();
+
+    for(size_t missingBytes((sizeof(m_inBitsBuffer) * 8 - m_inBitsNum) >> 3); missingBytes != 0; missingBytes = (sizeof(m_inBitsBuffer) * 8 - m_inBitsNum) >> 3)
+    {
+        const std::uint8_t* pData;
+        size_t availableBytes(m_pStreamReader->getBufferedData(&pData));
+        if(availableBytes == 0)
+        {
+            return;
+        }
+        if(availableBytes > missingBytes)
+        {
+            availableBytes = missingBytes;
+        }
+
+        // Load all the bytes that precede the first 0xff
+        ///////////////////////////////////////////////////////////
+        const std::uint8_t* pFF((const std::uint8_t*)::memchr(pData, 0xff, availableBytes));
+        const size_t plainBytes(pFF == nullptr ? availableBytes : (size_t)(pFF - pData));
+        for(size_t loadBytes(0); loadBytes != plainBytes; ++loadBytes)
+        {
+            loadByte(pData[loadBytes], false);
+        }
+        m_pStreamReader->consumeBufferedData(plainBytes);
+        if(pFF == nullptr)
+        {
+            continue;
+        }
+
+        // Only 0xff followed by 0x00 is data: leave tags and
+        //  fill bytes to readByte()
+        ///////////////////////////////////////////////////////////
+        std::uint8_t byte;
+        m_pStreamReader->read(&byte, 1);
+        if(m_pStreamReader->endReached())
+        {
+            rewind(1);
+            return;
+        }
+        m_pStreamReader->read(&byte, 1);
+        if(byte != 0)
+        {
+            rewind(2);
+            return;
+        }
+        loadByte(0xff, true);
+    }
+
+    IMEBRA_FUNCTION_END();
+}
+
+
+///////////////////////////////////////////////////////////
+//
+// Move the read position back
+//
+///////////////////////////////////////////////////////////
+void jpegStreamReader::rewind(size_t bytesNum)
+{
+    IMEBRA_FUNCTION_START();
+
+    m_pStreamReader->seek(m_pStreamReader->position() - bytesNum);
+
+    IMEBRA_FUNCTION_END();
 }
 
 
@@ -23,6 +23,7 @@ If you do not want to be bound by the GPL terms (such as the requirement
 #include <list>
 #include "imageCodecImpl.h"
 #include "streamReaderImpl.h"
+#include "simdImpl.h"
 
 // Bits used to left shift the values before they are passed to the
 // DCT
@@ -87,6 +88,13 @@ namespace jpeg
         ///////////////////////////////////////////////////////////
         std::int32_t m_defaultDCValue;
 
+        // Reduced resolution decoding: each 8x8 block is
+        //  decoded into (8 >> m_scaleShiftX) x
+        //  (8 >> m_scaleShiftY) pixels
+        ///////////////////////////////////////////////////////////
+        std::uint32_t m_scaleShiftX;
+        std::uint32_t m_scaleShiftY;
+
         // Lossless position
         ///////////////////////////////////////////////////////////
         std::uint32_t m_losslessPositionX;
@@ -131,6 +139,17 @@ namespace jpeg
         void processUnprocessedAmplitudes();
     };
 
+    // Entropy coded data of one restart interval, used when
+    //  the restart intervals are decoded in parallel
+    ///////////////////////////////////////////////////////////
+    struct restartSegment
+    {
+        size_t m_start;                  // offset in the scan data
+        size_t m_length;                 // length, in bytes
+        std::uint8_t m_markerId;         // id (0...7) of the preceding RST marker
+        std::uint32_t m_restartInterval; // restart interval's index
+    };
+
     struct jpegInformation
     {
         jpegInformation();
@@ -218,6 +237,10 @@ namespace jpeg
         ///////////////////////////////////////////////////////////
         bool m_bLossless;
 
+        // true if we are reading a progressive jpeg image
+        ///////////////////////////////////////////////////////////
+        bool m_bProgressive;
+
         // The maximum sampling factor
         ///////////////////////////////////////////////////////////
         std::uint32_t m_maxSamplingFactorX;
@@ -235,8 +258,23 @@ namespace jpeg
         std::uint32_t m_jpegImageWidth;
         std::uint32_t m_jpegImageHeight;
 
+        // Lossy images decoded at a reduced resolution: the
+        //  image's size is divided by (1 << m_scaleShift).
+        // The subsampled channels are reduced less (see
+        //  jpegChannel::m_scaleShiftX/m_scaleShiftY)
+        ///////////////////////////////////////////////////////////
+        std::uint32_t m_scaleShift;
+
         std::array<std::array<long long, 64>, 16> m_decompressionQuantizationTable;
         std::array<std::array<float, 64> , 16> m_compressionQuantizationTable;
+
+        // Dequantization tables used by the vectorized IDCT
+        ///////////////////////////////////////////////////////////
+        std::array<std::array<float, 64> , 16> m_decompressionQuantizationTableFloat;
+
+        // Instruction set used by the FDCT/IDCT
+        ///////////////////////////////////////////////////////////
+        simdInstructions_t m_simdInstructions;
     };
 }
 
@@ -568,49 +606,21 @@ public:
     {
         IMEBRA_FUNCTION_START();
 
-        const size_t bufferSize(8);
-
-        // All the requested bits are already in the buffer.
-        // Just return them.
+        // Load the missing bytes into the bits buffer. readByte()
+        //  reports the tags that stop fillBitsBuffer()
         ///////////////////////////////////////////////////////////
-        if(bitsNum <= m_inBitsNum)
+        if(m_inBitsNum < bitsNum)
         {
-            std::uint32_t returnValue((m_inBitsBuffer & 0x00ff) >> (bufferSize - bitsNum));
-            m_inBitsBuffer <<= bitsNum;
-            m_inBitsNum -= bitsNum;
-            return returnValue;
-        }
-
-        // Fill a local variable with the read bits
-        ///////////////////////////////////////////////////////////
-        std::uint32_t returnValue(0);
-
-        // Some bits are in the bits buffer, copy them and reset
-        //  the bits buffer
-        ///////////////////////////////////////////////////////////
-        if(m_inBitsNum != 0)
-        {
-            bitsNum -= m_inBitsNum;
-            returnValue = ((std::uint32_t)((m_inBitsBuffer & 0xff) >> (bufferSize - m_inBitsNum))) << bitsNum;
-        }
-
-        // Read the requested number of bits
-        ///////////////////////////////////////////////////////////
-        for(;;)
-        {
-            if(bitsNum <= 8)
+            fillBitsBuffer();
+            while(m_inBitsNum < bitsNum)
             {
-                m_inBitsBuffer = readByte();
-                returnValue |= (m_inBitsBuffer >> (bufferSize - bitsNum));
-                m_inBitsBuffer <<= bitsNum;
-                m_inBitsNum = 8 - bitsNum;
-                return returnValue;
+                loadByte(readByte(), false);
             }
-
-            bitsNum -= 8;
-            returnValue |= ((std::uint32_t)readByte()) << bitsNum;
         }
 
+        m_inBitsNum -= bitsNum;
+        return (std::uint32_t)(m_inBitsBuffer >> m_inBitsNum) & (std::uint32_t)((std::uint64_t(1) << bitsNum) - 1);
+
         IMEBRA_FUNCTION_END();
     }
 
@@ -631,12 +641,14 @@ public:
 
         if(m_inBitsNum == 0)
         {
-            m_inBitsBuffer = readByte();
-            m_inBitsNum = 8;
+            fillBitsBuffer();
+            if(m_inBitsNum == 0)
+            {
+                loadByte(readByte(), false);
+            }
         }
         --m_inBitsNum;
-        m_inBitsBuffer <<= 1;
-        return (m_inBitsBuffer >> 8) & 1;
+        return (std::uint32_t)(m_inBitsBuffer >> m_inBitsNum) & 1;
 
         IMEBRA_FUNCTION_END();
     }
@@ -662,17 +674,63 @@ public:
         IMEBRA_FUNCTION_START();
 
         (*pBuffer) <<= 1;
+        *pBuffer |= readBit();
 
-        if(m_inBitsNum == 0)
+        IMEBRA_FUNCTION_END();
+    }
+
+    /// \brief Return the next bits in the stream without
+    ///         consuming them.
+    ///
+    /// The function loads as many bytes as possible into the
+    ///  bits buffer, but stops before a jpeg tag or the end
+    ///  of the stream: in this case the bits that cannot be
+    ///  loaded are returned as zeros and availableBits()
+    ///  returns a value smaller than bitsNum.
+    ///
+    /// Use skipBits() to consume the bits that have been
+    ///  used.
+    ///
+    /// @param bitsNum   the number of bits to peek.
+    ///                  The function can peek 32 bits maximum
+    /// @return an integer containing the peeked bits, right
+    ///                   aligned
+    ///
+    ///////////////////////////////////////////////////////////
+    inline std::uint32_t peekBits(size_t bitsNum)
+    {
+        if(m_inBitsNum < bitsNum)
         {
-            m_inBitsBuffer = readByte();
-            m_inBitsNum = 8;
+            fillBitsBuffer();
+            if(m_inBitsNum < bitsNum)
+            {
+                return (std::uint32_t)(m_inBitsBuffer << (bitsNum - m_inBitsNum)) & (std::uint32_t)((std::uint64_t(1) << bitsNum) - 1);
+            }
         }
-        m_inBitsBuffer <<= 1;
-        --m_inBitsNum;
-        *pBuffer |= (m_inBitsBuffer >> 8) & 1;
+        return (std::uint32_t)(m_inBitsBuffer >> (m_inBitsNum - bitsNum)) & (std::uint32_t)((std::uint64_t(1) << bitsNum) - 1);
+    }
 
-        IMEBRA_FUNCTION_END();
+    /// \brief Return the number of bits already loaded in
+    ///         the bits buffer.
+    ///
+    /// @return the number of bits that can be consumed by
+    ///          skipBits()
+    ///
+    ///////////////////////////////////////////////////////////
+    inline size_t availableBits() const
+    {
+        return m_inBitsNum;
+    }
+
+    /// \brief Consume bits previously returned by peekBits().
+    ///
+    /// @param bitsNum   the number of bits to consume. Must
+    ///                   not be greater than availableBits()
+    ///
+    ///////////////////////////////////////////////////////////
+    inline void skipBits(size_t bitsNum)
+    {
+        m_inBitsNum -= bitsNum;
     }
 
     /// \brief Reset the bit pointer used by readBits(),
@@ -681,11 +739,18 @@ public:
     /// A subsequent call to readBits(), readBit and
     ///  addBit() will read data from a byte-aligned boundary.
     ///
+    /// The whole bytes loaded by peekBits() but not consumed
+    ///  are returned to the stream.
+    ///
     ///////////////////////////////////////////////////////////
-    inline void resetInBitsBuffer()
-    {
-        m_inBitsNum = 0;
-    }
+    void resetInBitsBuffer();
+
+    /// \brief Returns true if the last byte in the stream
+    ///         has already been read and no whole byte is
+    ///         left in the bits buffer.
+    ///
+    ///////////////////////////////////////////////////////////
+    bool endReached();
 
     /// \brief Read a single byte from the stream, parsing it
     ///         if m_pTagByte is not zero.
@@ -745,11 +810,50 @@ public:
     }
 
 private:
+    /// \brief Append a byte to the bits buffer.
+    ///
+    /// @param byte      the byte to append
+    /// @param bStuffed  true if the byte was followed by a
+    ///                   stuffed 0x00 in the stream
+    ///
+    ///////////////////////////////////////////////////////////
+    inline void loadByte(std::uint8_t byte, bool bStuffed)
+    {
+        m_inBitsBuffer = (m_inBitsBuffer << 8) | byte;
+        m_inBitsNum += 8;
+        m_inBytesStuffed = (m_inBytesStuffed << 1) | (bStuffed ? 1u : 0u);
+    }
+
+    /// \brief Load bytes into the bits buffer until it is
+    ///         full or a jpeg tag or the end of the stream
+    ///         is reached.
+    ///
+    /// The bytes are taken directly from the streamReader's
+    ///  data buffer: memchr() locates the 0xFF bytes so only
+    ///  them need the byte-by-byte unstuffing.
+    ///
+    ///////////////////////////////////////////////////////////
+    void fillBitsBuffer();
+
+    /// \brief Move the stream position back by the specified
+    ///         number of bytes.
+    ///
+    ///////////////////////////////////////////////////////////
+    void rewind(size_t bytesNum);
+
     std::shared_ptr<streamReader> m_pStreamReader;
 
-    unsigned int m_inBitsBuffer;
+    // The bits not yet consumed are in the m_inBitsNum least
+    //  significant bits
+    ///////////////////////////////////////////////////////////
+    std::uint64_t m_inBitsBuffer;
     size_t m_inBitsNum;
 
+    // One bit for each byte loaded in m_inBitsBuffer: 1 if
+    //  the byte occupied 2 bytes in the stream (0xff, 0x00)
+    ///////////////////////////////////////////////////////////
+    std::uint32_t m_inBytesStuffed;
+
 };
 
 } // namespace codecs
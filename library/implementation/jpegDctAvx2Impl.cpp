@@ -0,0 +1,96 @@
+/*
+Copyright 2005 - 2017 by Paolo Brandoli/Binarno s.p.
+
+Imebra is available for free under the GNU General Public License.
+
+The full text of the license is available in the file license.rst
+ in the project root folder.
+
+If you do not want to be bound by the GPL terms (such as the requirement 
+ that your application must also be GPL), you may purchase a commercial 
+ license for Imebra from the Imebra’s website (http://imebra.com).
+*/
+
+/*! \file jpegDctAvx2Impl.cpp
+    \brief AVX2 version of the vectorized FDCT/IDCT.
+
+    This file is compiled with the AVX2 instruction set enabled: its
+     functions are called only when the CPU supports AVX2.
+     Don't include headers that define non-template inline functions
+     shared with other translation units.
+
+*/
+
+#include "jpegDctImpl.h"
+
+#if defined(IMEBRA_SIMD_X86) && defined(__AVX2__)
+
+#include "jpegDctKernelsImpl.h"
+
+namespace imebra
+{
+
+namespace implementation
+{
+
+namespace codecs
+{
+
+namespace jpeg
+{
+
+void FDCTAvx2(std::int32_t* pIOMatrix, const float* pDescaleFactors)
+{
+    fdctKernel<simd::vector8f>(pIOMatrix, pDescaleFactors);
+}
+
+void IDCTAvx2(std::int32_t* pIOMatrix, const float* pScaleFactors)
+{
+    idctKernel<simd::vector8f>(pIOMatrix, pScaleFactors);
+}
+
+} // namespace jpeg
+
+} // namespace codecs
+
+} // namespace implementation
+
+} // namespace imebra
+
+#elif defined(IMEBRA_SIMD_X86)
+
+#include "jpegDctKernelsImpl.h"
+
+namespace imebra
+{
+
+namespace implementation
+{
+
+namespace codecs
+{
+
+namespace jpeg
+{
+
+// Built without the AVX2 flags: fall back to SSE2
+///////////////////////////////////////////////////////////
+void FDCTAvx2(std::int32_t* pIOMatrix, const float* pDescaleFactors)
+{
+    fdctKernel<simd::vector4f>(pIOMatrix, pDescaleFactors);
+}
+
+void IDCTAvx2(std::int32_t* pIOMatrix, const float* pScaleFactors)
+{
+    idctKernel<simd::vector4f>(pIOMatrix, pScaleFactors);
+}
+
+} // namespace jpeg
+
+} // namespace codecs
+
+} // namespace implementation
+
+} // namespace imebra
+
+#endif
@@ -0,0 +1,138 @@
+/*
+Copyright 2005 - 2017 by Paolo Brandoli/Binarno s.p.
+
+Imebra is available for free under the GNU General Public License.
+
+The full text of the license is available in the file license.rst
+ in the project root folder.
+
+If you do not want to be bound by the GPL terms (such as the requirement 
+ that your application must also be GPL), you may purchase a commercial 
+ license for Imebra from the Imebra’s website (http://imebra.com).
+*/
+
+/*! \file jpegDctImpl.cpp
+    \brief Implementation of the vectorized FDCT/IDCT used by the jpeg
+            codec (SSE2 and NEON versions and runtime dispatch).
+
+*/
+
+#include "jpegDctImpl.h"
+#include "jpegDctKernelsImpl.h"
+
+namespace imebra
+{
+
+namespace implementation
+{
+
+namespace codecs
+{
+
+namespace jpeg
+{
+
+/////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////
+//
+//
+// Dispatch the FDCT to the requested instruction set
+//
+//
+/////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////
+void FDCTSimd(simdInstructions_t instructions, std::int32_t* pIOMatrix, const float* pDescaleFactors)
+{
+    switch(instructions)
+    {
+#if defined(IMEBRA_SIMD_X86)
+    case simdInstructions_t::avx2:
+        FDCTAvx2(pIOMatrix, pDescaleFactors);
+        return;
+    case simdInstructions_t::sse2:
+        FDCTSse2(pIOMatrix, pDescaleFactors);
+        return;
+#endif
+#if defined(IMEBRA_SIMD_NEON)
+    case simdInstructions_t::neon:
+        FDCTNeon(pIOMatrix, pDescaleFactors);
+        return;
+#endif
+    default:
+        (void)pIOMatrix;
+        (void)pDescaleFactors;
+        return;
+    }
+}
+
+
+/////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////
+//
+//
+// Dispatch the IDCT to the requested instruction set
+//
+//
+/////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////
+void IDCTSimd(simdInstructions_t instructions, std::int32_t* pIOMatrix, const float* pScaleFactors)
+{
+    switch(instructions)
+    {
+#if defined(IMEBRA_SIMD_X86)
+    case simdInstructions_t::avx2:
+        IDCTAvx2(pIOMatrix, pScaleFactors);
+        return;
+    case simdInstructions_t::sse2:
+        IDCTSse2(pIOMatrix, pScaleFactors);
+        return;
+#endif
+#if defined(IMEBRA_SIMD_NEON)
+    case simdInstructions_t::neon:
+        IDCTNeon(pIOMatrix, pScaleFactors);
+        return;
+#endif
+    default:
+        (void)pIOMatrix;
+        (void)pScaleFactors;
+        return;
+    }
+}
+
+
+#if defined(IMEBRA_SIMD_X86)
+
+void FDCTSse2(std::int32_t* pIOMatrix, const float* pDescaleFactors)
+{
+    fdctKernel<simd::vector4f>(pIOMatrix, pDescaleFactors);
+}
+
+void IDCTSse2(std::int32_t* pIOMatrix, const float* pScaleFactors)
+{
+    idctKernel<simd::vector4f>(pIOMatrix, pScaleFactors);
+}
+
+#endif
+
+
+#if defined(IMEBRA_SIMD_NEON)
+
+void FDCTNeon(std::int32_t* pIOMatrix, const float* pDescaleFactors)
+{
+    fdctKernel<simd::vector4f>(pIOMatrix, pDescaleFactors);
+}
+
+void IDCTNeon(std::int32_t* pIOMatrix, const float* pScaleFactors)
+{
+    idctKernel<simd::vector4f>(pIOMatrix, pScaleFactors);
+}
+
+#endif
+
+} // namespace jpeg
+
+} // namespace codecs
+
+} // namespace implementation
+
+} // namespace imebra
@@ -0,0 +1,91 @@
+/*
+Copyright 2005 - 2017 by Paolo Brandoli/Binarno s.p.
+
+Imebra is available for free under the GNU General Public License.
+
+The full text of the license is available in the file license.rst
+ in the project root folder.
+
+If you do not want to be bound by the GPL terms (such as the requirement 
+ that your application must also be GPL), you may purchase a commercial 
+ license for Imebra from the Imebra’s website (http://imebra.com).
+*/
+
+/*! \file jpegDctImpl.h
+    \brief Declaration of the vectorized FDCT/IDCT used by the jpeg codec.
+
+*/
+
+#if !defined(imebraJpegDct_9C2B7A14_E3D5_4B8F_A6C1_0F5E8D3A7B26__INCLUDED_)
+#define imebraJpegDct_9C2B7A14_E3D5_4B8F_A6C1_0F5E8D3A7B26__INCLUDED_
+
+#include "simdImpl.h"
+#include <cstdint>
+
+namespace imebra
+{
+
+namespace implementation
+{
+
+namespace codecs
+{
+
+namespace jpeg
+{
+
+///////////////////////////////////////////////////////////
+/// \brief Vectorized FDCT.
+///
+/// Gives the same results as jpegImageCodec::FDCT(): the
+///  operations are executed in the same order and with the
+///  same precision.
+///
+/// \param instructions     the instruction set to use.
+///                         Must not be
+///                         simdInstructions_t::none
+/// \param pIOMatrix        the 8x8 block to transform
+/// \param pDescaleFactors  the 64 descale factors
+///
+///////////////////////////////////////////////////////////
+void FDCTSimd(simdInstructions_t instructions, std::int32_t* pIOMatrix, const float* pDescaleFactors);
+
+///////////////////////////////////////////////////////////
+/// \brief Vectorized IDCT.
+///
+/// Works in single precision: the results differ by at
+///  most 1 from the ones returned by
+///  jpegImageCodec::IDCT().
+///
+/// \param instructions     the instruction set to use.
+///                         Must not be
+///                         simdInstructions_t::none
+/// \param pIOMatrix        the 8x8 block to transform
+/// \param pScaleFactors    the 64 dequantization factors,
+///                         already multiplied by the
+///                         scale factors of the IDCT
+///
+///////////////////////////////////////////////////////////
+void IDCTSimd(simdInstructions_t instructions, std::int32_t* pIOMatrix, const float* pScaleFactors);
+
+#if defined(IMEBRA_SIMD_X86)
+void FDCTSse2(std::int32_t* pIOMatrix, const float* pDescaleFactors);
+void IDCTSse2(std::int32_t* pIOMatrix, const float* pScaleFactors);
+void FDCTAvx2(std::int32_t* pIOMatrix, const float* pDescaleFactors);
+void IDCTAvx2(std::int32_t* pIOMatrix, const float* pScaleFactors);
+#endif
+
+#if defined(IMEBRA_SIMD_NEON)
+void FDCTNeon(std::int32_t* pIOMatrix, const float* pDescaleFactors);
+void IDCTNeon(std::int32_t* pIOMatrix, const float* pScaleFactors);
+#endif
+
+} // namespace jpeg
+
+} // namespace codecs
+
+} // namespace implementation
+
+} // namespace imebra
+
+#endif // !defined(imebraJpegDct_9C2B7A14_E3D5_4B8F_A6C1_0F5E8D3A7B26__INCLUDED_)
@@ -0,0 +1,268 @@
+/*
+Copyright 2005 - 2017 by Paolo Brandoli/Binarno s.p.
+
+Imebra is available for free under the GNU General Public License.
+
+The full text of the license is available in the file license.rst
+ in the project root folder.
+
+If you do not want to be bound by the GPL terms (such as the requirement 
+ that your application must also be GPL), you may purchase a commercial 
+ license for Imebra from the Imebra’s website (http://imebra.com).
+*/
+
+/*! \file jpegDctKernelsImpl.h
+    \brief FDCT/IDCT written once for all the vector types declared in
+            simdVectorImpl.h.
+
+    Included only by the files that instantiate the kernels for a
+     specific instruction set.
+
+*/
+
+#if !defined(imebraJpegDctKernels_4E7A1D38_B9C2_4F05_8E6B_3D1C5A9F2E74__INCLUDED_)
+#define imebraJpegDctKernels_4E7A1D38_B9C2_4F05_8E6B_3D1C5A9F2E74__INCLUDED_
+
+#include "simdVectorImpl.h"
+
+namespace imebra
+{
+
+namespace implementation
+{
+
+namespace codecs
+{
+
+namespace jpeg
+{
+
+namespace
+{
+
+/////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////
+//
+//
+// FDCT on the columns of a 8x8 matrix, vector_t::lanes columns
+//  at once.
+// Same operations, in the same order, as jpegImageCodec::FDCT()
+//
+//
+/////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////
+template<class vector_t>
+inline void fdctColumns(float* pMatrix)
+{
+    const vector_t c4(0.707106781f);
+    const vector_t c6(0.382683433f);
+    const vector_t c2MinusC6(0.541196100f);
+    const vector_t c2PlusC6(1.306562965f);
+
+    for(size_t column(0); column != 8; column += vector_t::lanes)
+    {
+        float* pColumn(pMatrix + column);
+
+        const vector_t in0(vector_t::load(pColumn)), in1(vector_t::load(pColumn + 8));
+        const vector_t in2(vector_t::load(pColumn + 16)), in3(vector_t::load(pColumn + 24));
+        const vector_t in4(vector_t::load(pColumn + 32)), in5(vector_t::load(pColumn + 40));
+        const vector_t in6(vector_t::load(pColumn + 48)), in7(vector_t::load(pColumn + 56));
+
+        const vector_t tmp0(in0 + in7);
+        const vector_t tmp7(in0 - in7);
+        const vector_t tmp1(in1 + in6);
+        const vector_t tmp6(in1 - in6);
+        const vector_t tmp2(in2 + in5);
+        const vector_t tmp5(in2 - in5);
+        const vector_t tmp3(in3 + in4);
+        const vector_t tmp4(in3 - in4);
+
+        // Even part
+        ///////////////////////////////////////////////////////////
+        vector_t tmp10(tmp0 + tmp3);
+        const vector_t tmp13(tmp0 - tmp3);
+        vector_t tmp11(tmp1 + tmp2);
+        vector_t tmp12(tmp1 - tmp2);
+
+        (tmp10 + tmp11).store(pColumn);
+        (tmp10 - tmp11).store(pColumn + 32);
+
+        const vector_t z1((tmp12 + tmp13) * c4);
+        (tmp13 + z1).store(pColumn + 16);
+        (tmp13 - z1).store(pColumn + 48);
+
+        // Odd part
+        ///////////////////////////////////////////////////////////
+        tmp10 = tmp4 + tmp5;
+        tmp11 = tmp5 + tmp6;
+        tmp12 = tmp6 + tmp7;
+
+        const vector_t z5((tmp10 - tmp12) * c6);
+        const vector_t z2(tmp10 * c2MinusC6 + z5);
+        const vector_t z4(tmp12 * c2PlusC6 + z5);
+        const vector_t z3(tmp11 * c4);
+
+        const vector_t z11(tmp7 + z3);
+        const vector_t z13(tmp7 - z3);
+
+        (z13 + z2).store(pColumn + 40);
+        (z13 - z2).store(pColumn + 24);
+        (z11 + z4).store(pColumn + 8);
+        (z11 - z4).store(pColumn + 56);
+    }
+}
+
+
+/////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////
+//
+//
+// IDCT on the columns of a 8x8 matrix, vector_t::lanes columns
+//  at once.
+// Single precision version of jpegImageCodec::IDCT()
+//
+//
+/////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////
+template<class vector_t>
+inline void idctColumns(float* pMatrix)
+{
+    const vector_t twoC4(1.414213562f);
+    const vector_t twoC2(1.847759065f);
+    const vector_t twoC2MinusC6(1.0823922f);
+    const vector_t twoC2PlusC6(2.61312593f);
+
+    for(size_t column(0); column != 8; column += vector_t::lanes)
+    {
+        float* pColumn(pMatrix + column);
+
+        // Even part
+        ///////////////////////////////////////////////////////////
+        vector_t tmp0(vector_t::load(pColumn));
+        vector_t tmp1(vector_t::load(pColumn + 16));
+        vector_t tmp2(vector_t::load(pColumn + 32));
+        vector_t tmp3(vector_t::load(pColumn + 48));
+
+        vector_t tmp10(tmp0 + tmp2);
+        vector_t tmp11(tmp0 - tmp2);
+
+        const vector_t tmp13(tmp1 + tmp3);
+        vector_t tmp12((tmp1 - tmp3) * twoC4 - tmp13);
+
+        tmp0 = tmp10 + tmp13;
+        tmp3 = tmp10 - tmp13;
+        tmp1 = tmp11 + tmp12;
+        tmp2 = tmp11 - tmp12;
+
+        // Odd part
+        ///////////////////////////////////////////////////////////
+        const vector_t tmp4(vector_t::load(pColumn + 8));
+        const vector_t tmp5(vector_t::load(pColumn + 24));
+        const vector_t tmp6(vector_t::load(pColumn + 40));
+        const vector_t tmp7(vector_t::load(pColumn + 56));
+
+        const vector_t z13(tmp6 + tmp5);
+        const vector_t z10(tmp6 - tmp5);
+        const vector_t z11(tmp4 + tmp7);
+        const vector_t z12(tmp4 - tmp7);
+
+        const vector_t odd7(z11 + z13);
+        tmp11 = (z11 - z13) * twoC4;
+
+        const vector_t z5((z10 + z12) * twoC2);
+        tmp10 = z12 * twoC2MinusC6 - z5;
+        tmp12 = z5 - z10 * twoC2PlusC6;
+
+        const vector_t odd6(tmp12 - odd7);
+        const vector_t odd5(tmp11 - odd6);
+        const vector_t odd4(tmp10 + odd5);
+
+        (tmp0 + odd7).store(pColumn);
+        (tmp1 + odd6).store(pColumn + 8);
+        (tmp2 + odd5).store(pColumn + 16);
+        (tmp3 - odd4).store(pColumn + 24);
+        (tmp3 + odd4).store(pColumn + 32);
+        (tmp2 - odd5).store(pColumn + 40);
+        (tmp1 - odd6).store(pColumn + 48);
+        (tmp0 - odd7).store(pColumn + 56);
+    }
+}
+
+
+/////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////
+//
+//
+// FDCT: rows first, then columns, then descale
+//
+//
+/////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////
+template<class vector_t>
+void fdctKernel(std::int32_t* pIOMatrix, const float* pDescaleFactors)
+{
+    // The pixels are at most 16 bits wide: their sums are
+    //  exact in single precision, so converting them before
+    //  the first additions doesn't change the results
+    ///////////////////////////////////////////////////////////
+    alignas(32) float matrix[64];
+    for(size_t index(0); index != 64; index += vector_t::lanes)
+    {
+        vector_t::loadInt32(pIOMatrix + index).store(matrix + index);
+    }
+
+    vector_t::transpose8x8(matrix);
+    fdctColumns<vector_t>(matrix);
+    vector_t::transpose8x8(matrix);
+    fdctColumns<vector_t>(matrix);
+
+    const vector_t half(.5f);
+    for(size_t index(0); index != 64; index += vector_t::lanes)
+    {
+        (vector_t::load(matrix + index) * vector_t::load(pDescaleFactors + index) + half).storeInt32Truncated(pIOMatrix + index);
+    }
+}
+
+
+/////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////
+//
+//
+// IDCT: dequantize, rows first, then columns, then scale down
+//  by 8
+//
+//
+/////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////
+template<class vector_t>
+void idctKernel(std::int32_t* pIOMatrix, const float* pScaleFactors)
+{
+    alignas(32) float matrix[64];
+    for(size_t index(0); index != 64; index += vector_t::lanes)
+    {
+        (vector_t::loadInt32(pIOMatrix + index) * vector_t::load(pScaleFactors + index)).store(matrix + index);
+    }
+
+    vector_t::transpose8x8(matrix);
+    idctColumns<vector_t>(matrix);
+    vector_t::transpose8x8(matrix);
+    idctColumns<vector_t>(matrix);
+
+    const vector_t oneEighth(.125f);
+    for(size_t index(0); index != 64; index += vector_t::lanes)
+    {
+        (vector_t::load(matrix + index) * oneEighth).storeInt32Rounded(pIOMatrix + index);
+    }
+}
+
+} // anonymous namespace
+
+} // namespace jpeg
+
+} // namespace codecs
+
+} // namespace implementation
+
+} // namespace imebra
+
+#endif // !defined(imebraJpegDctKernels_4E7A1D38_B9C2_4F05_8E6B_3D1C5A9F2E74__INCLUDED_)
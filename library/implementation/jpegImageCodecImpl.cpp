@@ -25,10 +25,17 @@ If you do not want to be bound by the GPL terms (such as the requirement
 #include "imageImpl.h"
 #include "dataHandlerNumericImpl.h"
 #include "codecFactoryImpl.h"
+#include "jpegDctImpl.h"
+#include "memoryImpl.h"
+#include "memoryStreamImpl.h"
+#include "threadPoolImpl.h"
 #include "../include/imebra/exceptions.h"
 #include <vector>
+#include <atomic>
+#include <algorithm>
 #include <stdlib.h>
 #include <string.h>
+#include <cmath>
 
 namespace imebra
 {
@@ -335,6 +342,74 @@ std::shared_ptr<image> jpegImageCodec::getImage(const std::string& transferSynta
 {
     IMEBRA_FUNCTION_START();
 
+    return decodeImage(transferSyntax, colorSpace, b2Complement, 0, pSourceStream);
+
+    IMEBRA_FUNCTION_END();
+}
+
+
+////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////
+//
+//
+// Get a jpeg image from a Dicom dataset at a reduced
+//  resolution
+//
+//
+/////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////
+std::shared_ptr<image> jpegImageCodec::getScaledImage(const std::string& transferSyntax,
+                                                      const std::string& colorSpace,
+                                                      std::uint32_t /* channelsNumber */,
+                                                      std::uint32_t /* imageWidth */,
+                                                      std::uint32_t /* imageHeight */,
+                                                      bool /* bSubSampledX */,
+                                                      bool /* bSubSampledY */,
+                                                      bool /* bInterleaved */,
+                                                      bool b2Complement,
+                                                      std::uint8_t /* allocatedBits */,
+                                                      std::uint8_t /* storedBits */,
+                                                      std::uint8_t /* highBit */,
+                                                      imageScale_t scale,
+                                                      std::shared_ptr<streamReader> pSourceStream) const
+{
+    IMEBRA_FUNCTION_START();
+
+    std::uint32_t scaleShift(0);
+    switch(scale)
+    {
+    case imageScale_t::half:
+        scaleShift = 1;
+        break;
+    case imageScale_t::quarter:
+        scaleShift = 2;
+        break;
+    case imageScale_t::eighth:
+        scaleShift = 3;
+        break;
+    default:
+        break;
+    }
+
+    return decodeImage(transferSyntax, colorSpace, b2Complement, scaleShift, pSourceStream);
+
+    IMEBRA_FUNCTION_END();
+}
+
+
+////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////
+//
+//
+// Decode the jpeg stream
+//
+//
+/////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////
+std::shared_ptr<image> jpegImageCodec::decodeImage(const std::string& transferSyntax, const std::string& colorSpace, bool b2Complement, std::uint32_t scaleShift, std::shared_ptr<streamReader> pSourceStream) const
+{
+    IMEBRA_FUNCTION_START();
+
     jpegStreamReader jpegStream(pSourceStream);
 
     // Read the Jpeg signature
@@ -361,7 +436,18 @@ std::shared_ptr<image> jpegImageCodec::getImage(const std::string& transferSynta
 
     // Read until the end of the image is reached
     ///////////////////////////////////////////////////////////
+    size_t decodingThreads(codecFactory::getCodecFactory()->getMaximumDecodingThreads());
+    if(decodingThreads != 1)
+    {
+        const size_t availableThreads(threadPool::getThreadPool()->getMaximumParallelism());
+        if(decodingThreads == 0 || decodingThreads > availableThreads)
+        {
+            decodingThreads = availableThreads;
+        }
+    }
+
     jpeg::jpegInformation information;
+    information.m_scaleShift = scaleShift;
     for(; !information.m_bEndOfImage; jpegStream.resetInBitsBuffer())
     {
         std::uint32_t nextMcuStop = information.m_mcuNumberTotal;
@@ -419,102 +505,439 @@ std::shared_ptr<image> jpegImageCodec::getImage(const std::string& transferSynta
 
         }
 
-        while(information.m_mcuProcessed < nextMcuStop && !pSourceStream->endReached())
+        // Decode the restart intervals in parallel when possible
+        ///////////////////////////////////////////////////////////
+        if(information.m_mcuProcessed == 0 && decodingThreads != 1 && canReadRestartIntervalsInParallel(information))
         {
-            // Read an MCU
-            ///////////////////////////////////////////////////////////
+            readRestartIntervalsInParallel(*pSourceStream, information, decodingThreads);
+            continue;
+        }
 
-            // Scan all components
+        readMcus(jpegStream, information, nextMcuStop);
+    }
+
+    // Process unprocessed lossless amplitudes
+    ///////////////////////////////////////////////////////////
+    for(jpeg::jpegInformation::tChannelsMap::iterator processLosslessIterator = information.m_channelsMap.begin();
+        processLosslessIterator != information.m_channelsMap.end();
+        ++processLosslessIterator)
+    {
+        processLosslessIterator->second->processUnprocessedAmplitudes();
+    }
+
+
+    // If the compression is jpeg baseline or jpeg extended
+    //  then the color space cannot be "RGB"
+    ///////////////////////////////////////////////////////////
+    std::shared_ptr<image> pImage;
+    if(colorSpace == "RGB" && (transferSyntax == "1.2.840.10008.1.2.4.50" ||  // baseline (8 bits lossy)
+                transferSyntax == "1.2.840.10008.1.2.4.51"))    // extended (12 bits lossy)
+    {
+        pImage = copyJpegChannelsToImage(information, b2Complement, "YBR_FULL");
+    }
+    else
+    {
+        pImage = copyJpegChannelsToImage(information, b2Complement, colorSpace);
+    }
+
+    // The lossless and the progressive images are always
+    //  decoded at full resolution
+    ///////////////////////////////////////////////////////////
+    if((information.m_bLossless || information.m_bProgressive) && scaleShift != 0)
+    {
+        return scaleImage(pImage, (imageScale_t)((std::uint32_t)1 << scaleShift));
+    }
+
+    return pImage;
+
+    IMEBRA_FUNCTION_END_MODIFY(StreamEOFError, CodecCorruptedFileError);
+}
+
+
+///////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////
+//
+//
+// Read the MCUs of the active scan until nextMcuStop or
+//  the end of the stream
+//
+//
+///////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////
+void jpegImageCodec::readMcus(jpegStreamReader& jpegStream, jpeg::jpegInformation& information, std::uint32_t nextMcuStop) const
+{
+    IMEBRA_FUNCTION_START();
+
+    while(information.m_mcuProcessed < nextMcuStop && !jpegStream.endReached())
+    {
+        // Read an MCU
+        ///////////////////////////////////////////////////////////
+
+        // Scan all components
+        ///////////////////////////////////////////////////////////
+        for(const std::shared_ptr<jpeg::jpegChannel>& pChannel: information.m_channelsList)
+        {
+            // Read a lossless pixel
             ///////////////////////////////////////////////////////////
-            for(const std::shared_ptr<jpeg::jpegChannel>& pChannel: information.m_channelsList)
+            if(information.m_bLossless)
             {
-                // Read a lossless pixel
-                ///////////////////////////////////////////////////////////
-                if(information.m_bLossless)
+                for(std::uint32_t
+                    scanBlock = 0;
+                    scanBlock != pChannel->m_blockMcuXY;
+                    ++scanBlock)
                 {
-                    for(std::uint32_t
-                        scanBlock = 0;
-                        scanBlock != pChannel->m_blockMcuXY;
-                        ++scanBlock)
+                    // The amplitude length 16 has no amplitude bits
+                    //  (value & 0xf == 0)
+                    ///////////////////////////////////////////////////////////
+                    std::int32_t amplitude;
+                    std::uint32_t amplitudeLength = pChannel->m_pActiveHuffmanTableDC->readHuffmanCodeAndAmplitude(jpegStream, &amplitude);
+                    if(amplitudeLength == 16) // logically we should compare with information.m_precision, but DICOM says otherwise
                     {
-                        std::uint32_t amplitudeLength = pChannel->m_pActiveHuffmanTableDC->readHuffmanCode(jpegStream);
-                        std::int32_t amplitude;
-                        if(amplitudeLength == 16) // logically we should compare with information.m_precision, but DICOM says otherwise
-                        {
-                            amplitude = (std::int32_t)1 << 15;
-                        }
-                        else if(amplitudeLength != 0)
-                        {
-                            amplitude = (std::int32_t)jpegStream.readBits(amplitudeLength);
-                            if(amplitude < ((std::int32_t)1<<(amplitudeLength-1)))
-                            {
-                                amplitude -= ((std::int32_t)1<<amplitudeLength)-1;
-                            }
-                        }
-                        else
-                        {
-                            amplitude = 0;
-                        }
-
-                        pChannel->addUnprocessedAmplitude(amplitude, information.m_spectralIndexStart, information.m_mcuLastRestart == information.m_mcuProcessed && scanBlock == 0);
+                        amplitude = (std::int32_t)1 << 15;
                     }
 
-                    continue;
+                    pChannel->addUnprocessedAmplitude(amplitude, information.m_spectralIndexStart, information.m_mcuLastRestart == information.m_mcuProcessed && scanBlock == 0);
                 }
 
-                // Read a lossy MCU
-                ///////////////////////////////////////////////////////////
-                std::uint32_t bufferPointer = (information.m_mcuProcessedY * pChannel->m_blockMcuY * ((information.m_jpegImageWidth * pChannel->m_samplingFactorX / information.m_maxSamplingFactorX) >> 3) + information.m_mcuProcessedX * pChannel->m_blockMcuX) * 64;
-                for(std::uint32_t scanBlockY = pChannel->m_blockMcuY; (scanBlockY != 0); --scanBlockY)
+                continue;
+            }
+
+            // Read a lossy MCU
+            ///////////////////////////////////////////////////////////
+            const bool bScaled(pChannel->m_scaleShiftX != 0 || pChannel->m_scaleShiftY != 0);
+            const std::uint32_t blockValues((std::uint32_t)64 >> (pChannel->m_scaleShiftX + pChannel->m_scaleShiftY));
+            std::uint32_t bufferPointer = (information.m_mcuProcessedY * pChannel->m_blockMcuY * ((information.m_jpegImageWidth * pChannel->m_samplingFactorX / information.m_maxSamplingFactorX) >> 3) + information.m_mcuProcessedX * pChannel->m_blockMcuX) * blockValues;
+            for(std::uint32_t scanBlockY = pChannel->m_blockMcuY; (scanBlockY != 0); --scanBlockY)
+            {
+                for(std::uint32_t scanBlockX = pChannel->m_blockMcuX; scanBlockX != 0; --scanBlockX)
                 {
-                    for(std::uint32_t scanBlockX = pChannel->m_blockMcuX; scanBlockX != 0; --scanBlockX)
+                    // Reduced resolution: the coefficients are
+                    //  read in a temporary block
+                    ///////////////////////////////////////////////////////////
+                    if(bScaled)
                     {
-                        readBlock(jpegStream, information, &(pChannel->m_pBuffer[bufferPointer]), pChannel);
+                        std::int32_t coefficients[64] = {};
+                        readBlock(jpegStream, information, coefficients, pChannel);
+                        IDCTScaled(coefficients, information.m_quantizationTable[pChannel->m_quantTable], pChannel->m_scaleShiftX, pChannel->m_scaleShiftY, &(pChannel->m_pBuffer[bufferPointer]));
+                        bufferPointer += blockValues;
+                        continue;
+                    }
 
-                        if(information.m_spectralIndexEnd >= 63)
+                    readBlock(jpegStream, information, &(pChannel->m_pBuffer[bufferPointer]), pChannel);
+
+                    if(information.m_spectralIndexEnd >= 63)
+                    {
+                        if(information.m_simdInstructions == simdInstructions_t::none)
                         {
                             IDCT(
                                         &(pChannel->m_pBuffer[bufferPointer]),
                                         information.m_decompressionQuantizationTable[pChannel->m_quantTable]
                                     );
                         }
-                        bufferPointer += 64;
+                        else
+                        {
+                            jpeg::IDCTSimd(
+                                        information.m_simdInstructions,
+                                        &(pChannel->m_pBuffer[bufferPointer]),
+                                        information.m_decompressionQuantizationTableFloat[pChannel->m_quantTable].data()
+                                    );
+                        }
                     }
-                    bufferPointer += (information.m_mcuNumberX -1) * pChannel->m_blockMcuX * 64;
+                    bufferPointer += 64;
                 }
+                bufferPointer += (information.m_mcuNumberX -1) * pChannel->m_blockMcuX * blockValues;
             }
+        }
+
+        ++information.m_mcuProcessed;
+        if(++information.m_mcuProcessedX == information.m_mcuNumberX)
+        {
+            information.m_mcuProcessedX = 0;
+            ++information.m_mcuProcessedY;
+        }
+    }
+
+    IMEBRA_FUNCTION_END();
+}
+
+
+///////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////
+//
+//
+// Return true if the restart intervals of the active scan
+//  can be decoded independently
+//
+//
+///////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////
+bool jpegImageCodec::canReadRestartIntervalsInParallel(const jpeg::jpegInformation& information) const
+{
+    IMEBRA_FUNCTION_START();
+
+    if(information.m_mcuPerRestartInterval == 0 ||
+            information.m_mcuNumberTotal <= information.m_mcuPerRestartInterval ||
+            information.m_eobRun != 0)
+    {
+        return false;
+    }
 
-            ++information.m_mcuProcessed;
-            if(++information.m_mcuProcessedX == information.m_mcuNumberX)
+    // The lossless amplitudes are decoded in parallel and
+    //  then predicted sample by sample: each MCU must
+    //  contain one sample per channel and the channel must
+    //  contain exactly one sample per MCU, because the
+    //  amplitudes are stored at the sample's position in a
+    //  buffer of m_mcuNumberTotal elements
+    ///////////////////////////////////////////////////////////
+    if(information.m_bLossless)
+    {
+        for(const std::shared_ptr<jpeg::jpegChannel>& pChannel: information.m_channelsList)
+        {
+            if(pChannel->m_blockMcuXY != 1 ||
+                    (std::uint64_t)pChannel->m_width * (std::uint64_t)pChannel->m_height != (std::uint64_t)information.m_mcuNumberTotal)
             {
-                information.m_mcuProcessedX = 0;
-                ++information.m_mcuProcessedY;
+                return false;
             }
         }
+        return true;
     }
 
-    // Process unprocessed lossless amplitudes
+    // Only full spectral scans (no progressive scans)
     ///////////////////////////////////////////////////////////
-    for(jpeg::jpegInformation::tChannelsMap::iterator processLosslessIterator = information.m_channelsMap.begin();
-        processLosslessIterator != information.m_channelsMap.end();
-        ++processLosslessIterator)
+    return information.m_spectralIndexStart == 0 && information.m_spectralIndexEnd >= 63;
+
+    IMEBRA_FUNCTION_END();
+}
+
+
+///////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////
+//
+//
+// Copy the entropy coded data of the active scan into
+//  memory, splitting it at the RST markers.
+// Each segment keeps the marker that terminates it, so the
+//  decoder finds the end of the data exactly as it does in
+//  the original stream.
+// The source stream is left on the tag that follows the
+//  scan.
+//
+//
+///////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////
+void jpegImageCodec::readRestartSegments(streamReader& sourceStream, stringUint8& scanData, std::vector<jpeg::restartSegment>& segments) const
+{
+    IMEBRA_FUNCTION_START();
+
+    // The first segment isn't preceded by a RST marker
+    ///////////////////////////////////////////////////////////
+    jpeg::restartSegment segment;
+    segment.m_start = 0;
+    segment.m_markerId = 0xff;
+
+    for(;;)
     {
-        processLosslessIterator->second->processUnprocessedAmplitudes();
+        const std::uint8_t* pData;
+        const size_t availableBytes(sourceStream.getBufferedData(&pData));
+        if(availableBytes == 0)
+        {
+            break;
+        }
+
+        const std::uint8_t* pFF((const std::uint8_t*)::memchr(pData, 0xff, availableBytes));
+        const size_t plainBytes(pFF == nullptr ? availableBytes : (size_t)(pFF - pData));
+        scanData.append(pData, plainBytes);
+        sourceStream.consumeBufferedData(plainBytes);
+        if(pFF == nullptr)
+        {
+            continue;
+        }
+
+        // Skip the fill bytes
+        ///////////////////////////////////////////////////////////
+        std::uint8_t byte(0xff);
+        while(byte == 0xff && !sourceStream.endReached())
+        {
+            sourceStream.read(&byte, 1);
+        }
+        if(byte == 0xff)
+        {
+            break;
+        }
+
+        // Stuffed 0xff: keep it in the segment
+        ///////////////////////////////////////////////////////////
+        if(byte == 0)
+        {
+            scanData.push_back(0xff);
+            scanData.push_back(0);
+            continue;
+        }
+
+        // A RST marker closes the segment
+        ///////////////////////////////////////////////////////////
+        if(byte >= 0xd0 && byte <= 0xd7)
+        {
+            scanData.push_back(0xff);
+            scanData.push_back(byte);
+            segment.m_length = scanData.size() - segment.m_start;
+            segments.push_back(segment);
+            segment.m_start = scanData.size();
+            segment.m_markerId = (std::uint8_t)(byte & 0x7);
+            continue;
+        }
+
+        // Any other tag ends the scan: leave it to the tags
+        //  parser
+        ///////////////////////////////////////////////////////////
+        sourceStream.seek(sourceStream.position() - 2);
+        break;
     }
 
+    scanData.push_back(0xff);
+    scanData.push_back((std::uint8_t)tTagId::eoi);
+    segment.m_length = scanData.size() - segment.m_start;
+    segments.push_back(segment);
 
-    // If the compression is jpeg baseline or jpeg extended
-    //  then the color space cannot be "RGB"
+    IMEBRA_FUNCTION_END();
+}
+
+
+///////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////
+//
+//
+// Decode the restart intervals of the active scan in
+//  parallel
+//
+//
+///////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////
+void jpegImageCodec::readRestartIntervalsInParallel(streamReader& sourceStream, jpeg::jpegInformation& information, size_t maxThreads) const
+{
+    IMEBRA_FUNCTION_START();
+
+    std::unique_ptr<stringUint8> pScanData(new stringUint8());
+    std::vector<jpeg::restartSegment> segments;
+    readRestartSegments(sourceStream, *pScanData, segments);
+    std::shared_ptr<memory> pScanMemory(std::make_shared<memory>(pScanData.release()));
+
+    // Assign a restart interval to each segment, as done
+    //  by tagRST::readTag(): missing RST markers cause the
+    //  skipped intervals to be left empty
     ///////////////////////////////////////////////////////////
-    if(colorSpace == "RGB" && (transferSyntax == "1.2.840.10008.1.2.4.50" ||  // baseline (8 bits lossy)
-                transferSyntax == "1.2.840.10008.1.2.4.51"))    // extended (12 bits lossy)
+    const std::uint32_t mcuPerRestartInterval(information.m_mcuPerRestartInterval);
+    const std::uint32_t restartIntervals((information.m_mcuNumberTotal + mcuPerRestartInterval - 1) / mcuPerRestartInterval);
+    std::uint32_t restartInterval(0);
+    for(size_t scanSegments(1); scanSegments < segments.size(); ++scanSegments)
+    {
+        std::uint32_t nextRestartInterval(restartInterval + 1);
+        nextRestartInterval += (std::uint32_t)((segments[scanSegments].m_markerId - (restartInterval & 0x7) + 8) & 0x7);
+        restartInterval = nextRestartInterval;
+        segments[scanSegments].m_restartInterval = restartInterval;
+    }
+    segments[0].m_restartInterval = 0;
+    while(!segments.empty() && segments.back().m_restartInterval >= restartIntervals)
     {
-        return copyJpegChannelsToImage(information, b2Complement, "YBR_FULL");
+        segments.pop_back();
     }
 
-    return copyJpegChannelsToImage(information, b2Complement, colorSpace);
+    // Lossless images: the workers store the amplitudes in
+    //  a separate buffer, the prediction runs when all the
+    //  amplitudes are available
+    ///////////////////////////////////////////////////////////
+    std::vector<std::vector<std::int32_t> > losslessAmplitudes(information.m_channelsList.size());
+    if(information.m_bLossless)
+    {
+        for(std::vector<std::int32_t>& channelAmplitudes: losslessAmplitudes)
+        {
+            channelAmplitudes.resize(information.m_mcuNumberTotal);
+        }
+    }
 
-    IMEBRA_FUNCTION_END_MODIFY(StreamEOFError, CodecCorruptedFileError);
+    // Each worker decodes a restart interval at a time,
+    //  using private copies of the scan state
+    ///////////////////////////////////////////////////////////
+    std::atomic<size_t> nextSegment(0);
+    std::shared_ptr<threadPool> pThreadPool(threadPool::getThreadPool());
+    const size_t workers(std::min(segments.size(), maxThreads));
+    pThreadPool->parallelFor(workers, workers, [&](size_t)
+    {
+        jpeg::jpegInformation workerInformation(information);
+        workerInformation.m_channelsList.clear();
+        size_t channelIndex(0);
+        for(const std::shared_ptr<jpeg::jpegChannel>& pChannel: information.m_channelsList)
+        {
+            std::shared_ptr<jpeg::jpegChannel> pWorkerChannel(std::make_shared<jpeg::jpegChannel>(*pChannel));
+            if(information.m_bLossless)
+            {
+                pWorkerChannel->m_pBuffer = losslessAmplitudes[channelIndex++].data();
+                pWorkerChannel->m_defaultDCValue = 0;
+            }
+            workerInformation.m_channelsList.push_back(pWorkerChannel);
+        }
+        if(information.m_bLossless)
+        {
+            // Predictor 0 stores the amplitudes as they are
+            ///////////////////////////////////////////////////////////
+            workerInformation.m_spectralIndexStart = 0;
+        }
+
+        for(size_t segmentIndex(nextSegment++); segmentIndex < segments.size(); segmentIndex = nextSegment++)
+        {
+            const jpeg::restartSegment& segment(segments[segmentIndex]);
+            const std::uint32_t firstMcu(segment.m_restartInterval * mcuPerRestartInterval);
+            const std::uint32_t lastMcu(std::min(firstMcu + mcuPerRestartInterval, information.m_mcuNumberTotal));
+
+            workerInformation.m_mcuProcessed = firstMcu;
+            workerInformation.m_mcuLastRestart = firstMcu;
+            workerInformation.m_mcuProcessedY = firstMcu / information.m_mcuNumberX;
+            workerInformation.m_mcuProcessedX = firstMcu - workerInformation.m_mcuProcessedY * information.m_mcuNumberX;
+            workerInformation.m_eobRun = 0;
+            for(const std::shared_ptr<jpeg::jpegChannel>& pChannel: workerInformation.m_channelsList)
+            {
+                pChannel->m_lastDCValue = pChannel->m_defaultDCValue;
+                pChannel->m_losslessPositionX = workerInformation.m_mcuProcessedX;
+                pChannel->m_losslessPositionY = workerInformation.m_mcuProcessedY;
+                pChannel->m_unprocessedAmplitudesCount = 0;
+            }
+
+            jpegStreamReader segmentStream(std::make_shared<streamReader>(std::make_shared<memoryStreamInput>(pScanMemory), segment.m_start, segment.m_length));
+            readMcus(segmentStream, workerInformation, lastMcu);
+
+            for(const std::shared_ptr<jpeg::jpegChannel>& pChannel: workerInformation.m_channelsList)
+            {
+                pChannel->processUnprocessedAmplitudes();
+            }
+        }
+    });
+
+    // Apply the lossless prediction, one channel per thread
+    ///////////////////////////////////////////////////////////
+    if(information.m_bLossless)
+    {
+        std::vector<std::shared_ptr<jpeg::jpegChannel> > channels(information.m_channelsList.begin(), information.m_channelsList.end());
+        pThreadPool->parallelFor(channels.size(), maxThreads, [&](size_t channelIndex)
+        {
+            jpeg::jpegChannel& channel(*(channels[channelIndex]));
+            const std::int32_t* pAmplitudes(losslessAmplitudes[channelIndex].data());
+            channel.m_losslessPositionX = 0;
+            channel.m_losslessPositionY = 0;
+            channel.m_unprocessedAmplitudesCount = 0;
+            for(std::uint32_t scanMcu(0); scanMcu != information.m_mcuNumberTotal; ++scanMcu)
+            {
+                channel.addUnprocessedAmplitude(pAmplitudes[scanMcu], information.m_spectralIndexStart, scanMcu % mcuPerRestartInterval == 0);
+            }
+            channel.processUnprocessedAmplitudes();
+        });
+    }
+
+    information.m_mcuProcessed = information.m_mcuNumberTotal;
+    information.m_mcuLastRestart = information.m_mcuNumberTotal;
+    information.m_mcuProcessedX = 0;
+    information.m_mcuProcessedY = information.m_mcuNumberY;
+
+    IMEBRA_FUNCTION_END();
 }
 
 
@@ -555,7 +978,14 @@ std::shared_ptr<image> jpegImageCodec::copyJpegChannelsToImage(
     else
         depth = (information.m_precision==8) ? bitDepth_t::depthU8 : bitDepth_t::depthU16;
 
-    std::shared_ptr<image> destImage(std::make_shared<image>(information.m_imageWidth, information.m_imageHeight, depth, colorSpace, (std::uint8_t)(information.m_precision-1)));
+    // The lossy images may have been decoded at a reduced
+    //  resolution
+    ///////////////////////////////////////////////////////////
+    const std::uint32_t scaleShift((information.m_bLossless || information.m_bProgressive) ? 0 : information.m_scaleShift);
+    const std::uint32_t imageWidth((information.m_imageWidth + ((std::uint32_t)1 << scaleShift) - 1) >> scaleShift);
+    const std::uint32_t imageHeight((information.m_imageHeight + ((std::uint32_t)1 << scaleShift) - 1) >> scaleShift);
+
+    std::shared_ptr<image> destImage(std::make_shared<image>(imageWidth, imageHeight, depth, colorSpace, (std::uint8_t)(information.m_precision-1)));
 
     std::shared_ptr<handlers::writingDataHandlerNumericBase> handler = destImage->getWritingDataHandler();
 
@@ -642,8 +1072,16 @@ std::shared_ptr<image> jpegImageCodec::copyJpegChannelsToImage(
 
         // Lossy interleaved
         ///////////////////////////////////////////////////////////
-        std::uint32_t totalBlocksY(pChannel->m_height >> 3);
-        std::uint32_t totalBlocksX(pChannel->m_width >> 3);
+        // The subsampled channels may have been reduced less
+        //  than the image: they are replicated less
+        ///////////////////////////////////////////////////////////
+        const std::uint32_t blockWidth((std::uint32_t)8 >> pChannel->m_scaleShiftX);
+        const std::uint32_t blockHeight((std::uint32_t)8 >> pChannel->m_scaleShiftY);
+        runX >>= (scaleShift - pChannel->m_scaleShiftX);
+        runY >>= (scaleShift - pChannel->m_scaleShiftY);
+
+        std::uint32_t totalBlocksY(pChannel->m_height / blockHeight);
+        std::uint32_t totalBlocksX(pChannel->m_width / blockWidth);
 
         std::int32_t* pSourceBuffer(pChannel->m_pBuffer);
 
@@ -651,11 +1089,11 @@ std::shared_ptr<image> jpegImageCodec::copyJpegChannelsToImage(
         for(std::uint32_t scanBlockY = 0; scanBlockY < totalBlocksY; ++scanBlockY)
         {
             std::uint32_t startCol(0);
-            std::uint32_t endRow(startRow + (runY << 3));
+            std::uint32_t endRow(startRow + runY * blockHeight);
 
             for(std::uint32_t scanBlockX = 0; scanBlockX < totalBlocksX; ++scanBlockX)
             {
-                std::uint32_t endCol = startCol + (runX << 3);
+                std::uint32_t endCol = startCol + runX * blockWidth;
                 handler->copyFromInt32Interleaved(
                             pSourceBuffer,
                             runX, runY,
@@ -664,10 +1102,10 @@ std::shared_ptr<image> jpegImageCodec::copyJpegChannelsToImage(
                             endCol,
                             endRow,
                             destChannelNumber,
-                            information.m_imageWidth, information.m_imageHeight,
+                            imageWidth, imageHeight,
                             (std::uint32_t)information.m_channelsMap.size());
 
-                pSourceBuffer += 64;
+                pSourceBuffer += blockWidth * blockHeight;
                 startCol = endCol;
             }
             startRow = endRow;
@@ -903,6 +1341,7 @@ void jpegImageCodec::setImage(
     ////////////////////////////////////////////////////////////////
     jpeg::jpegInformation information;
     information.reset(imageQuality);
+    information.m_mcuPerRestartInterval = codecFactory::getCodecFactory()->getJpegRestartInterval();
 
     information.m_bLossless = transferSyntax == "1.2.840.10008.1.2.4.57" ||  // lossless NH
             transferSyntax == "1.2.840.10008.1.2.4.70";    // lossless NH first order prediction
@@ -922,6 +1361,13 @@ void jpegImageCodec::setImage(
     ////////////////////////////////////////////////////////////////
     writeTag(pDestinationStream, tTagId::dqt, information);
 
+    // Write the restart interval
+    ////////////////////////////////////////////////////////////////
+    if(information.m_mcuPerRestartInterval != 0)
+    {
+        writeTag(pDestinationStream, tTagId::dri, information);
+    }
+
     for(int phase = 0; phase < 2; ++phase)
     {
         if(phase == 1)
@@ -991,6 +1437,26 @@ void jpegImageCodec::writeScan(streamWriter* pDestinationStream, jpeg::jpegInfor
 
     while(information.m_mcuProcessed < information.m_mcuNumberTotal)
     {
+        // Start a new restart interval: reset the predictors and
+        //  write the RST marker on a byte boundary
+        ///////////////////////////////////////////////////////////
+        const bool bRestart(information.m_mcuPerRestartInterval != 0 &&
+                            information.m_mcuProcessed != 0 &&
+                            information.m_mcuProcessed % information.m_mcuPerRestartInterval == 0);
+        if(bRestart)
+        {
+            for(const std::shared_ptr<jpeg::jpegChannel>& pChannel: information.m_channelsList)
+            {
+                pChannel->m_lastDCValue = pChannel->m_defaultDCValue;
+            }
+            if(!bCalcHuffman)
+            {
+                pDestinationStream->resetOutBitsBuffer();
+                const std::uint32_t restartInterval(information.m_mcuProcessed / information.m_mcuPerRestartInterval - 1);
+                writeTag(pDestinationStream, (tTagId)((std::uint8_t)tTagId::rst0 + (restartInterval & 0x7)), information);
+            }
+        }
+
         // Write an MCU
         ///////////////////////////////////////////////////////////
 
@@ -1008,7 +1474,12 @@ void jpegImageCodec::writeScan(streamWriter* pDestinationStream, jpeg::jpegInfor
                 for(std::uint32_t scanBlock = pChannel->m_blockMcuXY; scanBlock != 0; --scanBlock)
                 {
                     std::int32_t value(*pBuffer);
-                    if(pChannel->m_losslessPositionX == 0 && pChannel->m_losslessPositionY != 0)
+
+                    // The first sample of a restart interval is
+                    //  predicted from the default value
+                    ///////////////////////////////////////////////////////////
+                    if(pChannel->m_losslessPositionX == 0 && pChannel->m_losslessPositionY != 0 &&
+                            !(bRestart && scanBlock == pChannel->m_blockMcuXY))
                     {
                         lastValue = *(pBuffer - pChannel->m_width);
                     }
@@ -1123,6 +1594,7 @@ inline void jpegImageCodec::readBlock(jpegStreamReader& stream, jpeg::jpegInform
 
     std::int32_t value = 0;
     std::int32_t oldValue;
+    std::int32_t amplitude;
 
     // Scan the specified spectral values
     /////////////////////////////////////////////////////////////////
@@ -1142,7 +1614,7 @@ inline void jpegImageCodec::readBlock(jpegStreamReader& stream, jpeg::jpegInform
         std::uint32_t hufCode;
         if(spectralIndex != 0)
         {
-            hufCode = pChannel->m_pActiveHuffmanTableAC->readHuffmanCode(stream);
+            hufCode = pChannel->m_pActiveHuffmanTableAC->readHuffmanCodeAndAmplitude(stream, &amplitude);
 
             // End of block reached
             /////////////////////////////////////////////////////////////////
@@ -1155,7 +1627,7 @@ inline void jpegImageCodec::readBlock(jpegStreamReader& stream, jpeg::jpegInform
         }
         else
         {
-            hufCode = pChannel->m_pActiveHuffmanTableDC->readHuffmanCode(stream);
+            hufCode = pChannel->m_pActiveHuffmanTableDC->readHuffmanCodeAndAmplitude(stream, &amplitude);
         }
 
 
@@ -1176,20 +1648,9 @@ inline void jpegImageCodec::readBlock(jpegStreamReader& stream, jpeg::jpegInform
         /////////////////////////////////////////////////////////////////
         if(spectralIndex == 0 || amplitudeLength != 0 || runLength == 0xf)
         {
-            // Read coeff
+            // The coeff has been read together with the huffman code
             /////////////////////////////////////////////////////////////////
-            if(amplitudeLength != 0)
-            {
-                value = (std::int32_t)(stream.readBits(amplitudeLength));
-                if(value < ((std::int32_t)1 << (amplitudeLength-1)) )
-                {
-                    value -= ((std::int32_t)1 << amplitudeLength) - 1;
-                }
-            }
-            else
-            {
-                value = 0;
-            }
+            value = amplitude;
 
             spectralIndex += runLength;
 
@@ -1246,7 +1707,14 @@ inline void jpegImageCodec::writeBlock(streamWriter* pStream, jpeg::jpegInformat
 
     if(bCalcHuffman)
     {
-        FDCT(pBuffer, information.m_compressionQuantizationTable[pChannel->m_quantTable]);
+        if(information.m_simdInstructions == simdInstructions_t::none)
+        {
+            FDCT(pBuffer, information.m_compressionQuantizationTable[pChannel->m_quantTable]);
+        }
+        else
+        {
+            jpeg::FDCTSimd(information.m_simdInstructions, pBuffer, information.m_compressionQuantizationTable[pChannel->m_quantTable].data());
+        }
     }
 
     // Scan the specified spectral values
@@ -1700,6 +2168,107 @@ void jpegImageCodec::IDCT(std::int32_t* pIOMatrix, std::array<long long, 64>& pS
     }
 }
 
+
+namespace
+{
+
+///////////////////////////////////////////////////////////
+//
+// Cosine basis of the reduced IDCTs. For each block size
+//  N = 8 >> scaleShift the item [x][u] is
+//  C(u)/2 * cos((2x + 1) * u * pi / 2N)
+//
+///////////////////////////////////////////////////////////
+struct reducedIdctBasis
+{
+    reducedIdctBasis()
+    {
+        const double pi(3.14159265358979323846);
+        for(std::uint32_t scaleShift(0); scaleShift != 4; ++scaleShift)
+        {
+            const std::uint32_t blockSize((std::uint32_t)8 >> scaleShift);
+            for(std::uint32_t x(0); x != blockSize; ++x)
+            {
+                for(std::uint32_t u(0); u != blockSize; ++u)
+                {
+                    const double c(u == 0 ? 1.0 / std::sqrt(2.0) : 1.0);
+                    m_basis[scaleShift][x][u] = (float)(c / 2.0 * std::cos((double)((2 * x + 1) * u) * pi / (double)(2 * blockSize)));
+                }
+            }
+        }
+    }
+
+    float m_basis[4][8][8];
+};
+
+} // anonymous namespace
+
+
+/////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////
+//
+//
+// Reduced IDCT: evaluates the lowest frequencies at the
+//  center of each group of pixels represented by an output
+//  value.
+// The DC only version just returns the block's average.
+//
+// Values must be Zero centered (-x...0...+x)
+//
+//
+/////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////
+void jpegImageCodec::IDCTScaled(const std::int32_t* pCoefficients, const std::uint32_t* pQuantizationTable, std::uint32_t scaleShiftX, std::uint32_t scaleShiftY, std::int32_t* pOutput) const
+{
+    if(scaleShiftX == 3 && scaleShiftY == 3)
+    {
+        *pOutput = (std::int32_t)(((std::int64_t)pCoefficients[0] * (std::int64_t)pQuantizationTable[0] + 4) >> 3);
+        return;
+    }
+
+    static const reducedIdctBasis basis;
+    const float (*pBasisX)[8](basis.m_basis[scaleShiftX]);
+    const float (*pBasisY)[8](basis.m_basis[scaleShiftY]);
+    const std::uint32_t blockWidth((std::uint32_t)8 >> scaleShiftX);
+    const std::uint32_t blockHeight((std::uint32_t)8 >> scaleShiftY);
+
+    // Rows IDCT on the dequantized low frequencies
+    /////////////////////////////////////////////////////////////////
+    float rows[8][8];
+    for(std::uint32_t v(0); v != blockHeight; ++v)
+    {
+        float dequantized[8];
+        for(std::uint32_t u(0); u != blockWidth; ++u)
+        {
+            dequantized[u] = (float)pCoefficients[v * 8 + u] * (float)pQuantizationTable[v * 8 + u];
+        }
+        for(std::uint32_t x(0); x != blockWidth; ++x)
+        {
+            float value(0);
+            for(std::uint32_t u(0); u != blockWidth; ++u)
+            {
+                value += pBasisX[x][u] * dequantized[u];
+            }
+            rows[v][x] = value;
+        }
+    }
+
+    // Columns IDCT
+    /////////////////////////////////////////////////////////////////
+    for(std::uint32_t y(0); y != blockHeight; ++y)
+    {
+        for(std::uint32_t x(0); x != blockWidth; ++x)
+        {
+            float value(0);
+            for(std::uint32_t v(0); v != blockHeight; ++v)
+            {
+                value += pBasisY[y][v] * rows[v][x];
+            }
+            *pOutput++ = (std::int32_t)std::floor(value + 0.5f);
+        }
+    }
+}
+
 } // namespace codecs
 
 } // namespace implementation
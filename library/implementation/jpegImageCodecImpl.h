@@ -21,8 +21,10 @@ If you do not want to be bound by the GPL terms (such as the requirement
 
 #include "imageCodecImpl.h"
 #include "jpegCodecBaseImpl.h"
+#include "memoryImpl.h"
 #include <map>
 #include <list>
+#include <vector>
 
 
 namespace imebra
@@ -65,6 +67,24 @@ public:
                                             std::uint8_t highBit,
                                             std::shared_ptr<streamReader> pSourceStream) const override;
 
+    // Retrieve the image at a reduced resolution: the lossy
+    //  images are decoded with reduced IDCTs
+    ///////////////////////////////////////////////////////////
+    virtual std::shared_ptr<image> getScaledImage(const std::string& transferSyntax,
+                                                  const std::string& colorSpace,
+                                                  std::uint32_t channelsNumber,
+                                                  std::uint32_t imageWidth,
+                                                  std::uint32_t imageHeight,
+                                                  bool bSubSampledX,
+                                                  bool bSubSampledY,
+                                                  bool bInterleaved,
+                                                  bool b2Complement,
+                                                  std::uint8_t allocatedBits,
+                                                  std::uint8_t storedBits,
+                                                  std::uint8_t highBit,
+                                                  imageScale_t scale,
+                                                  std::shared_ptr<streamReader> pSourceStream) const override;
+
     // Return the default planar configuration
     ///////////////////////////////////////////////////////////
     virtual bool defaultInterleaved() const override;
@@ -96,12 +116,25 @@ public:
     ///////////////////////////////////////////////////////////
     virtual std::uint32_t suggestAllocatedBits(const std::string& transferSyntax, std::uint32_t highBit) const override;
 
-    // FDCT/IDCT
+    // FDCT/IDCT: portable reference implementation.
+    // The vectorized versions are declared in jpegDctImpl.h
     ///////////////////////////////////////////////////////////
     void FDCT(std::int32_t* pIOMatrix, std::array<float, 64>& pDescaleFactors) const;
     void IDCT(std::int32_t* pIOMatrix, std::array<long long, 64>& pScaleFactors) const;
 
+    // Reduced IDCT: decodes an 8x8 block of coefficients
+    //  into a block of (8 >> scaleShiftX) x
+    //  (8 >> scaleShiftY) pixels by using only the lowest
+    //  frequencies
+    ///////////////////////////////////////////////////////////
+    void IDCTScaled(const std::int32_t* pCoefficients, const std::uint32_t* pQuantizationTable, std::uint32_t scaleShiftX, std::uint32_t scaleShiftY, std::int32_t* pOutput) const;
+
 private:
+    // Decode the image. scaleShift is used only by the
+    //  lossy images
+    ///////////////////////////////////////////////////////////
+    std::shared_ptr<image> decodeImage(const std::string& transferSyntax, const std::string& colorSpace, bool b2Complement, std::uint32_t scaleShift, std::shared_ptr<streamReader> pSourceStream) const;
+
     // Read a lossy block of pixels
     ///////////////////////////////////////////////////////////
     inline void readBlock(jpegStreamReader& stream, jpeg::jpegInformation& information, std::int32_t* pBuffer, const std::shared_ptr<jpeg::jpegChannel>& pChannel) const;
@@ -110,6 +143,17 @@ private:
     ///////////////////////////////////////////////////////////
     inline void writeBlock(streamWriter* pStream, jpeg::jpegInformation& information, std::int32_t* pBuffer, const std::shared_ptr<jpeg::jpegChannel>& pChannel, bool bCalcHuffman) const;
 
+    // Read the MCUs of the active scan until nextMcuStop or
+    //  the end of the stream
+    ///////////////////////////////////////////////////////////
+    void readMcus(jpegStreamReader& stream, jpeg::jpegInformation& information, std::uint32_t nextMcuStop) const;
+
+    // Parallel decoding of the restart intervals
+    ///////////////////////////////////////////////////////////
+    bool canReadRestartIntervalsInParallel(const jpeg::jpegInformation& information) const;
+    void readRestartSegments(streamReader& sourceStream, stringUint8& scanData, std::vector<jpeg::restartSegment>& segments) const;
+    void readRestartIntervalsInParallel(streamReader& sourceStream, jpeg::jpegInformation& information, size_t maxThreads) const;
+
     std::shared_ptr<image> copyJpegChannelsToImage(jpeg::jpegInformation& information, bool b2complement, const std::string& colorSpace) const;
     void copyImageToJpegChannels(jpeg::jpegInformation& information, std::shared_ptr<const image> sourceImage, bool b2complement, std::uint32_t allocatedBits, bool bSubSampledX, bool bSubSampledY) const;
 
@@ -131,7 +131,7 @@ void jpegStreamCodec::writeStream(std::shared_ptr<streamWriter> pStream, std::sh
 //
 /////////////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////////////
-void jpegStreamCodec::readStream(std::shared_ptr<streamReader> pStream, std::shared_ptr<dataSet> pDataSet, std::uint32_t /* maxSizeBufferLoad = 0xffffffff */) const
+void jpegStreamCodec::readStream(std::shared_ptr<streamReader> pStream, std::shared_ptr<dataSet> pDataSet, std::uint32_t /* maxSizeBufferLoad = 0xffffffff */, std::uint32_t /* stopAtTag = 0xffffffff */, const tagFilter_t& /* tagFilter = tagFilter_t() */) const
 {
     IMEBRA_FUNCTION_START();
 
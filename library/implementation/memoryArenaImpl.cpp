@@ -0,0 +1,128 @@
+/*
+Copyright 2005 - 2017 by Paolo Brandoli/Binarno s.p.
+
+Imebra is available for free under the GNU General Public License.
+
+The full text of the license is available in the file license.rst
+ in the project root folder.
+
+If you do not want to be bound by the GPL terms (such as the requirement
+ that your application must also be GPL), you may purchase a commercial
+ license for Imebra from the Imebra’s website (http://imebra.com).
+*/
+
+/*! \file memoryArenaImpl.cpp
+    \brief Implementation of the arena that allocates the objects of a
+            loaded dataSet.
+
+*/
+
+#include "memoryArenaImpl.h"
+#include "exceptionImpl.h"
+
+namespace imebra
+{
+
+namespace implementation
+{
+
+///////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////
+//
+//
+//
+// memoryArena
+//
+//
+//
+///////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////
+memoryArena::memoryArena():
+    m_pFree(nullptr),
+    m_freeSize(0),
+    m_nextBlockSize(IMEBRA_MEMORY_ARENA_FIRST_BLOCK_SIZE),
+    m_reservedSize(0)
+{
+}
+
+memoryArena::~memoryArena()
+{
+}
+
+
+///////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////
+//
+//
+// Allocate a region from the current block, or from a
+//  new block
+//
+//
+///////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////
+void* memoryArena::allocate(size_t size, size_t alignment)
+{
+    IMEBRA_FUNCTION_START();
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    const size_t padding((alignment - reinterpret_cast<std::uintptr_t>(m_pFree) % alignment) % alignment);
+    if(m_pFree == nullptr || padding + size > m_freeSize)
+    {
+        // Regions larger than half block get a dedicated block,
+        //  so the current block can still be used
+        ///////////////////////////////////////////////////////////
+        const size_t blockSize(size > m_nextBlockSize / 2 ? size : m_nextBlockSize);
+        const size_t blockElements((blockSize + sizeof(std::max_align_t) - 1) / sizeof(std::max_align_t));
+        m_blocks.emplace_back(new std::max_align_t[blockElements]);
+        m_reservedSize += blockElements * sizeof(std::max_align_t);
+
+        std::uint8_t* pBlock(reinterpret_cast<std::uint8_t*>(m_blocks.back().get()));
+        if(blockSize != m_nextBlockSize)
+        {
+            return pBlock;
+        }
+
+        m_pFree = pBlock;
+        m_freeSize = blockElements * sizeof(std::max_align_t);
+        if(m_nextBlockSize < IMEBRA_MEMORY_ARENA_MAX_BLOCK_SIZE)
+        {
+            m_nextBlockSize *= 2;
+        }
+
+        std::uint8_t* pAllocated(m_pFree);
+        m_pFree += size;
+        m_freeSize -= size;
+        return pAllocated;
+    }
+
+    std::uint8_t* pAllocated(m_pFree + padding);
+    m_pFree = pAllocated + size;
+    m_freeSize -= padding + size;
+    return pAllocated;
+
+    IMEBRA_FUNCTION_END();
+}
+
+
+///////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////
+//
+//
+// Return the size of the allocated blocks
+//
+//
+///////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////
+size_t memoryArena::getReservedSize() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    return m_reservedSize;
+}
+
+} // namespace implementation
+
+} // namespace imebra
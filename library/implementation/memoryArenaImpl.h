@@ -0,0 +1,179 @@
+/*
+Copyright 2005 - 2017 by Paolo Brandoli/Binarno s.p.
+
+Imebra is available for free under the GNU General Public License.
+
+The full text of the license is available in the file license.rst
+ in the project root folder.
+
+If you do not want to be bound by the GPL terms (such as the requirement
+ that your application must also be GPL), you may purchase a commercial
+ license for Imebra from the Imebra’s website (http://imebra.com).
+*/
+
+/*! \file memoryArenaImpl.h
+    \brief Declaration of the arena that allocates the objects of a
+            loaded dataSet.
+
+*/
+
+#if !defined(imebraMemoryArena_3B8E61D4_7F20_4C59_9A6E_D21C05F8B7A3__INCLUDED_)
+#define imebraMemoryArena_3B8E61D4_7F20_4C59_9A6E_D21C05F8B7A3__INCLUDED_
+
+#include <memory>
+#include <mutex>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+#if(!defined IMEBRA_MEMORY_ARENA_FIRST_BLOCK_SIZE)
+    #define IMEBRA_MEMORY_ARENA_FIRST_BLOCK_SIZE 4096
+#endif
+#if(!defined IMEBRA_MEMORY_ARENA_MAX_BLOCK_SIZE)
+    #define IMEBRA_MEMORY_ARENA_MAX_BLOCK_SIZE 65536
+#endif
+#if(!defined IMEBRA_MEMORY_ARENA_MAX_VALUE_SIZE)
+    #define IMEBRA_MEMORY_ARENA_MAX_VALUE_SIZE 256
+#endif
+
+namespace imebra
+{
+
+namespace implementation
+{
+
+///////////////////////////////////////////////////////////
+/// \brief A bump allocator that serves the small objects
+///        of one dataSet.
+///
+/// The memory is taken from blocks that grow from
+///  IMEBRA_MEMORY_ARENA_FIRST_BLOCK_SIZE up to
+///  IMEBRA_MEMORY_ARENA_MAX_BLOCK_SIZE bytes. The
+///  allocations are never released individually: all the
+///  blocks are released together when the arena is
+///  destroyed.
+///
+/// The objects allocated through arenaAllocator keep a
+///  reference to the arena, so the arena lives until the
+///  last of them is destroyed.
+///
+///////////////////////////////////////////////////////////
+class memoryArena
+{
+public:
+    memoryArena();
+
+    ~memoryArena();
+
+    memoryArena(const memoryArena&) = delete;
+    memoryArena& operator=(const memoryArena&) = delete;
+
+    /// \brief Allocate a region from the arena.
+    ///
+    /// Thread safe.
+    ///
+    /// \param size      the number of bytes to allocate
+    /// \param alignment the alignment of the region. Must be
+    ///                   a power of 2 not greater than
+    ///                   alignof(std::max_align_t)
+    /// \return a pointer to the allocated region
+    ///
+    ///////////////////////////////////////////////////////////
+    void* allocate(size_t size, size_t alignment);
+
+    /// \brief Return the number of bytes reserved by the
+    ///        arena's blocks.
+    ///
+    ///////////////////////////////////////////////////////////
+    size_t getReservedSize() const;
+
+private:
+    std::vector<std::unique_ptr<std::max_align_t[]> > m_blocks;
+
+    std::uint8_t* m_pFree;
+    size_t m_freeSize;
+    size_t m_nextBlockSize;
+    size_t m_reservedSize;
+
+    mutable std::mutex m_mutex;
+};
+
+
+///////////////////////////////////////////////////////////
+/// \brief Standard allocator that takes the memory from
+///        a memoryArena.
+///
+/// deallocate() does nothing: the memory is released with
+///  the arena.
+///
+///////////////////////////////////////////////////////////
+template <class T>
+class arenaAllocator
+{
+    template <class U> friend class arenaAllocator;
+
+public:
+    typedef T value_type;
+
+    template <class U>
+    struct rebind
+    {
+        typedef arenaAllocator<U> other;
+    };
+
+    explicit arenaAllocator(const std::shared_ptr<memoryArena>& pArena): m_pArena(pArena)
+    {
+    }
+
+    template <class U>
+    arenaAllocator(const arenaAllocator<U>& source): m_pArena(source.m_pArena)
+    {
+    }
+
+    T* allocate(size_t n)
+    {
+        return static_cast<T*>(m_pArena->allocate(n * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T*, size_t)
+    {
+    }
+
+    template <class U>
+    bool operator==(const arenaAllocator<U>& other) const
+    {
+        return m_pArena == other.m_pArena;
+    }
+
+    template <class U>
+    bool operator!=(const arenaAllocator<U>& other) const
+    {
+        return m_pArena != other.m_pArena;
+    }
+
+private:
+    std::shared_ptr<memoryArena> m_pArena;
+};
+
+
+///////////////////////////////////////////////////////////
+/// \brief Create an object in the arena, or on the heap
+///        when pArena is null.
+///
+///////////////////////////////////////////////////////////
+template <class T, class... Args>
+std::shared_ptr<T> allocateShared(const std::shared_ptr<memoryArena>& pArena, Args&&... args)
+{
+    if(pArena == nullptr)
+    {
+        return std::make_shared<T>(std::forward<Args>(args)...);
+    }
+    return std::allocate_shared<T>(arenaAllocator<T>(pArena), std::forward<Args>(args)...);
+}
+
+} // namespace implementation
+
+} // namespace imebra
+
+#endif // !defined(imebraMemoryArena_3B8E61D4_7F20_4C59_9A6E_D21C05F8B7A3__INCLUDED_)
@@ -51,17 +51,26 @@ namespace implementation
 ///////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////
 memory::memory():
-    m_pMemoryBuffer(new stringUint8())
+    m_pMemoryBuffer(new stringUint8()),
+    m_pExternalData(0), m_externalSize(0)
 {
 }
 
 memory::memory(stringUint8* pBuffer):
-    m_pMemoryBuffer(pBuffer)
+    m_pMemoryBuffer(pBuffer),
+    m_pExternalData(0), m_externalSize(0)
 {
 }
 
 memory::memory(size_t initialSize):
-    m_pMemoryBuffer(memoryPoolGetter::getMemoryPoolGetter().getMemoryPoolLocal().getMemory(initialSize))
+    m_pMemoryBuffer(memoryPoolGetter::getMemoryPoolGetter().getMemoryPoolLocal().getMemory(initialSize)),
+    m_pExternalData(0), m_externalSize(0)
+{
+}
+
+memory::memory(const std::shared_ptr<const void>& pExternalOwner, const std::uint8_t* pExternalData, size_t externalSize):
+    m_pExternalOwner(pExternalOwner),
+    m_pExternalData(pExternalData), m_externalSize(externalSize)
 {
 }
 
@@ -99,6 +108,9 @@ void memory::copyFrom(const std::shared_ptr<const memory>& sourceMemory)
         m_pMemoryBuffer.reset(new stringUint8);
     }
     m_pMemoryBuffer->assign(sourceMemory->data(), sourceMemory->size());
+    m_pExternalOwner.reset();
+    m_pExternalData = 0;
+    m_externalSize = 0;
 
     IMEBRA_FUNCTION_END();
 }
@@ -119,6 +131,9 @@ void memory::clear()
     {
         m_pMemoryBuffer->clear();
     }
+    m_pExternalOwner.reset();
+    m_pExternalData = 0;
+    m_externalSize = 0;
 }
 
 
@@ -135,6 +150,8 @@ void memory::resize(size_t newSize)
 {
     IMEBRA_FUNCTION_START();
 
+    detachExternalMemory();
+
     if(m_pMemoryBuffer.get() == 0)
     {
         m_pMemoryBuffer.reset(new stringUint8((size_t)newSize, (std::uint8_t)0));
@@ -161,6 +178,8 @@ void memory::reserve(size_t reserveSize)
 {
     IMEBRA_FUNCTION_START();
 
+    detachExternalMemory();
+
     if(m_pMemoryBuffer.get() == 0)
     {
         m_pMemoryBuffer.reset(new stringUint8());
@@ -182,6 +201,10 @@ void memory::reserve(size_t reserveSize)
 ///////////////////////////////////////////////////////////
 size_t memory::size() const
 {
+    if(m_pExternalData != 0)
+    {
+        return m_externalSize;
+    }
     if(m_pMemoryBuffer.get() == 0)
     {
         return 0;
@@ -201,6 +224,8 @@ size_t memory::size() const
 ///////////////////////////////////////////////////////////
 std::uint8_t* memory::data()
 {
+    detachExternalMemory();
+
     if(m_pMemoryBuffer.get() == 0 || m_pMemoryBuffer->empty())
     {
         return 0;
@@ -210,6 +235,10 @@ std::uint8_t* memory::data()
 
 const std::uint8_t* memory::data() const
 {
+    if(m_pExternalData != 0)
+    {
+        return m_externalSize == 0 ? 0 : m_pExternalData;
+    }
     if(m_pMemoryBuffer.get() == 0 || m_pMemoryBuffer->empty())
     {
         return 0;
@@ -228,6 +257,10 @@ const std::uint8_t* memory::data() const
 ///////////////////////////////////////////////////////////
 bool memory::empty() const
 {
+    if(m_pExternalData != 0)
+    {
+        return m_externalSize == 0;
+    }
     return m_pMemoryBuffer.get() == 0 || m_pMemoryBuffer->empty();
 }
 
@@ -250,6 +283,9 @@ void memory::assign(const std::uint8_t* pSource, const size_t sourceLength)
         m_pMemoryBuffer.reset(new stringUint8);
     }
     m_pMemoryBuffer->assign(pSource, sourceLength);
+    m_pExternalOwner.reset();
+    m_pExternalData = 0;
+    m_externalSize = 0;
 
     IMEBRA_FUNCTION_END();
 }
@@ -258,6 +294,8 @@ void memory::assignRegion(const std::uint8_t* pSource, const size_t sourceLength
 {
     IMEBRA_FUNCTION_START();
 
+    detachExternalMemory();
+
     if(m_pMemoryBuffer.get() == 0)
     {
         m_pMemoryBuffer.reset(new stringUint8);
@@ -273,6 +311,37 @@ void memory::assignRegion(const std::uint8_t* pSource, const size_t sourceLength
 }
 
 
+///////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////
+//
+//
+// Copy the external region into an owned buffer
+//
+//
+///////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////
+void memory::detachExternalMemory()
+{
+    IMEBRA_FUNCTION_START();
+
+    if(m_pExternalData == 0)
+    {
+        return;
+    }
+
+    m_pMemoryBuffer.reset(memoryPoolGetter::getMemoryPoolGetter().getMemoryPoolLocal().getMemory(m_externalSize));
+    if(m_externalSize != 0)
+    {
+        ::memcpy(&((*m_pMemoryBuffer)[0]), m_pExternalData, m_externalSize);
+    }
+    m_pExternalOwner.reset();
+    m_pExternalData = 0;
+    m_externalSize = 0;
+
+    IMEBRA_FUNCTION_END();
+}
+
+
 ///////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////
@@ -95,6 +95,24 @@ public:
     ///////////////////////////////////////////////////////////
     memory(size_t initialSize);
 
+    /// \brief Construct a memory object that refers to
+    ///         an external read-only region, without
+    ///         copying it.
+    ///
+    /// The region is copied into an owned buffer the first
+    ///  time the memory is modified or data() is called
+    ///  on a non-const memory object.
+    ///
+    /// @param pExternalOwner keeps the external region
+    ///                       alive while this object
+    ///                       refers to it
+    /// @param pExternalData  pointer to the external region
+    /// @param externalSize   size of the external region,
+    ///                       in bytes
+    ///
+    ///////////////////////////////////////////////////////////
+    memory(const std::shared_ptr<const void>& pExternalOwner, const std::uint8_t* pExternalData, size_t externalSize);
+
     /// \brief Destruct the memory object.
     ///
     /// The owned buffer is passed to the memoryPool for
@@ -192,7 +210,17 @@ public:
 
 
 protected:
+    /// \brief Copy the external region into an owned buffer
+    ///         and release the external region.
+    ///
+    ///////////////////////////////////////////////////////////
+    void detachExternalMemory();
+
     std::unique_ptr<stringUint8> m_pMemoryBuffer;
+
+    std::shared_ptr<const void> m_pExternalOwner;
+    const std::uint8_t* m_pExternalData;
+    size_t m_externalSize;
 };
 
 
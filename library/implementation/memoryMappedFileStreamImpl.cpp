@@ -0,0 +1,341 @@
+/*
+Copyright 2005 - 2017 by Paolo Brandoli/Binarno s.p.
+
+Imebra is available for free under the GNU General Public License.
+
+The full text of the license is available in the file license.rst
+ in the project root folder.
+
+If you do not want to be bound by the GPL terms (such as the requirement
+ that your application must also be GPL), you may purchase a commercial
+ license for Imebra from the Imebra’s website (http://imebra.com).
+*/
+
+/*! \file memoryMappedFileStreamImpl.cpp
+    \brief Implementation of the memory mapped file input stream.
+
+*/
+
+#include "exceptionImpl.h"
+#include "memoryMappedFileStreamImpl.h"
+#include "memoryImpl.h"
+#include "../include/imebra/exceptions.h"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <errno.h>
+
+#if defined(IMEBRA_WINDOWS)
+#include <windows.h>
+#else
+#include <locale>
+#include <codecvt>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+
+namespace imebra
+{
+
+namespace implementation
+{
+
+///////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////
+//
+//
+// Map a file (ansi)
+//
+//
+///////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////
+memoryMappedFileStreamInput::fileMapping::fileMapping(const std::string& fileName):
+    m_pData(0), m_size(0)
+{
+    IMEBRA_FUNCTION_START();
+
+#if defined(IMEBRA_WINDOWS)
+    HANDLE hFile(::CreateFileA(fileName.c_str(), GENERIC_READ, FILE_SHARE_READ, 0, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, 0));
+    if(hFile == INVALID_HANDLE_VALUE)
+    {
+        IMEBRA_THROW(StreamOpenError, "memoryMappedFileStreamInput failure - error code: " << ::GetLastError());
+    }
+    mapFile(hFile);
+#else
+    int fileDescriptor(::open(fileName.c_str(), O_RDONLY | O_CLOEXEC));
+    if(fileDescriptor < 0)
+    {
+        IMEBRA_THROW(StreamOpenError, "memoryMappedFileStreamInput failure - error code: " << errno);
+    }
+    mapFile(fileDescriptor);
+#endif
+
+    IMEBRA_FUNCTION_END();
+}
+
+
+#if defined(IMEBRA_WINDOWS)
+
+///////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////
+//
+//
+// Map a file (unicode)
+//
+//
+///////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////
+memoryMappedFileStreamInput::fileMapping::fileMapping(const std::wstring& fileName):
+    m_pData(0), m_size(0)
+{
+    IMEBRA_FUNCTION_START();
+
+    HANDLE hFile(::CreateFileW(fileName.c_str(), GENERIC_READ, FILE_SHARE_READ, 0, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, 0));
+    if(hFile == INVALID_HANDLE_VALUE)
+    {
+        IMEBRA_THROW(StreamOpenError, "memoryMappedFileStreamInput failure - error code: " << ::GetLastError());
+    }
+    mapFile(hFile);
+
+    IMEBRA_FUNCTION_END();
+}
+
+
+///////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////
+//
+//
+// Map the whole file and close the file handle
+//
+//
+///////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////
+void memoryMappedFileStreamInput::fileMapping::mapFile(void* hFile)
+{
+    IMEBRA_FUNCTION_START();
+
+    LARGE_INTEGER fileSize;
+    if(::GetFileSizeEx(hFile, &fileSize) == 0)
+    {
+        DWORD errorCode(::GetLastError());
+        ::CloseHandle(hFile);
+        IMEBRA_THROW(StreamOpenError, "memoryMappedFileStreamInput::GetFileSizeEx failure - error code: " << errorCode);
+    }
+    if((std::uint64_t)fileSize.QuadPart > (std::uint64_t)std::numeric_limits<size_t>::max())
+    {
+        ::CloseHandle(hFile);
+        IMEBRA_THROW(StreamOpenError, "memoryMappedFileStreamInput failure - the file is too big to be mapped");
+    }
+
+    // Empty files cannot be mapped
+    ///////////////////////////////////////////////////////////
+    if(fileSize.QuadPart == 0)
+    {
+        ::CloseHandle(hFile);
+        return;
+    }
+
+    HANDLE hMapping(::CreateFileMappingW(hFile, 0, PAGE_READONLY, 0, 0, 0));
+    DWORD errorCode(::GetLastError());
+    ::CloseHandle(hFile);
+    if(hMapping == 0)
+    {
+        IMEBRA_THROW(StreamOpenError, "memoryMappedFileStreamInput::CreateFileMapping failure - error code: " << errorCode);
+    }
+
+    // The view keeps the mapping object alive
+    ///////////////////////////////////////////////////////////
+    void* pView(::MapViewOfFile(hMapping, FILE_MAP_READ, 0, 0, 0));
+    errorCode = ::GetLastError();
+    ::CloseHandle(hMapping);
+    if(pView == 0)
+    {
+        IMEBRA_THROW(StreamOpenError, "memoryMappedFileStreamInput::MapViewOfFile failure - error code: " << errorCode);
+    }
+
+    m_pData = static_cast<const std::uint8_t*>(pView);
+    m_size = (size_t)fileSize.QuadPart;
+
+    IMEBRA_FUNCTION_END();
+}
+
+#else
+
+///////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////
+//
+//
+// Map the whole file and close the file descriptor
+//
+//
+///////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////
+void memoryMappedFileStreamInput::fileMapping::mapFile(int fileDescriptor)
+{
+    IMEBRA_FUNCTION_START();
+
+    struct stat fileStatus;
+    if(::fstat(fileDescriptor, &fileStatus) != 0)
+    {
+        int errorCode(errno);
+        ::close(fileDescriptor);
+        IMEBRA_THROW(StreamOpenError, "memoryMappedFileStreamInput::fstat failure - error code: " << errorCode);
+    }
+    if(fileStatus.st_size < 0 || (std::uint64_t)fileStatus.st_size > (std::uint64_t)std::numeric_limits<size_t>::max())
+    {
+        ::close(fileDescriptor);
+        IMEBRA_THROW(StreamOpenError, "memoryMappedFileStreamInput failure - the file is too big to be mapped");
+    }
+
+    // Empty files cannot be mapped
+    ///////////////////////////////////////////////////////////
+    if(fileStatus.st_size == 0)
+    {
+        ::close(fileDescriptor);
+        return;
+    }
+
+    // The mapping stays valid after the descriptor is closed
+    ///////////////////////////////////////////////////////////
+    void* pMapping(::mmap(0, (size_t)fileStatus.st_size, PROT_READ, MAP_PRIVATE, fileDescriptor, 0));
+    int errorCode(errno);
+    ::close(fileDescriptor);
+    if(pMapping == MAP_FAILED)
+    {
+        IMEBRA_THROW(StreamOpenError, "memoryMappedFileStreamInput::mmap failure - error code: " << errorCode);
+    }
+
+    m_pData = static_cast<const std::uint8_t*>(pMapping);
+    m_size = (size_t)fileStatus.st_size;
+
+    IMEBRA_FUNCTION_END();
+}
+
+#endif
+
+
+///////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////
+//
+//
+// Unmap the file
+//
+//
+///////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////
+memoryMappedFileStreamInput::fileMapping::~fileMapping()
+{
+    if(m_pData == 0)
+    {
+        return;
+    }
+#if defined(IMEBRA_WINDOWS)
+    ::UnmapViewOfFile(m_pData);
+#else
+    ::munmap(const_cast<std::uint8_t*>(m_pData), m_size);
+#endif
+}
+
+
+///////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////
+//
+//
+// Constructors
+//
+//
+///////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////
+memoryMappedFileStreamInput::memoryMappedFileStreamInput(const std::string& fileName):
+    m_pMapping(std::make_shared<fileMapping>(fileName))
+{
+}
+
+#if defined(IMEBRA_WINDOWS)
+memoryMappedFileStreamInput::memoryMappedFileStreamInput(const std::wstring& fileName):
+    m_pMapping(std::make_shared<fileMapping>(fileName))
+{
+}
+#else
+memoryMappedFileStreamInput::memoryMappedFileStreamInput(const std::wstring& fileName):
+    m_pMapping(std::make_shared<fileMapping>(std::wstring_convert<std::codecvt_utf8<wchar_t>, wchar_t>{}.to_bytes(fileName)))
+{
+}
+#endif
+
+
+///////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////
+//
+//
+// Read raw data from the stream
+//
+//
+///////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////
+size_t memoryMappedFileStreamInput::read(size_t startPosition, std::uint8_t* pBuffer, size_t bufferLength)
+{
+    if(startPosition >= m_pMapping->m_size)
+    {
+        return 0;
+    }
+
+    const size_t copySize(std::min(bufferLength, m_pMapping->m_size - startPosition));
+    ::memcpy(pBuffer, m_pMapping->m_pData + startPosition, copySize);
+
+    return copySize;
+}
+
+
+void memoryMappedFileStreamInput::terminate()
+{
+}
+
+
+bool memoryMappedFileStreamInput::seekable() const
+{
+    return true;
+}
+
+
+size_t memoryMappedFileStreamInput::getSize() const
+{
+    return m_pMapping->m_size;
+}
+
+
+///////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////
+//
+//
+// Return a memory object that refers to the mapping
+//
+//
+///////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////
+std::shared_ptr<const memory> memoryMappedFileStreamInput::getMemory(size_t startPosition, size_t length) const
+{
+    IMEBRA_FUNCTION_START();
+
+    if(startPosition > m_pMapping->m_size || length > m_pMapping->m_size - startPosition)
+    {
+        IMEBRA_THROW(StreamEOFError, "Attempt to read past the end of the file");
+    }
+
+    if(length == 0)
+    {
+        return std::make_shared<memory>();
+    }
+
+    return std::make_shared<memory>(m_pMapping, m_pMapping->m_pData + startPosition, length);
+
+    IMEBRA_FUNCTION_END();
+}
+
+} // namespace implementation
+
+} // namespace imebra
@@ -0,0 +1,125 @@
+/*
+Copyright 2005 - 2017 by Paolo Brandoli/Binarno s.p.
+
+Imebra is available for free under the GNU General Public License.
+
+The full text of the license is available in the file license.rst
+ in the project root folder.
+
+If you do not want to be bound by the GPL terms (such as the requirement
+ that your application must also be GPL), you may purchase a commercial
+ license for Imebra from the Imebra’s website (http://imebra.com).
+*/
+
+/*! \file memoryMappedFileStreamImpl.h
+    \brief Declaration of the memory mapped file input stream.
+
+*/
+
+#if !defined(imebraMemoryMappedFileStream_6E1D2F0B_93C4_4B8A_A5D7_1F28C0E4B937__INCLUDED_)
+#define imebraMemoryMappedFileStream_6E1D2F0B_93C4_4B8A_A5D7_1F28C0E4B937__INCLUDED_
+
+#include "configurationImpl.h"
+#include "baseStreamImpl.h"
+
+#include <memory>
+#include <string>
+#include <cstdint>
+
+
+namespace imebra
+{
+
+namespace implementation
+{
+
+class memory;
+
+///////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////
+/// \brief An input stream that maps a file in memory.
+///
+/// The whole file is mapped in read-only mode when the
+///  stream is constructed, then read() copies the data
+///  straight from the mapping without locking: several
+///  threads can read from the same stream concurrently.
+///
+/// Buffers loaded lazily from this stream refer to the
+///  mapped pages via getMemory() instead of copying
+///  them.
+///
+///////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////
+class memoryMappedFileStreamInput : public baseStreamInput
+{
+public:
+    memoryMappedFileStreamInput(const std::string& fileName);
+    memoryMappedFileStreamInput(const std::wstring& fileName);
+
+    ///////////////////////////////////////////////////////////
+    //
+    // Virtual stream's functions
+    //
+    ///////////////////////////////////////////////////////////
+    virtual size_t read(size_t startPosition, std::uint8_t* pBuffer, size_t bufferLength) override;
+
+    virtual void terminate() override;
+
+    virtual bool seekable() const override;
+
+    ///////////////////////////////////////////////////////////
+    //
+    // Returns the file size
+    //
+    ///////////////////////////////////////////////////////////
+    size_t getSize() const;
+
+    /// \brief Return a memory object that refers to a region
+    ///        of the mapped file without copying it.
+    ///
+    /// The returned memory keeps the mapping alive also
+    ///  after the stream has been destroyed.
+    ///
+    /// \param startPosition the position of the first byte
+    ///                      of the region
+    /// \param length        the region's size, in bytes
+    /// \return a memory object referring to the region
+    ///
+    ///////////////////////////////////////////////////////////
+    virtual std::shared_ptr<const memory> getMemory(size_t startPosition, size_t length) const override;
+
+private:
+    ///////////////////////////////////////////////////////////
+    //
+    // Owns the mapping and unmaps the file when destroyed
+    //
+    ///////////////////////////////////////////////////////////
+    class fileMapping
+    {
+    public:
+        fileMapping(const std::string& fileName);
+#if defined(IMEBRA_WINDOWS)
+        fileMapping(const std::wstring& fileName);
+#endif
+        ~fileMapping();
+
+        const std::uint8_t* m_pData;
+        size_t m_size;
+
+    private:
+#if defined(IMEBRA_WINDOWS)
+        void mapFile(void* hFile);
+#else
+        void mapFile(int fileDescriptor);
+#endif
+    };
+
+    const std::shared_ptr<const fileMapping> m_pMapping;
+};
+
+} // namespace implementation
+
+} // namespace imebra
+
+
+#endif // !defined(imebraMemoryMappedFileStream_6E1D2F0B_93C4_4B8A_A5D7_1F28C0E4B937__INCLUDED_)
@@ -0,0 +1,161 @@
+/*
+Copyright 2005 - 2017 by Paolo Brandoli/Binarno s.p.
+
+Imebra is available for free under the GNU General Public License.
+
+The full text of the license is available in the file license.rst
+ in the project root folder.
+
+If you do not want to be bound by the GPL terms (such as the requirement
+ that your application must also be GPL), you may purchase a commercial
+ license for Imebra from the Imebra’s website (http://imebra.com).
+*/
+
+/*! \file modalityVOILUTAvx2Impl.cpp
+    \brief AVX2 version of the rescale slope/intercept.
+
+    This file is compiled with the AVX2 instruction set enabled: its
+     functions are called only when the CPU supports AVX2.
+     Don't include headers that define non-template inline functions
+     shared with other translation units.
+
+*/
+
+#include "modalityVOILUTSimdImpl.h"
+#include "simdAvx2Impl.h"
+
+#if defined(IMEBRA_SIMD_X86)
+
+namespace imebra
+{
+
+namespace implementation
+{
+
+#if defined(__AVX2__)
+
+namespace
+{
+
+///////////////////////////////////////////////////////////
+//
+// Integer rescale, with or without the multiplication
+//
+///////////////////////////////////////////////////////////
+template <bool bMultiply, class inputType, class outputType>
+size_t rescaleInteger(const inputType* pInput, outputType* pOutput, size_t count, std::int32_t slope, std::int32_t intercept)
+{
+    const __m256i slopeVector(_mm256_set1_epi32(slope));
+    const __m256i interceptVector(_mm256_set1_epi32(intercept));
+
+    const size_t rescaledCount(count & ~(size_t)7);
+    for(size_t scanValues(0); scanValues != rescaledCount; scanValues += 8)
+    {
+        __m256i values(simd::load8(pInput + scanValues));
+        if(bMultiply)
+        {
+            values = _mm256_mullo_epi32(values, slopeVector);
+        }
+        simd::store8(_mm256_add_epi32(values, interceptVector), pOutput + scanValues);
+    }
+
+    return rescaledCount;
+}
+
+} // anonymous namespace
+
+
+///////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////
+//
+//
+// Integer rescale
+//
+//
+///////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////
+template <class inputType, class outputType>
+size_t rescaleIntegerAvx2(const inputType* pInput, outputType* pOutput, size_t count, std::int32_t slope, std::int32_t intercept)
+{
+    if(slope == 1)
+    {
+        return rescaleInteger<false>(pInput, pOutput, count, slope, intercept);
+    }
+    return rescaleInteger<true>(pInput, pOutput, count, slope, intercept);
+}
+
+
+///////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////
+//
+//
+// Double precision rescale: the multiplication and the
+//  addition are separate operations, so the results
+//  match the portable code
+//
+//
+///////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////
+template <class inputType, class outputType>
+size_t rescaleDoubleAvx2(const inputType* pInput, outputType* pOutput, size_t count, double slope, double intercept)
+{
+    const __m256d slopeVector(_mm256_set1_pd(slope));
+    const __m256d interceptVector(_mm256_set1_pd(intercept));
+
+    const size_t rescaledCount(count & ~(size_t)7);
+    for(size_t scanValues(0); scanValues != rescaledCount; scanValues += 8)
+    {
+        const __m256i values(simd::load8(pInput + scanValues));
+        const __m256d low(_mm256_add_pd(_mm256_mul_pd(_mm256_cvtepi32_pd(_mm256_castsi256_si128(values)), slopeVector), interceptVector));
+        const __m256d high(_mm256_add_pd(_mm256_mul_pd(_mm256_cvtepi32_pd(_mm256_extracti128_si256(values, 1)), slopeVector), interceptVector));
+        const __m256i rescaled(_mm256_inserti128_si256(_mm256_castsi128_si256(_mm256_cvttpd_epi32(low)), _mm256_cvttpd_epi32(high), 1));
+        simd::store8(rescaled, pOutput + scanValues);
+    }
+
+    return rescaledCount;
+}
+
+#else
+
+///////////////////////////////////////////////////////////
+//
+// Built without the AVX2 flags: let the caller rescale
+//  all the values
+//
+///////////////////////////////////////////////////////////
+template <class inputType, class outputType>
+size_t rescaleIntegerAvx2(const inputType* /* pInput */, outputType* /* pOutput */, size_t /* count */, std::int32_t /* slope */, std::int32_t /* intercept */)
+{
+    return 0;
+}
+
+template <class inputType, class outputType>
+size_t rescaleDoubleAvx2(const inputType* /* pInput */, outputType* /* pOutput */, size_t /* count */, double /* slope */, double /* intercept */)
+{
+    return 0;
+}
+
+#endif
+
+#define IMEBRA_INSTANTIATE_RESCALE_AVX2(inputType, outputType) \
+    template size_t rescaleIntegerAvx2<inputType, outputType>(const inputType*, outputType*, size_t, std::int32_t, std::int32_t); \
+    template size_t rescaleDoubleAvx2<inputType, outputType>(const inputType*, outputType*, size_t, double, double);
+
+#define IMEBRA_INSTANTIATE_RESCALE_AVX2_INPUT(inputType) \
+    IMEBRA_INSTANTIATE_RESCALE_AVX2(inputType, std::uint8_t) \
+    IMEBRA_INSTANTIATE_RESCALE_AVX2(inputType, std::int8_t) \
+    IMEBRA_INSTANTIATE_RESCALE_AVX2(inputType, std::uint16_t) \
+    IMEBRA_INSTANTIATE_RESCALE_AVX2(inputType, std::int16_t) \
+    IMEBRA_INSTANTIATE_RESCALE_AVX2(inputType, std::uint32_t) \
+    IMEBRA_INSTANTIATE_RESCALE_AVX2(inputType, std::int32_t)
+
+IMEBRA_INSTANTIATE_RESCALE_AVX2_INPUT(std::uint8_t)
+IMEBRA_INSTANTIATE_RESCALE_AVX2_INPUT(std::int8_t)
+IMEBRA_INSTANTIATE_RESCALE_AVX2_INPUT(std::uint16_t)
+IMEBRA_INSTANTIATE_RESCALE_AVX2_INPUT(std::int16_t)
+
+} // namespace implementation
+
+} // namespace imebra
+
+#endif
@@ -32,6 +32,28 @@ namespace implementation
 namespace transforms
 {
 
+namespace
+{
+
+///////////////////////////////////////////////////////////
+//
+// Return true if the value is an integer in the range
+//  [-limit, limit]
+//
+///////////////////////////////////////////////////////////
+bool getSmallInteger(double value, double limit, std::int64_t* pInteger)
+{
+    if(!(value >= -limit && value <= limit))
+    {
+        return false;
+    }
+
+    *pInteger = (std::int64_t)value;
+    return fabs(value - (double)*pInteger) < std::numeric_limits<double>::denorm_min();
+}
+
+}
+
 
 ///////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////
@@ -43,7 +65,8 @@ namespace transforms
 ///////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////
 modalityVOILUT::modalityVOILUT(std::shared_ptr<const dataSet> pDataSet):
-        m_pDataSet(pDataSet), m_voiLut(0), m_rescaleIntercept(pDataSet->getDouble(0x0028, 0, 0x1052, 0, 0, 0)), m_rescaleSlope(1.0), m_bEmpty(true)
+        m_pDataSet(pDataSet), m_voiLut(0), m_rescaleIntercept(pDataSet->getDouble(0x0028, 0, 0x1052, 0, 0, 0)), m_rescaleSlope(1.0), m_bEmpty(true),
+        m_rescaleKernel(rescaleKernel_t::floatingPoint), m_integerSlope(1), m_integerIntercept(0), m_bSimdRescale(false)
 
 {
     IMEBRA_FUNCTION_START();
@@ -67,6 +90,33 @@ modalityVOILUT::modalityVOILUT(std::shared_ptr<const dataSet> pDataSet):
 
     }
 
+    // Select the rescale kernel. The integer kernels are
+    //  exact when the products stay well below 2^53
+    ///////////////////////////////////////////////////////////
+    std::int64_t integerSlope, integerIntercept;
+    if(getSmallInteger(m_rescaleSlope, 65536.0, &integerSlope) && getSmallInteger(m_rescaleIntercept, 2147483648.0, &integerIntercept))
+    {
+        m_integerSlope = integerSlope;
+        m_integerIntercept = integerIntercept;
+        if(integerSlope != 1)
+        {
+            m_rescaleKernel = rescaleKernel_t::integerMultiplyAdd;
+        }
+        else if(integerIntercept != 0)
+        {
+            m_rescaleKernel = rescaleKernel_t::integerAdd;
+        }
+        else
+        {
+            m_rescaleKernel = rescaleKernel_t::identity;
+        }
+    }
+
+    // The vectorized kernels calculate 8 and 16 bit values
+    //  in 32 bit lanes
+    ///////////////////////////////////////////////////////////
+    m_bSimdRescale = fabs(m_rescaleSlope) * 65536.0 + fabs(m_rescaleIntercept) < 2147483648.0;
+
     IMEBRA_FUNCTION_END();
 }
 
@@ -24,7 +24,10 @@ If you do not want to be bound by the GPL terms (such as the requirement
 #include "dataSetImpl.h"
 #include "LUTImpl.h"
 #include "colorTransformsFactoryImpl.h"
+#include "modalityVOILUTSimdImpl.h"
 #include "../include/imebra/exceptions.h"
+#include <algorithm>
+#include <type_traits>
 
 
 namespace imebra
@@ -106,12 +109,9 @@ public:
 		{
 			for(; inputHeight != 0; --inputHeight)
 			{
-                for(std::uint32_t scanPixels(inputWidth); scanPixels != 0; --scanPixels)
-				{
-                    *(pOutputMemory++) = (outputType) ( m_voiLut->getMappedValue((std::int32_t)*(pInputMemory++)));
-				}
-				pInputMemory += (inputHandlerWidth - inputWidth);
-				pOutputMemory += (outputHandlerWidth - inputWidth);
+                m_voiLut->mapValues(pInputMemory, pOutputMemory, inputWidth, 0);
+                pInputMemory += inputHandlerWidth;
+                pOutputMemory += outputHandlerWidth;
 			}
 			return;
 		}
@@ -121,16 +121,13 @@ public:
 		//
 		///////////////////////////////////////////////////////////
 
-		// Retrieve the intercept/scale pair
+		// Apply the intercept/scale pair
 		///////////////////////////////////////////////////////////
 		for(; inputHeight != 0; --inputHeight)
 		{
-            for(std::uint32_t scanPixels(inputWidth); scanPixels != 0; --scanPixels)
-			{
-                *(pOutputMemory++) = (outputType)((double)(*(pInputMemory++)) * m_rescaleSlope + m_rescaleIntercept);
-			}
-			pInputMemory += (inputHandlerWidth - inputWidth);
-			pOutputMemory += (outputHandlerWidth - inputWidth);
+            rescaleValues(pInputMemory, pOutputMemory, inputWidth);
+            pInputMemory += inputHandlerWidth;
+            pOutputMemory += outputHandlerWidth;
 		}
 		IMEBRA_FUNCTION_END();
 	}
@@ -145,11 +142,118 @@ public:
             std::uint32_t outputWidth, std::uint32_t outputHeight) const override;
 
 private:
+    // Kernels that apply the rescale slope and intercept.
+    // The constructor selects the cheapest one.
+    ///////////////////////////////////////////////////////////
+    enum class rescaleKernel_t
+    {
+        identity,           ///< Slope 1 and intercept 0
+        integerAdd,         ///< Slope 1 and integer intercept
+        integerMultiplyAdd, ///< Integer slope and intercept
+        floatingPoint       ///< Any other slope and intercept
+    };
+
+    // Apply the rescale slope and intercept to a row of
+    //  values. All the kernels produce the same results as
+    //  the double precision formula.
+    ///////////////////////////////////////////////////////////
+    template <class inputType, class outputType>
+    void rescaleValues(const inputType* pInput, outputType* pOutput, size_t count) const
+    {
+        const size_t simdCount(rescaleValuesSimd(pInput, pOutput, count, std::integral_constant<bool, sizeof(inputType) <= 2>()));
+        pInput += simdCount;
+        pOutput += simdCount;
+        const inputType* const pInputEnd(pInput + count - simdCount);
+
+        switch(m_rescaleKernel)
+        {
+        case rescaleKernel_t::identity:
+            std::copy(pInput, pInputEnd, pOutput);
+            return;
+
+        case rescaleKernel_t::integerAdd:
+            {
+                const std::int64_t intercept(m_integerIntercept);
+                while(pInput != pInputEnd)
+                {
+                    *(pOutput++) = (outputType)((std::int64_t)*(pInput++) + intercept);
+                }
+            }
+            return;
+
+        case rescaleKernel_t::integerMultiplyAdd:
+            {
+                const std::int64_t slope(m_integerSlope);
+                const std::int64_t intercept(m_integerIntercept);
+                while(pInput != pInputEnd)
+                {
+                    *(pOutput++) = (outputType)((std::int64_t)*(pInput++) * slope + intercept);
+                }
+            }
+            return;
+
+        case rescaleKernel_t::floatingPoint:
+            {
+                const double slope(m_rescaleSlope);
+                const double intercept(m_rescaleIntercept);
+                while(pInput != pInputEnd)
+                {
+                    *(pOutput++) = (outputType)((double)*(pInput++) * slope + intercept);
+                }
+            }
+            return;
+        }
+    }
+
+    // Vectorized version of rescaleValues() for 8 and 16 bit
+    //  input values: returns the number of values that have
+    //  been rescaled.
+    ///////////////////////////////////////////////////////////
+    template <class inputType, class outputType>
+    size_t rescaleValuesSimd(const inputType* /* pInput */, outputType* /* pOutput */, size_t /* count */, std::false_type) const
+    {
+        return 0;
+    }
+
+    template <class inputType, class outputType>
+    size_t rescaleValuesSimd(const inputType* pInput, outputType* pOutput, size_t count, std::true_type) const
+    {
+#if defined(IMEBRA_SIMD_X86)
+        if(m_bSimdRescale && getSimdInstructions() == simdInstructions_t::avx2)
+        {
+            switch(m_rescaleKernel)
+            {
+            case rescaleKernel_t::identity:
+                return 0;
+            case rescaleKernel_t::integerAdd:
+            case rescaleKernel_t::integerMultiplyAdd:
+                return rescaleIntegerAvx2(pInput, pOutput, count, (std::int32_t)m_integerSlope, (std::int32_t)m_integerIntercept);
+            case rescaleKernel_t::floatingPoint:
+                return rescaleDoubleAvx2(pInput, pOutput, count, m_rescaleSlope, m_rescaleIntercept);
+            }
+        }
+#else
+        (void)pInput;
+        (void)pOutput;
+        (void)count;
+#endif
+        return 0;
+    }
+
     std::shared_ptr<const dataSet> m_pDataSet;
     std::shared_ptr<const lut> m_voiLut;
     double m_rescaleIntercept;
     double m_rescaleSlope;
 	bool m_bEmpty;
+
+    rescaleKernel_t m_rescaleKernel;
+    std::int64_t m_integerSlope;
+    std::int64_t m_integerIntercept;
+
+    // True when the rescaled 8 and 16 bit values fit in the
+    //  32 bit lanes of the vectorized kernels
+    ///////////////////////////////////////////////////////////
+    bool m_bSimdRescale;
 };
 
 
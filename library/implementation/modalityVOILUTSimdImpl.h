@@ -0,0 +1,91 @@
+/*
+Copyright 2005 - 2017 by Paolo Brandoli/Binarno s.p.
+
+Imebra is available for free under the GNU General Public License.
+
+The full text of the license is available in the file license.rst
+ in the project root folder.
+
+If you do not want to be bound by the GPL terms (such as the requirement
+ that your application must also be GPL), you may purchase a commercial
+ license for Imebra from the Imebra’s website (http://imebra.com).
+*/
+
+/*! \file modalityVOILUTSimdImpl.h
+    \brief Declaration of the vectorized rescale slope/intercept.
+
+*/
+
+#if !defined(imebraModalityVOILUTSimd_54006FB8_B498_410E_831E_66A1BE3E5C9A__INCLUDED_)
+#define imebraModalityVOILUTSimd_54006FB8_B498_410E_831E_66A1BE3E5C9A__INCLUDED_
+
+#include "simdImpl.h"
+#include <cstdint>
+#include <cstddef>
+
+namespace imebra
+{
+
+namespace implementation
+{
+
+#if defined(IMEBRA_SIMD_X86)
+
+///////////////////////////////////////////////////////////
+/// \brief Calculates value * slope + intercept with
+///        integer slope and intercept by using the AVX2
+///        instructions.
+///
+/// The results are truncated to outputType.
+/// The caller must make sure that the results fit in
+///  32 bit signed integers.
+///
+/// Instantiated for std::uint8_t, std::int8_t,
+///  std::uint16_t and std::int16_t input values and all
+///  the integer output types used by the images.
+///
+/// \param pInput    the values to rescale
+/// \param pOutput   the buffer that receives the rescaled
+///                  values
+/// \param count     the number of values to rescale
+/// \param slope     the rescale slope
+/// \param intercept the rescale intercept
+/// \return the number of values rescaled: the caller must
+///         rescale the remaining ones
+///
+///////////////////////////////////////////////////////////
+template <class inputType, class outputType>
+size_t rescaleIntegerAvx2(const inputType* pInput, outputType* pOutput, size_t count, std::int32_t slope, std::int32_t intercept);
+
+///////////////////////////////////////////////////////////
+/// \brief Calculates value * slope + intercept in double
+///        precision by using the AVX2 instructions.
+///
+/// The results are truncated toward zero, exactly like
+///  the conversion from double to integer does.
+/// The caller must make sure that the results fit in
+///  32 bit signed integers.
+///
+/// Instantiated for the same types as
+///  rescaleIntegerAvx2().
+///
+/// \param pInput    the values to rescale
+/// \param pOutput   the buffer that receives the rescaled
+///                  values
+/// \param count     the number of values to rescale
+/// \param slope     the rescale slope
+/// \param intercept the rescale intercept
+/// \return the number of values rescaled: the caller must
+///         rescale the remaining ones
+///
+///////////////////////////////////////////////////////////
+template <class inputType, class outputType>
+size_t rescaleDoubleAvx2(const inputType* pInput, outputType* pOutput, size_t count, double slope, double intercept);
+
+#endif
+
+} // namespace implementation
+
+} // namespace imebra
+
+#endif // !defined(imebraModalityVOILUTSimd_54006FB8_B498_410E_831E_66A1BE3E5C9A__INCLUDED_)
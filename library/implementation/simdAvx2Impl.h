@@ -0,0 +1,146 @@
+/*
+Copyright 2005 - 2017 by Paolo Brandoli/Binarno s.p.
+
+Imebra is available for free under the GNU General Public License.
+
+The full text of the license is available in the file license.rst
+ in the project root folder.
+
+If you do not want to be bound by the GPL terms (such as the requirement
+ that your application must also be GPL), you may purchase a commercial
+ license for Imebra from the Imebra’s website (http://imebra.com).
+*/
+
+/*! \file simdAvx2Impl.h
+    \brief Helpers that move 8 integer values between the memory and the
+            32 bit lanes of an AVX2 register.
+
+    Include this file only from the files *Avx2Impl.cpp: the helpers
+     live in an anonymous namespace and need the AVX2 instruction set.
+
+*/
+
+#if !defined(imebraSimdAvx2_5EB9E9A2_BE42_4587_80E4_7C43EE149C1C__INCLUDED_)
+#define imebraSimdAvx2_5EB9E9A2_BE42_4587_80E4_7C43EE149C1C__INCLUDED_
+
+#include "simdImpl.h"
+#include <cstdint>
+
+#if defined(IMEBRA_SIMD_X86) && defined(__AVX2__)
+
+#include <immintrin.h>
+
+namespace imebra
+{
+
+namespace implementation
+{
+
+namespace simd
+{
+
+namespace
+{
+
+///////////////////////////////////////////////////////////
+//
+// Load 8 values and extend them to 32 bit
+//
+///////////////////////////////////////////////////////////
+inline __m256i load8(const std::uint8_t* pInput)
+{
+    return _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(pInput)));
+}
+
+inline __m256i load8(const std::int8_t* pInput)
+{
+    return _mm256_cvtepi8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(pInput)));
+}
+
+inline __m256i load8(const std::uint16_t* pInput)
+{
+    return _mm256_cvtepu16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pInput)));
+}
+
+inline __m256i load8(const std::int16_t* pInput)
+{
+    return _mm256_cvtepi16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pInput)));
+}
+
+
+///////////////////////////////////////////////////////////
+//
+// Keep the lowest byte or word of 8 32 bit values.
+//  The result is in the lowest part of the register.
+//
+///////////////////////////////////////////////////////////
+inline __m128i truncateToBytes(__m256i values)
+{
+    // Keep the lowest byte of each value, then join the
+    //  two 128 bit lanes
+    ///////////////////////////////////////////////////////////
+    const __m256i shuffle(_mm256_setr_epi8(
+                              0, 4, 8, 12, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+                              0, 4, 8, 12, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1));
+    return _mm256_castsi256_si128(_mm256_permutevar8x32_epi32(_mm256_shuffle_epi8(values, shuffle), _mm256_setr_epi32(0, 4, 0, 0, 0, 0, 0, 0)));
+}
+
+inline __m128i truncateToWords(__m256i values)
+{
+    // Keep the lowest word of each value, then join the
+    //  two 128 bit lanes
+    ///////////////////////////////////////////////////////////
+    const __m256i shuffle(_mm256_setr_epi8(
+                              0, 1, 4, 5, 8, 9, 12, 13, -1, -1, -1, -1, -1, -1, -1, -1,
+                              0, 1, 4, 5, 8, 9, 12, 13, -1, -1, -1, -1, -1, -1, -1, -1));
+    return _mm256_castsi256_si128(_mm256_permutevar8x32_epi32(_mm256_shuffle_epi8(values, shuffle), _mm256_setr_epi32(0, 1, 4, 5, 0, 0, 0, 0)));
+}
+
+
+///////////////////////////////////////////////////////////
+//
+// Truncate 8 32 bit values to the output type and store
+//  them
+//
+///////////////////////////////////////////////////////////
+inline void store8(__m256i values, std::uint8_t* pOutput)
+{
+    _mm_storel_epi64(reinterpret_cast<__m128i*>(pOutput), truncateToBytes(values));
+}
+
+inline void store8(__m256i values, std::int8_t* pOutput)
+{
+    _mm_storel_epi64(reinterpret_cast<__m128i*>(pOutput), truncateToBytes(values));
+}
+
+inline void store8(__m256i values, std::uint16_t* pOutput)
+{
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(pOutput), truncateToWords(values));
+}
+
+inline void store8(__m256i values, std::int16_t* pOutput)
+{
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(pOutput), truncateToWords(values));
+}
+
+inline void store8(__m256i values, std::uint32_t* pOutput)
+{
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(pOutput), values);
+}
+
+inline void store8(__m256i values, std::int32_t* pOutput)
+{
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(pOutput), values);
+}
+
+} // anonymous namespace
+
+} // namespace simd
+
+} // namespace implementation
+
+} // namespace imebra
+
+#endif
+
+#endif // !defined(imebraSimdAvx2_5EB9E9A2_BE42_4587_80E4_7C43EE149C1C__INCLUDED_)
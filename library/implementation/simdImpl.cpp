@@ -0,0 +1,127 @@
+/*
+Copyright 2005 - 2017 by Paolo Brandoli/Binarno s.p.
+
+Imebra is available for free under the GNU General Public License.
+
+The full text of the license is available in the file license.rst
+ in the project root folder.
+
+If you do not want to be bound by the GPL terms (such as the requirement 
+ that your application must also be GPL), you may purchase a commercial 
+ license for Imebra from the Imebra’s website (http://imebra.com).
+*/
+
+/*! \file simdImpl.cpp
+    \brief Implementation of the functions that detect the SIMD instructions
+            available on the running CPU.
+
+*/
+
+#include "simdImpl.h"
+#include <atomic>
+
+#if defined(IMEBRA_SIMD_X86) && defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace imebra
+{
+
+namespace implementation
+{
+
+namespace
+{
+
+///////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////
+//
+//
+// Query the CPU
+//
+//
+///////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////
+simdInstructions_t detectSimdInstructions()
+{
+#if defined(IMEBRA_SIMD_X86)
+
+#if defined(_MSC_VER)
+    int cpuInfo[4];
+    __cpuid(cpuInfo, 0);
+    if(cpuInfo[0] >= 7)
+    {
+        // AVX2 also needs the OS to save the YMM registers
+        ///////////////////////////////////////////////////////////
+        __cpuid(cpuInfo, 1);
+        const bool bOsxsave((cpuInfo[2] & (1 << 27)) != 0);
+        const bool bAvx((cpuInfo[2] & (1 << 28)) != 0);
+        __cpuidex(cpuInfo, 7, 0);
+        const bool bAvx2((cpuInfo[1] & (1 << 5)) != 0);
+        if(bOsxsave && bAvx && bAvx2 && (_xgetbv(0) & 0x6) == 0x6)
+        {
+            return simdInstructions_t::avx2;
+        }
+    }
+#else
+    __builtin_cpu_init();
+    if(__builtin_cpu_supports("avx2"))
+    {
+        return simdInstructions_t::avx2;
+    }
+#endif
+
+    // SSE2 is part of the x86-64 baseline
+    ///////////////////////////////////////////////////////////
+    return simdInstructions_t::sse2;
+
+#elif defined(IMEBRA_SIMD_NEON)
+
+    return simdInstructions_t::neon;
+
+#else
+
+    return simdInstructions_t::none;
+
+#endif
+}
+
+std::atomic<bool> simdEnabled(true);
+
+}
+
+
+///////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////
+//
+//
+// Return the instructions to use
+//
+//
+///////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////
+simdInstructions_t getSimdInstructions()
+{
+    static const simdInstructions_t detectedInstructions(detectSimdInstructions());
+
+    return simdEnabled.load(std::memory_order_relaxed) ? detectedInstructions : simdInstructions_t::none;
+}
+
+
+///////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////
+//
+//
+// Enable/disable the SIMD kernels
+//
+//
+///////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////
+void enableSimd(bool bEnable)
+{
+    simdEnabled.store(bEnable, std::memory_order_relaxed);
+}
+
+} // namespace implementation
+
+} // namespace imebra
@@ -0,0 +1,100 @@
+/*
+Copyright 2005 - 2017 by Paolo Brandoli/Binarno s.p.
+
+Imebra is available for free under the GNU General Public License.
+
+The full text of the license is available in the file license.rst
+ in the project root folder.
+
+If you do not want to be bound by the GPL terms (such as the requirement 
+ that your application must also be GPL), you may purchase a commercial 
+ license for Imebra from the Imebra’s website (http://imebra.com).
+*/
+
+/*! \file simdImpl.h
+    \brief Declaration of the functions that detect the SIMD instructions
+            available on the running CPU.
+
+*/
+
+#if !defined(imebraSimd_3A1E5C0B_7D42_4F6E_9B1A_52C8D2E4F901__INCLUDED_)
+#define imebraSimd_3A1E5C0B_7D42_4F6E_9B1A_52C8D2E4F901__INCLUDED_
+
+#include "configurationImpl.h"
+
+///////////////////////////////////////////////////////////
+//
+// IMEBRA_SIMD_X86 is defined when the SSE2/AVX2 kernels
+//  are compiled: the best kernel is selected at runtime.
+//  The AVX2 kernels live in the files *Avx2Impl.cpp, which
+//  are compiled with the AVX2 instruction set enabled.
+//
+// IMEBRA_SIMD_NEON is defined when the NEON kernels are
+//  compiled: the build must define IMEBRA_NEON and the
+//  compiler must target a CPU with NEON.
+//
+// Define IMEBRA_DISABLE_SIMD to compile only the portable
+//  code.
+//
+///////////////////////////////////////////////////////////
+#if !defined(IMEBRA_DISABLE_SIMD)
+
+#if defined(__x86_64__) || defined(_M_X64)
+    #define IMEBRA_SIMD_X86
+#endif
+
+#if defined(IMEBRA_NEON) && (defined(__ARM_NEON) || defined(__ARM_NEON__))
+    #define IMEBRA_SIMD_NEON
+#endif
+
+#endif
+
+namespace imebra
+{
+
+namespace implementation
+{
+
+///////////////////////////////////////////////////////////
+/// \brief Instruction sets for which Imebra has optimized
+///        kernels.
+///
+///////////////////////////////////////////////////////////
+enum class simdInstructions_t
+{
+    none, ///< Portable code only
+    sse2, ///< SSE2 (4 x 32 bit lanes)
+    avx2, ///< AVX2 (8 x 32 bit lanes)
+    neon  ///< ARM NEON (4 x 32 bit lanes)
+};
+
+///////////////////////////////////////////////////////////
+/// \brief Returns the best instruction set supported by
+///        both the library build and the running CPU.
+///
+/// Returns simdInstructions_t::none when the SIMD kernels
+///  have been disabled with enableSimd().
+///
+/// \return the instruction set the kernels should use
+///
+///////////////////////////////////////////////////////////
+simdInstructions_t getSimdInstructions();
+
+///////////////////////////////////////////////////////////
+/// \brief Enables or disables the SIMD kernels.
+///
+/// When disabled, getSimdInstructions() returns
+///  simdInstructions_t::none and the portable reference
+///  code is used.
+///
+/// \param bEnable true to enable the SIMD kernels (the
+///                default), false to disable them
+///
+///////////////////////////////////////////////////////////
+void enableSimd(bool bEnable);
+
+} // namespace implementation
+
+} // namespace imebra
+
+#endif // !defined(imebraSimd_3A1E5C0B_7D42_4F6E_9B1A_52C8D2E4F901__INCLUDED_)
@@ -0,0 +1,320 @@
+/*
+Copyright 2005 - 2017 by Paolo Brandoli/Binarno s.p.
+
+Imebra is available for free under the GNU General Public License.
+
+The full text of the license is available in the file license.rst
+ in the project root folder.
+
+If you do not want to be bound by the GPL terms (such as the requirement 
+ that your application must also be GPL), you may purchase a commercial 
+ license for Imebra from the Imebra’s website (http://imebra.com).
+*/
+
+/*! \file simdVectorImpl.h
+    \brief Thin wrappers around the SSE2, AVX2 and NEON floating point
+            vectors, used to write the SIMD kernels once for all the
+            instruction sets.
+
+    The wrappers live in an anonymous namespace: a translation unit
+     compiled with the AVX2 instruction set must not share inline
+     functions with the translation units compiled for the baseline CPU.
+
+*/
+
+#if !defined(imebraSimdVector_5B0F3C7E_2A61_4E18_8D3C_71E4A9B6C0D2__INCLUDED_)
+#define imebraSimdVector_5B0F3C7E_2A61_4E18_8D3C_71E4A9B6C0D2__INCLUDED_
+
+#include "simdImpl.h"
+#include <cstdint>
+#include <cstddef>
+
+#if defined(IMEBRA_SIMD_X86)
+#include <immintrin.h>
+#endif
+
+#if defined(IMEBRA_SIMD_NEON)
+#include <arm_neon.h>
+#endif
+
+namespace imebra
+{
+
+namespace implementation
+{
+
+namespace simd
+{
+
+namespace
+{
+
+#if defined(IMEBRA_SIMD_X86)
+
+///////////////////////////////////////////////////////////
+/// \brief 4 floats in a SSE2 register.
+///
+///////////////////////////////////////////////////////////
+class vector4f
+{
+public:
+    static const size_t lanes = 4;
+
+    vector4f() {}
+    explicit vector4f(__m128 value): m_value(value) {}
+    explicit vector4f(float value): m_value(_mm_set1_ps(value)) {}
+
+    static vector4f load(const float* pSource)
+    {
+        return vector4f(_mm_loadu_ps(pSource));
+    }
+
+    static vector4f loadInt32(const std::int32_t* pSource)
+    {
+        return vector4f(_mm_cvtepi32_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pSource))));
+    }
+
+    void store(float* pDestination) const
+    {
+        _mm_storeu_ps(pDestination, m_value);
+    }
+
+    // Convert to int32 truncating toward zero
+    ///////////////////////////////////////////////////////////
+    void storeInt32Truncated(std::int32_t* pDestination) const
+    {
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(pDestination), _mm_cvttps_epi32(m_value));
+    }
+
+    // Convert to int32 rounding to the nearest integer
+    ///////////////////////////////////////////////////////////
+    void storeInt32Rounded(std::int32_t* pDestination) const
+    {
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(pDestination), _mm_cvtps_epi32(m_value));
+    }
+
+    friend vector4f operator+(vector4f a, vector4f b) { return vector4f(_mm_add_ps(a.m_value, b.m_value)); }
+    friend vector4f operator-(vector4f a, vector4f b) { return vector4f(_mm_sub_ps(a.m_value, b.m_value)); }
+    friend vector4f operator*(vector4f a, vector4f b) { return vector4f(_mm_mul_ps(a.m_value, b.m_value)); }
+
+    // Transpose a row-major 8x8 matrix in place
+    ///////////////////////////////////////////////////////////
+    static void transpose8x8(float* pMatrix)
+    {
+        __m128 block[4][4];
+        for(size_t blockIndex(0); blockIndex != 4; ++blockIndex)
+        {
+            float* pBlock(pMatrix + (blockIndex >> 1) * 32 + (blockIndex & 1) * 4);
+            __m128 row0(_mm_loadu_ps(pBlock)), row1(_mm_loadu_ps(pBlock + 8)), row2(_mm_loadu_ps(pBlock + 16)), row3(_mm_loadu_ps(pBlock + 24));
+            _MM_TRANSPOSE4_PS(row0, row1, row2, row3);
+            block[blockIndex][0] = row0;
+            block[blockIndex][1] = row1;
+            block[blockIndex][2] = row2;
+            block[blockIndex][3] = row3;
+        }
+
+        // The off-diagonal blocks swap their positions
+        ///////////////////////////////////////////////////////////
+        static const size_t destinationBlock[4] = {0, 2, 1, 3};
+        for(size_t blockIndex(0); blockIndex != 4; ++blockIndex)
+        {
+            float* pBlock(pMatrix + (destinationBlock[blockIndex] >> 1) * 32 + (destinationBlock[blockIndex] & 1) * 4);
+            for(size_t row(0); row != 4; ++row)
+            {
+                _mm_storeu_ps(pBlock + row * 8, block[blockIndex][row]);
+            }
+        }
+    }
+
+private:
+    __m128 m_value;
+};
+
+#if defined(__AVX2__)
+
+///////////////////////////////////////////////////////////
+/// \brief 8 floats in an AVX register.
+///
+/// Available only in the translation units compiled with
+///  the AVX2 instruction set.
+///
+///////////////////////////////////////////////////////////
+class vector8f
+{
+public:
+    static const size_t lanes = 8;
+
+    vector8f() {}
+    explicit vector8f(__m256 value): m_value(value) {}
+    explicit vector8f(float value): m_value(_mm256_set1_ps(value)) {}
+
+    static vector8f load(const float* pSource)
+    {
+        return vector8f(_mm256_loadu_ps(pSource));
+    }
+
+    static vector8f loadInt32(const std::int32_t* pSource)
+    {
+        return vector8f(_mm256_cvtepi32_ps(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(pSource))));
+    }
+
+    void store(float* pDestination) const
+    {
+        _mm256_storeu_ps(pDestination, m_value);
+    }
+
+    // Convert to int32 truncating toward zero
+    ///////////////////////////////////////////////////////////
+    void storeInt32Truncated(std::int32_t* pDestination) const
+    {
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(pDestination), _mm256_cvttps_epi32(m_value));
+    }
+
+    // Convert to int32 rounding to the nearest integer
+    ///////////////////////////////////////////////////////////
+    void storeInt32Rounded(std::int32_t* pDestination) const
+    {
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(pDestination), _mm256_cvtps_epi32(m_value));
+    }
+
+    friend vector8f operator+(vector8f a, vector8f b) { return vector8f(_mm256_add_ps(a.m_value, b.m_value)); }
+    friend vector8f operator-(vector8f a, vector8f b) { return vector8f(_mm256_sub_ps(a.m_value, b.m_value)); }
+    friend vector8f operator*(vector8f a, vector8f b) { return vector8f(_mm256_mul_ps(a.m_value, b.m_value)); }
+
+    // Transpose a row-major 8x8 matrix in place
+    ///////////////////////////////////////////////////////////
+    static void transpose8x8(float* pMatrix)
+    {
+        __m256 row[8];
+        for(size_t scanRow(0); scanRow != 8; ++scanRow)
+        {
+            row[scanRow] = _mm256_loadu_ps(pMatrix + scanRow * 8);
+        }
+
+        __m256 unpacked[8];
+        for(size_t scanRow(0); scanRow != 8; scanRow += 2)
+        {
+            unpacked[scanRow] = _mm256_unpacklo_ps(row[scanRow], row[scanRow + 1]);
+            unpacked[scanRow + 1] = _mm256_unpackhi_ps(row[scanRow], row[scanRow + 1]);
+        }
+
+        __m256 shuffled[8];
+        for(size_t scanRow(0); scanRow != 8; scanRow += 4)
+        {
+            shuffled[scanRow] = _mm256_shuffle_ps(unpacked[scanRow], unpacked[scanRow + 2], _MM_SHUFFLE(1, 0, 1, 0));
+            shuffled[scanRow + 1] = _mm256_shuffle_ps(unpacked[scanRow], unpacked[scanRow + 2], _MM_SHUFFLE(3, 2, 3, 2));
+            shuffled[scanRow + 2] = _mm256_shuffle_ps(unpacked[scanRow + 1], unpacked[scanRow + 3], _MM_SHUFFLE(1, 0, 1, 0));
+            shuffled[scanRow + 3] = _mm256_shuffle_ps(unpacked[scanRow + 1], unpacked[scanRow + 3], _MM_SHUFFLE(3, 2, 3, 2));
+        }
+
+        for(size_t scanRow(0); scanRow != 4; ++scanRow)
+        {
+            _mm256_storeu_ps(pMatrix + scanRow * 8, _mm256_permute2f128_ps(shuffled[scanRow], shuffled[scanRow + 4], 0x20));
+            _mm256_storeu_ps(pMatrix + (scanRow + 4) * 8, _mm256_permute2f128_ps(shuffled[scanRow], shuffled[scanRow + 4], 0x31));
+        }
+    }
+
+private:
+    __m256 m_value;
+};
+
+#endif // defined(__AVX2__)
+
+#endif // defined(IMEBRA_SIMD_X86)
+
+
+#if defined(IMEBRA_SIMD_NEON)
+
+///////////////////////////////////////////////////////////
+/// \brief 4 floats in a NEON register.
+///
+///////////////////////////////////////////////////////////
+class vector4f
+{
+public:
+    static const size_t lanes = 4;
+
+    vector4f() {}
+    explicit vector4f(float32x4_t value): m_value(value) {}
+    explicit vector4f(float value): m_value(vdupq_n_f32(value)) {}
+
+    static vector4f load(const float* pSource)
+    {
+        return vector4f(vld1q_f32(pSource));
+    }
+
+    static vector4f loadInt32(const std::int32_t* pSource)
+    {
+        return vector4f(vcvtq_f32_s32(vld1q_s32(pSource)));
+    }
+
+    void store(float* pDestination) const
+    {
+        vst1q_f32(pDestination, m_value);
+    }
+
+    // Convert to int32 truncating toward zero
+    ///////////////////////////////////////////////////////////
+    void storeInt32Truncated(std::int32_t* pDestination) const
+    {
+        vst1q_s32(pDestination, vcvtq_s32_f32(m_value));
+    }
+
+    // Convert to int32 rounding to the nearest integer
+    //  (halfway cases away from zero)
+    ///////////////////////////////////////////////////////////
+    void storeInt32Rounded(std::int32_t* pDestination) const
+    {
+        const uint32x4_t signMask(vdupq_n_u32(0x80000000u));
+        const float32x4_t half(vreinterpretq_f32_u32(vorrq_u32(vandq_u32(vreinterpretq_u32_f32(m_value), signMask), vreinterpretq_u32_f32(vdupq_n_f32(0.5f)))));
+        vst1q_s32(pDestination, vcvtq_s32_f32(vaddq_f32(m_value, half)));
+    }
+
+    friend vector4f operator+(vector4f a, vector4f b) { return vector4f(vaddq_f32(a.m_value, b.m_value)); }
+    friend vector4f operator-(vector4f a, vector4f b) { return vector4f(vsubq_f32(a.m_value, b.m_value)); }
+    friend vector4f operator*(vector4f a, vector4f b) { return vector4f(vmulq_f32(a.m_value, b.m_value)); }
+
+    // Transpose a row-major 8x8 matrix in place
+    ///////////////////////////////////////////////////////////
+    static void transpose8x8(float* pMatrix)
+    {
+        float32x4_t block[4][4];
+        for(size_t blockIndex(0); blockIndex != 4; ++blockIndex)
+        {
+            float* pBlock(pMatrix + (blockIndex >> 1) * 32 + (blockIndex & 1) * 4);
+            const float32x4x2_t rows01(vtrnq_f32(vld1q_f32(pBlock), vld1q_f32(pBlock + 8)));
+            const float32x4x2_t rows23(vtrnq_f32(vld1q_f32(pBlock + 16), vld1q_f32(pBlock + 24)));
+            block[blockIndex][0] = vcombine_f32(vget_low_f32(rows01.val[0]), vget_low_f32(rows23.val[0]));
+            block[blockIndex][1] = vcombine_f32(vget_low_f32(rows01.val[1]), vget_low_f32(rows23.val[1]));
+            block[blockIndex][2] = vcombine_f32(vget_high_f32(rows01.val[0]), vget_high_f32(rows23.val[0]));
+            block[blockIndex][3] = vcombine_f32(vget_high_f32(rows01.val[1]), vget_high_f32(rows23.val[1]));
+        }
+
+        // The off-diagonal blocks swap their positions
+        ///////////////////////////////////////////////////////////
+        static const size_t destinationBlock[4] = {0, 2, 1, 3};
+        for(size_t blockIndex(0); blockIndex != 4; ++blockIndex)
+        {
+            float* pBlock(pMatrix + (destinationBlock[blockIndex] >> 1) * 32 + (destinationBlock[blockIndex] & 1) * 4);
+            for(size_t row(0); row != 4; ++row)
+            {
+                vst1q_f32(pBlock + row * 8, block[blockIndex][row]);
+            }
+        }
+    }
+
+private:
+    float32x4_t m_value;
+};
+
+#endif // defined(IMEBRA_SIMD_NEON)
+
+} // anonymous namespace
+
+} // namespace simd
+
+} // namespace implementation
+
+} // namespace imebra
+
+#endif // !defined(imebraSimdVector_5B0F3C7E_2A61_4E18_8D3C_71E4A9B6C0D2__INCLUDED_)
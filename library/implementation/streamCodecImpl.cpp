@@ -49,17 +49,23 @@ streamCodec::~streamCodec()
 //
 ///////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////
-std::shared_ptr<dataSet> streamCodec::read(std::shared_ptr<streamReader> pSourceStream, std::uint32_t maxSizeBufferLoad /* = 0xffffffff */) const
+std::shared_ptr<dataSet> streamCodec::read(
+        std::shared_ptr<streamReader> pSourceStream,
+        std::uint32_t maxSizeBufferLoad /* = 0xffffffff */,
+        std::uint32_t stopAtTag /* = 0xffffffff */,
+        const tagFilter_t& tagFilter /* = tagFilter_t() */,
+        dataSetAllocation_t allocation /* = dataSetAllocation_t::heap */) const
 {
     IMEBRA_FUNCTION_START();
 
     // Create a new dataset
     ///////////////////////////////////////////////////////////
-    std::shared_ptr<dataSet> pDestDataSet(std::make_shared<dataSet>("", charsetsList_t()));
+    std::shared_ptr<memoryArena> pArena(codecFactory::createDataSetArena(allocation));
+    std::shared_ptr<dataSet> pDestDataSet(allocateShared<dataSet>(pArena, "", charsetsList_t(), pArena));
 
     // Read the stream
     ///////////////////////////////////////////////////////////
-    readStream(pSourceStream, pDestDataSet, maxSizeBufferLoad);
+    readStream(pSourceStream, pDestDataSet, maxSizeBufferLoad, stopAtTag, tagFilter);
 
     return pDestDataSet;
 
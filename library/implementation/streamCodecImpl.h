@@ -22,6 +22,8 @@ If you do not want to be bound by the GPL terms (such as the requirement
 #include <stdexcept>
 #include <memory>
 #include <limits>
+#include <functional>
+#include <cstdint>
 #include "memoryImpl.h"
 #include "../include/imebra/definitions.h"
 
@@ -53,6 +55,22 @@ namespace codecs
 ///
 /// @{
 
+///////////////////////////////////////////////////////////
+/// \brief Decides which tags are loaded by
+///         streamCodec::read().
+///
+/// Called with the group and the id of each tag found in
+///  the stream, including the tags embedded in the
+///  sequences. Returns true if the tag must be loaded,
+///  false if it must be skipped.
+///
+/// The tags in the group 0x0002 and the tag 0x0008,0x0005
+///  are always loaded because they are needed to parse
+///  the rest of the stream.
+///
+///////////////////////////////////////////////////////////
+typedef std::function<bool(std::uint16_t groupId, std::uint16_t tagId)> tagFilter_t;
+
 ///////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////
 /// \brief This is the base class for all the Imebra
@@ -127,10 +145,30 @@ public:
     ///                 ignore this parameter.
     ///                Set to -1 to load all the buffers
     ///                 immediatly
+    /// @param stopAtTag the parsing stops when a tag of the
+    ///                 root dataset with an id (group in
+    ///                 the high word, tag in the low word)
+    ///                 equal or greater than stopAtTag is
+    ///                 found. The tag is not loaded.
+    ///                Set to 0xffffffff to parse the whole
+    ///                 stream
+    /// @param tagFilter if set, then only the tags for
+    ///                 which the filter returns true are
+    ///                 loaded: the other ones are skipped.
+    ///                Some codecs may ignore stopAtTag and
+    ///                 tagFilter
+    /// @param allocation dataSetAllocation_t::arena to
+    ///                 allocate the tags of the dataSet from
+    ///                 an arena owned by the dataSet
     /// @return        a pointer to the loaded dataSet
     ///
     ///////////////////////////////////////////////////////////
-    std::shared_ptr<dataSet> read(std::shared_ptr<streamReader> pSourceStream, std::uint32_t maxSizeBufferLoad = std::numeric_limits<std::uint32_t>::max()) const;
+    std::shared_ptr<dataSet> read(
+            std::shared_ptr<streamReader> pSourceStream,
+            std::uint32_t maxSizeBufferLoad = std::numeric_limits<std::uint32_t>::max(),
+            std::uint32_t stopAtTag = std::numeric_limits<std::uint32_t>::max(),
+            const tagFilter_t& tagFilter = tagFilter_t(),
+            dataSetAllocation_t allocation = dataSetAllocation_t::heap) const;
 
     /// \brief Write a dicom structure into a stream.
     ///
@@ -150,7 +188,12 @@ public:
     //@}
 
 protected:
-    virtual void readStream(std::shared_ptr<streamReader> pInputStream, std::shared_ptr<dataSet> pDestDataSet, std::uint32_t maxSizeBufferLoad = std::numeric_limits<std::uint32_t>::max()) const = 0;
+    virtual void readStream(
+            std::shared_ptr<streamReader> pInputStream,
+            std::shared_ptr<dataSet> pDestDataSet,
+            std::uint32_t maxSizeBufferLoad = std::numeric_limits<std::uint32_t>::max(),
+            std::uint32_t stopAtTag = std::numeric_limits<std::uint32_t>::max(),
+            const tagFilter_t& tagFilter = tagFilter_t()) const = 0;
     virtual void writeStream(std::shared_ptr<streamWriter> pDestStream, std::shared_ptr<dataSet> pSourceDataSet) const = 0;
 };
 
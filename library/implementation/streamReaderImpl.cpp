@@ -326,6 +326,46 @@ size_t streamReader::readSome(std::uint8_t* pBuffer, size_t bufferLength)
 }
 
 
+///////////////////////////////////////////////////////////
+//
+// Return the bytes already loaded in the data buffer
+//
+///////////////////////////////////////////////////////////
+size_t streamReader::getBufferedData(const std::uint8_t** ppData)
+{
+    IMEBRA_FUNCTION_START();
+
+    if(endReached())
+    {
+        return 0;
+    }
+
+    *ppData = &(m_dataBuffer[m_dataBufferCurrent]);
+    return m_dataBufferEnd - m_dataBufferCurrent;
+
+    IMEBRA_FUNCTION_END();
+}
+
+
+///////////////////////////////////////////////////////////
+//
+// Consume bytes returned by getBufferedData()
+//
+///////////////////////////////////////////////////////////
+void streamReader::consumeBufferedData(size_t bytesNum)
+{
+    IMEBRA_FUNCTION_START();
+
+    for(std::shared_ptr<streamWriter>& pWriter: m_forwardStream)
+    {
+        pWriter->write(&(m_dataBuffer[m_dataBufferCurrent]), bytesNum);
+    }
+    m_dataBufferCurrent += bytesNum;
+
+    IMEBRA_FUNCTION_END();
+}
+
+
 ///////////////////////////////////////////////////////////
 //
 // Causes current and subsequent read operations
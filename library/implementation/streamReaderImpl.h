@@ -122,6 +122,32 @@ public:
 
     size_t readSome(std::uint8_t* pBuffer, size_t bufferLength);
 
+    /// \brief Give direct access to the bytes already loaded
+    ///         in the internal data buffer.
+    ///
+    /// If the data buffer is empty then it is refilled from
+    ///  the controlled stream.
+    ///
+    /// The returned bytes are not consumed: call
+    ///  consumeBufferedData() to advance the read position.
+    ///
+    /// @param ppData   a pointer to a variable that receives
+    ///                  the pointer to the buffered bytes
+    /// @return the number of bytes available at *ppData, or
+    ///          0 if the end of the stream has been reached
+    ///
+    ///////////////////////////////////////////////////////////
+    size_t getBufferedData(const std::uint8_t** ppData);
+
+    /// \brief Consume bytes returned by getBufferedData().
+    ///
+    /// @param bytesNum the number of bytes to consume. Must
+    ///                  not be greater than the value
+    ///                  returned by getBufferedData()
+    ///
+    ///////////////////////////////////////////////////////////
+    void consumeBufferedData(size_t bytesNum);
+
     /// \brief Seek the stream's read position.
     ///
     /// The read position is moved to the specified byte in the
@@ -0,0 +1,315 @@
+/*
+Copyright 2005 - 2017 by Paolo Brandoli/Binarno s.p.
+
+Imebra is available for free under the GNU General Public License.
+
+The full text of the license is available in the file license.rst
+ in the project root folder.
+
+If you do not want to be bound by the GPL terms (such as the requirement 
+ that your application must also be GPL), you may purchase a commercial 
+ license for Imebra from the Imebra’s website (http://imebra.com).
+*/
+
+/*! \file threadPoolImpl.cpp
+    \brief Implementation of the thread pool used to split the decoding and
+            the transforms across the CPU cores.
+
+*/
+
+#include "threadPoolImpl.h"
+#include "exceptionImpl.h"
+#include <atomic>
+#include <exception>
+
+namespace imebra
+{
+
+namespace implementation
+{
+
+namespace
+{
+
+///////////////////////////////////////////////////////////
+//
+// State shared by the threads that execute the iterations
+//  of one parallelFor() call.
+// The jobs queued in the pool keep it alive: a job that
+//  starts after the loop has completed finds no iterations
+//  left and doesn't touch the task.
+//
+///////////////////////////////////////////////////////////
+struct parallelLoop
+{
+    parallelLoop(size_t iterations, const std::function<void(size_t)>& task):
+        m_iterations(iterations), m_nextIteration(0), m_completedIterations(0), m_pTask(&task)
+    {}
+
+    // Execute iterations until all of them have been taken
+    ///////////////////////////////////////////////////////////
+    void run()
+    {
+        size_t completed(0);
+        for(size_t iteration(m_nextIteration++); iteration < m_iterations; iteration = m_nextIteration++)
+        {
+            try
+            {
+                (*m_pTask)(iteration);
+            }
+            catch(...)
+            {
+                {
+                    std::lock_guard<std::mutex> lock(m_lock);
+                    if(!m_pException)
+                    {
+                        m_pException = std::current_exception();
+                    }
+                }
+
+                // Skip the iterations not yet started
+                ///////////////////////////////////////////////////////////
+                const size_t firstSkipped(m_nextIteration.exchange(m_iterations));
+                if(firstSkipped < m_iterations)
+                {
+                    completed += m_iterations - firstSkipped;
+                }
+            }
+            ++completed;
+        }
+
+        if(completed != 0)
+        {
+            std::lock_guard<std::mutex> lock(m_lock);
+            m_completedIterations += completed;
+            if(m_completedIterations == m_iterations)
+            {
+                m_allCompleted.notify_all();
+            }
+        }
+    }
+
+    const size_t m_iterations;
+    std::atomic<size_t> m_nextIteration;
+
+    std::mutex m_lock;
+    std::condition_variable m_allCompleted;
+    size_t m_completedIterations;
+    std::exception_ptr m_pException;
+
+    const std::function<void(size_t)>* m_pTask;
+};
+
+}
+
+
+///////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////
+//
+//
+// Constructor
+//
+//
+///////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////
+threadPool::threadPool(size_t threadsNumber): m_bTerminate(false)
+{
+    IMEBRA_FUNCTION_START();
+
+    for(size_t launchThreads(0); launchThreads != threadsNumber; ++launchThreads)
+    {
+        m_threads.emplace_back(&threadPool::workerThread, this);
+    }
+
+    IMEBRA_FUNCTION_END();
+}
+
+
+///////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////
+//
+//
+// Destructor
+//
+//
+///////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////
+threadPool::~threadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_lock);
+        m_bTerminate = true;
+    }
+    m_jobAvailable.notify_all();
+
+    for(std::thread& workerThread: m_threads)
+    {
+        workerThread.join();
+    }
+}
+
+
+///////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////
+//
+//
+// Return the pool shared by the library
+//
+//
+///////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////
+std::shared_ptr<threadPool> threadPool::getThreadPool()
+{
+    IMEBRA_FUNCTION_START();
+
+    static std::shared_ptr<threadPool> sharedThreadPool(std::make_shared<threadPool>(std::thread::hardware_concurrency() > 1 ? std::thread::hardware_concurrency() - 1 : 0));
+
+    return sharedThreadPool;
+
+    IMEBRA_FUNCTION_END();
+}
+
+
+///////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////
+//
+//
+// Return the number of threads usable by parallelFor()
+//
+//
+///////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////
+size_t threadPool::getMaximumParallelism() const
+{
+    return m_threads.size() + 1;
+}
+
+
+///////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////
+//
+//
+// Execute the iterations of a loop in parallel
+//
+//
+///////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////
+void threadPool::parallelFor(size_t iterations, size_t maxThreads, const std::function<void(size_t)>& task)
+{
+    IMEBRA_FUNCTION_START();
+
+    if(iterations == 0)
+    {
+        return;
+    }
+
+    size_t helperThreads(m_threads.size());
+    if(maxThreads != 0 && maxThreads - 1 < helperThreads)
+    {
+        helperThreads = maxThreads - 1;
+    }
+    if(iterations - 1 < helperThreads)
+    {
+        helperThreads = iterations - 1;
+    }
+
+    // Without helpers run the loop in the calling thread
+    ///////////////////////////////////////////////////////////
+    if(helperThreads == 0)
+    {
+        for(size_t iteration(0); iteration != iterations; ++iteration)
+        {
+            task(iteration);
+        }
+        return;
+    }
+
+    std::shared_ptr<parallelLoop> pLoop(std::make_shared<parallelLoop>(iterations, task));
+
+    {
+        std::lock_guard<std::mutex> lock(m_lock);
+        for(size_t queueJobs(0); queueJobs != helperThreads; ++queueJobs)
+        {
+            m_jobs.emplace_back([pLoop](){ pLoop->run(); });
+        }
+    }
+    m_jobAvailable.notify_all();
+
+    // The calling thread works too, then waits for the
+    //  iterations executed by the helpers
+    ///////////////////////////////////////////////////////////
+    pLoop->run();
+
+    {
+        std::unique_lock<std::mutex> lock(pLoop->m_lock);
+        pLoop->m_allCompleted.wait(lock, [pLoop](){ return pLoop->m_completedIterations == pLoop->m_iterations; });
+    }
+
+    if(pLoop->m_pException)
+    {
+        std::rethrow_exception(pLoop->m_pException);
+    }
+
+    IMEBRA_FUNCTION_END();
+}
+
+
+///////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////
+//
+//
+// Queue an asynchronous job
+//
+//
+///////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////
+void threadPool::execute(const std::function<void()>& job)
+{
+    IMEBRA_FUNCTION_START();
+
+    if(m_threads.empty())
+    {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_lock);
+        m_jobs.push_back(job);
+    }
+    m_jobAvailable.notify_one();
+
+    IMEBRA_FUNCTION_END();
+}
+
+
+///////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////
+//
+//
+// Worker thread: execute the queued jobs
+//
+//
+///////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////
+void threadPool::workerThread()
+{
+    for(;;)
+    {
+        std::function<void()> job;
+        {
+            std::unique_lock<std::mutex> lock(m_lock);
+            m_jobAvailable.wait(lock, [this](){ return m_bTerminate || !m_jobs.empty(); });
+            if(m_jobs.empty())
+            {
+                return;
+            }
+            job = std::move(m_jobs.front());
+            m_jobs.pop_front();
+        }
+        job();
+    }
+}
+
+} // namespace implementation
+
+} // namespace imebra
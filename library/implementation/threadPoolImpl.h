@@ -0,0 +1,127 @@
+/*
+Copyright 2005 - 2017 by Paolo Brandoli/Binarno s.p.
+
+Imebra is available for free under the GNU General Public License.
+
+The full text of the license is available in the file license.rst
+ in the project root folder.
+
+If you do not want to be bound by the GPL terms (such as the requirement 
+ that your application must also be GPL), you may purchase a commercial 
+ license for Imebra from the Imebra’s website (http://imebra.com).
+*/
+
+/*! \file threadPoolImpl.h
+    \brief Declaration of the thread pool used to split the decoding and
+            the transforms across the CPU cores.
+
+*/
+
+#if !defined(imebraThreadPool_6D3F2A81_C94B_4E27_B5D0_8A1E7C4F3B92__INCLUDED_)
+#define imebraThreadPool_6D3F2A81_C94B_4E27_B5D0_8A1E7C4F3B92__INCLUDED_
+
+#include <memory>
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+#include <vector>
+#include <cstddef>
+
+namespace imebra
+{
+
+namespace implementation
+{
+
+///////////////////////////////////////////////////////////
+/// \brief A pool of worker threads that execute the
+///        iterations of a loop in parallel.
+///
+/// The library uses only one pool, returned by
+///  getThreadPool().
+///
+///////////////////////////////////////////////////////////
+class threadPool
+{
+public:
+    /// \brief Constructor. Launches the worker threads.
+    ///
+    /// \param threadsNumber the number of worker threads
+    ///
+    ///////////////////////////////////////////////////////////
+    threadPool(size_t threadsNumber);
+
+    /// \brief Destructor. Waits for the worker threads to
+    ///        terminate.
+    ///
+    ///////////////////////////////////////////////////////////
+    ~threadPool();
+
+    /// \brief Return the pool shared by the library.
+    ///
+    /// The pool has one thread less than the hardware
+    ///  threads, because the thread that calls
+    ///  parallelFor() executes part of the iterations.
+    ///
+    ///////////////////////////////////////////////////////////
+    static std::shared_ptr<threadPool> getThreadPool();
+
+    /// \brief Return the number of threads that can execute
+    ///        the iterations of parallelFor(), including the
+    ///        calling thread.
+    ///
+    ///////////////////////////////////////////////////////////
+    size_t getMaximumParallelism() const;
+
+    /// \brief Execute task(0), task(1), ..., task(iterations - 1)
+    ///        and return when all the calls have returned.
+    ///
+    /// The calling thread executes part of the iterations,
+    ///  therefore parallelFor() can be called also from
+    ///  a task running in the pool.
+    ///
+    /// If a task throws then the iterations not yet started
+    ///  are skipped and the first exception is rethrown by
+    ///  parallelFor().
+    ///
+    /// \param iterations    the number of iterations
+    /// \param maxThreads    the maximum number of threads to
+    ///                      use, including the calling thread.
+    ///                      0 means all the available threads
+    /// \param task          the function to execute for each
+    ///                      iteration
+    ///
+    ///////////////////////////////////////////////////////////
+    void parallelFor(size_t iterations, size_t maxThreads, const std::function<void(size_t)>& task);
+
+    /// \brief Queue a job that is executed asynchronously by
+    ///        one of the worker threads.
+    ///
+    /// The job must not throw. If the pool has no worker
+    ///  threads then the job is never executed: the caller
+    ///  must be able to complete the work by itself (see
+    ///  getMaximumParallelism()).
+    ///
+    /// \param job the function to execute
+    ///
+    ///////////////////////////////////////////////////////////
+    void execute(const std::function<void()>& job);
+
+private:
+    void workerThread();
+
+    std::mutex m_lock;
+    std::condition_variable m_jobAvailable;
+    std::deque<std::function<void()> > m_jobs;
+    bool m_bTerminate;
+
+    std::vector<std::thread> m_threads;
+};
+
+} // namespace implementation
+
+} // namespace imebra
+
+#endif // !defined(imebraThreadPool_6D3F2A81_C94B_4E27_B5D0_8A1E7C4F3B92__INCLUDED_)
@@ -20,7 +20,9 @@ If you do not want to be bound by the GPL terms (such as the requirement
 #include "transformImpl.h"
 #include "imageImpl.h"
 #include "transformHighBitImpl.h"
+#include "threadPoolImpl.h"
 #include "../include/imebra/exceptions.h"
+#include <algorithm>
 
 namespace imebra
 {
@@ -44,6 +46,29 @@ transform::~transform()
 {
 }
 
+
+///////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////
+//
+//
+// Maximum number of threads used by runTransform()
+//
+//
+///////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////
+std::atomic<std::uint32_t> transform::m_maximumThreads(0);
+
+void transform::setMaximumThreads(std::uint32_t maximumThreads)
+{
+    m_maximumThreads = maximumThreads;
+}
+
+std::uint32_t transform::getMaximumThreads()
+{
+    return m_maximumThreads;
+}
+
+
 ///////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////
 //
@@ -92,20 +117,51 @@ void transform::runTransform(
 	std::uint32_t outputHighBit(outputImage->getHighBit());
     bitDepth_t outputDepth(outputImage->getDepth());
 
+    const transform* pTransform(this);
+    std::shared_ptr<transformHighBit> emptyTransform;
 	if(isEmpty())
 	{
-        std::shared_ptr<transformHighBit> emptyTransform(std::make_shared<transformHighBit>());
-        emptyTransform->runTransformHandlers(inputHandler, inputDepth, inputImageWidth, inputColorSpace, inputPalette, inputHighBit,
-											 inputTopLeftX, inputTopLeftY, inputWidth, inputHeight,
-                                             outputHandler, outputDepth, outputImageWidth, outputColorSpace, outputPalette, outputHighBit,
-											 outputTopLeftX, outputTopLeftY);
-		return;
+        emptyTransform = std::make_shared<transformHighBit>();
+        pTransform = emptyTransform.get();
 	}
 
-    runTransformHandlers(inputHandler, inputDepth, inputImageWidth, inputColorSpace, inputPalette, inputHighBit,
-		inputTopLeftX, inputTopLeftY, inputWidth, inputHeight,
-        outputHandler, outputDepth, outputImageWidth, outputColorSpace, outputPalette, outputHighBit,
-		outputTopLeftX, outputTopLeftY);
+    // Split the large areas in bands of rows, one for each
+    //  thread. The transforms process each pixel
+    //  independently, so the bands can run in parallel.
+    //  A transformsChain allocates its temporary images for
+    //  each band.
+    ///////////////////////////////////////////////////////////
+    std::shared_ptr<threadPool> pThreadPool(threadPool::getThreadPool());
+    const size_t minimumBandPixels(262144);
+    size_t maxThreads(getMaximumThreads());
+    if(maxThreads == 0 || maxThreads > pThreadPool->getMaximumParallelism())
+    {
+        maxThreads = pThreadPool->getMaximumParallelism();
+    }
+    const std::uint32_t bandsNumber((std::uint32_t)std::max((size_t)1, std::min(std::min(maxThreads, (size_t)inputWidth * (size_t)inputHeight / minimumBandPixels), (size_t)inputHeight)));
+
+    if(bandsNumber == 1)
+    {
+        pTransform->runTransformHandlers(inputHandler, inputDepth, inputImageWidth, inputColorSpace, inputPalette, inputHighBit,
+            inputTopLeftX, inputTopLeftY, inputWidth, inputHeight,
+            outputHandler, outputDepth, outputImageWidth, outputColorSpace, outputPalette, outputHighBit,
+            outputTopLeftX, outputTopLeftY);
+        return;
+    }
+
+    const std::uint32_t bandHeight((inputHeight + bandsNumber - 1) / bandsNumber);
+    pThreadPool->parallelFor(bandsNumber, bandsNumber, [&](size_t band)
+    {
+        const std::uint32_t firstRow((std::uint32_t)band * bandHeight);
+        if(firstRow >= inputHeight)
+        {
+            return;
+        }
+        pTransform->runTransformHandlers(inputHandler, inputDepth, inputImageWidth, inputColorSpace, inputPalette, inputHighBit,
+            inputTopLeftX, inputTopLeftY + firstRow, inputWidth, std::min(bandHeight, inputHeight - firstRow),
+            outputHandler, outputDepth, outputImageWidth, outputColorSpace, outputPalette, outputHighBit,
+            outputTopLeftX, outputTopLeftY + firstRow);
+    });
 
     IMEBRA_FUNCTION_END();
 }
@@ -21,6 +21,7 @@ If you do not want to be bound by the GPL terms (such as the requirement
 
 #include <memory>
 #include <limits>
+#include <atomic>
 #include "dataHandlerNumericImpl.h"
 #include "imageImpl.h"
 
@@ -196,6 +197,26 @@ public:
             const std::shared_ptr<image>& outputImage,
             std::uint32_t outputTopLeftX, std::uint32_t outputTopLeftY) const;
 
+    /// \brief Set the maximum number of threads used by
+    ///         runTransform() to process one image.
+    ///
+    /// runTransform() splits the large areas in bands of
+    ///  rows and processes them in parallel with the
+    ///  library's thread pool.
+    ///
+    /// @param maximumThreads the maximum number of threads,
+    ///                        including the calling thread.
+    ///                        0 means all the available
+    ///                        threads (default)
+    ///
+    ///////////////////////////////////////////////////////////
+    static void setMaximumThreads(std::uint32_t maximumThreads);
+
+    /// \brief Return the value set by setMaximumThreads().
+    ///
+    ///////////////////////////////////////////////////////////
+    static std::uint32_t getMaximumThreads();
+
     virtual void runTransformHandlers(
             std::shared_ptr<handlers::readingDataHandlerNumericBase> inputHandler, bitDepth_t inputDepth, std::uint32_t inputHandlerWidth, const std::string& inputHandlerColorSpace,
             std::shared_ptr<palette> inputPalette,
@@ -205,6 +226,9 @@ public:
             std::shared_ptr<palette> outputPalette,
             std::uint32_t outputHighBit,
             std::uint32_t outputTopLeftX, std::uint32_t outputTopLeftY) const = 0;
+
+private:
+    static std::atomic<std::uint32_t> m_maximumThreads;
 };
 
 
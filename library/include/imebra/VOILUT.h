@@ -101,6 +101,36 @@ public:
     ///////////////////////////////////////////////////////////////////////////////
     static VOIDescription getOptimalVOI(const Image& inputImage, std::uint32_t topLeftX, std::uint32_t topLeftY, std::uint32_t width, std::uint32_t height);
 
+    /// \brief Find the VOI settings that cover the values between two
+    ///        percentiles of a specific image's area.
+    ///
+    /// Use this function to ignore a small amount of very dark or very bright
+    ///  pixels (e.g. with lowPercentile 0.5 and highPercentile 99.5).
+    ///  With lowPercentile 0 and highPercentile 100 the result is the same
+    ///  returned by getOptimalVOI() without the percentiles.
+    ///
+    /// The percentiles are exact for images with up to 16 bits per sample;
+    ///  with wider samples the limits are rounded outward.
+    ///
+    /// The results are cached until the image content changes, so calling
+    ///  the function again for the same image and area is cheap.
+    ///
+    /// \param inputImage     the image to analyze
+    /// \param topLeftX       the horizontal coordinate of the top-left angle of
+    ///                       the area to analyze
+    /// \param topLeftY       the vertical coordinate of the top-left angle of
+    ///                       the area to analyze
+    /// \param width          the width of the area to analyze
+    /// \param height         the height of the area to analyze
+    /// \param lowPercentile  the percentage of pixels (0..100) that must be
+    ///                       left below the window
+    /// \param highPercentile the percentage of pixels (0..100) that must be
+    ///                       inside or below the window. Must be greater or
+    ///                       equal to lowPercentile
+    ///
+    ///////////////////////////////////////////////////////////////////////////////
+    static VOIDescription getOptimalVOI(const Image& inputImage, std::uint32_t topLeftX, std::uint32_t topLeftY, std::uint32_t width, std::uint32_t height, double lowPercentile, double highPercentile);
+
 };
 
 }
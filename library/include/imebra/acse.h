@@ -347,6 +347,24 @@ public:
     //////////////////////////////////////////////////////////////////
     std::string getOtherAET() const;
 
+    ///
+    /// \brief Set how the memory for the DataSet objects received from now
+    ///        on is allocated.
+    ///
+    /// When allocation is dataSetAllocation_t::arena then each received
+    ///  DataSet gets its own memory arena, as CodecFactory::load() does when
+    ///  called with dataSetAllocation_t::arena. This reduces the allocations
+    ///  made by SCPs that receive many small datasets (e.g. C-FIND
+    ///  identifiers).
+    ///
+    /// By default the received datasets are allocated on the heap.
+    ///
+    /// \param allocation how the memory for the received datasets is
+    ///                   allocated
+    ///
+    //////////////////////////////////////////////////////////////////
+    void setDataSetAllocation(dataSetAllocation_t allocation);
+
     ///
     /// \brief Returns the transfer syntax negotiated for a specific
     ///        abstract syntax.
@@ -22,6 +22,7 @@ If you do not want to be bound by the GPL terms (such as the requirement
 
 #include <string>
 #include <limits>
+#include <functional>
 #include "dataSet.h"
 #include "streamReader.h"
 #include "streamWriter.h"
@@ -58,6 +59,96 @@ public:
     ///////////////////////////////////////////////////////////////////////////////
     static const DataSet load(StreamReader& reader, size_t maxSizeBufferLoad = std::numeric_limits<size_t>::max());
 
+    /// \brief Parses the content of the input stream up to the specified tag
+    ///        and returns a DataSet representing the parsed content.
+    ///
+    /// The parsing stops at the first tag of the root DataSet that has an id
+    /// equal or greater than stopAtTag (the group order is ignored): the tag
+    /// stopAtTag and the rest of the stream are not read.
+    ///
+    /// For instance, pass TagId(tagId_t::PixelData_7FE0_0010) to load all the
+    /// tags that precede the pixel data, or TagId(0x0029, 0) to load only the
+    /// groups up to 0x0028.
+    ///
+    /// Only the DICOM codec supports this option: the other codecs parse the
+    /// whole stream.
+    ///
+    /// \param reader            a StreamReader connected to the input stream
+    /// \param maxSizeBufferLoad the maximum size of the tags that are loaded
+    ///                          immediately. Tags larger than maxSizeBufferLoad
+    ///                          are left on the input stream and loaded only when
+    ///                          a ReadingDataHandler or a WritingDataHandler
+    ///                          reference them.
+    /// \param stopAtTag         the tag at which the parsing stops. Use
+    ///                          TagId(0xffff, 0xffff) to parse the whole stream
+    /// \return a DataSet object representing the parsed content
+    ///
+    ///////////////////////////////////////////////////////////////////////////////
+    static const DataSet load(StreamReader& reader, size_t maxSizeBufferLoad, const TagId& stopAtTag);
+
+    /// \brief Parses the content of the input stream and returns a DataSet
+    ///        allocated with the specified strategy.
+    ///
+    /// When allocation is dataSetAllocation_t::arena then the DataSet gets
+    ///  its own memory arena. The arena provides the memory for the
+    ///  DataSet's tags, their buffers, the sequence items and the values
+    ///  shorter than 256 bytes. All of it is released in one go when the
+    ///  last object that uses the arena is destroyed.
+    ///
+    /// This reduces the allocations made by applications that load and
+    ///  discard many small datasets (e.g. C-FIND SCPs). The memory used by
+    ///  the modified tags is not reused until the whole DataSet is released.
+    ///
+    /// \param reader            a StreamReader connected to the input stream
+    /// \param maxSizeBufferLoad the maximum size of the tags that are loaded
+    ///                          immediately. Tags larger than maxSizeBufferLoad
+    ///                          are left on the input stream and loaded only when
+    ///                          a ReadingDataHandler or a WritingDataHandler
+    ///                          reference them.
+    /// \param allocation        how the memory for the DataSet is allocated
+    /// \return a DataSet object representing the input stream's content
+    ///
+    ///////////////////////////////////////////////////////////////////////////////
+    static const DataSet load(StreamReader& reader, size_t maxSizeBufferLoad, dataSetAllocation_t allocation);
+
+#ifndef SWIG
+    /// \brief Parses the content of the input stream up to the specified tag
+    ///        and returns a DataSet containing only the tags accepted by a
+    ///        filter.
+    ///
+    /// The filter is called with the group and the id of each tag found in the
+    /// stream, including the tags embedded in the sequences. The tags for which
+    /// the filter returns false are skipped without being loaded; when a
+    /// sequence is skipped then all its items are skipped too.
+    ///
+    /// The tags in the group 0x0002 and the tag 0x0008,0x0005 (Specific
+    /// Character Set) are always loaded because they are needed to parse the
+    /// stream.
+    ///
+    /// Only the DICOM codec supports this option: the other codecs parse the
+    /// whole stream.
+    ///
+    /// \param reader            a StreamReader connected to the input stream
+    /// \param maxSizeBufferLoad the maximum size of the tags that are loaded
+    ///                          immediately. Tags larger than maxSizeBufferLoad
+    ///                          are left on the input stream and loaded only when
+    ///                          a ReadingDataHandler or a WritingDataHandler
+    ///                          reference them.
+    /// \param stopAtTag         the tag at which the parsing stops. Use
+    ///                          TagId(0xffff, 0xffff) to parse the whole stream
+    /// \param tagFilter         function that receives the group id and the
+    ///                          tag id and returns true if the tag must be
+    ///                          loaded
+    /// \return a DataSet object representing the parsed content
+    ///
+    ///////////////////////////////////////////////////////////////////////////////
+    static const DataSet load(
+            StreamReader& reader,
+            size_t maxSizeBufferLoad,
+            const TagId& stopAtTag,
+            const std::function<bool(std::uint16_t groupId, std::uint16_t tagId)>& tagFilter);
+#endif
+
     /// \brief Parses the content of the input file and returns a DataSet
     ///        representing it.
     ///
@@ -148,6 +239,50 @@ public:
     ///////////////////////////////////////////////////////////////////////////////
     static void setMaximumImageSize(const std::uint32_t maximumWidth, const std::uint32_t maximumHeight);
 
+    /// \brief Enable or disable the SIMD (SSE2, AVX2 or NEON) code used by
+    ///        the codecs.
+    ///
+    /// The SIMD code is enabled by default and is used when the CPU supports
+    ///  it. The jpeg codec uses it for the FDCT (same results as the portable
+    ///  code) and for the IDCT (the decoded values may differ by 1 from the
+    ///  ones calculated by the portable code).
+    ///
+    /// \param bEnable           true to enable the SIMD code, false to use
+    ///                          only the portable code
+    ///
+    ///////////////////////////////////////////////////////////////////////////////
+    static void setSimdEnabled(bool bEnable);
+
+    /// \brief Set the maximum number of threads that a codec can use to
+    ///        decode one image.
+    ///
+    /// The jpeg codec decodes the restart intervals of baseline, extended
+    ///  and lossless images in parallel, when the images contain the
+    ///  restart markers.
+    ///
+    /// By default the images are decoded by the calling thread only.
+    ///
+    /// \param maximumThreads    the maximum number of threads (including
+    ///                          the calling thread) used to decode one
+    ///                          image. 0 means all the hardware threads
+    ///
+    ///////////////////////////////////////////////////////////////////////////////
+    static void setMaximumDecodingThreads(const std::uint32_t maximumThreads);
+
+    /// \brief Set the number of MCUs in each restart interval written by
+    ///        the jpeg encoder.
+    ///
+    /// Images that contain restart markers can be decoded in parallel
+    ///  (see setMaximumDecodingThreads()).
+    ///
+    /// By default the jpeg encoder doesn't write the restart markers.
+    ///
+    /// \param mcuPerRestartInterval the number of MCUs in each restart
+    ///                          interval. 0 disables the restart markers
+    ///
+    ///////////////////////////////////////////////////////////////////////////////
+    static void setJpegRestartInterval(const std::uint16_t mcuPerRestartInterval);
+
 };
 
 }
@@ -25,6 +25,7 @@ If you do not want to be bound by the GPL terms (such as the requirement
 #include <cstdint>
 #include <memory>
 #include "image.h"
+#include "framesDecoder.h"
 #include "readingDataHandlerNumeric.h"
 #include "writingDataHandlerNumeric.h"
 #include "tagId.h"
@@ -70,6 +71,7 @@ class Overlay;
 /// To retrieve the DataSet's content, use one of the following methods which
 /// give direct access to the tags' values:
 /// - getImage()
+/// - getImages()
 /// - getImageApplyModalityTransform()
 /// - getSequenceItem()
 /// - getInt64()
@@ -156,6 +158,45 @@ public:
     ///////////////////////////////////////////////////////////////////////////////
     const Image getImage(size_t frameNumber) const;
 
+    /// \brief Retrieve an image from the dataset at a reduced resolution.
+    ///
+    /// The returned image's width and height are the ones of the stored
+    /// image divided by the scale factor, rounded up. Each pixel is
+    /// (approximately) the average of the pixels it covers.
+    ///
+    /// Lossy JPEG images are decoded directly at the requested resolution,
+    /// skipping most of the IDCT work: this is the fastest way to generate
+    /// thumbnails and previews. The other images are decoded at full
+    /// resolution and then shrunk.
+    ///
+    /// Throws DataSetImageDoesntExistError if the requested frame does not exist.
+    ///
+    /// \param frameNumber the frame to retrieve (the first frame is 0)
+    /// \param scale       the scale at which the image is decoded
+    /// \return an Image object containing the decompressed image
+    ///
+    ///////////////////////////////////////////////////////////////////////////////
+    const Image getImageScaled(size_t frameNumber, imageScale_t scale) const;
+
+    /// \brief Retrieve several consecutive images from the dataset, decoding
+    ///        them in parallel.
+    ///
+    /// The function locates the frames and returns immediately: the frames
+    /// are decoded in the background in ascending order and can be retrieved
+    /// with FramesDecoder::getImage() as soon as they are ready.
+    ///
+    /// Throws DataSetImageDoesntExistError if one of the requested frames does
+    /// not exist.
+    ///
+    /// \param firstFrame  the first frame to retrieve (the first frame is 0)
+    /// \param framesCount the number of frames to retrieve
+    /// \param maxThreads  the maximum number of background threads used to
+    ///                    decode the frames. 0 means all the hardware threads
+    /// \return a FramesDecoder object that returns the decompressed images
+    ///
+    ///////////////////////////////////////////////////////////////////////////////
+    const FramesDecoder getImages(size_t firstFrame, size_t framesCount, size_t maxThreads) const;
+
     /// \brief Retrieve one of the DICOM overlays.
     ///
     /// Throws MissingGroupError if the requested overlay does not exist.
@@ -869,6 +910,45 @@ public:
     ///////////////////////////////////////////////////////////////////////////////
     tagVR_t getDataType(const TagId& tagId) const;
 
+    /// \brief Make the DataSet, its tags and its sequence items read only.
+    ///
+    /// A frozen DataSet is read without locking its content, so several
+    /// threads can read it concurrently without contention. Use it for
+    /// datasets that are loaded once and then shared by several readers.
+    ///
+    /// Once frozen, the DataSet cannot be modified anymore: any attempt to
+    /// modify it, also through a MutableDataSet or a MutableTag that refers to
+    /// the same content, throws DataSetFrozenError.
+    ///
+    /// All the WritingDataHandler objects obtained from the DataSet must be
+    /// released before freezing it: if one of them is still alive then
+    /// freeze() throws DataSetFrozenError and leaves the DataSet modifiable.
+    ///
+    /// Freezing a DataSet that is already frozen has no effect.
+    ///
+    ///////////////////////////////////////////////////////////////////////////////
+    void freeze() const;
+
+    /// \brief Returns true if the DataSet has been frozen with freeze().
+    ///
+    /// \return true if the DataSet is read only
+    ///
+    ///////////////////////////////////////////////////////////////////////////////
+    bool isFrozen() const;
+
+    /// \brief Returns the amount of memory reserved by the DataSet's memory
+    ///        arena.
+    ///
+    /// A DataSet has a memory arena when it has been loaded with
+    ///  CodecFactory::load() or received through an association with
+    ///  the allocation strategy dataSetAllocation_t::arena.
+    ///
+    /// \return the number of bytes reserved by the DataSet's memory arena,
+    ///         or 0 if the DataSet's tags are allocated on the heap
+    ///
+    ///////////////////////////////////////////////////////////////////////////////
+    size_t getArenaSize() const;
+
 #ifndef SWIG
 protected:
     explicit DataSet(const std::shared_ptr<imebra::implementation::dataSet>& pDataSet);
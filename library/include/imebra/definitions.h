@@ -119,6 +119,23 @@ enum class bitDepth_t: std::uint32_t
 };
 
 
+///
+/// \brief Defines the resolution at which DataSet::getImageScaled() decodes
+///        an image.
+///
+/// The size of the returned image is the size of the stored image divided by
+/// the scale factor, rounded up.
+///
+///////////////////////////////////////////////////////////////////////////////
+enum class imageScale_t: std::uint32_t
+{
+    full = 1,    ///< Full resolution
+    half = 2,    ///< 1/2 of the width and height
+    quarter = 4, ///< 1/4 of the width and height
+    eighth = 8   ///< 1/8 of the width and height
+};
+
+
 ///
 /// \brief Defines the data stream & images codec.
 ///
@@ -129,6 +146,18 @@ enum class codecType_t: std::uint32_t
     jpeg   ///< JPEG codec
 };
 
+///
+/// \brief Defines how the memory for the tags of a loaded DataSet is
+///        allocated.
+///
+///////////////////////////////////////////////////////////////////////////////
+enum class dataSetAllocation_t: std::uint32_t
+{
+    heap,  ///< Each tag, buffer and value is allocated separately on the heap
+    arena  ///< The tags, buffers, sequence items and values shorter than 256
+           ///<  bytes are allocated from a memory arena owned by the DataSet
+};
+
 ///
 /// \brief Defines the Overlay type.
 ///
@@ -306,6 +335,17 @@ enum class drawBitmapType_t: std::uint32_t
 };
 
 
+///
+/// \brief Defines the filter used by DrawBitmap to resize the rendered area.
+///
+///////////////////////////////////////////////////////////////////////////////
+enum class drawBitmapFilter_t: std::uint32_t
+{
+    box = 0,     ///< Each bitmap pixel is the average of the image pixels it covers
+    bilinear = 1 ///< Each bitmap pixel is interpolated from the 4 nearest image pixels
+};
+
+
 ///
 /// \brief The function to use when applying the VOI window center/width.
 ///
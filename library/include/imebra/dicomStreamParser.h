@@ -0,0 +1,155 @@
+/*
+Copyright 2005 - 2017 by Paolo Brandoli/Binarno s.p.
+
+Imebra is available for free under the GNU General Public License.
+
+The full text of the license is available in the file license.rst
+ in the project root folder.
+
+If you do not want to be bound by the GPL terms (such as the requirement
+ that your application must also be GPL), you may purchase a commercial
+ license for Imebra from the Imebra’s website (http://imebra.com).
+*/
+
+/*! \file dicomStreamParser.h
+    \brief Declaration of the classes used to parse a DICOM stream without
+        building a DataSet.
+
+*/
+
+#if !defined(imebraDicomStreamParser__INCLUDED_)
+#define imebraDicomStreamParser__INCLUDED_
+
+#include <cstdint>
+#include "streamReader.h"
+#include "definitions.h"
+
+namespace imebra
+{
+
+///
+/// \brief Receives the content of a DICOM stream parsed by
+///        DicomStreamParser::parse().
+///
+/// Derive a class from DicomStreamHandler and override the callbacks for the
+/// events you are interested in: the default implementations do nothing.
+///
+/// The callbacks are called in the same order in which the tags, the
+/// sequences and the fragments appear in the stream.
+///
+///////////////////////////////////////////////////////////////////////////////
+class IMEBRA_API DicomStreamHandler
+{
+public:
+    virtual ~DicomStreamHandler();
+
+    /// \brief Called for each tag that has a defined length and is not a
+    ///        sequence.
+    ///
+    /// The reader sees only the tag's value: reading past its end throws
+    /// StreamEOFError. The bytes that are not read are skipped by the parser
+    /// without being loaded. The reader must not be used after the method
+    /// returns.
+    ///
+    /// The value is in the byte order of the stream's transfer syntax.
+    ///
+    /// \param groupId   the tag's group
+    /// \param tagId     the tag's id
+    /// \param tagVR     the tag's data type
+    /// \param tagLength the length of the tag's value, in bytes
+    /// \param reader    a StreamReader limited to the tag's value
+    ///
+    ///////////////////////////////////////////////////////////////////////////////
+    virtual void onTag(std::uint16_t groupId, std::uint16_t tagId, tagVR_t tagVR, std::uint32_t tagLength, StreamReader& reader);
+
+    /// \brief Called when a sequence or a tag with an undefined length (e.g.
+    ///        the encapsulated pixel data) starts.
+    ///
+    /// The sequence's items are notified by onItemStart() and onItemEnd(),
+    /// while the fragments of an encapsulated buffer are notified by
+    /// onPixelFragment().
+    ///
+    /// \param groupId   the tag's group
+    /// \param tagId     the tag's id
+    /// \param tagVR     the tag's data type
+    /// \param tagLength the tag's length, or 0xffffffff when undefined
+    ///
+    ///////////////////////////////////////////////////////////////////////////////
+    virtual void onSequenceStart(std::uint16_t groupId, std::uint16_t tagId, tagVR_t tagVR, std::uint32_t tagLength);
+
+    /// \brief Called when the sequence notified by onSequenceStart() ends.
+    ///
+    /// \param groupId the tag's group
+    /// \param tagId   the tag's id
+    ///
+    ///////////////////////////////////////////////////////////////////////////////
+    virtual void onSequenceEnd(std::uint16_t groupId, std::uint16_t tagId);
+
+    /// \brief Called when an item (embedded dataset) of a sequence starts.
+    ///
+    /// The tags of the item are notified before onItemEnd() is called.
+    ///
+    /// \param itemLength the item's length, or 0xffffffff when undefined
+    ///
+    ///////////////////////////////////////////////////////////////////////////////
+    virtual void onItemStart(std::uint32_t itemLength);
+
+    /// \brief Called when the item notified by onItemStart() ends.
+    ///
+    ///////////////////////////////////////////////////////////////////////////////
+    virtual void onItemEnd();
+
+    /// \brief Called for each fragment of an encapsulated buffer.
+    ///
+    /// The reader sees only the fragment: reading past its end throws
+    /// StreamEOFError. The bytes that are not read are skipped by the parser.
+    /// The reader must not be used after the method returns.
+    ///
+    /// \param groupId        the group of the tag containing the fragment
+    /// \param tagId          the id of the tag containing the fragment
+    /// \param fragmentId     the fragment's index. The fragment 0 contains the
+    ///                       offset table
+    /// \param fragmentLength the fragment's length, in bytes
+    /// \param reader         a StreamReader limited to the fragment
+    ///
+    ///////////////////////////////////////////////////////////////////////////////
+    virtual void onPixelFragment(std::uint16_t groupId, std::uint16_t tagId, std::uint32_t fragmentId, std::uint32_t fragmentLength, StreamReader& reader);
+};
+
+
+///
+/// \brief Parses a DICOM stream and sends its content to a
+///        DicomStreamHandler, without building a DataSet.
+///
+/// The parser keeps in memory only the value being notified, therefore it can
+/// scan streams of any size with a constant memory usage.
+///
+/// Use CodecFactory::load() to obtain a DataSet instead.
+///
+///////////////////////////////////////////////////////////////////////////////
+class IMEBRA_API DicomStreamParser
+{
+public:
+    /// \brief Parses a DICOM stream and calls the handler's callbacks for each
+    ///        tag, sequence, item and fragment.
+    ///
+    /// The stream may or may not contain the 128 bytes preamble and the DICM
+    /// signature.
+    ///
+    /// If the stream is not a DICOM stream then it throws
+    /// CodecWrongFormatError. The exceptions thrown by the handler are
+    /// propagated to the caller and stop the parsing.
+    ///
+    /// The read position of the StreamReader is undefined when this method
+    /// returns.
+    ///
+    /// \param reader  a StreamReader connected to the input stream
+    /// \param handler the handler that receives the stream's content
+    ///
+    ///////////////////////////////////////////////////////////////////////////////
+    static void parse(StreamReader& reader, DicomStreamHandler& handler);
+};
+
+}
+
+#endif // !defined(imebraDicomStreamParser__INCLUDED_)
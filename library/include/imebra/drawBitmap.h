@@ -115,6 +115,72 @@ public:
     ///////////////////////////////////////////////////////////////////////////////
     const Memory getBitmap(const Image& image, drawBitmapType_t drawBitmapType, std::uint32_t rowAlignBytes);
 
+    /// \brief Apply the transforms defined in the constructor (if any) to an
+    ///        area of the input image and resize it, then calculate an array
+    ///        of bytes containing a bitmap that can be rendered by the
+    ///        operating system.
+    ///
+    /// The area is resized in the same pass that applies the transforms:
+    /// only the image rows needed by the filter are transformed and no
+    /// intermediate image as large as the area is allocated.
+    ///
+    /// \param image          the image for which the bitmap must be calculated
+    /// \param sourceTopLeftX the horizontal coordinate of the top-left corner
+    ///                       of the area to render
+    /// \param sourceTopLeftY the vertical coordinate of the top-left corner
+    ///                       of the area to render
+    /// \param sourceWidth    the width of the area to render
+    /// \param sourceHeight   the height of the area to render
+    /// \param bitmapWidth    the width of the generated bitmap, in pixels
+    /// \param bitmapHeight   the height of the generated bitmap, in pixels
+    /// \param filter         the filter used to resize the area
+    /// \param drawBitmapType the type of bitmap to generate
+    /// \param rowAlignBytes  the number of bytes on which the bitmap rows are
+    ///                       aligned
+    /// \param destination    a pointer to the pre-allocated buffer where
+    ///                       getBitmap() will store the generated bitmap
+    /// \param destinationSize the size of the allocated buffer
+    /// \return the number of bytes occupied by the bitmap in the pre-allocated
+    ///         buffer. If the number of occupied bytes is bigger than the value
+    ///         of the parameter bufferSize then the method doesn't generate
+    ///         the bitmap
+    ///
+    ///////////////////////////////////////////////////////////////////////////////
+    size_t getBitmap(const Image& image,
+                     std::uint32_t sourceTopLeftX, std::uint32_t sourceTopLeftY, std::uint32_t sourceWidth, std::uint32_t sourceHeight,
+                     std::uint32_t bitmapWidth, std::uint32_t bitmapHeight,
+                     drawBitmapFilter_t filter,
+                     drawBitmapType_t drawBitmapType, std::uint32_t rowAlignBytes,
+                     char* destination, size_t destinationSize);
+
+    /// \brief Apply the transforms defined in the constructor (if any) to an
+    ///        area of the input image and resize it, then calculate an array
+    ///        of bytes containing a bitmap that can be rendered by the
+    ///        operating system.
+    ///
+    /// \param image          the image for which the bitmap must be calculated
+    /// \param sourceTopLeftX the horizontal coordinate of the top-left corner
+    ///                       of the area to render
+    /// \param sourceTopLeftY the vertical coordinate of the top-left corner
+    ///                       of the area to render
+    /// \param sourceWidth    the width of the area to render
+    /// \param sourceHeight   the height of the area to render
+    /// \param bitmapWidth    the width of the generated bitmap, in pixels
+    /// \param bitmapHeight   the height of the generated bitmap, in pixels
+    /// \param filter         the filter used to resize the area
+    /// \param drawBitmapType the type of bitmap to generate
+    /// \param rowAlignBytes  the number of bytes on which the bitmap rows are
+    ///                       aligned
+    /// \return a Memory object referencing the buffer containing the
+    ///         generated bitmap
+    ///
+    ///////////////////////////////////////////////////////////////////////////////
+    const Memory getBitmap(const Image& image,
+                           std::uint32_t sourceTopLeftX, std::uint32_t sourceTopLeftY, std::uint32_t sourceWidth, std::uint32_t sourceHeight,
+                           std::uint32_t bitmapWidth, std::uint32_t bitmapHeight,
+                           drawBitmapFilter_t filter,
+                           drawBitmapType_t drawBitmapType, std::uint32_t rowAlignBytes);
+
 #ifndef SWIG
 private:
     friend const std::shared_ptr<implementation::drawBitmap>& getDrawBitmapImplementation(const DrawBitmap& drawBitmap);
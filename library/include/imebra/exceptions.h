@@ -948,6 +948,30 @@ public:
 };
 
 
+/// \brief This exception is thrown when the client tries to modify a
+///        DataSet that has been frozen with DataSet::freeze(), or calls
+///        DataSet::freeze() while a WritingDataHandler obtained from the
+///        DataSet is still alive.
+///
+///////////////////////////////////////////////////////////////////////////////
+class IMEBRA_API DataSetFrozenError: public DataSetError
+{
+public:
+    /// \brief Constructor.
+    ///
+    /// \param message the message to store into the exception
+    ///
+    ///////////////////////////////////////////////////////////////////////////////
+    explicit DataSetFrozenError(const std::string& message);
+
+    DataSetFrozenError(const DataSetFrozenError& source);
+
+    DataSetFrozenError& operator=(const DataSetFrozenError&) = delete;
+
+    virtual ~DataSetFrozenError();
+};
+
+
 /// \brief Base class from which the exceptions thrown by DicomDirEntry and
 ///        DicomDir classes.
 ///
@@ -0,0 +1,109 @@
+/*
+Copyright 2005 - 2017 by Paolo Brandoli/Binarno s.p.
+
+Imebra is available for free under the GNU General Public License.
+
+The full text of the license is available in the file license.rst
+ in the project root folder.
+
+If you do not want to be bound by the GPL terms (such as the requirement
+ that your application must also be GPL), you may purchase a commercial
+ license for Imebra from the Imebra’s website (http://imebra.com).
+*/
+
+/*! \file framesDecoder.h
+    \brief Declaration of the class FramesDecoder.
+
+*/
+
+#if !defined(imebraFramesDecoder__INCLUDED_)
+#define imebraFramesDecoder__INCLUDED_
+
+#include <memory>
+#include <cstdint>
+#include "definitions.h"
+
+namespace imebra
+{
+
+namespace implementation
+{
+    class framesDecoder;
+}
+
+class Image;
+
+///
+/// \brief Returns the frames retrieved by DataSet::getImages(), which
+///        decodes them in parallel.
+///
+/// The frames are decoded in the background in ascending order, therefore
+/// the application can display the first frames while the next ones are
+/// still being decoded.
+///
+/// Copies of a FramesDecoder share the same frames. When the last copy is
+/// destroyed the frames that are not being decoded yet are discarded.
+///
+///////////////////////////////////////////////////////////////////////////////
+class IMEBRA_API FramesDecoder
+{
+    friend class DataSet;
+
+public:
+    ///
+    /// \brief Copy constructor.
+    ///
+    /// \param source source FramesDecoder object
+    ///
+    ///////////////////////////////////////////////////////////////////////////////
+    FramesDecoder(const FramesDecoder& source);
+
+    virtual ~FramesDecoder();
+
+    FramesDecoder& operator=(const FramesDecoder& source) = delete;
+
+    ///
+    /// \brief Returns the number of the first frame.
+    ///
+    /// \return the zero based number of the first frame
+    ///
+    ///////////////////////////////////////////////////////////////////////////////
+    size_t getFirstFrame() const;
+
+    ///
+    /// \brief Returns the number of frames.
+    ///
+    /// \return the number of frames returned by getImage()
+    ///
+    ///////////////////////////////////////////////////////////////////////////////
+    size_t getFramesCount() const;
+
+    ///
+    /// \brief Returns one of the frames, waiting until it has been decoded.
+    ///
+    /// If the frame has not been picked up by the background threads yet then
+    /// it is decoded by the calling thread.
+    ///
+    /// Throws DataSetImageDoesntExistError if the frame is outside the range
+    /// requested to DataSet::getImages(), or the exception thrown by the
+    /// codec if the frame could not be decoded.
+    ///
+    /// \param frameNumber the frame to retrieve (the first frame of the
+    ///                    dataset is 0)
+    /// \return an Image object containing the decompressed image
+    ///
+    ///////////////////////////////////////////////////////////////////////////////
+    const Image getImage(size_t frameNumber) const;
+
+#ifndef SWIG
+protected:
+    explicit FramesDecoder(const std::shared_ptr<imebra::implementation::framesDecoder>& pFramesDecoder);
+
+private:
+    std::shared_ptr<implementation::framesDecoder> m_pFramesDecoder;
+#endif
+};
+
+}
+
+#endif // !defined(imebraFramesDecoder__INCLUDED_)
@@ -57,6 +57,7 @@ class IMEBRA_API Image
 {
     friend class DataSet;
     friend class Overlay;
+    friend class FramesDecoder;
 
 public:
     ///
@@ -29,10 +29,13 @@ If you do not want to be bound by the GPL terms (such as the requirement
 #include "dicomDir.h"
 #include "dicomDirEntry.h"
 #include "dicomDictionary.h"
+#include "dicomStreamParser.h"
 #include "drawBitmap.h"
 #include "exceptions.h"
 #include "fileStreamInput.h"
+#include "memoryMappedFileStreamInput.h"
 #include "fileStreamOutput.h"
+#include "framesDecoder.h"
 #include "image.h"
 #include "lut.h"
 #include "memory.h"
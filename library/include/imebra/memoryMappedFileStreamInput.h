@@ -0,0 +1,82 @@
+/*
+Copyright 2005 - 2017 by Paolo Brandoli/Binarno s.p.
+
+Imebra is available for free under the GNU General Public License.
+
+The full text of the license is available in the file license.rst
+ in the project root folder.
+
+If you do not want to be bound by the GPL terms (such as the requirement
+ that your application must also be GPL), you may purchase a commercial
+ license for Imebra from the Imebra’s website (http://imebra.com).
+*/
+
+/*! \file memoryMappedFileStreamInput.h
+    \brief Declaration of the MemoryMappedFileStreamInput class.
+
+*/
+
+#if !defined(imebraMemoryMappedFileStreamInput__INCLUDED_)
+#define imebraMemoryMappedFileStreamInput__INCLUDED_
+
+#include <string>
+#include "baseStreamInput.h"
+#include "definitions.h"
+
+namespace imebra
+{
+
+///
+/// \brief Represents an input file stream that maps the whole file in
+///        memory.
+///
+/// Reading from the stream doesn't lock it, so several threads can read
+///  from the same MemoryMappedFileStreamInput concurrently.
+///
+/// When a DataSet is loaded from this stream with a maximum buffer load
+///  size then the tags not loaded in memory refer directly to the mapped
+///  file and are not copied when they are read (unless their endianness
+///  has to be adjusted).
+///
+/// The mapping is released when the stream and all the data loaded
+///  from it have been destroyed.
+///
+///////////////////////////////////////////////////////////////////////////////
+class IMEBRA_API MemoryMappedFileStreamInput : public BaseStreamInput
+{
+
+public:
+    /// \brief Constructor.
+    ///
+    /// \param name the path to the file to map in read mode
+    ///
+    ///////////////////////////////////////////////////////////////////////////////
+#ifndef SWIG // Use only UTF-8 strings with SWIG
+    explicit MemoryMappedFileStreamInput(const std::wstring& name);
+#endif
+
+    /// \brief Constructor.
+    ///
+    /// \param name the path to the file to map in read mode, encoded in UTF8
+    ///
+    ///////////////////////////////////////////////////////////////////////////////
+    explicit MemoryMappedFileStreamInput(const std::string& name);
+
+    ///
+    /// \brief Copy constructor.
+    ///
+    /// \param source source MemoryMappedFileStreamInput object
+    ///
+    ///////////////////////////////////////////////////////////////////////////////
+    MemoryMappedFileStreamInput(const MemoryMappedFileStreamInput& source);
+
+    MemoryMappedFileStreamInput& operator=(const MemoryMappedFileStreamInput& source) = delete;
+
+    /// \brief Destructor.
+    ///
+    ///////////////////////////////////////////////////////////////////////////////
+    ~MemoryMappedFileStreamInput();
+};
+
+}
+#endif // !defined(imebraMemoryMappedFileStreamInput__INCLUDED_)
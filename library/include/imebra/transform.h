@@ -95,6 +95,22 @@ public:
             MutableImage& outputImage,
             std::uint32_t outputTopLeftX, std::uint32_t outputTopLeftY) const;
 
+    /// \brief Set the maximum number of threads that runTransform() can use
+    ///        to process one image.
+    ///
+    /// Large areas are split in bands of rows that are processed in
+    ///  parallel; small areas are always processed by the calling thread.
+    ///  The results don't depend on the number of threads.
+    ///
+    /// By default all the hardware threads can be used.
+    ///
+    /// \param maximumThreads the maximum number of threads (including the
+    ///                       calling thread) used to process one image.
+    ///                       0 means all the hardware threads
+    ///
+    ///////////////////////////////////////////////////////////////////////////////
+    static void setMaximumThreads(std::uint32_t maximumThreads);
+
 #ifndef SWIG
 protected:
     explicit Transform(const std::shared_ptr<imebra::implementation::transforms::transform>& pTransform);
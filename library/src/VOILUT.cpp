@@ -55,4 +55,13 @@ VOIDescription VOILUT::getOptimalVOI(const Image& inputImage, std::uint32_t topL
     IMEBRA_FUNCTION_END_LOG();
 }
 
+VOIDescription VOILUT::getOptimalVOI(const Image& inputImage, std::uint32_t topLeftX, std::uint32_t topLeftY, std::uint32_t width, std::uint32_t height, double lowPercentile, double highPercentile)
+{
+    IMEBRA_FUNCTION_START();
+
+    return VOIDescription(imebra::implementation::transforms::VOILUT::getOptimalVOI(getImageImplementation(inputImage), topLeftX, topLeftY, width, height, lowPercentile, highPercentile));
+
+    IMEBRA_FUNCTION_END_LOG();
+}
+
 }
@@ -257,6 +257,15 @@ std::string AssociationBase::getOtherAET() const
     IMEBRA_FUNCTION_END_LOG();
 }
 
+void AssociationBase::setDataSetAllocation(dataSetAllocation_t allocation)
+{
+    IMEBRA_FUNCTION_START();
+
+    m_pAssociation->setDataSetAllocation(allocation);
+
+    IMEBRA_FUNCTION_END_LOG();
+}
+
 std::string AssociationBase::getTransferSyntax(const std::string &abstractSyntax) const
 {
     IMEBRA_FUNCTION_START();
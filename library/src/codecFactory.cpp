@@ -25,6 +25,7 @@ If you do not want to be bound by the GPL terms (such as the requirement
 #include "../implementation/streamCodecImpl.h"
 #include "../implementation/imageCodecImpl.h"
 #include "../implementation/exceptionImpl.h"
+#include "../implementation/simdImpl.h"
 
 namespace imebra
 {
@@ -39,6 +40,42 @@ const DataSet CodecFactory::load(StreamReader& reader, size_t maxSizeBufferLoad
     IMEBRA_FUNCTION_END_LOG();
 }
 
+const DataSet CodecFactory::load(StreamReader& reader, size_t maxSizeBufferLoad, const TagId& stopAtTag)
+{
+    IMEBRA_FUNCTION_START();
+
+    std::shared_ptr<imebra::implementation::codecs::codecFactory> factory(imebra::implementation::codecs::codecFactory::getCodecFactory());
+    const std::uint32_t stopAtTagId(((std::uint32_t)stopAtTag.getGroupId() << 16) | stopAtTag.getTagId());
+    return DataSet(factory->load(reader.m_pReader, (std::uint32_t)maxSizeBufferLoad, stopAtTagId));
+
+    IMEBRA_FUNCTION_END_LOG();
+}
+
+const DataSet CodecFactory::load(StreamReader& reader, size_t maxSizeBufferLoad, dataSetAllocation_t allocation)
+{
+    IMEBRA_FUNCTION_START();
+
+    std::shared_ptr<imebra::implementation::codecs::codecFactory> factory(imebra::implementation::codecs::codecFactory::getCodecFactory());
+    return DataSet(factory->load(reader.m_pReader, (std::uint32_t)maxSizeBufferLoad, 0xffffffff, imebra::implementation::codecs::tagFilter_t(), allocation));
+
+    IMEBRA_FUNCTION_END_LOG();
+}
+
+const DataSet CodecFactory::load(
+        StreamReader& reader,
+        size_t maxSizeBufferLoad,
+        const TagId& stopAtTag,
+        const std::function<bool(std::uint16_t groupId, std::uint16_t tagId)>& tagFilter)
+{
+    IMEBRA_FUNCTION_START();
+
+    std::shared_ptr<imebra::implementation::codecs::codecFactory> factory(imebra::implementation::codecs::codecFactory::getCodecFactory());
+    const std::uint32_t stopAtTagId(((std::uint32_t)stopAtTag.getGroupId() << 16) | stopAtTag.getTagId());
+    return DataSet(factory->load(reader.m_pReader, (std::uint32_t)maxSizeBufferLoad, stopAtTagId, tagFilter));
+
+    IMEBRA_FUNCTION_END_LOG();
+}
+
 const DataSet CodecFactory::load(const std::wstring& fileName, size_t maxSizeBufferLoad)
 {
     IMEBRA_FUNCTION_START();
@@ -94,6 +131,35 @@ void CodecFactory::setMaximumImageSize(const std::uint32_t maximumWidth, const s
 
 }
 
+void CodecFactory::setMaximumDecodingThreads(const std::uint32_t maximumThreads)
+{
+    IMEBRA_FUNCTION_START();
+
+    std::shared_ptr<imebra::implementation::codecs::codecFactory> factory(imebra::implementation::codecs::codecFactory::getCodecFactory());
+    factory->setMaximumDecodingThreads(maximumThreads);
+
+    IMEBRA_FUNCTION_END_LOG();
+}
+
+void CodecFactory::setJpegRestartInterval(const std::uint16_t mcuPerRestartInterval)
+{
+    IMEBRA_FUNCTION_START();
+
+    std::shared_ptr<imebra::implementation::codecs::codecFactory> factory(imebra::implementation::codecs::codecFactory::getCodecFactory());
+    factory->setJpegRestartInterval(mcuPerRestartInterval);
+
+    IMEBRA_FUNCTION_END_LOG();
+}
+
+void CodecFactory::setSimdEnabled(bool bEnable)
+{
+    IMEBRA_FUNCTION_START();
+
+    imebra::implementation::enableSimd(bEnable);
+
+    IMEBRA_FUNCTION_END_LOG();
+}
+
 
 void CodecFactory::save(const DataSet& dataSet, StreamWriter& writer, codecType_t codecType)
 {
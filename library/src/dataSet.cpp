@@ -21,6 +21,7 @@ If you do not want to be bound by the GPL terms (such as the requirement
 #include "../include/imebra/streamReader.h"
 #include "../include/imebra/overlay.h"
 #include "../implementation/dataSetImpl.h"
+#include "../implementation/memoryArenaImpl.h"
 #include "../include/imebra/streamWriter.h"
 #include "../include/imebra/uidsEnumeration.h"
 #include "../implementation/dataHandlerNumericImpl.h"
@@ -97,6 +98,24 @@ const Image DataSet::getImage(size_t frameNumber) const
     IMEBRA_FUNCTION_END_LOG();
 }
 
+const Image DataSet::getImageScaled(size_t frameNumber, imageScale_t scale) const
+{
+    IMEBRA_FUNCTION_START();
+
+    return Image(m_pDataSet->getScaledImage(static_cast<std::uint32_t>(frameNumber), scale));
+
+    IMEBRA_FUNCTION_END_LOG();
+}
+
+const FramesDecoder DataSet::getImages(size_t firstFrame, size_t framesCount, size_t maxThreads) const
+{
+    IMEBRA_FUNCTION_START();
+
+    return FramesDecoder(m_pDataSet->getImages(static_cast<std::uint32_t>(firstFrame), static_cast<std::uint32_t>(framesCount), maxThreads));
+
+    IMEBRA_FUNCTION_END_LOG();
+}
+
 const Overlay DataSet::getOverlay(size_t overlayNumber) const
 {
     IMEBRA_FUNCTION_START();
@@ -538,6 +557,30 @@ tagVR_t DataSet::getDataType(const TagId& tagId) const
     IMEBRA_FUNCTION_END_LOG();
 }
 
+void DataSet::freeze() const
+{
+    IMEBRA_FUNCTION_START();
+
+    m_pDataSet->freeze();
+
+    IMEBRA_FUNCTION_END_LOG();
+}
+
+bool DataSet::isFrozen() const
+{
+    return m_pDataSet->isFrozen();
+}
+
+size_t DataSet::getArenaSize() const
+{
+    IMEBRA_FUNCTION_START();
+
+    const std::shared_ptr<imebra::implementation::memoryArena>& pArena(m_pDataSet->getArena());
+    return pArena == nullptr ? 0 : pArena->getReservedSize();
+
+    IMEBRA_FUNCTION_END_LOG();
+}
+
 MutableDataSet::MutableDataSet(const MutableDataSet &source): DataSet(source)
 {
 }
@@ -0,0 +1,137 @@
+/*
+Copyright 2005 - 2017 by Paolo Brandoli/Binarno s.p.
+
+Imebra is available for free under the GNU General Public License.
+
+The full text of the license is available in the file license.rst
+ in the project root folder.
+
+If you do not want to be bound by the GPL terms (such as the requirement
+ that your application must also be GPL), you may purchase a commercial
+ license for Imebra from the Imebra’s website (http://imebra.com).
+*/
+
+/*! \file dicomStreamParser.cpp
+    \brief Implementation of the classes used to parse a DICOM stream without
+        building a DataSet.
+
+*/
+
+#include "../include/imebra/dicomStreamParser.h"
+#include "../implementation/dicomStreamCodecImpl.h"
+#include "../implementation/streamReaderImpl.h"
+#include "../implementation/exceptionImpl.h"
+
+namespace imebra
+{
+
+namespace
+{
+
+///////////////////////////////////////////////////////////
+//
+// Gives the user's handler access to the reader limited
+//  to a value, built by the implementation parser
+//
+///////////////////////////////////////////////////////////
+class valueStreamReader: public StreamReader
+{
+public:
+    explicit valueStreamReader(const std::shared_ptr<implementation::streamReader>& pReader):
+        StreamReader(pReader)
+    {
+    }
+};
+
+
+///////////////////////////////////////////////////////////
+//
+// Forwards the events of the implementation parser to
+//  the user's handler
+//
+///////////////////////////////////////////////////////////
+class streamHandlerAdapter: public implementation::codecs::dicomStreamHandler
+{
+public:
+    explicit streamHandlerAdapter(DicomStreamHandler& handler):
+        m_handler(handler)
+    {
+    }
+
+    virtual void onTag(std::uint16_t groupId, std::uint16_t tagId, tagVR_t tagVR, std::uint32_t tagLength, const std::shared_ptr<implementation::streamReader>& pReader) override
+    {
+        valueStreamReader valueReader(pReader);
+        m_handler.onTag(groupId, tagId, tagVR, tagLength, valueReader);
+    }
+
+    virtual void onSequenceStart(std::uint16_t groupId, std::uint16_t tagId, tagVR_t tagVR, std::uint32_t tagLength) override
+    {
+        m_handler.onSequenceStart(groupId, tagId, tagVR, tagLength);
+    }
+
+    virtual void onSequenceEnd(std::uint16_t groupId, std::uint16_t tagId) override
+    {
+        m_handler.onSequenceEnd(groupId, tagId);
+    }
+
+    virtual void onItemStart(std::uint32_t itemLength) override
+    {
+        m_handler.onItemStart(itemLength);
+    }
+
+    virtual void onItemEnd() override
+    {
+        m_handler.onItemEnd();
+    }
+
+    virtual void onPixelFragment(std::uint16_t groupId, std::uint16_t tagId, std::uint32_t fragmentId, std::uint32_t fragmentLength, const std::shared_ptr<implementation::streamReader>& pReader) override
+    {
+        valueStreamReader valueReader(pReader);
+        m_handler.onPixelFragment(groupId, tagId, fragmentId, fragmentLength, valueReader);
+    }
+
+private:
+    DicomStreamHandler& m_handler;
+};
+
+}
+
+DicomStreamHandler::~DicomStreamHandler()
+{
+}
+
+void DicomStreamHandler::onTag(std::uint16_t /* groupId */, std::uint16_t /* tagId */, tagVR_t /* tagVR */, std::uint32_t /* tagLength */, StreamReader& /* reader */)
+{
+}
+
+void DicomStreamHandler::onSequenceStart(std::uint16_t /* groupId */, std::uint16_t /* tagId */, tagVR_t /* tagVR */, std::uint32_t /* tagLength */)
+{
+}
+
+void DicomStreamHandler::onSequenceEnd(std::uint16_t /* groupId */, std::uint16_t /* tagId */)
+{
+}
+
+void DicomStreamHandler::onItemStart(std::uint32_t /* itemLength */)
+{
+}
+
+void DicomStreamHandler::onItemEnd()
+{
+}
+
+void DicomStreamHandler::onPixelFragment(std::uint16_t /* groupId */, std::uint16_t /* tagId */, std::uint32_t /* fragmentId */, std::uint32_t /* fragmentLength */, StreamReader& /* reader */)
+{
+}
+
+void DicomStreamParser::parse(StreamReader& reader, DicomStreamHandler& handler)
+{
+    IMEBRA_FUNCTION_START();
+
+    streamHandlerAdapter adapter(handler);
+    implementation::codecs::dicomStreamCodec::parseStreamEvents(getStreamReaderImplementation(reader), adapter);
+
+    IMEBRA_FUNCTION_END_LOG();
+}
+
+}
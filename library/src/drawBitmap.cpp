@@ -65,4 +65,40 @@ const Memory DrawBitmap::getBitmap(const Image& image, drawBitmapType_t drawBitm
     IMEBRA_FUNCTION_END_LOG();
 }
 
+size_t DrawBitmap::getBitmap(const Image& image,
+                             std::uint32_t sourceTopLeftX, std::uint32_t sourceTopLeftY, std::uint32_t sourceWidth, std::uint32_t sourceHeight,
+                             std::uint32_t bitmapWidth, std::uint32_t bitmapHeight,
+                             drawBitmapFilter_t filter,
+                             drawBitmapType_t drawBitmapType, std::uint32_t rowAlignBytes,
+                             char* buffer, size_t bufferSize)
+{
+    IMEBRA_FUNCTION_START();
+
+    return m_pDrawBitmap->getBitmap(getImageImplementation(image),
+                                    sourceTopLeftX, sourceTopLeftY, sourceWidth, sourceHeight,
+                                    bitmapWidth, bitmapHeight,
+                                    filter,
+                                    drawBitmapType, rowAlignBytes,
+                                    (std::uint8_t*)buffer, bufferSize);
+
+    IMEBRA_FUNCTION_END_LOG();
+}
+
+const Memory DrawBitmap::getBitmap(const Image& image,
+                                   std::uint32_t sourceTopLeftX, std::uint32_t sourceTopLeftY, std::uint32_t sourceWidth, std::uint32_t sourceHeight,
+                                   std::uint32_t bitmapWidth, std::uint32_t bitmapHeight,
+                                   drawBitmapFilter_t filter,
+                                   drawBitmapType_t drawBitmapType, std::uint32_t rowAlignBytes)
+{
+    IMEBRA_FUNCTION_START();
+
+    return Memory(m_pDrawBitmap->getBitmap(getImageImplementation(image),
+                                           sourceTopLeftX, sourceTopLeftY, sourceWidth, sourceHeight,
+                                           bitmapWidth, bitmapHeight,
+                                           filter,
+                                           drawBitmapType, rowAlignBytes));
+
+    IMEBRA_FUNCTION_END_LOG();
+}
+
 }
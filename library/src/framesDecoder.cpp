@@ -0,0 +1,58 @@
+/*
+Copyright 2005 - 2017 by Paolo Brandoli/Binarno s.p.
+
+Imebra is available for free under the GNU General Public License.
+
+The full text of the license is available in the file license.rst
+ in the project root folder.
+
+If you do not want to be bound by the GPL terms (such as the requirement
+ that your application must also be GPL), you may purchase a commercial
+ license for Imebra from the Imebra’s website (http://imebra.com).
+*/
+
+/*! \file framesDecoder.cpp
+    \brief Implementation of the class FramesDecoder.
+
+*/
+
+#include "../include/imebra/framesDecoder.h"
+#include "../include/imebra/image.h"
+#include "../implementation/framesDecoderImpl.h"
+#include "../implementation/exceptionImpl.h"
+
+namespace imebra
+{
+
+FramesDecoder::FramesDecoder(const FramesDecoder& source): m_pFramesDecoder(source.m_pFramesDecoder)
+{
+}
+
+FramesDecoder::FramesDecoder(const std::shared_ptr<imebra::implementation::framesDecoder>& pFramesDecoder): m_pFramesDecoder(pFramesDecoder)
+{
+}
+
+FramesDecoder::~FramesDecoder()
+{
+}
+
+size_t FramesDecoder::getFirstFrame() const
+{
+    return m_pFramesDecoder->getFirstFrame();
+}
+
+size_t FramesDecoder::getFramesCount() const
+{
+    return m_pFramesDecoder->getFramesCount();
+}
+
+const Image FramesDecoder::getImage(size_t frameNumber) const
+{
+    IMEBRA_FUNCTION_START();
+
+    return Image(m_pFramesDecoder->getImage(static_cast<std::uint32_t>(frameNumber)));
+
+    IMEBRA_FUNCTION_END_LOG();
+}
+
+}
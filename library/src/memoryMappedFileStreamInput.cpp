@@ -0,0 +1,41 @@
+/*
+Copyright 2005 - 2017 by Paolo Brandoli/Binarno s.p.
+
+Imebra is available for free under the GNU General Public License.
+
+The full text of the license is available in the file license.rst
+ in the project root folder.
+
+If you do not want to be bound by the GPL terms (such as the requirement
+ that your application must also be GPL), you may purchase a commercial
+ license for Imebra from the Imebra’s website (http://imebra.com).
+*/
+
+/*! \file memoryMappedFileStreamInput.cpp
+    \brief Implementation of the memory mapped file input stream class.
+
+*/
+
+#include "../include/imebra/memoryMappedFileStreamInput.h"
+#include "../implementation/memoryMappedFileStreamImpl.h"
+
+namespace imebra
+{
+
+MemoryMappedFileStreamInput::~MemoryMappedFileStreamInput()
+{
+}
+
+MemoryMappedFileStreamInput::MemoryMappedFileStreamInput(const std::wstring& name): BaseStreamInput(std::make_shared<implementation::memoryMappedFileStreamInput>(name))
+{
+}
+
+MemoryMappedFileStreamInput::MemoryMappedFileStreamInput(const std::string& name): BaseStreamInput(std::make_shared<implementation::memoryMappedFileStreamInput>(name))
+{
+}
+
+MemoryMappedFileStreamInput::MemoryMappedFileStreamInput(const MemoryMappedFileStreamInput& source): BaseStreamInput(source)
+{
+}
+
+}
@@ -82,4 +82,13 @@ void Transform::runTransform(
     IMEBRA_FUNCTION_END_LOG();
 }
 
+void Transform::setMaximumThreads(std::uint32_t maximumThreads)
+{
+    IMEBRA_FUNCTION_START();
+
+    imebra::implementation::transforms::transform::setMaximumThreads(maximumThreads);
+
+    IMEBRA_FUNCTION_END_LOG();
+}
+
 }
@@ -726,6 +726,70 @@ TEST(acseTest, overlappingOperations)
 }
 
 
+TEST(acseTest, arenaAllocation)
+{
+    PipeStream toSCU(1024), toSCP(1024);
+
+    StreamReader readSCU(toSCU.getStreamInput());
+    StreamWriter writeSCU(toSCP.getStreamOutput());
+
+    StreamReader readSCP(toSCP.getStreamInput());
+    StreamWriter writeSCP(toSCU.getStreamOutput());
+
+    PresentationContext context("1.2.840.10008.1.1");
+    context.addTransferSyntax("1.2.840.10008.1.2.1"); // explicit VR little endian
+    PresentationContexts presentationContexts;
+    presentationContexts.addPresentationContext(context);
+
+    const std::string scpName("SCP");
+
+    std::thread scp(imebra::tests::scpThreadMultipleOperations, std::ref(scpName), std::ref(presentationContexts), std::ref(readSCP), std::ref(writeSCP), 1u);
+
+    {
+        AssociationSCU scu("SCU", scpName, 1, 1, presentationContexts, readSCU, writeSCU, 0);
+
+        for(std::uint16_t messageId(1); messageId != 3; ++messageId)
+        {
+            const bool bArena(messageId == 2);
+            scu.setDataSetAllocation(bArena ? dataSetAllocation_t::arena : dataSetAllocation_t::heap);
+
+            MutableAssociationMessage command("1.2.840.10008.1.1");
+
+            MutableDataSet dataset0;
+            dataset0.setUint32(TagId(tagId_t::CommandField_0000_0100), 0x1, tagVR_t::US);
+            dataset0.setUint32(TagId(tagId_t::MessageID_0000_0110), messageId, tagVR_t::US);
+            dataset0.setUint32(TagId(tagId_t::CommandDataSetType_0000_0800), 0);
+            command.addDataSet(dataset0);
+
+            MutableDataSet payload("1.2.840.10008.1.2.1");
+            payload.setString(TagId(tagId_t::PatientName_0010_0010), "Patient^Name");
+            command.addDataSet(payload);
+
+            scu.sendMessage(command);
+
+            AssociationMessage response = scu.getResponse(messageId);
+            DataSet responsePayload = response.getPayload();
+            EXPECT_EQ("Patient^Name", responsePayload.getString(TagId(tagId_t::PatientName_0010_0010), 0));
+
+            if(bArena)
+            {
+                EXPECT_GT(response.getCommand().getArenaSize(), 0u);
+                EXPECT_GT(responsePayload.getArenaSize(), 0u);
+            }
+            else
+            {
+                EXPECT_EQ(0u, response.getCommand().getArenaSize());
+                EXPECT_EQ(0u, responsePayload.getArenaSize());
+            }
+        }
+
+        scu.release();
+    }
+
+    scp.join();
+}
+
+
 TEST(acseTest, negotiationMultiplePresentationContexts)
 {
     PipeStream toSCU(1024), toSCP(1024);
@@ -405,6 +405,152 @@ TEST(colorConversion, factoryTest)
     ASSERT_EQ("PALETTE COLOR", ColorTransformsFactory::normalizeColorSpace("PALETTE COLOR"));
 }
 
+
+Image runColorTransformForTest(const Transform& colorTransform, const Image& source)
+{
+    MutableImage destination(colorTransform.allocateOutputImage(source, source.getWidth(), source.getHeight()));
+    colorTransform.runTransform(source, 0, 0, source.getWidth(), source.getHeight(), destination, 0, 0);
+    return destination;
+}
+
+
+TEST(colorConversion, factoryTransformsMap)
+{
+    // All the registered transforms
+    ///////////////////////////////////////////////////////////
+    const std::string directConversions[][2] = {
+        {"MONOCHROME1", "MONOCHROME2"},
+        {"MONOCHROME2", "MONOCHROME1"},
+        {"MONOCHROME1", "RGB"},
+        {"MONOCHROME2", "RGB"},
+        {"MONOCHROME2", "YBR_FULL"},
+        {"MONOCHROME2", "YBR_ICT"},
+        {"PALETTE COLOR", "RGB"},
+        {"RGB", "MONOCHROME2"},
+        {"RGB", "YBR_FULL"},
+        {"RGB", "YBR_ICT"},
+        {"RGB", "YBR_RCT"},
+        {"RGB", "YBR_PARTIAL"},
+        {"YBR_FULL", "MONOCHROME2"},
+        {"YBR_ICT", "MONOCHROME2"},
+        {"YBR_FULL", "RGB"},
+        {"YBR_ICT", "RGB"},
+        {"YBR_RCT", "RGB"},
+        {"YBR_PARTIAL", "RGB"}};
+
+    for(const std::string* pConversion: directConversions)
+    {
+        Transform colorTransform(ColorTransformsFactory::getTransform(pConversion[0], pConversion[1]));
+        ASSERT_FALSE(colorTransform.isEmpty());
+
+        MutableImage source(4, 3, bitDepth_t::depthU8, pConversion[0], 7);
+        Image destination(colorTransform.allocateOutputImage(source, 4, 3));
+        EXPECT_EQ(pConversion[1], destination.getColorSpace());
+    }
+
+    Image ybrPartial(buildImageForTest(17, 9, bitDepth_t::depthU8, 7, "YBR_PARTIAL", 30));
+
+    // Two transforms chained through RGB
+    ///////////////////////////////////////////////////////////
+    {
+        Transform partialToFull(ColorTransformsFactory::getTransform("YBR_PARTIAL", "YBR_FULL"));
+        Image ybrFull(runColorTransformForTest(partialToFull, ybrPartial));
+        EXPECT_EQ("YBR_FULL", ybrFull.getColorSpace());
+
+        Image rgb(runColorTransformForTest(ColorTransformsFactory::getTransform("YBR_PARTIAL", "RGB"), ybrPartial));
+        Image compareYbrFull(runColorTransformForTest(ColorTransformsFactory::getTransform("RGB", "YBR_FULL"), rgb));
+        EXPECT_EQ(0.0, compareImages(compareYbrFull, ybrFull));
+    }
+
+    // The color spaces names are normalized
+    ///////////////////////////////////////////////////////////
+    {
+        Image ybrFull(runColorTransformForTest(ColorTransformsFactory::getTransform("YBR_PARTIAL", "YBR_FULL"), ybrPartial));
+        Image rgb(runColorTransformForTest(ColorTransformsFactory::getTransform("YBR_FULL", "RGB"), ybrFull));
+
+        for(const std::string subsampledColorSpace: {"YBR_FULL_422", "YBR_FULL_420", "ybr_full"})
+        {
+            Transform normalizedTransform(ColorTransformsFactory::getTransform(subsampledColorSpace, "RGB"));
+            Image normalizedRgb(runColorTransformForTest(normalizedTransform, ybrFull));
+            EXPECT_EQ("RGB", normalizedRgb.getColorSpace());
+            EXPECT_EQ(0.0, compareImages(rgb, normalizedRgb));
+        }
+    }
+
+    // No transform between color spaces with the same
+    //  normalized name or without a conversion path
+    ///////////////////////////////////////////////////////////
+    EXPECT_THROW(ColorTransformsFactory::getTransform("RGB", "RGB"), ColorTransformsFactoryNoTransformError);
+    EXPECT_THROW(ColorTransformsFactory::getTransform("YBR_FULL_422", "YBR_FULL"), ColorTransformsFactoryNoTransformError);
+    EXPECT_THROW(ColorTransformsFactory::getTransform("YBR_FULL_420", "ybr_full_422"), ColorTransformsFactoryNoTransformError);
+    EXPECT_THROW(ColorTransformsFactory::getTransform("RGB", "PALETTE COLOR"), ColorTransformsFactoryNoTransformError);
+}
+
+
+Image convertColorSpaceForSimdTest(const Image& source, const std::string& finalColorSpace, bool bSimd)
+{
+    CodecFactory::setSimdEnabled(bSimd);
+
+    // Convert a part of the image, so the rows have a
+    //  different length and the pixels a different position
+    //  in the input and output images
+    Transform colorTransform(ColorTransformsFactory::getTransform(source.getColorSpace(), finalColorSpace));
+    MutableImage destination(colorTransform.allocateOutputImage(source, source.getWidth() + 3, source.getHeight()));
+    colorTransform.runTransform(source, 0, 0, source.getWidth(), source.getHeight(), destination, 0, 0);
+    colorTransform.runTransform(source, 1, 1, source.getWidth() - 2, source.getHeight() - 2, destination, 3, 0);
+
+    CodecFactory::setSimdEnabled(true);
+
+    return destination;
+}
+
+
+TEST(colorConversion, simdMatchesPortable)
+{
+    const std::string conversions[][2] = {
+        {"RGB", "YBR_FULL"},
+        {"RGB", "YBR_ICT"},
+        {"RGB", "YBR_PARTIAL"},
+        {"RGB", "YBR_RCT"},
+        {"YBR_FULL", "RGB"},
+        {"YBR_ICT", "RGB"},
+        {"YBR_PARTIAL", "RGB"},
+        {"YBR_RCT", "RGB"}};
+
+    const std::uint32_t width(45), height(7);
+
+    for(std::uint32_t highBit(3); highBit != 16; ++highBit)
+    {
+        const bitDepth_t depth(highBit < 8 ? bitDepth_t::depthU8 : bitDepth_t::depthU16);
+
+        for(const std::string* pConversion: conversions)
+        {
+            MutableImage source(width, height, depth, pConversion[0], highBit);
+
+            {
+                WritingDataHandlerNumeric sourceHandler(source.getWritingDataHandler());
+                std::uint32_t random(highBit);
+                for(size_t scanValues(0); scanValues != sourceHandler.getSize(); ++scanValues)
+                {
+                    random = random * 1103515245u + 12345u;
+                    sourceHandler.setUint32(scanValues, (random >> 8) & ((1u << (highBit + 1)) - 1));
+                }
+            }
+
+            Image portableImage(convertColorSpaceForSimdTest(source, pConversion[1], false));
+            Image simdImage(convertColorSpaceForSimdTest(source, pConversion[1], true));
+
+            ReadingDataHandlerNumeric portableHandler(portableImage.getReadingDataHandler());
+            ReadingDataHandlerNumeric simdHandler(simdImage.getReadingDataHandler());
+            ASSERT_EQ(portableHandler.getSize(), simdHandler.getSize());
+            for(size_t scanValues(0); scanValues != portableHandler.getSize(); ++scanValues)
+            {
+                ASSERT_EQ(portableHandler.getUint32(scanValues), simdHandler.getUint32(scanValues));
+            }
+        }
+    }
+}
+
 }
 
 }
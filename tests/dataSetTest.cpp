@@ -4,6 +4,9 @@
 #include <list>
 #include <string.h>
 #include <memory>
+#include <thread>
+#include <atomic>
+#include <vector>
 #include <gtest/gtest.h>
 
 namespace imebra
@@ -160,6 +163,41 @@ TEST(dataSetTest, testGetTags)
     ASSERT_TRUE(bPatientAge);
 }
 
+TEST(dataSetTest, testTagsOrder)
+{
+    MutableDataSet testDataSet;
+
+    // Insert the tags in random order
+    testDataSet.setString(TagId(std::uint16_t(0x0011), std::uint32_t(1), std::uint16_t(0x0020)), "Order 1", tagVR_t::LO);
+    testDataSet.setString(TagId(tagId_t::PatientAge_0010_1010), "003Y");
+    testDataSet.setString(TagId(std::uint16_t(0x0011), std::uint32_t(0), std::uint16_t(0x0030)), "Order 0", tagVR_t::LO);
+    testDataSet.setString(TagId(tagId_t::Modality_0008_0060), "OT");
+    testDataSet.setString(TagId(tagId_t::PatientName_0010_0010), "Test patient");
+    testDataSet.setString(TagId(std::uint16_t(0xffff), std::uint16_t(0xffff)), "Last", tagVR_t::LO);
+
+    tagsIds_t tags = testDataSet.getTags();
+    ASSERT_EQ(7u, tags.size());
+    EXPECT_EQ(0x0002u, tags[0].getGroupId()); // transfer syntax
+    EXPECT_EQ(0x0008u, tags[1].getGroupId());
+    EXPECT_EQ(0x0060u, tags[1].getTagId());
+    EXPECT_EQ(0x0010u, tags[2].getTagId());
+    EXPECT_EQ(0x1010u, tags[3].getTagId());
+    EXPECT_EQ(0x0011u, tags[4].getGroupId());
+    EXPECT_EQ(0u, tags[4].getGroupOrder());
+    EXPECT_EQ(0x0030u, tags[4].getTagId());
+    EXPECT_EQ(1u, tags[5].getGroupOrder());
+    EXPECT_EQ(0x0020u, tags[5].getTagId());
+    EXPECT_EQ(0xffffu, tags[6].getGroupId());
+    EXPECT_EQ(0xffffu, tags[6].getTagId());
+
+    EXPECT_EQ("Order 1", testDataSet.getString(TagId(std::uint16_t(0x0011), std::uint32_t(1), std::uint16_t(0x0020)), 0));
+    EXPECT_EQ("Last", testDataSet.getString(TagId(std::uint16_t(0xffff), std::uint16_t(0xffff)), 0));
+    EXPECT_THROW(testDataSet.getTag(TagId(std::uint16_t(0x0011), std::uint32_t(0), std::uint16_t(0x0020))), MissingTagError);
+    EXPECT_THROW(testDataSet.getTag(TagId(std::uint16_t(0x0011), std::uint32_t(2), std::uint16_t(0x0020))), MissingGroupError);
+    EXPECT_THROW(testDataSet.getTag(TagId(std::uint16_t(0x0012), std::uint16_t(0x0020))), MissingGroupError);
+    EXPECT_THROW(testDataSet.getTag(TagId(tagId_t::PatientSex_0010_0040)), MissingTagError);
+}
+
 TEST(dataSetTest, testCreateTags)
 {
     MutableDataSet testDataSet;
@@ -595,6 +633,80 @@ TEST(dataSetTest, streamWriterAndReader)
     }
 }
 
+TEST(dataSetTest, frozenDataSet)
+{
+    MutableDataSet testDataSet;
+    testDataSet.setString(TagId(tagId_t::PatientName_0010_0010), "Test^Patient");
+    testDataSet.setUint32(TagId(tagId_t::SeriesNumber_0020_0011), 12);
+    MutableDataSet sequenceItem = testDataSet.appendSequenceItem(TagId(tagId_t::ReferencedPerformedProcedureStepSequence_0008_1111));
+    sequenceItem.setString(TagId(0x10, 0x10), "Item");
+
+    MutableTag patientTag = testDataSet.getTagCreate(TagId(tagId_t::PatientName_0010_0010));
+
+    ASSERT_FALSE(testDataSet.isFrozen());
+    {
+        // The dataset cannot be frozen while a writing handler
+        //  is alive
+        WritingDataHandler pendingHandler = testDataSet.getWritingDataHandler(TagId(tagId_t::PatientID_0010_0020), 0);
+        pendingHandler.setString(0, "Kept");
+
+        EXPECT_THROW(testDataSet.freeze(), DataSetFrozenError);
+        EXPECT_FALSE(testDataSet.isFrozen());
+        EXPECT_FALSE(sequenceItem.isFrozen());
+    }
+    {
+        // Also a writing handler in a sequence item prevents the
+        //  freezing
+        WritingDataHandler pendingHandler = sequenceItem.getWritingDataHandler(TagId(0x10, 0x20), 0);
+        pendingHandler.setString(0, "ItemId");
+
+        EXPECT_THROW(testDataSet.freeze(), DataSetFrozenError);
+        EXPECT_FALSE(testDataSet.isFrozen());
+        EXPECT_FALSE(sequenceItem.isFrozen());
+    }
+    EXPECT_EQ("Kept", testDataSet.getString(TagId(tagId_t::PatientID_0010_0020), 0));
+    EXPECT_EQ("ItemId", sequenceItem.getString(TagId(0x10, 0x20), 0));
+
+    testDataSet.freeze();
+    ASSERT_TRUE(testDataSet.isFrozen());
+    ASSERT_TRUE(sequenceItem.isFrozen());
+    testDataSet.freeze();
+
+    EXPECT_THROW(testDataSet.setString(TagId(tagId_t::PatientName_0010_0010), "Changed"), DataSetFrozenError);
+    EXPECT_THROW(testDataSet.setString(TagId(tagId_t::PatientSex_0010_0040), "M"), DataSetFrozenError);
+    EXPECT_THROW(testDataSet.getTagCreate(TagId(tagId_t::PatientSex_0010_0040)), DataSetFrozenError);
+    EXPECT_THROW(testDataSet.appendSequenceItem(TagId(tagId_t::ReferencedPerformedProcedureStepSequence_0008_1111)), DataSetFrozenError);
+    EXPECT_THROW(patientTag.getWritingDataHandler(0), DataSetFrozenError);
+    EXPECT_THROW(patientTag.getWritingDataHandler(1), DataSetFrozenError);
+    EXPECT_THROW(sequenceItem.setString(TagId(0x10, 0x10), "Changed"), DataSetFrozenError);
+    EXPECT_EQ("Kept", testDataSet.getString(TagId(tagId_t::PatientID_0010_0020), 0));
+
+    std::atomic<size_t> errors(0);
+    std::vector<std::thread> readers;
+    for(size_t threadId(0); threadId != 4; ++threadId)
+    {
+        readers.emplace_back([&testDataSet, &errors]()
+        {
+            for(size_t iteration(0); iteration != 1000; ++iteration)
+            {
+                DataSet sequenceItem = testDataSet.getSequenceItem(TagId(tagId_t::ReferencedPerformedProcedureStepSequence_0008_1111), 0);
+                if(testDataSet.getString(TagId(tagId_t::PatientName_0010_0010), 0) != "Test^Patient" ||
+                        testDataSet.getUint32(TagId(tagId_t::SeriesNumber_0020_0011), 0) != 12u ||
+                        sequenceItem.getString(TagId(0x10, 0x10), 0) != "Item" ||
+                        testDataSet.getTags().size() != 5u)
+                {
+                    ++errors;
+                }
+            }
+        });
+    }
+    for(std::thread& reader: readers)
+    {
+        reader.join();
+    }
+    EXPECT_EQ(0u, errors.load());
+}
+
 } // namespace tests
 
 } // namespace imebra
@@ -4,6 +4,9 @@
 #include <gtest/gtest.h>
 #include <limits>
 #include <thread>
+#include <sstream>
+#include <algorithm>
+#include <vector>
 
 #ifndef DISABLE_DCMTK_INTEROPERABILITY_TEST
 
@@ -378,6 +381,383 @@ TEST(dicomCodecTest, testImplicitPrivateTags)
 }
 
 
+TEST(dicomCodecTest, stopAtTagAndTagFilter)
+{
+    for(const std::string transferSyntax: {"1.2.840.10008.1.2", "1.2.840.10008.1.2.1", "1.2.840.10008.1.2.5"})
+    {
+        MutableMemory streamMemory;
+        {
+            MutableDataSet testDataSet(transferSyntax);
+            testDataSet.setString(TagId(tagId_t::Modality_0008_0060), "OT");
+            testDataSet.setString(TagId(tagId_t::PatientName_0010_0010), "Patient name");
+            MutableDataSet sequenceItem(testDataSet.appendSequenceItem(TagId(tagId_t::ReferencedImageSequence_0008_1140)));
+            sequenceItem.setString(TagId(tagId_t::ReferencedSOPInstanceUID_0008_1155), "1.2.3.4");
+            testDataSet.setImage(0, buildImageForTest(64, 32, bitDepth_t::depthU8, 7, "MONOCHROME2", 50), imageQuality_t::veryHigh);
+            testDataSet.setString(TagId(std::uint16_t(0x7fe1), std::uint16_t(0x0010)), "After pixel data", tagVR_t::LO);
+
+            MemoryStreamOutput writeStream(streamMemory);
+            StreamWriter writer(writeStream);
+            CodecFactory::save(testDataSet, writer, codecType_t::dicom);
+        }
+
+        // Stop before the pixel data
+        {
+            MemoryStreamInput readStream(streamMemory);
+            StreamReader reader(readStream);
+            DataSet testDataSet = CodecFactory::load(reader, std::numeric_limits<size_t>::max(), TagId(tagId_t::PixelData_7FE0_0010));
+
+            EXPECT_EQ(transferSyntax, testDataSet.getString(TagId(tagId_t::TransferSyntaxUID_0002_0010), 0));
+            EXPECT_EQ("Patient name", testDataSet.getString(TagId(tagId_t::PatientName_0010_0010), 0));
+            EXPECT_EQ("1.2.3.4", testDataSet.getSequenceItem(TagId(tagId_t::ReferencedImageSequence_0008_1140), 0).getString(TagId(tagId_t::ReferencedSOPInstanceUID_0008_1155), 0));
+            EXPECT_EQ(64u, testDataSet.getUint32(TagId(tagId_t::Columns_0028_0011), 0));
+            EXPECT_THROW(testDataSet.getTag(TagId(tagId_t::PixelData_7FE0_0010)), MissingDataElementError);
+            EXPECT_THROW(testDataSet.getTag(TagId(std::uint16_t(0x7fe1), std::uint16_t(0x0010))), MissingDataElementError);
+        }
+
+        // Stop before the group 0x0010
+        {
+            MemoryStreamInput readStream(streamMemory);
+            StreamReader reader(readStream);
+            DataSet testDataSet = CodecFactory::load(reader, std::numeric_limits<size_t>::max(), TagId(std::uint16_t(0x0010), std::uint16_t(0)));
+
+            EXPECT_EQ("OT", testDataSet.getString(TagId(tagId_t::Modality_0008_0060), 0));
+            EXPECT_THROW(testDataSet.getTag(TagId(tagId_t::PatientName_0010_0010)), MissingDataElementError);
+        }
+
+        // Skip the group 0x0008 and the pixel data
+        {
+            MemoryStreamInput readStream(streamMemory);
+            StreamReader reader(readStream);
+            DataSet testDataSet = CodecFactory::load(reader, std::numeric_limits<size_t>::max(), TagId(std::uint16_t(0xffff), std::uint16_t(0xffff)),
+                                                     [](std::uint16_t groupId, std::uint16_t tagId)
+            {
+                return groupId != 0x0008 && !(groupId == 0x7fe0 && tagId == 0x0010);
+            });
+
+            EXPECT_EQ(transferSyntax, testDataSet.getString(TagId(tagId_t::TransferSyntaxUID_0002_0010), 0));
+            EXPECT_EQ("Patient name", testDataSet.getString(TagId(tagId_t::PatientName_0010_0010), 0));
+            EXPECT_EQ(64u, testDataSet.getUint32(TagId(tagId_t::Columns_0028_0011), 0));
+            EXPECT_THROW(testDataSet.getTag(TagId(tagId_t::Modality_0008_0060)), MissingDataElementError);
+            EXPECT_THROW(testDataSet.getTag(TagId(tagId_t::ReferencedImageSequence_0008_1140)), MissingDataElementError);
+            EXPECT_THROW(testDataSet.getTag(TagId(tagId_t::PixelData_7FE0_0010)), MissingDataElementError);
+            EXPECT_NO_THROW(testDataSet.getTag(TagId(std::uint16_t(0x7fe1), std::uint16_t(0x0010))));
+        }
+    }
+}
+
+
+class testStreamHandler: public DicomStreamHandler
+{
+public:
+    virtual void onTag(std::uint16_t groupId, std::uint16_t tagId, tagVR_t tagVR, std::uint32_t tagLength, StreamReader& reader) override
+    {
+        std::ostringstream event;
+        event << "tag " << std::hex << groupId << "," << tagId << " " << (tagVR == tagVR_t::SQ ? "SQ" : "");
+
+        // Read only the strings that we want to check
+        if(tagVR == tagVR_t::PN || tagVR == tagVR_t::UI || tagVR == tagVR_t::CS)
+        {
+            std::string value(tagLength, ' ');
+            if(tagLength != 0)
+            {
+                reader.read(&(value[0]), tagLength);
+            }
+            while(!value.empty() && (value.back() == ' ' || value.back() == 0))
+            {
+                value.pop_back();
+            }
+            event << value;
+        }
+        m_events.push_back(event.str());
+    }
+
+    virtual void onSequenceStart(std::uint16_t groupId, std::uint16_t tagId, tagVR_t, std::uint32_t) override
+    {
+        std::ostringstream event;
+        event << "sequence " << std::hex << groupId << "," << tagId;
+        m_events.push_back(event.str());
+    }
+
+    virtual void onSequenceEnd(std::uint16_t groupId, std::uint16_t tagId) override
+    {
+        std::ostringstream event;
+        event << "end sequence " << std::hex << groupId << "," << tagId;
+        m_events.push_back(event.str());
+    }
+
+    virtual void onItemStart(std::uint32_t) override
+    {
+        m_events.push_back("item");
+    }
+
+    virtual void onItemEnd() override
+    {
+        m_events.push_back("end item");
+    }
+
+    virtual void onPixelFragment(std::uint16_t groupId, std::uint16_t tagId, std::uint32_t fragmentId, std::uint32_t fragmentLength, StreamReader& reader) override
+    {
+        std::ostringstream event;
+        event << "fragment " << std::hex << groupId << "," << tagId << " " << fragmentId;
+        m_events.push_back(event.str());
+
+        // Read the first half of the fragment: the parser skips
+        //  the rest
+        if(fragmentLength > 1)
+        {
+            std::vector<char> fragment(fragmentLength / 2);
+            reader.read(fragment.data(), fragment.size());
+        }
+        m_fragmentsSize += fragmentLength;
+    }
+
+    std::vector<std::string> m_events;
+    size_t m_fragmentsSize = 0;
+};
+
+
+TEST(dicomCodecTest, streamParser)
+{
+    for(const std::string transferSyntax: {"1.2.840.10008.1.2", "1.2.840.10008.1.2.1", "1.2.840.10008.1.2.2", "1.2.840.10008.1.2.5"})
+    {
+        MutableMemory streamMemory;
+        {
+            MutableDataSet testDataSet(transferSyntax);
+            testDataSet.setString(TagId(tagId_t::Modality_0008_0060), "OT");
+            testDataSet.setString(TagId(tagId_t::PatientName_0010_0010), "Patient name");
+            MutableDataSet sequenceItem(testDataSet.appendSequenceItem(TagId(tagId_t::ReferencedImageSequence_0008_1140)));
+            sequenceItem.setString(TagId(tagId_t::ReferencedSOPInstanceUID_0008_1155), "1.2.3.4");
+            testDataSet.setImage(0, buildImageForTest(64, 32, bitDepth_t::depthU8, 7, "MONOCHROME2", 50), imageQuality_t::veryHigh);
+
+            MemoryStreamOutput writeStream(streamMemory);
+            StreamWriter writer(writeStream);
+            CodecFactory::save(testDataSet, writer, codecType_t::dicom);
+        }
+
+        MemoryStreamInput readStream(streamMemory);
+        StreamReader reader(readStream);
+        testStreamHandler handler;
+        DicomStreamParser::parse(reader, handler);
+
+        const std::vector<std::string>& events(handler.m_events);
+
+        const std::vector<std::string>::const_iterator transferSyntaxEvent(std::find(events.begin(), events.end(), "tag 2,10 " + transferSyntax));
+        const std::vector<std::string>::const_iterator modalityEvent(std::find(events.begin(), events.end(), "tag 8,60 OT"));
+        const std::vector<std::string>::const_iterator sequenceEvent(std::find(events.begin(), events.end(), "sequence 8,1140"));
+        const std::vector<std::string>::const_iterator patientEvent(std::find(events.begin(), events.end(), "tag 10,10 Patient name"));
+        ASSERT_TRUE(transferSyntaxEvent != events.end());
+        ASSERT_TRUE(modalityEvent != events.end());
+        ASSERT_TRUE(sequenceEvent != events.end());
+        ASSERT_TRUE(patientEvent != events.end());
+        EXPECT_TRUE(transferSyntaxEvent < modalityEvent);
+        EXPECT_TRUE(modalityEvent < sequenceEvent);
+        EXPECT_TRUE(sequenceEvent < patientEvent);
+
+        // The sequence contains one item with one tag
+        ASSERT_TRUE(events.end() - sequenceEvent > 4);
+        EXPECT_EQ("item", *(sequenceEvent + 1));
+        EXPECT_EQ("tag 8,1155 1.2.3.4", *(sequenceEvent + 2));
+        EXPECT_EQ("end item", *(sequenceEvent + 3));
+        EXPECT_EQ("end sequence 8,1140", *(sequenceEvent + 4));
+
+        if(transferSyntax == "1.2.840.10008.1.2.5")
+        {
+            // Encapsulated pixel data: offset table and one fragment
+            ASSERT_LE(4u, events.size());
+            EXPECT_EQ("sequence 7fe0,10", events[events.size() - 4]);
+            EXPECT_EQ("fragment 7fe0,10 0", events[events.size() - 3]);
+            EXPECT_EQ("fragment 7fe0,10 1", events[events.size() - 2]);
+            EXPECT_EQ("end sequence 7fe0,10", events.back());
+            EXPECT_NE(0u, handler.m_fragmentsSize);
+        }
+        else
+        {
+            EXPECT_EQ("tag 7fe0,10 ", events.back());
+        }
+    }
+}
+
+
+class throwingStreamHandler: public DicomStreamHandler
+{
+public:
+    virtual void onTag(std::uint16_t, std::uint16_t, tagVR_t, std::uint32_t tagLength, StreamReader& reader) override
+    {
+        // Read past the end of the tag
+        std::vector<char> value(tagLength + 1);
+        reader.read(value.data(), value.size());
+    }
+};
+
+
+class throwingFragmentsHandler: public DicomStreamHandler
+{
+public:
+    virtual void onPixelFragment(std::uint16_t, std::uint16_t, std::uint32_t, std::uint32_t fragmentLength, StreamReader& reader) override
+    {
+        // Read past the end of the fragment
+        std::vector<char> fragment(fragmentLength + 1);
+        reader.read(fragment.data(), fragment.size());
+    }
+};
+
+
+class overReadingStreamHandler: public DicomStreamHandler
+{
+public:
+    virtual void onTag(std::uint16_t groupId, std::uint16_t tagId, tagVR_t, std::uint32_t tagLength, StreamReader& reader) override
+    {
+        ++m_tags;
+
+        std::string value(tagLength, ' ');
+        if(tagLength != 0)
+        {
+            reader.read(&(value[0]), tagLength);
+        }
+        if(groupId == 0x10 && tagId == 0x10)
+        {
+            m_patientName = value;
+        }
+
+        // The reader doesn't reach the next tag
+        char nextByte;
+        try
+        {
+            reader.read(&nextByte, 1);
+        }
+        catch(const StreamEOFError&)
+        {
+            ++m_overReads;
+        }
+    }
+
+    size_t m_tags = 0;
+    size_t m_overReads = 0;
+    std::string m_patientName;
+};
+
+
+TEST(dicomCodecTest, streamParserErrors)
+{
+    MutableMemory streamMemory;
+    {
+        MutableDataSet testDataSet("1.2.840.10008.1.2.1");
+        testDataSet.setString(TagId(tagId_t::PatientName_0010_0010), "Patient name");
+
+        MemoryStreamOutput writeStream(streamMemory);
+        StreamWriter writer(writeStream);
+        CodecFactory::save(testDataSet, writer, codecType_t::dicom);
+    }
+
+    // The default handler ignores all the events
+    {
+        MemoryStreamInput readStream(streamMemory);
+        StreamReader reader(readStream);
+        DicomStreamHandler handler;
+        EXPECT_NO_THROW(DicomStreamParser::parse(reader, handler));
+    }
+
+    {
+        MemoryStreamInput readStream(streamMemory);
+        StreamReader reader(readStream);
+        throwingStreamHandler handler;
+        EXPECT_THROW(DicomStreamParser::parse(reader, handler), StreamEOFError);
+    }
+
+    // The handler that catches the failed reads doesn't
+    //  disturb the parser
+    {
+        MemoryStreamInput readStream(streamMemory);
+        StreamReader reader(readStream);
+        overReadingStreamHandler handler;
+        EXPECT_NO_THROW(DicomStreamParser::parse(reader, handler));
+        EXPECT_NE(0u, handler.m_tags);
+        EXPECT_EQ(handler.m_tags, handler.m_overReads);
+        EXPECT_EQ("Patient name", handler.m_patientName);
+    }
+
+    {
+        MutableMemory encapsulatedMemory;
+        {
+            MutableDataSet testDataSet("1.2.840.10008.1.2.5");
+            testDataSet.setImage(0, buildImageForTest(64, 32, bitDepth_t::depthU8, 7, "MONOCHROME2", 50), imageQuality_t::veryHigh);
+
+            MemoryStreamOutput writeStream(encapsulatedMemory);
+            StreamWriter writer(writeStream);
+            CodecFactory::save(testDataSet, writer, codecType_t::dicom);
+        }
+
+        MemoryStreamInput readStream(encapsulatedMemory);
+        StreamReader reader(readStream);
+        throwingFragmentsHandler handler;
+        EXPECT_THROW(DicomStreamParser::parse(reader, handler), StreamEOFError);
+    }
+
+    {
+        MutableMemory notDicom(std::string(256, 'a').c_str(), 256);
+        MemoryStreamInput readStream(notDicom);
+        StreamReader reader(readStream);
+        DicomStreamHandler handler;
+        EXPECT_THROW(DicomStreamParser::parse(reader, handler), CodecWrongFormatError);
+    }
+}
+
+
+TEST(dicomCodecTest, arenaAllocation)
+{
+    for(const std::string transferSyntax: {"1.2.840.10008.1.2", "1.2.840.10008.1.2.1", "1.2.840.10008.1.2.2"})
+    {
+        MutableMemory streamMemory;
+        {
+            MutableDataSet testDataSet(transferSyntax);
+            testDataSet.setString(TagId(tagId_t::PatientName_0010_0010), "Patient name");
+            testDataSet.setUint32(TagId(tagId_t::SeriesNumber_0020_0011), 1);
+            testDataSet.setDouble(TagId(tagId_t::SliceThickness_0018_0050), 1.5);
+            testDataSet.setString(TagId(tagId_t::ImageComments_0020_4000), std::string(1000, 'a'));
+            MutableDataSet sequenceItem(testDataSet.appendSequenceItem(TagId(tagId_t::ReferencedImageSequence_0008_1140)));
+            sequenceItem.setString(TagId(tagId_t::ReferencedSOPInstanceUID_0008_1155), "1.2.3.4");
+            testDataSet.setImage(0, buildImageForTest(64, 32, bitDepth_t::depthU16, 15, "MONOCHROME2", 50), imageQuality_t::veryHigh);
+
+            MemoryStreamOutput writeStream(streamMemory);
+            StreamWriter writer(writeStream);
+            CodecFactory::save(testDataSet, writer, codecType_t::dicom);
+        }
+
+        {
+            MemoryStreamInput readStream(streamMemory);
+            StreamReader reader(readStream);
+            DataSet heapDataSet(CodecFactory::load(reader, std::numeric_limits<size_t>::max(), dataSetAllocation_t::heap));
+            EXPECT_EQ(0u, heapDataSet.getArenaSize());
+            EXPECT_EQ("Patient name", heapDataSet.getString(TagId(tagId_t::PatientName_0010_0010), 0));
+        }
+
+        std::unique_ptr<Tag> pPatientTag;
+        {
+            MemoryStreamInput readStream(streamMemory);
+            StreamReader reader(readStream);
+            DataSet testDataSet(CodecFactory::load(reader, std::numeric_limits<size_t>::max(), dataSetAllocation_t::arena));
+            EXPECT_GT(testDataSet.getArenaSize(), 0u);
+
+            EXPECT_EQ(transferSyntax, testDataSet.getString(TagId(tagId_t::TransferSyntaxUID_0002_0010), 0));
+            EXPECT_EQ("Patient name", testDataSet.getString(TagId(tagId_t::PatientName_0010_0010), 0));
+            EXPECT_EQ(1u, testDataSet.getUint32(TagId(tagId_t::SeriesNumber_0020_0011), 0));
+            EXPECT_DOUBLE_EQ(1.5, testDataSet.getDouble(TagId(tagId_t::SliceThickness_0018_0050), 0));
+            EXPECT_EQ(std::string(1000, 'a'), testDataSet.getString(TagId(tagId_t::ImageComments_0020_4000), 0));
+            EXPECT_EQ("1.2.3.4", testDataSet.getSequenceItem(TagId(tagId_t::ReferencedImageSequence_0008_1140), 0).getString(TagId(tagId_t::ReferencedSOPInstanceUID_0008_1155), 0));
+
+            Image image(testDataSet.getImage(0));
+            Image compareImage(buildImageForTest(64, 32, bitDepth_t::depthU16, 15, "MONOCHROME2", 50));
+            EXPECT_EQ(0.0, compareImages(image, compareImage));
+
+            pPatientTag.reset(new Tag(testDataSet.getTag(TagId(tagId_t::PatientName_0010_0010))));
+        }
+
+        // The tag survives the dataset
+        EXPECT_EQ("Patient name", pPatientTag->getReadingDataHandler(0).getString(0));
+    }
+}
+
+
 void feedDataThread(PipeStream& source, DataSet& dataSet)
 {
     StreamWriter writer(source.getStreamOutput());
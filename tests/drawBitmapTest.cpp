@@ -1,6 +1,7 @@
 #include <imebra/imebra.h>
 #include "buildImageForTest.h"
 #include <gtest/gtest.h>
+#include <algorithm>
 
 namespace imebra
 {
@@ -304,6 +305,219 @@ TEST(drawBitmapTest, testDrawBitmapBGRA)
     }
 }
 
+TEST(drawBitmapTest, testDrawBitmapMonochromeVOILUT)
+{
+    struct testParameters_t
+    {
+        bitDepth_t depth;
+        std::uint32_t highBit;
+        double center;
+        double width;
+        dicomVOIFunction_t function;
+    };
+
+    const testParameters_t testParameters[] = {
+        {bitDepth_t::depthU8, 7, 100, 80, dicomVOIFunction_t::linear},
+        {bitDepth_t::depthS8, 7, 0, 100, dicomVOIFunction_t::linear},
+        {bitDepth_t::depthU16, 11, 2048, 1000, dicomVOIFunction_t::linear},
+        {bitDepth_t::depthU16, 15, 30000, 20000, dicomVOIFunction_t::sigmoid},
+        {bitDepth_t::depthS16, 15, 0, 20000, dicomVOIFunction_t::linearExact}
+    };
+
+    for(const testParameters_t& parameters: testParameters)
+    {
+        Image testImage = buildImageForTest(401, 301, parameters.depth, parameters.highBit, "MONOCHROME2", 50);
+
+        VOILUT voilut(VOIDescription(parameters.center, parameters.width, parameters.function, L""));
+        TransformsChain chain;
+        chain.addTransform(voilut);
+
+        // Calculate the expected pixels with the transforms
+        ///////////////////////////////////////////////////////////
+        MutableImage voilutImage = voilut.allocateOutputImage(testImage, testImage.getWidth(), testImage.getHeight());
+        voilut.runTransform(testImage, 0, 0, testImage.getWidth(), testImage.getHeight(), voilutImage, 0, 0);
+        MutableImage expectedImage(testImage.getWidth(), testImage.getHeight(), bitDepth_t::depthU8, "MONOCHROME2", 7);
+        TransformHighBit highBit;
+        highBit.runTransform(voilutImage, 0, 0, testImage.getWidth(), testImage.getHeight(), expectedImage, 0, 0);
+        ReadingDataHandler expectedHandler = expectedImage.getReadingDataHandler();
+
+        DrawBitmap testDraw(chain);
+
+        for(int alpha(0); alpha != 2; ++alpha)
+        {
+            const std::uint32_t pixelSize(alpha == 0 ? 3 : 4);
+            const std::uint32_t rowSize(((testImage.getWidth() * pixelSize + 3) / 4) * 4);
+
+            Memory bitmapBuffer = testDraw.getBitmap(testImage, alpha == 0 ? drawBitmapType_t::drawBitmapBGR : drawBitmapType_t::drawBitmapRGBA, 4);
+            size_t bufferSize;
+            const std::uint8_t* pBuffer((const std::uint8_t*)(bitmapBuffer.data(&bufferSize)));
+            ASSERT_EQ(rowSize * testImage.getHeight(), bufferSize);
+
+            for(std::uint32_t scanY = 0; scanY != testImage.getHeight(); ++scanY)
+            {
+                const std::uint8_t* pRow(pBuffer + scanY * rowSize);
+                for(std::uint32_t scanX = 0; scanX != testImage.getWidth(); ++scanX)
+                {
+                    const std::uint32_t expected(expectedHandler.getUint32(scanY * testImage.getWidth() + scanX));
+                    ASSERT_EQ(expected, (std::uint32_t)*(pRow++));
+                    ASSERT_EQ(expected, (std::uint32_t)*(pRow++));
+                    ASSERT_EQ(expected, (std::uint32_t)*(pRow++));
+                    if(alpha != 0)
+                    {
+                        ASSERT_EQ(255u, (std::uint32_t)*(pRow++));
+                    }
+                }
+            }
+        }
+    }
+}
+
+
+TEST(drawBitmapTest, testDrawBitmapArea)
+{
+    for(int monochrome(0); monochrome != 2; ++monochrome)
+    {
+        Image testImage = buildImageForTest(
+                    401,
+                    301,
+                    monochrome == 1 ? bitDepth_t::depthU16 : bitDepth_t::depthU8,
+                    monochrome == 1 ? 11 : 7,
+                    monochrome == 1 ? "MONOCHROME2" : "RGB",
+                    50);
+
+        TransformsChain chain;
+        if(monochrome == 1)
+        {
+            chain.addTransform(VOILUT(VOIDescription(2048, 3000, dicomVOIFunction_t::linear, L"")));
+        }
+        DrawBitmap testDraw(chain);
+
+        const std::uint32_t width(testImage.getWidth());
+        Memory referenceBitmap = testDraw.getBitmap(testImage, drawBitmapType_t::drawBitmapRGB, 1);
+        size_t referenceSize;
+        const std::uint8_t* pReference((const std::uint8_t*)referenceBitmap.data(&referenceSize));
+
+        // An area at its original size
+        ///////////////////////////////////////////////////////////
+        for(int filter(0); filter != 2; ++filter)
+        {
+            Memory areaBitmap = testDraw.getBitmap(testImage, 10, 20, 100, 50, 100, 50, filter == 0 ? drawBitmapFilter_t::box : drawBitmapFilter_t::bilinear, drawBitmapType_t::drawBitmapRGBA, 1);
+            size_t areaSize;
+            const std::uint8_t* pArea((const std::uint8_t*)areaBitmap.data(&areaSize));
+            ASSERT_EQ(100u * 50u * 4u, areaSize);
+            for(std::uint32_t scanY(0); scanY != 50; ++scanY)
+            {
+                for(std::uint32_t scanX(0); scanX != 100; ++scanX)
+                {
+                    const std::uint8_t* pReferencePixel(pReference + ((scanY + 20) * width + scanX + 10) * 3);
+                    ASSERT_EQ(pReferencePixel[0], *pArea++);
+                    ASSERT_EQ(pReferencePixel[1], *pArea++);
+                    ASSERT_EQ(pReferencePixel[2], *pArea++);
+                    ASSERT_EQ(255u, *pArea++);
+                }
+            }
+        }
+
+        // Halve the size: both the filters average 2x2 pixels
+        ///////////////////////////////////////////////////////////
+        for(int filter(0); filter != 2; ++filter)
+        {
+            Memory halfBitmap = testDraw.getBitmap(testImage, 0, 0, 400, 300, 200, 150, filter == 0 ? drawBitmapFilter_t::box : drawBitmapFilter_t::bilinear, drawBitmapType_t::drawBitmapBGR, 4);
+            size_t halfSize;
+            const std::uint8_t* pHalf((const std::uint8_t*)halfBitmap.data(&halfSize));
+            ASSERT_EQ(600u * 150u, halfSize);
+            for(std::uint32_t scanY(0); scanY != 150; ++scanY)
+            {
+                for(std::uint32_t scanX(0); scanX != 200; ++scanX)
+                {
+                    for(std::uint32_t channel(0); channel != 3; ++channel)
+                    {
+                        std::uint32_t sum(0);
+                        for(std::uint32_t pixelY(scanY * 2); pixelY != scanY * 2 + 2; ++pixelY)
+                        {
+                            for(std::uint32_t pixelX(scanX * 2); pixelX != scanX * 2 + 2; ++pixelX)
+                            {
+                                sum += pReference[(pixelY * width + pixelX) * 3 + channel];
+                            }
+                        }
+                        ASSERT_EQ((sum + 2) / 4, pHalf[scanY * 600 + scanX * 3 + 2 - channel]);
+                    }
+                }
+            }
+        }
+
+        // Enlarge an area and make a thumbnail of the image
+        ///////////////////////////////////////////////////////////
+        auto checkBilinear = [&](std::uint32_t topLeftX, std::uint32_t topLeftY, std::uint32_t areaWidth, std::uint32_t areaHeight, std::uint32_t bitmapWidth, std::uint32_t bitmapHeight)
+        {
+            Memory bilinearBitmap = testDraw.getBitmap(testImage, topLeftX, topLeftY, areaWidth, areaHeight, bitmapWidth, bitmapHeight, drawBitmapFilter_t::bilinear, drawBitmapType_t::drawBitmapRGB, 1);
+            size_t bilinearSize;
+            const std::uint8_t* pBilinear((const std::uint8_t*)bilinearBitmap.data(&bilinearSize));
+            ASSERT_EQ(bitmapWidth * bitmapHeight * 3u, bilinearSize);
+            for(std::uint32_t scanY(0); scanY != bitmapHeight; ++scanY)
+            {
+                const double sourceY(std::min(std::max((scanY + 0.5) * areaHeight / bitmapHeight - 0.5, 0.0), areaHeight - 1.0));
+                const std::uint32_t y0((std::uint32_t)sourceY), y1(std::min(y0 + 1, areaHeight - 1));
+                for(std::uint32_t scanX(0); scanX != bitmapWidth; ++scanX)
+                {
+                    const double sourceX(std::min(std::max((scanX + 0.5) * areaWidth / bitmapWidth - 0.5, 0.0), areaWidth - 1.0));
+                    const std::uint32_t x0((std::uint32_t)sourceX), x1(std::min(x0 + 1, areaWidth - 1));
+                    for(std::uint32_t channel(0); channel != 3; ++channel)
+                    {
+                        const double p00(pReference[((topLeftY + y0) * width + topLeftX + x0) * 3 + channel]);
+                        const double p01(pReference[((topLeftY + y0) * width + topLeftX + x1) * 3 + channel]);
+                        const double p10(pReference[((topLeftY + y1) * width + topLeftX + x0) * 3 + channel]);
+                        const double p11(pReference[((topLeftY + y1) * width + topLeftX + x1) * 3 + channel]);
+                        const double weightX(sourceX - x0), weightY(sourceY - y0);
+                        const double expected((p00 * (1 - weightX) + p01 * weightX) * (1 - weightY) + (p10 * (1 - weightX) + p11 * weightX) * weightY);
+                        ASSERT_NEAR(expected, (double)*pBilinear++, 1.5);
+                    }
+                }
+            }
+        };
+        checkBilinear(100, 100, 20, 10, 70, 30);
+        checkBilinear(0, 0, 401, 301, 40, 30);
+
+        // A thumbnail of the whole image: each pixel is the
+        //  rounded average of the pixels in the area it covers
+        ///////////////////////////////////////////////////////////
+        {
+            const std::uint32_t thumbnailWidth(16), thumbnailHeight(12);
+            std::uint8_t thumbnail[thumbnailWidth * thumbnailHeight * 3];
+            ASSERT_EQ(sizeof(thumbnail), testDraw.getBitmap(testImage, 0, 0, 401, 301, thumbnailWidth, thumbnailHeight, drawBitmapFilter_t::box, drawBitmapType_t::drawBitmapRGB, 1, 0, 0));
+            ASSERT_EQ(sizeof(thumbnail), testDraw.getBitmap(testImage, 0, 0, 401, 301, thumbnailWidth, thumbnailHeight, drawBitmapFilter_t::box, drawBitmapType_t::drawBitmapRGB, 1, (char*)thumbnail, sizeof(thumbnail)));
+
+            const std::uint8_t* pThumbnail(thumbnail);
+            for(std::uint32_t scanY(0); scanY != thumbnailHeight; ++scanY)
+            {
+                const std::uint32_t rowsStart(scanY * 301 / thumbnailHeight), rowsEnd((scanY + 1) * 301 / thumbnailHeight);
+                for(std::uint32_t scanX(0); scanX != thumbnailWidth; ++scanX)
+                {
+                    const std::uint32_t columnsStart(scanX * 401 / thumbnailWidth), columnsEnd((scanX + 1) * 401 / thumbnailWidth);
+                    const std::uint32_t area((rowsEnd - rowsStart) * (columnsEnd - columnsStart));
+                    for(std::uint32_t channel(0); channel != 3; ++channel)
+                    {
+                        std::uint32_t sum(0);
+                        for(std::uint32_t pixelY(rowsStart); pixelY != rowsEnd; ++pixelY)
+                        {
+                            for(std::uint32_t pixelX(columnsStart); pixelX != columnsEnd; ++pixelX)
+                            {
+                                sum += pReference[(pixelY * width + pixelX) * 3 + channel];
+                            }
+                        }
+                        ASSERT_EQ((sum + area / 2) / area, *pThumbnail++);
+                    }
+                }
+            }
+        }
+
+        ASSERT_THROW(testDraw.getBitmap(testImage, 1, 0, 401, 301, 16, 12, drawBitmapFilter_t::box, drawBitmapType_t::drawBitmapRGB, 1), TransformInvalidAreaError);
+        ASSERT_THROW(testDraw.getBitmap(testImage, 0, 300, 401, 2, 16, 12, drawBitmapFilter_t::bilinear, drawBitmapType_t::drawBitmapRGB, 1), TransformInvalidAreaError);
+        ASSERT_THROW(testDraw.getBitmap(testImage, 0, 0, 0, 10, 16, 12, drawBitmapFilter_t::bilinear, drawBitmapType_t::drawBitmapRGB, 1), TransformInvalidAreaError);
+    }
+}
+
+
 TEST(drawBitmapTest, testPalette)
 {
     MutableDataSet testDataSet("1.2.840.10008.1.2.1");
@@ -1,6 +1,7 @@
 #include <imebra/imebra.h>
 #include <gtest/gtest.h>
 #include <thread>
+#include <algorithm>
 #include "buildImageForTest.h"
 
 namespace imebra
@@ -206,6 +207,71 @@ TEST(jpegCodecTest, testLossless)
 }
 
 
+MutableMemory saveJpegForSimdTest(const Image& image, const std::string& transferSyntax)
+{
+    MutableMemory memory;
+    {
+        MemoryStreamOutput streamOutput(memory);
+        StreamWriter writer(streamOutput);
+        CodecFactory::saveImage(writer, image, transferSyntax, imageQuality_t::veryHigh, image.getHighBit() < 8 ? 8 : 16, false, false, true, false);
+    }
+    return memory;
+}
+
+
+Image loadJpegForSimdTest(const Memory& memory)
+{
+    MemoryStreamInput streamInput(memory);
+    StreamReader reader(streamInput);
+    DataSet dataSet(CodecFactory::load(reader));
+    return dataSet.getImage(0);
+}
+
+
+TEST(jpegCodecTest, simdDct)
+{
+    for(int precision=0; precision != 2; ++precision)
+    {
+        std::uint32_t bits = precision == 0 ? 7 : 11;
+        std::string transferSyntax = precision == 0 ? "1.2.840.10008.1.2.4.50" : "1.2.840.10008.1.2.4.51";
+
+        std::uint32_t width = 600;
+        std::uint32_t height = 400;
+
+        Image ybrImage = buildImageForTest(width, height, precision == 0 ? bitDepth_t::depthU8 : bitDepth_t::depthU16, bits, "YBR_FULL", 50);
+
+        // The vectorized FDCT must produce the same stream as
+        //  the portable one
+        CodecFactory::setSimdEnabled(false);
+        MutableMemory portableJpeg(saveJpegForSimdTest(ybrImage, transferSyntax));
+        Image portableImage(loadJpegForSimdTest(portableJpeg));
+
+        CodecFactory::setSimdEnabled(true);
+        MutableMemory simdJpeg(saveJpegForSimdTest(ybrImage, transferSyntax));
+        Image simdImage(loadJpegForSimdTest(portableJpeg));
+
+        ASSERT_EQ(portableJpeg.size(), simdJpeg.size());
+        size_t dataSize;
+        const char* pPortableData(portableJpeg.data(&dataSize));
+        const char* pSimdData(simdJpeg.data(&dataSize));
+        ASSERT_TRUE(std::equal(pPortableData, pPortableData + dataSize, pSimdData));
+
+        // The vectorized IDCT may differ by 1
+        ASSERT_EQ(portableImage.getWidth(), simdImage.getWidth());
+        ASSERT_EQ(portableImage.getHeight(), simdImage.getHeight());
+        ReadingDataHandlerNumeric portableHandler(portableImage.getReadingDataHandler());
+        ReadingDataHandlerNumeric simdHandler(simdImage.getReadingDataHandler());
+        ASSERT_EQ(portableHandler.getSize(), simdHandler.getSize());
+        for(size_t scanValues(0); scanValues != portableHandler.getSize(); ++scanValues)
+        {
+            std::int64_t difference((std::int64_t)portableHandler.getUint32(scanValues) - (std::int64_t)simdHandler.getUint32(scanValues));
+            ASSERT_LE(difference, 1);
+            ASSERT_GE(difference, -1);
+        }
+    }
+}
+
+
 void feedJpegDataThread(PipeStream& source, DataSet& dataSet)
 {
     StreamWriter writer(source.getStreamOutput());
@@ -216,6 +282,76 @@ void feedJpegDataThread(PipeStream& source, DataSet& dataSet)
 }
 
 
+TEST(jpegCodecTest, restartIntervals)
+{
+    for(int lossless = 0; lossless != 2; ++lossless)
+    {
+        for(int subsampled = 0; subsampled != 2; ++subsampled)
+        {
+            for(int interleaved = 0; interleaved != 2; ++interleaved)
+            {
+                for(std::uint16_t mcuPerRestartInterval = 1; mcuPerRestartInterval < 64; mcuPerRestartInterval = (std::uint16_t)(mcuPerRestartInterval * 7))
+                {
+                    std::cout <<
+                                 "Testing restart intervals (lossless=" << lossless <<
+                                 ", subsampled=" << subsampled <<
+                                 ", interleaved=" << interleaved <<
+                                 ", mcuPerRestartInterval=" << mcuPerRestartInterval <<
+                                 ")"<< std::endl;
+
+                    std::string transferSyntax = (lossless == 0) ? "1.2.840.10008.1.2.4.50" : "1.2.840.10008.1.2.4.70";
+
+                    std::uint32_t width = 115;
+                    std::uint32_t height = 73;
+
+                    Image image = buildImageForTest(width, height, bitDepth_t::depthU8, 7, lossless == 0 ? "YBR_FULL" : "RGB", 50);
+
+                    CodecFactory::setJpegRestartInterval(mcuPerRestartInterval);
+                    MutableMemory savedJpeg;
+                    {
+                        MemoryStreamOutput streamOutput(savedJpeg);
+                        StreamWriter writer(streamOutput);
+                        CodecFactory::saveImage(writer, image, transferSyntax, imageQuality_t::veryHigh, 8, subsampled != 0 && lossless == 0, false, interleaved != 0, false);
+                    }
+                    CodecFactory::setJpegRestartInterval(0);
+
+                    // Check that the restart markers have been written
+                    size_t dataSize;
+                    const std::uint8_t* pData(reinterpret_cast<const std::uint8_t*>(savedJpeg.data(&dataSize)));
+                    size_t restartMarkers(0);
+                    for(size_t scanData(1); scanData < dataSize; ++scanData)
+                    {
+                        if(pData[scanData - 1] == 0xff && (pData[scanData] & 0xf8) == 0xd0)
+                        {
+                            ++restartMarkers;
+                        }
+                    }
+                    ASSERT_NE(0u, restartMarkers);
+
+                    // The serial and the parallel decoders must
+                    //  return the same image
+                    CodecFactory::setMaximumDecodingThreads(1);
+                    Image serialImage(loadJpegForSimdTest(savedJpeg));
+                    CodecFactory::setMaximumDecodingThreads(4);
+                    Image parallelImage(loadJpegForSimdTest(savedJpeg));
+                    CodecFactory::setMaximumDecodingThreads(1);
+
+                    ASSERT_DOUBLE_EQ(0.0, compareImages(serialImage, parallelImage));
+                    if(lossless != 0)
+                    {
+                        ASSERT_DOUBLE_EQ(0.0, compareImages(image, parallelImage));
+                    }
+                    else
+                    {
+                        ASSERT_LE(compareImages(image, parallelImage), (1 + subsampled) * 25);
+                    }
+                }
+            }
+        }
+    }
+}
+
+
 TEST(jpegCodecTest, codecFactoryPipe)
 {
     MutableDataSet testDataSet("1.2.840.10008.1.2.4.50");
@@ -253,6 +389,181 @@ TEST(jpegCodecTest, codecFactoryPipe)
     ASSERT_LE(differenceYBR, 1);
 }
 
+
+Image shrinkImageForTest(const Image& image, std::uint32_t scale)
+{
+    const std::uint32_t width(image.getWidth()), height(image.getHeight()), channels(image.getChannelsNumber());
+    const std::uint32_t scaledWidth((width + scale - 1) / scale), scaledHeight((height + scale - 1) / scale);
+    MutableImage scaledImage(scaledWidth, scaledHeight, image.getDepth(), image.getColorSpace(), image.getHighBit());
+    ReadingDataHandler source(image.getReadingDataHandler());
+    WritingDataHandler destination(scaledImage.getWritingDataHandler());
+    for(std::uint32_t scaledY(0); scaledY != scaledHeight; ++scaledY)
+    {
+        for(std::uint32_t scaledX(0); scaledX != scaledWidth; ++scaledX)
+        {
+            for(std::uint32_t channel(0); channel != channels; ++channel)
+            {
+                std::uint64_t sum(0), count(0);
+                for(std::uint32_t y(scaledY * scale); y != std::min(scaledY * scale + scale, height); ++y)
+                {
+                    for(std::uint32_t x(scaledX * scale); x != std::min(scaledX * scale + scale, width); ++x)
+                    {
+                        sum += source.getUint32((y * width + x) * channels + channel);
+                        ++count;
+                    }
+                }
+                destination.setUint32((scaledY * scaledWidth + scaledX) * channels + channel, (std::uint32_t)((sum + count / 2) / count));
+            }
+        }
+    }
+    return scaledImage;
+}
+
+
+TEST(jpegCodecTest, scaledDecoding)
+{
+    const char* transferSyntaxes[] = {"1.2.840.10008.1.2.4.50", "1.2.840.10008.1.2.4.51", "1.2.840.10008.1.2.4.70", "1.2.840.10008.1.2.1"};
+    const imageScale_t scales[] = {imageScale_t::full, imageScale_t::half, imageScale_t::quarter, imageScale_t::eighth};
+
+    for(const char* transferSyntax: transferSyntaxes)
+    {
+        const bool bLossy(std::string(transferSyntax) == "1.2.840.10008.1.2.4.50" || std::string(transferSyntax) == "1.2.840.10008.1.2.4.51");
+        const std::uint32_t bits(std::string(transferSyntax) == "1.2.840.10008.1.2.4.51" ? 11 : 7);
+
+        for(int subsampled = 0; subsampled != (bLossy ? 2 : 1); ++subsampled)
+        {
+            std::cout << "Testing scaled decoding (transfer syntax=" << transferSyntax << ", subsampled=" << subsampled << ")" << std::endl;
+
+            const std::uint32_t width(301);
+            const std::uint32_t height(203);
+            Image image = buildImageForTest(width, height, bits == 7 ? bitDepth_t::depthU8 : bitDepth_t::depthU16, bits, "YBR_FULL", 1000);
+
+            // The quality belowMedium subsamples the chrominance
+            MutableDataSet dataSet(transferSyntax);
+            dataSet.setImage(0, image, subsampled == 0 ? imageQuality_t::veryHigh : imageQuality_t::belowMedium);
+
+            Image fullImage(dataSet.getImage(0));
+
+            for(imageScale_t scale: scales)
+            {
+                Image scaledImage(dataSet.getImageScaled(0, scale));
+                const std::uint32_t scaleFactor((std::uint32_t)scale);
+                ASSERT_EQ((width + scaleFactor - 1) / scaleFactor, scaledImage.getWidth());
+                ASSERT_EQ((height + scaleFactor - 1) / scaleFactor, scaledImage.getHeight());
+
+                // The lossy images are decoded with reduced IDCTs:
+                //  they differ a little from the averaged pixels,
+                //  mainly in the blocks that cross the image's border
+                Image expectedImage(shrinkImageForTest(fullImage, scaleFactor));
+                if(bLossy && scale != imageScale_t::full)
+                {
+                    ASSERT_LE(compareImages(expectedImage, scaledImage), 20);
+                }
+                else
+                {
+                    ASSERT_DOUBLE_EQ(0.0, compareImages(expectedImage, scaledImage));
+                }
+            }
+        }
+    }
+}
+
+
+TEST(jpegCodecTest, scaledProgressiveDecoding)
+{
+    // 40x24 RGB image with 4:2:0 subsampled chrominance, saved by
+    //  libjpeg as a progressive jpeg with a DC scan and two AC
+    //  scans per channel
+    static const std::uint8_t progressiveJpeg[] = {
+        0xff, 0xd8, 0xff, 0xe0, 0x00, 0x10, 0x4a, 0x46, 0x49, 0x46, 0x00, 0x01, 0x01, 0x00, 0x00, 0x01,
+        0x00, 0x01, 0x00, 0x00, 0xff, 0xdb, 0x00, 0x43, 0x00, 0x03, 0x02, 0x02, 0x03, 0x02, 0x02, 0x03,
+        0x03, 0x03, 0x03, 0x04, 0x03, 0x03, 0x04, 0x05, 0x08, 0x05, 0x05, 0x04, 0x04, 0x05, 0x0a, 0x07,
+        0x07, 0x06, 0x08, 0x0c, 0x0a, 0x0c, 0x0c, 0x0b, 0x0a, 0x0b, 0x0b, 0x0d, 0x0e, 0x12, 0x10, 0x0d,
+        0x0e, 0x11, 0x0e, 0x0b, 0x0b, 0x10, 0x16, 0x10, 0x11, 0x13, 0x14, 0x15, 0x15, 0x15, 0x0c, 0x0f,
+        0x17, 0x18, 0x16, 0x14, 0x18, 0x12, 0x14, 0x15, 0x14, 0xff, 0xdb, 0x00, 0x43, 0x01, 0x03, 0x04,
+        0x04, 0x05, 0x04, 0x05, 0x09, 0x05, 0x05, 0x09, 0x14, 0x0d, 0x0b, 0x0d, 0x14, 0x14, 0x14, 0x14,
+        0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14,
+        0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14,
+        0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0xff, 0xc2,
+        0x00, 0x11, 0x08, 0x00, 0x18, 0x00, 0x28, 0x03, 0x01, 0x22, 0x00, 0x02, 0x11, 0x01, 0x03, 0x11,
+        0x01, 0xff, 0xc4, 0x00, 0x18, 0x00, 0x01, 0x01, 0x01, 0x01, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x06, 0x07, 0x05, 0x08, 0xff, 0xc4, 0x00, 0x17, 0x01,
+        0x01, 0x01, 0x01, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x06, 0x07, 0x08, 0x09, 0xff, 0xda, 0x00, 0x0c, 0x03, 0x01, 0x00, 0x02, 0x10, 0x03, 0x10, 0x00,
+        0x00, 0x00, 0xf0, 0xb5, 0x36, 0xaf, 0x4d, 0x4a, 0x1b, 0x94, 0x53, 0x6a, 0xf4, 0xe4, 0xf4, 0x06,
+        0x50, 0xdf, 0x46, 0xad, 0xdc, 0x3a, 0x60, 0xc7, 0x1e, 0xa9, 0xe9, 0x82, 0x9a, 0x02, 0x98, 0x4f,
+        0xee, 0x7f, 0xff, 0xc4, 0x00, 0x17, 0x10, 0x00, 0x03, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x05, 0x06, 0x15, 0xff, 0xda, 0x00, 0x08, 0x01,
+        0x01, 0x00, 0x01, 0x05, 0x00, 0x5f, 0x13, 0x82, 0x2e, 0x89, 0xc1, 0x17, 0xc4, 0xe0, 0x8b, 0xe2,
+        0x70, 0x45, 0xf1, 0x58, 0x22, 0xf8, 0x9c, 0x11, 0x74, 0x4e, 0x08, 0xbe, 0x2b, 0x04, 0x5f, 0x13,
+        0x82, 0x2f, 0x8a, 0xc1, 0x17, 0xc4, 0xe0, 0x8b, 0xa2, 0x70, 0x45, 0xf1, 0x58, 0x22, 0xf8, 0x9c,
+        0x11, 0x74, 0x4e, 0x09, 0xff, 0xc4, 0x00, 0x1c, 0x10, 0x00, 0x01, 0x03, 0x05, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x11, 0x00, 0x01, 0x13, 0x12, 0x23, 0x51,
+        0x61, 0x91, 0xff, 0xda, 0x00, 0x08, 0x01, 0x01, 0x00, 0x06, 0x3f, 0x00, 0x6b, 0x73, 0xcb, 0xaa,
+        0x40, 0xee, 0x53, 0x5b, 0x9e, 0x5d, 0x52, 0x07, 0x72, 0x9a, 0xdc, 0xf2, 0xea, 0x90, 0x3b, 0x94,
+        0xd6, 0xe7, 0x97, 0x54, 0x81, 0xdc, 0xa6, 0xb7, 0x3c, 0xba, 0xa4, 0x0e, 0xe5, 0x35, 0xb9, 0xe5,
+        0xd5, 0x20, 0x77, 0x29, 0xad, 0xcf, 0x2e, 0xa9, 0x03, 0xb9, 0x4d, 0x6e, 0x79, 0x75, 0x48, 0x1d,
+        0xca, 0x6b, 0x73, 0xcb, 0xaa, 0x40, 0xee, 0x53, 0x5b, 0x9e, 0x5d, 0x52, 0x07, 0x72, 0x9a, 0xdc,
+        0xf2, 0xea, 0x90, 0x3b, 0x94, 0xd6, 0xe7, 0x97, 0x54, 0x81, 0xdc, 0xa6, 0xb7, 0x3c, 0xba, 0xa4,
+        0x0e, 0xe5, 0x35, 0xb9, 0xe5, 0xd5, 0x20, 0x77, 0x29, 0xad, 0xcf, 0x2e, 0xa9, 0x03, 0xb9, 0x5f,
+        0xff, 0xc4, 0x00, 0x1b, 0x11, 0x00, 0x01, 0x05, 0x01, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x05, 0x00, 0x03, 0x04, 0x06, 0x14, 0x02, 0x15, 0xff, 0xda, 0x00,
+        0x08, 0x01, 0x02, 0x01, 0x01, 0x05, 0x00, 0x92, 0x7b, 0x22, 0x92, 0x7b, 0x22, 0x72, 0xdb, 0xe6,
+        0x74, 0x62, 0x63, 0xc3, 0x11, 0x89, 0x8f, 0x0c, 0x47, 0xac, 0xc5, 0x6b, 0xc4, 0x7f, 0xff, 0xc4,
+        0x00, 0x28, 0x11, 0x00, 0x00, 0x04, 0x04, 0x04, 0x06, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x01, 0x11, 0x12, 0x13, 0x00, 0x02, 0x14, 0x31, 0x03, 0x04, 0x21, 0x41, 0x05,
+        0x32, 0x42, 0x81, 0x82, 0xb3, 0x33, 0x43, 0xa1, 0xff, 0xda, 0x00, 0x08, 0x01, 0x02, 0x01, 0x06,
+        0x3f, 0x00, 0xbb, 0x0c, 0x79, 0xd3, 0x2f, 0xdc, 0xf7, 0x76, 0xcf, 0x62, 0x8b, 0xb0, 0xc7, 0x9d,
+        0x32, 0xfd, 0xcf, 0x77, 0x6c, 0xf6, 0x28, 0xa4, 0xaf, 0xa3, 0x4f, 0xd2, 0xdb, 0xa8, 0x3d, 0x7e,
+        0x42, 0x15, 0x28, 0xd5, 0x7d, 0x14, 0x9d, 0xa3, 0x3d, 0x48, 0x29, 0xa3, 0x6d, 0x9d, 0xd0, 0xe9,
+        0x39, 0x73, 0x52, 0x8c, 0x79, 0x94, 0x5d, 0x25, 0x19, 0xea, 0x41, 0x4d, 0x1b, 0x6c, 0xee, 0x87,
+        0x49, 0xcb, 0x9a, 0x94, 0x63, 0xcc, 0xa2, 0xe9, 0x28, 0xc4, 0xe1, 0x9c, 0x33, 0x15, 0xbc, 0x1c,
+        0x32, 0x4c, 0xa4, 0x13, 0x12, 0xa5, 0x09, 0x87, 0x59, 0x80, 0x44, 0x4c, 0x44, 0x47, 0x51, 0xfc,
+        0x8f, 0xff, 0xc4, 0x00, 0x1a, 0x11, 0x00, 0x01, 0x05, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x04, 0x00, 0x03, 0x05, 0x06, 0x12, 0x02, 0xff, 0xda, 0x00,
+        0x08, 0x01, 0x03, 0x01, 0x01, 0x05, 0x00, 0x83, 0xb3, 0x69, 0x41, 0xd9, 0xb4, 0x83, 0xb2, 0x6d,
+        0xa8, 0x13, 0xc8, 0xed, 0x40, 0x9e, 0x47, 0x6a, 0x38, 0xb7, 0x5d, 0x1f, 0xff, 0xc4, 0x00, 0x20,
+        0x11, 0x00, 0x01, 0x03, 0x03, 0x05, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x11, 0x00, 0x01, 0x02, 0x12, 0x31, 0x81, 0x03, 0x22, 0x32, 0xa1, 0xb1, 0x61, 0xff, 0xda,
+        0x00, 0x08, 0x01, 0x03, 0x01, 0x06, 0x3f, 0x00, 0x6d, 0xc4, 0xe2, 0xa1, 0xe0, 0xed, 0x36, 0xe2,
+        0x71, 0x50, 0xf0, 0x76, 0x9a, 0x5c, 0xbe, 0x91, 0xd2, 0xd3, 0xaa, 0x5c, 0xaf, 0x8b, 0x2d, 0x3a,
+        0xa5, 0xca, 0xf8, 0xb2, 0x8c, 0xe6, 0xe5, 0xdd, 0x7f, 0xff, 0xd9
+    };
+
+    MutableDataSet dataSet("1.2.840.10008.1.2.4.50");
+    dataSet.setUint32(TagId(tagId_t::Columns_0028_0011), 40);
+    dataSet.setUint32(TagId(tagId_t::Rows_0028_0010), 24);
+    dataSet.setUint32(TagId(tagId_t::SamplesPerPixel_0028_0002), 3);
+    dataSet.setUint32(TagId(tagId_t::BitsAllocated_0028_0100), 8);
+    dataSet.setUint32(TagId(tagId_t::BitsStored_0028_0101), 8);
+    dataSet.setUint32(TagId(tagId_t::HighBit_0028_0102), 7);
+    dataSet.setUint32(TagId(tagId_t::PixelRepresentation_0028_0103), 0);
+    dataSet.setUint32(TagId(tagId_t::PlanarConfiguration_0028_0006), 0);
+    dataSet.setString(TagId(tagId_t::PhotometricInterpretation_0028_0004), "YBR_FULL");
+    {
+        // Buffer 0 is the empty offset table, buffer 1 the frame
+        WritingDataHandlerNumeric offsetTable(dataSet.getWritingDataHandlerRaw(TagId(tagId_t::PixelData_7FE0_0010), 0, tagVR_t::OB));
+        WritingDataHandlerNumeric frame(dataSet.getWritingDataHandlerRaw(TagId(tagId_t::PixelData_7FE0_0010), 1, tagVR_t::OB));
+        frame.assign((const char*)progressiveJpeg, sizeof(progressiveJpeg));
+    }
+
+    Image fullImage(dataSet.getImage(0));
+    ASSERT_EQ(40u, fullImage.getWidth());
+    ASSERT_EQ(24u, fullImage.getHeight());
+
+    // The progressive images are decoded at full resolution
+    //  and then reduced
+    const imageScale_t scales[] = {imageScale_t::half, imageScale_t::quarter, imageScale_t::eighth};
+    for(imageScale_t scale: scales)
+    {
+        const std::uint32_t scaleFactor((std::uint32_t)scale);
+        Image scaledImage(dataSet.getImageScaled(0, scale));
+        ASSERT_EQ((40u + scaleFactor - 1) / scaleFactor, scaledImage.getWidth());
+        ASSERT_EQ((24u + scaleFactor - 1) / scaleFactor, scaledImage.getHeight());
+        ASSERT_DOUBLE_EQ(0.0, compareImages(shrinkImageForTest(fullImage, scaleFactor), scaledImage));
+    }
+}
+
 } // namespace tests
 
 } // namespace imebra
@@ -218,6 +218,71 @@ TEST(modalityVoilut, voilutSigned8)
 }
 
 
+TEST(modalityVoilut, rescaleKernels)
+{
+    // Identity, integer add, integer multiply-add and
+    //  floating point rescale
+    const double rescale[][2] = {
+        {1.0, 0.0},
+        {1.0, -1024.0},
+        {3.0, -7.0},
+        {-2.0, 100.0},
+        {0.5, -1024.25},
+        {1.3, 0.7},
+        {-0.37, 12.5}};
+
+    const bitDepth_t depths[] = {
+        bitDepth_t::depthU8, bitDepth_t::depthS8,
+        bitDepth_t::depthU16, bitDepth_t::depthS16,
+        bitDepth_t::depthU32};
+
+    const std::uint32_t width(37), height(3);
+
+    for(const double* pRescale: rescale)
+    {
+        MutableDataSet testDataSet("1.2.840.10008.1.2.1");
+        testDataSet.setDouble(TagId(tagId_t::RescaleSlope_0028_1053), pRescale[0]);
+        testDataSet.setDouble(TagId(tagId_t::RescaleIntercept_0028_1052), pRescale[1]);
+
+        for(bitDepth_t depth: depths)
+        {
+            const bool bSigned(depth == bitDepth_t::depthS8 || depth == bitDepth_t::depthS16);
+            const std::uint32_t highBit((depth == bitDepth_t::depthU8 || depth == bitDepth_t::depthS8) ? 7 : 15);
+            const std::int64_t minValue(bSigned ? -((std::int64_t)1 << highBit) : 0);
+            const std::int64_t maxValue(bSigned ? ((std::int64_t)1 << highBit) - 1 : ((std::int64_t)1 << (highBit + 1)) - 1);
+
+            MutableImage inputImage(width, height, depth, "MONOCHROME2", highBit);
+            {
+                WritingDataHandler inputHandler(inputImage.getWritingDataHandler());
+                for(std::uint32_t scanValues(0); scanValues != width * height; ++scanValues)
+                {
+                    inputHandler.setInt32(scanValues, (std::int32_t)(minValue + (std::int64_t)(scanValues * 1777u) % (maxValue - minValue + 1)));
+                }
+            }
+
+            for(int simd(0); simd != 2; ++simd)
+            {
+                CodecFactory::setSimdEnabled(simd != 0);
+
+                ModalityVOILUT voilut(testDataSet);
+                MutableImage outputImage(voilut.allocateOutputImage(inputImage, width, height));
+                voilut.runTransform(inputImage, 0, 0, width, height, outputImage, 0, 0);
+
+                ReadingDataHandler inputHandler(inputImage.getReadingDataHandler());
+                ReadingDataHandler outputHandler(outputImage.getReadingDataHandler());
+                for(std::uint32_t scanValues(0); scanValues != width * height; ++scanValues)
+                {
+                    const std::int32_t expected((std::int32_t)((double)inputHandler.getInt32(scanValues) * pRescale[0] + pRescale[1]));
+                    ASSERT_EQ(expected, outputHandler.getInt32(scanValues));
+                }
+            }
+
+            CodecFactory::setSimdEnabled(true);
+        }
+    }
+}
+
+
 TEST(modalityVoilut, voilutUnsigned8LUT)
 {
     MutableImage unsigned8(6, 1, bitDepth_t::depthU8, "MONOCHROME2", 7);
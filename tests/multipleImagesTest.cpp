@@ -103,6 +103,81 @@ TEST(multipleImagesTest, testLosslessImages)
     } // transferSyntaxId
 }
 
+
+TEST(multipleImagesTest, testParallelDecoding)
+{
+    const size_t numImages(12);
+
+    for(int transferSyntaxId(0); transferSyntaxId != 3; ++transferSyntaxId)
+    {
+        std::string transferSyntax;
+        switch(transferSyntaxId)
+        {
+        case 0:
+            transferSyntax = "1.2.840.10008.1.2.4.70";
+            break;
+        case 1:
+            transferSyntax = "1.2.840.10008.1.2.1";
+            break;
+        case 2:
+            transferSyntax = "1.2.840.10008.1.2.5";
+            break;
+        }
+
+        std::cout << "Parallel images decoding test. Transfer syntax: " << transferSyntax << std::endl;
+
+        std::vector<Image> images;
+        MutableMemory streamMemory;
+        {
+            MutableDataSet testDataSet(transferSyntax);
+            for(size_t imageNumber(0); imageNumber != numImages; ++imageNumber)
+            {
+                images.push_back(buildImageForTest(300, 200, bitDepth_t::depthU8, 7, "MONOCHROME2", (std::uint32_t)(2 + imageNumber)));
+                testDataSet.setImage(imageNumber, images.back(), imageQuality_t::veryHigh);
+            }
+
+            MemoryStreamOutput writeStream(streamMemory);
+            StreamWriter writer(writeStream);
+            CodecFactory::save(testDataSet, writer, codecType_t::dicom);
+        }
+
+        for(unsigned int lazyLoad(0); lazyLoad != 2; ++lazyLoad)
+        {
+            MemoryStreamInput readStream(streamMemory);
+            StreamReader reader(readStream);
+            DataSet testDataSet = CodecFactory::load(reader, lazyLoad == 0 ? std::numeric_limits<size_t>::max() : 1);
+
+            for(size_t maxThreads(0); maxThreads != 3; ++maxThreads)
+            {
+                FramesDecoder frames(testDataSet.getImages(2, 8, maxThreads));
+                ASSERT_EQ(2u, frames.getFirstFrame());
+                ASSERT_EQ(8u, frames.getFramesCount());
+
+                for(size_t imageNumber(2); imageNumber != 10; ++imageNumber)
+                {
+                    Image checkImage = frames.getImage(imageNumber);
+                    ASSERT_TRUE(identicalImages(checkImage, images[imageNumber]));
+                }
+                ASSERT_THROW(frames.getImage(1), DataSetImageDoesntExistError);
+                ASSERT_THROW(frames.getImage(10), DataSetImageDoesntExistError);
+
+                // Frames retrieved in random order
+                FramesDecoder randomFrames(testDataSet.getImages(0, numImages, maxThreads));
+                for(size_t imageNumber(numImages); imageNumber != 0; imageNumber -= 2)
+                {
+                    Image checkImage = randomFrames.getImage(imageNumber - 1);
+                    ASSERT_TRUE(identicalImages(checkImage, images[imageNumber - 1]));
+                }
+
+                // Frames never retrieved
+                testDataSet.getImages(0, numImages, maxThreads);
+            }
+
+            ASSERT_THROW(testDataSet.getImages(10, 3, 0), DataSetImageDoesntExistError);
+        }
+    }
+}
+
 }
 
 }
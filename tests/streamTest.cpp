@@ -1,5 +1,8 @@
 #include <gtest/gtest.h>
 #include <imebra/imebra.h>
+#include <thread>
+#include <vector>
+#include <cstdio>
 
 namespace imebra
 {
@@ -159,6 +162,216 @@ TEST(streamTest, testTimeout1)
     EXPECT_EQ("ABCD", string);
 }
 
+
+// Test the MemoryMappedFileStreamInput class
+TEST(streamTest, testMemoryMappedFile)
+{
+    const std::uint32_t valuesCount(4096);
+
+    for(int transferSyntaxId(0); transferSyntaxId != 2; ++transferSyntaxId)
+    {
+        const std::string transferSyntax(transferSyntaxId == 0 ? "1.2.840.10008.1.2.1" : "1.2.840.10008.1.2.2");
+
+        char* tempFileName = ::tempnam(0, "dcmimebramapped");
+        std::string fileName(tempFileName);
+        free(tempFileName);
+
+        {
+            MutableDataSet testDataSet(transferSyntax);
+            testDataSet.setString(TagId(tagId_t::PatientName_0010_0010), "Test Patient");
+            {
+                WritingDataHandler handler = testDataSet.getWritingDataHandler(TagId(0x0011, 0x0010), 0, tagVR_t::OW);
+                handler.setSize(valuesCount);
+                for(std::uint32_t writeValue(0); writeValue != valuesCount; ++writeValue)
+                {
+                    handler.setUint32(writeValue, writeValue * 13u);
+                }
+            }
+            CodecFactory::save(testDataSet, fileName, codecType_t::dicom);
+        }
+
+        auto loadMappedFile = [](const std::string& name)
+        {
+            MemoryMappedFileStreamInput input(name);
+            StreamReader reader(input);
+            return CodecFactory::load(reader, 1024);
+        };
+        DataSet loadedDataSet(loadMappedFile(fileName));
+
+        // The mapping must survive the stream
+        ///////////////////////////////////////////////////////////
+        EXPECT_EQ("Test Patient", loadedDataSet.getString(TagId(tagId_t::PatientName_0010_0010), 0));
+        ReadingDataHandler handler = loadedDataSet.getReadingDataHandler(TagId(0x0011, 0x0010), 0);
+        ASSERT_EQ(valuesCount, handler.getSize());
+        for(std::uint32_t readValue(0); readValue != valuesCount; ++readValue)
+        {
+            EXPECT_EQ((readValue * 13u) & 0xffffu, handler.getUint32(readValue));
+        }
+
+        // Read the whole file from several threads
+        ///////////////////////////////////////////////////////////
+        MemoryMappedFileStreamInput input(fileName);
+        std::string fileContent;
+        {
+            FileStreamInput fileInput(fileName);
+            StreamReader reader(fileInput);
+            char buffer[1024];
+            try
+            {
+                for(size_t readBytes = reader.readSome(buffer, sizeof(buffer)); readBytes != 0; readBytes = reader.readSome(buffer, sizeof(buffer)))
+                {
+                    fileContent.append(buffer, readBytes);
+                }
+            }
+            catch(const StreamEOFError&)
+            {
+            }
+        }
+
+        std::vector<std::thread> threads;
+        std::vector<int> threadsResults(4, 0);
+        for(size_t threadNumber(0); threadNumber != threadsResults.size(); ++threadNumber)
+        {
+            threads.emplace_back([&input, &fileContent, &threadsResults, threadNumber]()
+            {
+                StreamReader reader(input);
+                Memory readContent(reader.read(fileContent.size()));
+                size_t readSize;
+                const char* pReadContent(readContent.data(&readSize));
+                threadsResults[threadNumber] = (std::string(pReadContent, readSize) == fileContent) ? 1 : 0;
+            });
+        }
+        for(std::thread& thread: threads)
+        {
+            thread.join();
+        }
+        for(int result: threadsResults)
+        {
+            EXPECT_EQ(1, result);
+        }
+
+        StreamReader endReader(input);
+        endReader.read(fileContent.size());
+        EXPECT_THROW(endReader.read(1), StreamEOFError);
+
+        ::remove(fileName.c_str());
+    }
+
+    EXPECT_THROW(MemoryMappedFileStreamInput("/this/file/does/not/exist"), StreamOpenError);
+}
+
+
+// Test concurrent reads from the same FileStreamInput
+TEST(streamTest, testFileStreamConcurrentReads)
+{
+    char* tempFileName = ::tempnam(0, "dcmimebraconcurrent");
+    std::string fileName(tempFileName);
+    free(tempFileName);
+
+    const size_t fileSize(256 * 1024);
+    {
+        FileStreamOutput writeFile(fileName);
+        StreamWriter writer(writeFile);
+        for(size_t writeByte(0); writeByte != fileSize; ++writeByte)
+        {
+            const char value((char)((writeByte * 31u) & 0xffu));
+            writer.write(&value, 1);
+        }
+    }
+
+    FileStreamInput input(fileName);
+    std::vector<std::thread> threads;
+    std::vector<size_t> threadsErrors(4, 0);
+    for(size_t threadNumber(0); threadNumber != threadsErrors.size(); ++threadNumber)
+    {
+        threads.emplace_back([&input, &threadsErrors, threadNumber, fileSize]()
+        {
+            // Each thread starts at a different position
+            ///////////////////////////////////////////////////////////
+            const size_t startPosition(threadNumber * 4099u);
+            StreamReader reader(input, startPosition, fileSize - startPosition);
+            char buffer[1000];
+            size_t position(startPosition);
+            try
+            {
+                for(size_t readBytes = reader.readSome(buffer, sizeof(buffer)); readBytes != 0; readBytes = reader.readSome(buffer, sizeof(buffer)))
+                {
+                    for(size_t scanBuffer(0); scanBuffer != readBytes; ++scanBuffer, ++position)
+                    {
+                        if(buffer[scanBuffer] != (char)((position * 31u) & 0xffu))
+                        {
+                            ++threadsErrors[threadNumber];
+                        }
+                    }
+                }
+            }
+            catch(const StreamEOFError&)
+            {
+            }
+            if(position != fileSize)
+            {
+                ++threadsErrors[threadNumber];
+            }
+        });
+    }
+    for(std::thread& thread: threads)
+    {
+        thread.join();
+    }
+    for(size_t errors: threadsErrors)
+    {
+        EXPECT_EQ(0u, errors);
+    }
+
+    ::remove(fileName.c_str());
+}
+
+
+// Test that the buffers loaded lazily from a memory stream refer to the
+//  stream's memory
+TEST(streamTest, testLazyBuffersFromMemory)
+{
+    const std::uint32_t valuesCount(4096);
+
+    for(int transferSyntaxId(0); transferSyntaxId != 2; ++transferSyntaxId)
+    {
+        const bool bBigEndian(transferSyntaxId == 1);
+
+        MutableMemory streamMemory;
+        {
+            MutableDataSet testDataSet(bBigEndian ? "1.2.840.10008.1.2.2" : "1.2.840.10008.1.2.1");
+            {
+                WritingDataHandler handler = testDataSet.getWritingDataHandler(TagId(0x0011, 0x0010), 0, tagVR_t::OW);
+                handler.setSize(valuesCount);
+                for(std::uint32_t writeValue(0); writeValue != valuesCount; ++writeValue)
+                {
+                    handler.setUint32(writeValue, writeValue * 7u);
+                }
+            }
+            MemoryStreamOutput output(streamMemory);
+            StreamWriter writer(output);
+            CodecFactory::save(testDataSet, writer, codecType_t::dicom);
+        }
+
+        MemoryStreamInput input(streamMemory);
+        StreamReader reader(input);
+        DataSet loadedDataSet(CodecFactory::load(reader, 1024));
+
+        // Reallocating the source memory must not leave the tags
+        //  that have not been loaded yet pointing to the old
+        //  storage
+        ///////////////////////////////////////////////////////////
+        streamMemory.resize(streamMemory.size() * 4);
+
+        ReadingDataHandlerNumeric handler = loadedDataSet.getReadingDataHandlerNumeric(TagId(0x0011, 0x0010), 0);
+        ASSERT_EQ(valuesCount, handler.getSize());
+        for(std::uint32_t readValue(0); readValue != valuesCount; ++readValue)
+        {
+            EXPECT_EQ((readValue * 7u) & 0xffffu, handler.getUint32(readValue));
+        }
+    }
+}
+
 } // namespace tests
 
 } // namespace imebra
@@ -110,6 +110,48 @@ TEST(transformsChain, twoTransform)
     identicalImages(monochrome, outputImage);
 }
 
+
+TEST(transformsChain, parallelBands)
+{
+    const std::uint32_t width(1501);
+    const std::uint32_t height(703);
+
+    MutableImage monochrome(width, height, bitDepth_t::depthU16, "MONOCHROME2", 11);
+    {
+        WritingDataHandler monochromeHandler = monochrome.getWritingDataHandler();
+        for(std::uint32_t index(0); index != width * height; ++index)
+        {
+            monochromeHandler.setUint32(index, (index * 7919u) % 4096u);
+        }
+    }
+
+    VOILUT voilut(VOIDescription(1800, 2500, dicomVOIFunction_t::linear, ""));
+    TransformsChain chain;
+    chain.addTransform(voilut);
+    chain.addTransform(ColorTransformsFactory::getTransform("MONOCHROME2", "RGB"));
+
+    const Transform* transforms[] = {&voilut, &chain};
+    for(const Transform* pTransform: transforms)
+    {
+        // Whole image and an area with an offset
+        ///////////////////////////////////////////////////////////
+        MutableImage singleThreadOutput(pTransform->allocateOutputImage(monochrome, width, height));
+        MutableImage parallelOutput(pTransform->allocateOutputImage(monochrome, width, height));
+
+        Transform::setMaximumThreads(1);
+        pTransform->runTransform(monochrome, 0, 0, width, height, singleThreadOutput, 0, 0);
+        Transform::setMaximumThreads(0);
+        pTransform->runTransform(monochrome, 0, 0, width, height, parallelOutput, 0, 0);
+        EXPECT_TRUE(identicalImages(singleThreadOutput, parallelOutput));
+
+        Transform::setMaximumThreads(1);
+        pTransform->runTransform(monochrome, 3, 5, width - 10, height - 7, singleThreadOutput, 7, 2);
+        Transform::setMaximumThreads(0);
+        pTransform->runTransform(monochrome, 3, 5, width - 10, height - 7, parallelOutput, 7, 2);
+        EXPECT_TRUE(identicalImages(singleThreadOutput, parallelOutput));
+    }
+}
+
 }
 
 }
@@ -2,6 +2,8 @@
 #include <gtest/gtest.h>
 #include <locale>
 #include <codecvt>
+#include <thread>
+#include <vector>
 
 namespace imebra
 {
@@ -383,6 +385,55 @@ TEST(unicodeStringHandlerTest, normalizeCharset)
 }
 
 
+TEST(unicodeStringHandlerTest, concurrentConversions)
+{
+    // ASCII strings and strings that need escape sequences,
+    //  converted concurrently by several threads
+    std::wstring asciiName(L"Test^Patient=Line~{}");
+    std::wstring mixedName(L"Test^\x0628\x062a\x062b");
+    std::string escapeName("\x1b\x2d\x47\xc8\xca");
+
+    charsetsList_t charsets;
+    charsets.push_back("ISO_IR 6");
+    charsets.push_back("ISO 2022 IR 127");
+
+    std::vector<std::thread> threads;
+    std::vector<size_t> threadsErrors(4, 0);
+    for(size_t threadNumber(0); threadNumber != threadsErrors.size(); ++threadNumber)
+    {
+        threads.emplace_back([&, threadNumber]()
+        {
+            for(size_t repeat(0); repeat != 200; ++repeat)
+            {
+                MutableDataSet testDataSet("1.2.840.10008.1.2.1", charsets);
+                testDataSet.setUnicodeString(TagId(tagId_t::PatientName_0010_0010), asciiName);
+                testDataSet.setUnicodeString(TagId(tagId_t::PatientComments_0010_4000), mixedName);
+                {
+                    WritingDataHandlerNumeric handler = testDataSet.getWritingDataHandlerRaw(TagId(tagId_t::OtherPatientNames_0010_1001), 0);
+                    handler.assign(escapeName.c_str(), escapeName.size());
+                }
+
+                if(testDataSet.getString(TagId(tagId_t::PatientName_0010_0010), 0) != std::string(asciiName.begin(), asciiName.end()) ||
+                        testDataSet.getUnicodeString(TagId(tagId_t::PatientName_0010_0010), 0) != asciiName ||
+                        testDataSet.getUnicodeString(TagId(tagId_t::PatientComments_0010_4000), 0) != mixedName ||
+                        testDataSet.getUnicodeString(TagId(tagId_t::OtherPatientNames_0010_1001), 0) != L"\x0628\x062a")
+                {
+                    ++threadsErrors[threadNumber];
+                }
+            }
+        });
+    }
+    for(std::thread& thread: threads)
+    {
+        thread.join();
+    }
+    for(size_t errors: threadsErrors)
+    {
+        EXPECT_EQ(0u, errors);
+    }
+}
+
+
 } // namespace tests
 
 } // namespace imebra
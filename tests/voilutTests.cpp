@@ -1,6 +1,9 @@
 #include <imebra/imebra.h>
 #include "buildImageForTest.h"
 #include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+#include <vector>
 
 
 namespace imebra
@@ -187,6 +190,121 @@ TEST(voilut, voilutUnsigned8OptimalVOI)
 }
 
 
+TEST(voilut, voilutOptimalVOIPercentiles)
+{
+    const std::uint32_t width(601);
+    const std::uint32_t height(307);
+
+    struct testImage
+    {
+        bitDepth_t depth;
+        std::uint32_t highBit;
+        std::int32_t minValue;
+        std::int32_t maxValue;
+        bool bExact;
+    };
+
+    const testImage testImages[] = {
+        {bitDepth_t::depthU8, 7, 0, 255, true},
+        {bitDepth_t::depthS16, 15, -32768, 32767, true},
+        {bitDepth_t::depthU16, 11, 0, 4095, true},
+        {bitDepth_t::depthS32, 31, -40000, 20000, true},
+        {bitDepth_t::depthS32, 31, -2000000000, 2000000000, false}
+    };
+
+    for(const testImage& imageType: testImages)
+    {
+        // A ramp with a few outliers at both ends
+        ///////////////////////////////////////////////////////////
+        std::vector<std::int64_t> values;
+        MutableImage image(width, height, imageType.depth, "MONOCHROME2", imageType.highBit);
+        {
+            WritingDataHandler handler(image.getWritingDataHandler());
+            const std::int64_t range((std::int64_t)imageType.maxValue - (std::int64_t)imageType.minValue);
+            for(std::uint32_t index(0); index != width * height; ++index)
+            {
+                std::int64_t value((std::int64_t)imageType.minValue + range / 8 + (std::int64_t)(index * 7919u % 10007u) * (range / 2) / 10007);
+                if(index % 97 == 0)
+                {
+                    value = imageType.minValue;
+                }
+                else if(index % 89 == 0)
+                {
+                    value = imageType.maxValue;
+                }
+                handler.setInt32(index, (std::int32_t)value);
+                values.push_back(value);
+            }
+        }
+        std::sort(values.begin(), values.end());
+
+        // 0% and 100% select the minimum and maximum values
+        ///////////////////////////////////////////////////////////
+        {
+            VOIDescription fullRange(VOILUT::getOptimalVOI(image, 0, 0, width, height));
+            VOIDescription fullRangePercentiles(VOILUT::getOptimalVOI(image, 0, 0, width, height, 0, 100));
+            const double center((double)((std::int64_t)imageType.maxValue + (std::int64_t)imageType.minValue + 1) / 2);
+            EXPECT_DOUBLE_EQ(center, fullRange.getCenter());
+            EXPECT_DOUBLE_EQ(2.0 * (center - (double)imageType.minValue), fullRange.getWidth());
+            EXPECT_DOUBLE_EQ(fullRange.getCenter(), fullRangePercentiles.getCenter());
+            EXPECT_DOUBLE_EQ(fullRange.getWidth(), fullRangePercentiles.getWidth());
+        }
+
+        const double percentiles[][2] = {{0.5, 99.5}, {2, 98}, {0, 90}, {10, 100}, {50, 50}};
+        for(const double* limits: percentiles)
+        {
+            VOIDescription voi(VOILUT::getOptimalVOI(image, 0, 0, width, height, limits[0], limits[1]));
+            const double low(voi.getCenter() - voi.getWidth() / 2);
+            const double high(voi.getCenter() + voi.getWidth() / 2 - 1);
+
+            const std::int64_t expectedLow(values[(size_t)std::floor((double)values.size() * limits[0] / 100.0)]);
+            const std::int64_t expectedHigh(values[(size_t)std::ceil((double)values.size() * limits[1] / 100.0) - 1]);
+            if(imageType.bExact)
+            {
+                EXPECT_DOUBLE_EQ((double)expectedLow, low);
+                EXPECT_DOUBLE_EQ((double)expectedHigh, high);
+            }
+            else
+            {
+                // Wide ranges use bins of 2^16 values
+                ///////////////////////////////////////////////////////////
+                EXPECT_LE(low, (double)expectedLow);
+                EXPECT_GT(low, (double)expectedLow - 65536.0);
+                EXPECT_GE(high, (double)expectedHigh);
+                EXPECT_LT(high, (double)expectedHigh + 65536.0);
+            }
+
+            // Same result from the cache
+            ///////////////////////////////////////////////////////////
+            VOIDescription cachedVoi(VOILUT::getOptimalVOI(image, 0, 0, width, height, limits[0], limits[1]));
+            EXPECT_DOUBLE_EQ(voi.getCenter(), cachedVoi.getCenter());
+            EXPECT_DOUBLE_EQ(voi.getWidth(), cachedVoi.getWidth());
+        }
+
+        // Modifying the image invalidates the cached values
+        ///////////////////////////////////////////////////////////
+        {
+            WritingDataHandler handler(image.getWritingDataHandler());
+            for(std::uint32_t index(0); index != width * height; ++index)
+            {
+                handler.setInt32(index, index % 2 == 0 ? imageType.minValue : imageType.maxValue);
+            }
+        }
+        VOIDescription modifiedVoi(VOILUT::getOptimalVOI(image, 0, 0, width, height, 0.5, 99.5));
+        EXPECT_DOUBLE_EQ((double)imageType.minValue, modifiedVoi.getCenter() - modifiedVoi.getWidth() / 2);
+
+        // A sub-area
+        ///////////////////////////////////////////////////////////
+        VOIDescription areaVoi(VOILUT::getOptimalVOI(image, 1, 0, 1, 1, 0.5, 99.5));
+        EXPECT_DOUBLE_EQ((double)imageType.maxValue, areaVoi.getCenter() + areaVoi.getWidth() / 2 - 1);
+
+        EXPECT_THROW(VOILUT::getOptimalVOI(image, 0, 0, width, height, -1, 50), TransformError);
+        EXPECT_THROW(VOILUT::getOptimalVOI(image, 0, 0, width, height, 60, 50), TransformError);
+        EXPECT_THROW(VOILUT::getOptimalVOI(image, 0, 0, width, height, 0, 101), TransformError);
+    }
+}
+
+
 TEST(voilut, voilutUnsigned8LUT)
 {
     MutableImage unsigned8(6, 1, bitDepth_t::depthU8, "MONOCHROME2", 7);
@@ -232,7 +350,146 @@ TEST(voilut, voilutUnsigned8LUT)
 
 }
 
+
+TEST(voilut, voilutWindowTable)
+{
+    // 8 and 16 bit images are mapped through a table: compare
+    //  the results with the ones of a 32 bit image, which is
+    //  transformed pixel by pixel
+    ///////////////////////////////////////////////////////////
+    const bitDepth_t depths[] = {bitDepth_t::depthU8, bitDepth_t::depthS8, bitDepth_t::depthU16, bitDepth_t::depthS16};
+    const dicomVOIFunction_t functions[] = {dicomVOIFunction_t::linear, dicomVOIFunction_t::linearExact, dicomVOIFunction_t::sigmoid};
+    const double centerWidth[][2] = {{40.0, 400.0}, {-1000.5, 3000.0}, {100.0, 1.0}, {30000.0, 20000.0}, {0.0, 70000.0}};
+
+    const std::uint32_t width(257), height(256);
+
+    for(bitDepth_t depth: depths)
+    {
+        const bool b8Bit(depth == bitDepth_t::depthU8 || depth == bitDepth_t::depthS8);
+        const bool bSigned(depth == bitDepth_t::depthS8 || depth == bitDepth_t::depthS16);
+        const std::uint32_t highBit(b8Bit ? 7 : 15);
+        const std::int32_t minValue(bSigned ? -((std::int32_t)1 << highBit) : 0);
+        const std::uint32_t numValues((std::uint32_t)1 << (highBit + 1));
+
+        MutableImage tableImage(width, height, depth, "MONOCHROME2", highBit);
+        MutableImage pixelImage(width, height, bitDepth_t::depthS32, "MONOCHROME2", 31);
+        {
+            WritingDataHandler tableHandler = tableImage.getWritingDataHandler();
+            WritingDataHandler pixelHandler = pixelImage.getWritingDataHandler();
+            for(std::uint32_t scanPixels(0); scanPixels != width * height; ++scanPixels)
+            {
+                const std::int32_t value(minValue + (std::int32_t)(scanPixels % numValues));
+                tableHandler.setInt32(scanPixels, value);
+                pixelHandler.setInt32(scanPixels, value);
+            }
+        }
+
+        for(dicomVOIFunction_t function: functions)
+        {
+            for(const double* pCenterWidth: centerWidth)
+            {
+                VOILUT voilut(VOIDescription(pCenterWidth[0], pCenterWidth[1], function, ""));
+
+                const bitDepth_t outputDepths[] = {bitDepth_t::depthU8, bitDepth_t::depthU16, bitDepth_t::depthS16};
+                for(bitDepth_t outputDepth: outputDepths)
+                {
+                    const std::uint32_t outputHighBit(outputDepth == bitDepth_t::depthU8 ? 7 : 15);
+                    MutableImage tableOut(width, height, outputDepth, "MONOCHROME2", outputHighBit);
+                    MutableImage pixelOut(width, height, outputDepth, "MONOCHROME2", outputHighBit);
+                    voilut.runTransform(tableImage, 0, 0, width, height, tableOut, 0, 0);
+                    voilut.runTransform(pixelImage, 0, 0, width, height, pixelOut, 0, 0);
+
+                    ReadingDataHandler tableHandler = tableOut.getReadingDataHandler();
+                    ReadingDataHandler pixelHandler = pixelOut.getReadingDataHandler();
+                    for(std::uint32_t scanPixels(0); scanPixels != width * height; ++scanPixels)
+                    {
+                        ASSERT_EQ(pixelHandler.getInt32(scanPixels), tableHandler.getInt32(scanPixels));
+                    }
+                }
+            }
+        }
+    }
+}
+
+
+TEST(voilut, voilutSigned16LUT)
+{
+    // The image is wider than the vectorized loops and its
+    //  values fall also outside the LUT range
+    ///////////////////////////////////////////////////////////
+    const std::uint32_t width(37), height(5);
+    MutableImage signed16(width, height, bitDepth_t::depthS16, "MONOCHROME2", 15);
+    {
+        WritingDataHandler signed16Handler = signed16.getWritingDataHandler();
+        for(std::uint32_t scanPixels(0); scanPixels != width * height; ++scanPixels)
+        {
+            signed16Handler.setInt32(scanPixels, (std::int32_t)((scanPixels * 7919u) % 65536u) - 32768);
+        }
+        signed16Handler.setInt32(0, 999);
+        signed16Handler.setInt32(1, 1000);
+        signed16Handler.setInt32(2, 4999);
+        signed16Handler.setInt32(3, 5000);
+    }
+
+    MutableDataSet testDataSet;
+    MutableTag sequenceTag = testDataSet.getTagCreate(TagId(tagId_t::VOILUTSequence_0028_3010));
+    MutableDataSet lutItem = sequenceTag.appendSequenceItem();
+    {
+        WritingDataHandlerNumeric descriptor = lutItem.getWritingDataHandlerNumeric(TagId(tagId_t::LUTDescriptor_0028_3002), 0, tagVR_t::US);
+        WritingDataHandlerNumeric data = lutItem.getWritingDataHandlerNumeric(TagId(tagId_t::LUTData_0028_3006), 0, tagVR_t::US);
+        descriptor.setUint32(0, 4000);
+        descriptor.setUint32(1, 1000);
+        descriptor.setUint32(2, 16);
+
+        for(std::uint32_t fillLut(0); fillLut != 4000; ++fillLut)
+        {
+            data.setUint32(fillLut, (fillLut * 40009u) % 65536u);
+        }
+    }
+    LUT lut = testDataSet.getLUT(TagId(tagId_t::VOILUTSequence_0028_3010), 0);
+
+    VOILUT voilut(lut);
+
+    ReadingDataHandler inputHandler = signed16.getReadingDataHandler();
+
+    {
+        MutableImage lutOut = voilut.allocateOutputImage(signed16, width, height);
+        voilut.runTransform(signed16, 0, 0, width, height, lutOut, 0, 0);
+
+        ReadingDataHandler lutHandler = lutOut.getReadingDataHandler();
+        for(std::uint32_t scanPixels(0); scanPixels != width * height; ++scanPixels)
+        {
+            ASSERT_EQ(lut.getMappedValue(inputHandler.getInt32(scanPixels)), lutHandler.getUint32(scanPixels));
+        }
+    }
+
+    // Transform an area into images with different depths
+    ///////////////////////////////////////////////////////////
+    {
+        MutableImage unsigned8Out(width, height, bitDepth_t::depthU8, "MONOCHROME2", 7);
+        MutableImage signed16Out(width, height, bitDepth_t::depthS16, "MONOCHROME2", 15);
+        MutableImage signed32Out(width, height, bitDepth_t::depthS32, "MONOCHROME2", 31);
+        voilut.runTransform(signed16, 2, 1, width - 3, height - 2, unsigned8Out, 1, 0);
+        voilut.runTransform(signed16, 2, 1, width - 3, height - 2, signed16Out, 1, 0);
+        voilut.runTransform(signed16, 2, 1, width - 3, height - 2, signed32Out, 1, 0);
+
+        ReadingDataHandler unsigned8Handler = unsigned8Out.getReadingDataHandler();
+        ReadingDataHandler signed16Handler = signed16Out.getReadingDataHandler();
+        ReadingDataHandler signed32Handler = signed32Out.getReadingDataHandler();
+        for(std::uint32_t scanY(0); scanY != height - 2; ++scanY)
+        {
+            for(std::uint32_t scanX(0); scanX != width - 3; ++scanX)
+            {
+                const std::uint32_t mappedValue(lut.getMappedValue(inputHandler.getInt32((scanY + 1) * width + scanX + 2)));
+                const size_t outputIndex(scanY * width + scanX + 1);
+                ASSERT_EQ(mappedValue & 0xffu, unsigned8Handler.getUint32(outputIndex));
+                ASSERT_EQ((std::int32_t)(std::int16_t)(mappedValue - 32768u), signed16Handler.getInt32(outputIndex));
+                ASSERT_EQ((std::int32_t)(mappedValue - 2147483648u), signed32Handler.getInt32(outputIndex));
+            }
+        }
+    }
 }
 
 }
 
+}
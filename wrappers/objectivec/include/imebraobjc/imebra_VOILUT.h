@@ -80,6 +80,36 @@ If you do not want to be bound by the GPL terms (such as the requirement
 
         __attribute__((swift_error(nonnull_error)));
 
+    /// \brief Find the VOI settings that cover the values between two
+    ///        percentiles of a specific image's area.
+    ///
+    /// \param pInputImage    the image to analyze
+    /// \param topLeftX       the horizontal coordinate of the top-left angle of
+    ///                       the area to analyze
+    /// \param topLeftY       the vertical coordinate of the top-left angle of
+    ///                       the area to analyze
+    /// \param width          the width of the area to analyze
+    /// \param height         the height of the area to analyze
+    /// \param lowPercentile  the percentage of pixels (0..100) that must be
+    ///                       left below the window
+    /// \param highPercentile the percentage of pixels (0..100) that must be
+    ///                       inside or below the window
+    /// \param pError         set to a NSError derived class in case of error
+    /// \return an ImebraVOIDescription object describing the VOI parameters
+    ///
+    ///////////////////////////////////////////////////////////////////////////////
+    +(ImebraVOIDescription*)getOptimalVOI:
+        (ImebraImage*)pInputImage
+        inputTopLeftX:(unsigned int)inputTopLeftX
+        inputTopLeftY:(unsigned int)inputTopLeftY
+        inputWidth:(unsigned int)inputWidth
+        inputHeight:(unsigned int)inputHeight
+        lowPercentile:(double)lowPercentile
+        highPercentile:(double)highPercentile
+        error:(NSError**)pError
+
+        __attribute__((swift_error(nonnull_error)));
+
 
 @end
 
@@ -18,6 +18,7 @@ If you do not want to be bound by the GPL terms (such as the requirement
 
 @class ImebraDataSet;
 @class ImebraStreamReader;
+@class ImebraTagId;
 @class ImebraStreamWriter;
 
 
@@ -113,6 +114,25 @@ typedef NS_ENUM(unsigned short, ImebraCodecType)
     ///////////////////////////////////////////////////////////////////////////////
     +(ImebraDataSet*)loadFromStreamMaxSize:(ImebraStreamReader*)pReader maxBufferSize:(unsigned int)maxBufferSize error:(NSError**)pError;
 
+    /// \brief Parses the content of the input stream up to the specified tag
+    ///        and returns an ImebraDataSet representing the parsed content.
+    ///
+    /// The parsing stops at the first tag of the root dataset that has an id
+    /// equal or greater than pStopAtTag: the tag and the rest of the stream
+    /// are not read.
+    ///
+    /// \param pReader           a ImebraStreamReader object connected to the
+    ///                          input stream
+    /// \param maxSizeBufferLoad the maximum size of the tags that are loaded
+    ///                          immediately
+    /// \param pStopAtTag        the tag at which the parsing stops
+    /// \param pError            pointer to a NSError pointer that will be set
+    ///                          in case of error
+    /// \return an ImebraDataSet object representing the parsed content
+    ///
+    ///////////////////////////////////////////////////////////////////////////////
+    +(ImebraDataSet*)loadFromStreamStopAtTag:(ImebraStreamReader*)pReader maxBufferSize:(unsigned int)maxBufferSize stopAtTag:(ImebraTagId*)pStopAtTag error:(NSError**)pError;
+
     /// \brief Saves the content of a ImebraDataSet object to a file.
     ///
     /// \param fileName          the name of the output file
@@ -148,6 +168,41 @@ typedef NS_ENUM(unsigned short, ImebraCodecType)
     ///////////////////////////////////////////////////////////////////////////////
     +(void)setMaximumImageSize:(unsigned int)maximumWidth maxHeight:(unsigned int)maximumHeight;
 
+    /// \brief Enable or disable the SIMD (SSE2, AVX2 or NEON) code used by
+    ///        the codecs.
+    ///
+    /// The SIMD code is enabled by default and is used when the CPU supports
+    ///  it.
+    ///
+    /// \param bEnable           true to enable the SIMD code, false to use
+    ///                          only the portable code
+    ///
+    ///////////////////////////////////////////////////////////////////////////////
+    +(void)setSimdEnabled:(BOOL)bEnable;
+
+    /// \brief Set the maximum number of threads that a codec can use to
+    ///        decode one image.
+    ///
+    /// By default the images are decoded by the calling thread only.
+    ///
+    /// \param maximumThreads    the maximum number of threads (including
+    ///                          the calling thread) used to decode one
+    ///                          image. 0 means all the hardware threads
+    ///
+    ///////////////////////////////////////////////////////////////////////////////
+    +(void)setMaximumDecodingThreads:(unsigned int)maximumThreads;
+
+    /// \brief Set the number of MCUs in each restart interval written by
+    ///        the jpeg encoder.
+    ///
+    /// By default the jpeg encoder doesn't write the restart markers.
+    ///
+    /// \param mcuPerRestartInterval the number of MCUs in each restart
+    ///                          interval. 0 disables the restart markers
+    ///
+    ///////////////////////////////////////////////////////////////////////////////
+    +(void)setJpegRestartInterval:(unsigned short)mcuPerRestartInterval;
+
 @end
 
 #endif // imebraObjcCodecFactory__INCLUDED_
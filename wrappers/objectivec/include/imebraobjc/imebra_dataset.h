@@ -913,6 +913,30 @@ typedef NS_ENUM(unsigned int, ImebraImageQuality)
     -(ImebraTagType)getDataType:(ImebraTagId*)tagId error:(NSError**)pError
         __attribute__((swift_error(nonnull_error)));
 
+    /// \brief Make the DataSet, its tags and its sequence items read only.
+    ///
+    /// A frozen DataSet is read without locking its content, so several
+    /// threads can read it concurrently without contention.
+    ///
+    /// Once frozen, any attempt to modify the DataSet sets pError to
+    /// ImebraDataSetFrozenError.
+    ///
+    /// All the ImebraWritingDataHandler objects obtained from the DataSet
+    /// must be released before freezing it, otherwise pError is set to
+    /// ImebraDataSetFrozenError and the DataSet is not frozen.
+    ///
+    /// \param pError   a pointer to a NSError pointer which is set when an
+    ///                  error occurs
+    ///
+    ///////////////////////////////////////////////////////////////////////////////
+    -(void)freeze:(NSError**)pError
+        __attribute__((swift_error(nonnull_error)));
+
+    /// \brief Returns true if the DataSet has been frozen with freeze().
+    ///
+    ///////////////////////////////////////////////////////////////////////////////
+    -(BOOL)isFrozen;
+
 @end
 
 
@@ -143,6 +143,9 @@ If you do not want to be bound by the GPL terms (such as the requirement
 @interface ImebraDataSetCorruptedOffsetTableError: ImebraDataSetError
 @end
 
+@interface ImebraDataSetFrozenError: ImebraDataSetError
+@end
+
 @interface ImebraDicomDirError: NSError
 @end
 
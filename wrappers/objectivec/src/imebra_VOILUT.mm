@@ -65,6 +65,31 @@ If you do not want to be bound by the GPL terms (such as the requirement
     OBJC_IMEBRA_FUNCTION_END_RETURN(nil);
 }
 
++(ImebraVOIDescription*)getOptimalVOI:
+    (ImebraImage*)pInputImage
+    inputTopLeftX:(unsigned int)inputTopLeftX
+    inputTopLeftY:(unsigned int)inputTopLeftY
+    inputWidth:(unsigned int)inputWidth
+    inputHeight:(unsigned int)inputHeight
+    lowPercentile:(double)lowPercentile
+    highPercentile:(double)highPercentile
+    error:(NSError**)pError
+{
+    OBJC_IMEBRA_FUNCTION_START();
+
+    return [[ImebraVOIDescription alloc] initWithImebraVOIDescription:new imebra::VOIDescription(
+        imebra::VOILUT::getOptimalVOI(
+                *get_other_imebra_object_holder(pInputImage, Image),
+                (std::uint32_t)inputTopLeftX,
+                (std::uint32_t)inputTopLeftY,
+                (std::uint32_t)inputWidth,
+                (std::uint32_t)inputHeight,
+                lowPercentile,
+                highPercentile)) ];
+
+    OBJC_IMEBRA_FUNCTION_END_RETURN(nil);
+}
+
 @end
 
 
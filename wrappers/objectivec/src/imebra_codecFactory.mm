@@ -15,12 +15,14 @@ If you do not want to be bound by the GPL terms (such as the requirement
 #import "../include/imebraobjc/imebra_dataset.h"
 #import "../include/imebraobjc/imebra_streamReader.h"
 #import "../include/imebraobjc/imebra_streamWriter.h"
+#import "../include/imebraobjc/imebra_tagId.h"
 #include "imebra_implementation_macros.h"
 #include "imebra_nserror.h"
 #include "imebra_strings.h"
 #include <imebra/codecFactory.h>
 #include <imebra/dataSet.h>
 #include <imebra/streamReader.h>
+#include <imebra/tagId.h>
 
 @implementation ImebraCodecFactory
 
@@ -64,6 +66,16 @@ If you do not want to be bound by the GPL terms (such as the requirement
     OBJC_IMEBRA_FUNCTION_END_RETURN(nil);
 }
 
++(ImebraDataSet*)loadFromStreamStopAtTag:(ImebraStreamReader*)pReader maxBufferSize:(unsigned int)maxBufferSize stopAtTag:(ImebraTagId*)pStopAtTag error:(NSError**)pError
+{
+    OBJC_IMEBRA_FUNCTION_START();
+
+    std::unique_ptr<imebra::DataSet> pDataSet(new imebra::DataSet(imebra::CodecFactory::load(*get_other_imebra_object_holder(pReader, StreamReader), maxBufferSize, *get_other_imebra_object_holder(pStopAtTag, TagId))));
+    return [[ImebraDataSet alloc] initWithImebraDataSet:pDataSet.release()];
+
+    OBJC_IMEBRA_FUNCTION_END_RETURN(nil);
+}
+
 +(void)saveToFile:(NSString*)fileName dataSet:(ImebraDataSet*)pDataSet codecType:(ImebraCodecType)codecType error:(NSError**)pError
 {
     OBJC_IMEBRA_FUNCTION_START();
@@ -88,6 +100,21 @@ If you do not want to be bound by the GPL terms (such as the requirement
     imebra::CodecFactory::setMaximumImageSize((const::uint32_t)maximumWidth, (const::uint32_t)maximumHeight);
 }
 
++(void)setMaximumDecodingThreads:(unsigned int)maximumThreads
+{
+    imebra::CodecFactory::setMaximumDecodingThreads((std::uint32_t)maximumThreads);
+}
+
++(void)setJpegRestartInterval:(unsigned short)mcuPerRestartInterval
+{
+    imebra::CodecFactory::setJpegRestartInterval((std::uint16_t)mcuPerRestartInterval);
+}
+
++(void)setSimdEnabled:(BOOL)bEnable
+{
+    imebra::CodecFactory::setSimdEnabled(bEnable ? true : false);
+}
+
 
 @end
 
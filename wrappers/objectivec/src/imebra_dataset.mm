@@ -511,6 +511,20 @@ If you do not want to be bound by the GPL terms (such as the requirement
     OBJC_IMEBRA_FUNCTION_END_RETURN(ImebraTagTypeAE);
 }
 
+-(void)freeze:(NSError**)pError
+{
+    OBJC_IMEBRA_FUNCTION_START();
+
+    get_imebra_object_holder(DataSet)->freeze();
+
+    OBJC_IMEBRA_FUNCTION_END();
+}
+
+-(BOOL)isFrozen
+{
+    return get_imebra_object_holder(DataSet)->isFrozen();
+}
+
 @end
 
 
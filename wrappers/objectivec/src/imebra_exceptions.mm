@@ -127,6 +127,9 @@
 @implementation ImebraDataSetCorruptedOffsetTableError: ImebraDataSetError
 @end
 
+@implementation ImebraDataSetFrozenError: ImebraDataSetError
+@end
+
 @implementation ImebraDicomDirError: NSError
 @end
 
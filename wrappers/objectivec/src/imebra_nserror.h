@@ -184,6 +184,10 @@ namespace imebra
     {\
         imebra::setNSError(e, pError, [ImebraDataSetCorruptedOffsetTableError class]);\
     }\
+    catch(imebra::DataSetFrozenError& e)\
+    {\
+        imebra::setNSError(e, pError, [ImebraDataSetFrozenError class]);\
+    }\
     catch(imebra::DataSetError& e)\
     {\
         imebra::setNSError(e, pError, [ImebraDataSetError class]);\
@@ -131,6 +131,7 @@
 %include "../library/include/imebra/writingDataHandlerNumeric.h"
 %include "../library/include/imebra/lut.h"
 %include "../library/include/imebra/image.h"
+%include "../library/include/imebra/framesDecoder.h"
 %include "../library/include/imebra/overlay.h"
 %include "../library/include/imebra/tag.h"
 %include "../library/include/imebra/dataSet.h"
@@ -151,6 +152,7 @@
 %include "../library/include/imebra/dicomDictionary.h"
 %include "../library/include/imebra/drawBitmap.h"
 %include "../library/include/imebra/fileStreamInput.h"
+%include "../library/include/imebra/memoryMappedFileStreamInput.h"
 %include "../library/include/imebra/fileStreamOutput.h"
 %include "../library/include/imebra/memoryStreamInput.h"
 %include "../library/include/imebra/memoryStreamOutput.h"